@@ -0,0 +1,63 @@
+project(cooker)
+
+# The cooker only needs the files, jobs and logging of the engine, the texture formats and the cooking code itself.
+set(ENGINE_SOURCES
+    ${CMAKE_SOURCE_DIR}/engine/src/core/Compression.cpp
+    ${CMAKE_SOURCE_DIR}/engine/src/core/Data.cpp
+    ${CMAKE_SOURCE_DIR}/engine/src/core/DataStream.cpp
+    ${CMAKE_SOURCE_DIR}/engine/src/core/JobSystem.cpp
+    ${CMAKE_SOURCE_DIR}/engine/src/core/MemoryMappedFile.cpp
+    ${CMAKE_SOURCE_DIR}/engine/src/core/PakFile.cpp
+    ${CMAKE_SOURCE_DIR}/engine/src/core/PakWriter.cpp
+    ${CMAKE_SOURCE_DIR}/engine/src/core/System.cpp
+    ${CMAKE_SOURCE_DIR}/engine/src/graphics/TextureData.cpp
+    ${CMAKE_SOURCE_DIR}/engine/src/logger/Logger.cpp
+    ${CMAKE_SOURCE_DIR}/engine/src/utils/file_abstractions.cpp
+    ${CMAKE_SOURCE_DIR}/engine/src/utils/string_extensions.cpp
+)
+file(GLOB_RECURSE COOKING_HEADERS ${CMAKE_SOURCE_DIR}/engine/src/cooking/*.h)
+file(GLOB_RECURSE COOKING_SOURCES ${CMAKE_SOURCE_DIR}/engine/src/cooking/*.cpp)
+
+# Gather all cooker files.
+file(GLOB_RECURSE HEADERS ${CMAKE_SOURCE_DIR}/cooker/src/*.h)
+file(GLOB_RECURSE SOURCES ${CMAKE_SOURCE_DIR}/cooker/src/*.cpp)
+
+# Define executable.
+add_executable(${PROJECT_NAME} ${HEADERS} ${SOURCES} ${ENGINE_SOURCES} ${COOKING_HEADERS} ${COOKING_SOURCES})
+
+# Define preprocessor definitions for different configurations
+target_compile_definitions(${PROJECT_NAME} PRIVATE
+    "$<$<CONFIG:${DEBUG}>:${PREDEFINITIONS_GAME_DEBUG}>"
+    "$<$<CONFIG:${RELEASE}>:${PREDEFINITIONS_GAME_RELEASE}>"
+)
+
+# Include directories
+target_include_directories(${PROJECT_NAME} PUBLIC
+    ${CMAKE_SOURCE_DIR}/engine/src
+    ${CMAKE_SOURCE_DIR}/cooker/src
+    ${CMAKE_SOURCE_DIR}/external
+)
+
+# Set C++ standard
+set_target_properties(${PROJECT_NAME} PROPERTIES
+    CXX_STANDARD 20
+)
+
+find_package(Threads REQUIRED)
+target_link_libraries(${PROJECT_NAME} PRIVATE Threads::Threads)
+
+if(MSVC)
+    target_compile_options(${PROJECT_NAME} PRIVATE
+        "$<$<CONFIG:${DEBUG}>:/Od>"   # Disable optimizations for Debug
+        "$<$<CONFIG:${RELEASE}>:/O2>"  # Enable optimizations for Release
+        "$<$<CONFIG:${DEBUG}>:/MTd>"
+        "$<$<CONFIG:${RELEASE}>:/MT>"
+    )
+    target_link_libraries(${PROJECT_NAME} PRIVATE Shlwapi.lib)
+else()
+    # For GCC/Clang, set optimization level to 0 for debugging
+    target_compile_options(${PROJECT_NAME} PRIVATE
+        "$<$<CONFIG:${DEBUG}>:-O0>"  # Disable optimizations for Debug
+        "$<$<CONFIG:${RELEASE}>:-O2>"  # Optimize for Release
+    )
+endif()
\ No newline at end of file
@@ -0,0 +1,148 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "utils/file_abstractions.h"
+#include "core/JobSystem.h"
+#include "logger/Logger.h"
+#include "cooking/AssetCooker.h"
+
+namespace
+{
+	const char* g_sUsage =
+		"Usage: cooker [options]\n"
+		"  --input <path>         Resource folder to cook (default: assets).\n"
+		"  --output <path>        Folder the cooked assets and the cook cache are written to (default: cooked).\n"
+		"  --pak <path>           Also packs the cooked folder into an archive the resource atlas can mount.\n"
+		"  --format <name>        \"rgba8\", \"bc1\", \"bc3\", \"bc4\", \"bc5\" or \"bc7\", the format textures are stored in (default: rgba8).\n"
+		"  --quality <name>       \"fast\", \"normal\" or \"high\", how long block compression searches (default: normal).\n"
+		"  --mips <0|1>           Whether textures get a full mip chain (default: 1).\n"
+		"  --mip-filter <name>    \"box\" or \"kaiser\", the filter the mips are made with (default: box).\n"
+		"  --premultiply <0|1>    Whether texture colors get multiplied with their alpha (default: 1).\n"
+		"  --srgb <0|1>           Whether texture colors are sRGB encoded and get filtered in linear space (default: 1).\n"
+		"  --compress <0|1>       Whether the archive entries get compressed (default: 0).\n"
+		"  --force <0|1>          Whether assets that did not change since the last cook get cooked anyway (default: 0).\n"
+		"  --report <0|1>         Logs the PSNR and throughput of every cooked texture (default: 0).\n"
+		"The meta file of a texture overrides these texture settings for that texture.\n";
+
+	//---------------------------------------------------------------------
+	bool parseFlag(const char* a_sValue, bool& a_bFlag)
+	{
+		if (strcmp(a_sValue, "0") == 0 || strcmp(a_sValue, "1") == 0)
+		{
+			a_bFlag = a_sValue[0] == '1';
+			return true;
+		}
+		return false;
+	}
+
+	//---------------------------------------------------------------------
+	bool parseArguments(int a_iArgumentCount, char* a_aArguments[], fs::path& a_InputFolder, fs::path& a_OutputFolder, fs::path& a_ArchivePath, bool& a_bCompress, gallus::cooking::AssetCookSettings& a_Settings)
+	{
+		// Every option takes a value, so an option without one is a mistake rather than something to skip.
+		if (a_iArgumentCount % 2 == 0)
+		{
+			fprintf(stderr, "Option \"%s\" is missing its value.\n", a_aArguments[a_iArgumentCount - 1]);
+			return false;
+		}
+
+		for (int i = 1; i + 1 < a_iArgumentCount; i += 2)
+		{
+			const char* option = a_aArguments[i];
+			const char* value = a_aArguments[i + 1];
+
+			bool valid = true;
+			if (strcmp(option, "--input") == 0)
+			{
+				a_InputFolder = value;
+			}
+			else if (strcmp(option, "--output") == 0)
+			{
+				a_OutputFolder = value;
+			}
+			else if (strcmp(option, "--pak") == 0)
+			{
+				a_ArchivePath = value;
+			}
+			else if (strcmp(option, "--format") == 0)
+			{
+				valid = gallus::cooking::ParseTextureFormat(value, a_Settings.m_Texture.m_Format);
+			}
+			else if (strcmp(option, "--quality") == 0)
+			{
+				valid = gallus::cooking::ParseCompressionQuality(value, a_Settings.m_Texture.m_Quality);
+			}
+			else if (strcmp(option, "--mips") == 0)
+			{
+				valid = parseFlag(value, a_Settings.m_Texture.m_bGenerateMips);
+			}
+			else if (strcmp(option, "--mip-filter") == 0)
+			{
+				valid = gallus::cooking::ParseMipFilter(value, a_Settings.m_Texture.m_MipFilter);
+			}
+			else if (strcmp(option, "--premultiply") == 0)
+			{
+				valid = parseFlag(value, a_Settings.m_Texture.m_bPremultiplyAlpha);
+			}
+			else if (strcmp(option, "--srgb") == 0)
+			{
+				valid = parseFlag(value, a_Settings.m_Texture.m_bSRGB);
+			}
+			else if (strcmp(option, "--compress") == 0)
+			{
+				valid = parseFlag(value, a_bCompress);
+			}
+			else if (strcmp(option, "--force") == 0)
+			{
+				valid = parseFlag(value, a_Settings.m_bForce);
+			}
+			else if (strcmp(option, "--report") == 0)
+			{
+				valid = parseFlag(value, a_Settings.m_bReport);
+			}
+			else
+			{
+				fprintf(stderr, "Unknown option \"%s\".\n", option);
+				return false;
+			}
+
+			if (!valid)
+			{
+				fprintf(stderr, "Invalid value \"%s\" for option \"%s\".\n", value, option);
+				return false;
+			}
+		}
+		return true;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	fs::path inputFolder = "assets";
+	fs::path outputFolder = "cooked";
+	fs::path archivePath;
+	bool compress = false;
+	gallus::cooking::AssetCookSettings settings;
+	if (!parseArguments(argc, argv, inputFolder, outputFolder, archivePath, compress, settings))
+	{
+		fputs(g_sUsage, stderr);
+		return EXIT_FAILURE;
+	}
+
+	gallus::logger::LOGGER.Initialize(true);
+
+	gallus::core::JobSystem jobSystem;
+	jobSystem.Initialize();
+
+	gallus::cooking::AssetCooker cooker;
+	bool success = cooker.Cook(inputFolder, outputFolder, settings, jobSystem);
+	if (success && !archivePath.empty())
+	{
+		success = cooker.WriteArchive(outputFolder, archivePath, compress);
+	}
+
+	jobSystem.Destroy();
+	gallus::logger::LOGGER.Destroy();
+	return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
\ No newline at end of file
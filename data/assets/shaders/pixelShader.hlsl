@@ -3,13 +3,14 @@ SamplerState samplerState : register(s0);
 
 struct PSInput
 {
-    float4 pos : SV_POSITION;
-    float2 uv  : TEXCOORD0;
+    float4 pos   : SV_POSITION;
+    float2 uv    : TEXCOORD0;
+    float4 color : COLOR0;
 };
 
 float4 main(PSInput input) : SV_TARGET
 {
-    float4 color = spriteTexture.Sample(samplerState, input.uv);
+    float4 color = spriteTexture.Sample(samplerState, input.uv) * input.color;
 
     return float4(input.uv, 0, 1); // color;
 }
\ No newline at end of file
@@ -1,29 +1,39 @@
-cbuffer Transform : register(b0)
+cbuffer Camera : register(b0)
 {
-    float4x4 WorldViewProj;
+    float4x4 ViewProj;
 }
 
 struct VSInput
 {
     float2 pos : POSITION; 
     float2 uv  : TEXCOORD0;
+
+    // Per instance, see SpriteInstance.
+    float2 world0 : WORLD0;
+    float2 world1 : WORLD1;
+    float2 world2 : WORLD2;
+    float4 uvRect : UVRECT0;
+    float4 color  : COLOR0;
 };
 
 struct PSInput
 {
-    float4 pos : SV_POSITION;
-    float2 uv  : TEXCOORD0;
+    float4 pos   : SV_POSITION;
+    float2 uv    : TEXCOORD0;
+    float4 color : COLOR0;
 };
 
 PSInput main(VSInput input)
 {
     PSInput output;
 
-    float4 worldPos = float4(input.pos, 0.0f, 1.0f);
+    // The world matrix is a 3x2 affine matrix, applied to the position as a row vector.
+    float2 worldPos = input.pos.x * input.world0 + input.pos.y * input.world1 + input.world2;
 
-    output.pos = mul(WorldViewProj, worldPos);
+    output.pos = mul(ViewProj, float4(worldPos, 0.0f, 1.0f));
 
-    output.uv = input.uv;
+    output.uv = input.uvRect.xy + input.uv * input.uvRect.zw;
+    output.color = input.color;
 
     return output;
 }
\ No newline at end of file
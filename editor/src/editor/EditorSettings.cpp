@@ -1,5 +1,6 @@
 #include "EditorSettings.h"
 
+#include "utils/rapidjson_config.h"
 #include <rapidjson/document.h>
 #include <rapidjson/stringbuffer.h>
 #include <rapidjson/prettywriter.h>
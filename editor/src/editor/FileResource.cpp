@@ -2,6 +2,7 @@
 
 #include "FileResource.h"
 
+#include "utils/rapidjson_config.h"
 #include <rapidjson/document.h>
 #include <rapidjson/utils.h>
 #include <rapidjson/stringbuffer.h>
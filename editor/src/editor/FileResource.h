@@ -4,6 +4,7 @@
 
 #include <vector>
 #include <string>
+#include "utils/rapidjson_config.h"
 #include <rapidjson/document.h>
 
 #include "utils/file_abstractions.h"
@@ -14,7 +14,7 @@ namespace gallus
 		{
 			namespace editor
 			{
-				HierarchyEntityUIView::HierarchyEntityUIView(ImGuiWindow& a_Window, gameplay::EntityID& a_EntityID) : ImGuiUIView(a_Window), m_EntityID(a_EntityID)
+				HierarchyEntityUIView::HierarchyEntityUIView(ImGuiWindow& a_Window, const gameplay::EntityID& a_EntityID) : ImGuiUIView(a_Window), m_EntityID(a_EntityID)
 				{
 					m_sIcon = font::ICON_IMAGE;
 				}
@@ -5,12 +5,10 @@
 
 #include <string>
 
+#include "gameplay/EntityID.h"
+
 namespace gallus
 {
-	namespace gameplay
-	{
-		class EntityID;
-	}
 	namespace graphics
 	{
 		namespace imgui
@@ -22,7 +20,7 @@ namespace gallus
 				class HierarchyEntityUIView : public ImGuiUIView, public EditorSelectable
 				{
 				public:
-					HierarchyEntityUIView(ImGuiWindow& a_Window, gameplay::EntityID& a_EntityID);
+					HierarchyEntityUIView(ImGuiWindow& a_Window, const gameplay::EntityID& a_EntityID);
 
 					/// <summary>
 					/// Renders the entity UI with selection and click interaction.
@@ -35,7 +33,7 @@ namespace gallus
 					void Render() override
 					{}
 
-					gameplay::EntityID& GetEntityID()
+					const gameplay::EntityID& GetEntityID() const
 					{
 						return m_EntityID;
 					}
@@ -45,7 +43,7 @@ namespace gallus
 						return m_sIcon;
 					}
 				private:
-					gameplay::EntityID& m_EntityID;
+					gameplay::EntityID m_EntityID;
 					std::string m_sIcon;
 				};
 			}
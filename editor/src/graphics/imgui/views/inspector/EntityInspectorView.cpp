@@ -16,16 +16,11 @@ namespace gallus
 				{
 					m_bShowRename = true;
 					m_bShowDelete = true;
-
-					m_Entity = core::TOOL->GetECS().GetEntity(m_HierarchyEntityUIView.GetEntityID());
 				}
 
 				void EntityInspectorView::OnRename(const std::string& a_sName)
 				{
-					if (m_Entity)
-					{
-						m_Entity->SetName(a_sName);
-					}
+					core::TOOL->GetECS().RenameEntity(m_HierarchyEntityUIView.GetEntityID(), a_sName);
 				}
 
 				void EntityInspectorView::OnDelete()
@@ -35,7 +30,8 @@ namespace gallus
 
 				std::string EntityInspectorView::GetName() const
 				{
-					return m_Entity ? m_Entity->GetName() : "";
+					const gameplay::Entity* entity = core::TOOL->GetECS().GetEntity(m_HierarchyEntityUIView.GetEntityID());
+					return entity ? entity->GetName() : "";
 				}
 
 
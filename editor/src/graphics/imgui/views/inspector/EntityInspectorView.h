@@ -6,10 +6,6 @@
 
 namespace gallus
 {
-	namespace gameplay
-	{
-		class Entity;
-	}
 	namespace graphics
 	{
 		namespace imgui
@@ -44,7 +40,6 @@ namespace gallus
 					void Render();
 				protected:
 					HierarchyEntityUIView& m_HierarchyEntityUIView;
-					gameplay::Entity* m_Entity = nullptr;
 				};
 			}
 		}
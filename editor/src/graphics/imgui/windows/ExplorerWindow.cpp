@@ -10,6 +10,7 @@
 #include "utils/file_abstractions.h"
 #include "core/EditorTool.h"
 #include "editor/FileResource.h"
+#include "cooking/AssetCooker.h"
 
 #include "graphics/dx12/CommandQueue.h"
 #include "graphics/dx12/CommandList.h"
@@ -41,6 +42,13 @@ namespace gallus
 				{
 					core::EDITOR_TOOL->GetAssetDatabase().GetOnScanCompleted() -= std::bind(&ExplorerWindow::OnScanCompleted, this);
 
+					// The job writes to the task, so it has to finish before the window goes away.
+					if (m_pCookTask)
+					{
+						core::TOOL->GetJobSystem().Wait(m_pCookTask->m_Counter);
+						m_pCookTask = nullptr;
+					}
+
 					return BaseWindow::Destroy();
 				}
 
@@ -121,6 +129,17 @@ namespace gallus
 
 					ImGui::SameLine();
 
+					// One cook at a time, the button is disabled until the running one is done.
+					ImGui::BeginDisabled(m_pCookTask != nullptr);
+					if (ImGui::IconButton(
+						ImGui::IMGUI_FORMAT_ID(std::string(font::ICON_CUBE), BUTTON_ID, "COOK_ASSETS_EXPLORER").c_str(), m_Window.GetHeaderSize(), m_Window.GetIconFont(), ImGui::GetStyleColorVec4(ImGuiCol_TextColorAccent)))
+					{
+						StartCook();
+					}
+					ImGui::EndDisabled();
+
+					ImGui::SameLine();
+
 					bool list = m_ExplorerViewMode == ExplorerViewMode::ExplorerViewMode_List;
 					bool grid = m_ExplorerViewMode == ExplorerViewMode::ExplorerViewMode_Grid;
 					if (ImGui::IconCheckboxButton(
@@ -143,6 +162,8 @@ namespace gallus
 						}
 					}
 
+					RenderCookStatus(topPosY + (toolbarSize.y / 2));
+
 					ImVec2 endPos = ImGui::GetCursorPos();
 
 					float searchbarWidth = 300;
@@ -266,6 +287,78 @@ namespace gallus
 				{
 					m_bNeedsRescan = true;
 				}
+
+				void ExplorerWindow::StartCook()
+				{
+					// Cooks next to the resource folder, so the game can mount the archive instead of reading the sources.
+					const fs::path resourceFolder = core::TOOL->GetResourceAtlas().GetResourceFolder();
+					const fs::path cookedFolder = resourceFolder.parent_path() / "cooked";
+					const fs::path archivePath = resourceFolder.parent_path() / "assets.pak";
+
+					m_sCookResult.clear();
+					m_pCookTask = std::make_unique<CookTask>();
+
+					CookTask* task = m_pCookTask.get();
+					std::function<void()> cook = [task, resourceFolder, cookedFolder, archivePath]()
+					{
+						task->m_bCooked = task->m_Cooker.Cook(resourceFolder, cookedFolder, cooking::AssetCookSettings(), core::TOOL->GetJobSystem());
+						task->m_bArchiveWritten = task->m_bCooked && task->m_Cooker.WriteArchive(cookedFolder, archivePath, false);
+					};
+
+					// Without workers, scheduled jobs only run while somebody waits, so the cook runs right away.
+					core::JobSystem& jobSystem = core::TOOL->GetJobSystem();
+					if (jobSystem.GetWorkerCount() == 0)
+					{
+						cook();
+					}
+					else
+					{
+						jobSystem.Schedule(cook, &task->m_Counter);
+					}
+				}
+
+				void ExplorerWindow::RenderCookStatus(float a_fCenterY)
+				{
+					if (m_pCookTask && m_pCookTask->m_Counter.IsDone())
+					{
+						const cooking::AssetCookStats& stats = m_pCookTask->m_Cooker.GetStats();
+						if (!m_pCookTask->m_bCooked)
+						{
+							m_sCookResult = "Cook failed, " + std::to_string(stats.m_iFailed) + " assets could not be cooked.";
+						}
+						else if (!m_pCookTask->m_bArchiveWritten)
+						{
+							m_sCookResult = "Cooked the assets, but writing the archive failed.";
+						}
+						else
+						{
+							m_sCookResult = "Cooked " + std::to_string(stats.m_iCooked) + " textures, copied " + std::to_string(stats.m_iCopied) + " files, " + std::to_string(stats.m_iSkipped) + " unchanged.";
+						}
+						m_pCookTask = nullptr;
+					}
+
+					if (!m_pCookTask && m_sCookResult.empty())
+					{
+						return;
+					}
+
+					ImGui::SameLine(0, m_Window.GetWindowPadding().x);
+					if (m_pCookTask)
+					{
+						uint32_t done = 0, total = 0;
+						m_pCookTask->m_Cooker.GetProgress(done, total);
+
+						const std::string progress = "Cooking " + std::to_string(done) + "/" + std::to_string(total);
+						const float height = m_Window.GetFontSize() + m_Window.GetFramePadding().y * 2;
+						ImGui::SetCursorPosY(a_fCenterY - height / 2);
+						ImGui::ProgressBar(total > 0 ? static_cast<float>(done) / static_cast<float>(total) : 0.0f, ImVec2(200, height), progress.c_str());
+					}
+					else
+					{
+						ImGui::SetCursorPosY(a_fCenterY - ImGui::GetTextLineHeight() / 2);
+						ImGui::TextUnformatted(m_sCookResult.c_str());
+					}
+				}
 			}
 		}
 	}
@@ -6,6 +6,8 @@
 #include <string>
 #include <memory>
 
+#include "core/JobSystem.h"
+#include "cooking/AssetCooker.h"
 #include "graphics/imgui/windows/BaseWindow.h"
 #include "graphics/imgui/views/DataTypes/StringTextInput.h"
 #include "graphics/imgui/views/ExplorerFileUIView.h"
@@ -69,6 +71,28 @@ namespace gallus
 					/// </summary>
 					void OnScanCompleted();
 				private:
+					/// <summary>
+					/// A cook started from the toolbar. It runs on the job system, the window polls it every frame.
+					/// </summary>
+					struct CookTask
+					{
+						cooking::AssetCooker m_Cooker;
+						core::JobCounter m_Counter;
+						bool m_bCooked = false; /// Written by the job, read once the counter is done.
+						bool m_bArchiveWritten = false; /// Written by the job, read once the counter is done.
+					};
+
+					/// <summary>
+					/// Starts cooking the resource folder into an archive on the job system.
+					/// </summary>
+					void StartCook();
+
+					/// <summary>
+					/// Renders the progress of the running cook, or the result of the last one, next to the toolbar buttons.
+					/// </summary>
+					/// <param name="a_fCenterY">Vertical center of the toolbar.</param>
+					void RenderCookStatus(float a_fCenterY);
+
 					ExplorerViewMode m_ExplorerViewMode = ExplorerViewMode::ExplorerViewMode_List; // How are explorer resources shown?
 
 					bool m_bNeedsRescan = true; /// Whether the explorer needs to refresh the results shown in the explorer window.
@@ -80,6 +104,9 @@ namespace gallus
 					ExplorerFileUIView* m_pViewedFolder = nullptr; /// Selected resource used for context menu.
 
 					SearchBarInput m_SearchBar; /// Search bar to filter specific explorer items in the explorer window.
+
+					std::unique_ptr<CookTask> m_pCookTask = nullptr; /// The running cook, if any.
+					std::string m_sCookResult; /// Result of the last cook, shown in the toolbar.
 				};
 			}
 		}
@@ -3,6 +3,10 @@ project(engine_noimgui)
 file(GLOB_RECURSE HEADERS ${CMAKE_SOURCE_DIR}/engine/src/*.h)
 file(GLOB_RECURSE SOURCES ${CMAKE_SOURCE_DIR}/engine/src/*.cpp)
 
+# The null graphics backend and the software rasterizer that draws its resources are only used by the headless project.
+list(FILTER HEADERS EXCLUDE REGEX "/graphics/(null|software)/")
+list(FILTER SOURCES EXCLUDE REGEX "/graphics/(null|software)/")
+
 set(DX12
     ${CMAKE_SOURCE_DIR}/external/dx12/directx/d3dx12_property_format_table.cpp
 )
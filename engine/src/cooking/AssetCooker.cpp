@@ -0,0 +1,326 @@
+#include "cooking/AssetCooker.h"
+
+// # Rapidjson
+#include "utils/rapidjson_config.h"
+#include <rapidjson/document.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/prettywriter.h>
+#include <rapidjson/utils.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "core/DataStream.h"
+#include "core/Hash.h"
+#include "core/PakWriter.h"
+#include "utils/string_extensions.h"
+#include "logger/Logger.h"
+
+#define JSON_COOK_CACHE_VERSION_VAR "version"
+#define JSON_COOK_CACHE_ASSETS_VAR "assets"
+#define JSON_COOK_CACHE_SOURCE_VAR "source"
+#define JSON_COOK_CACHE_SETTINGS_VAR "settings"
+
+#define JSON_TEXTURE_META_FORMAT_VAR "textureFormat"
+#define JSON_TEXTURE_META_QUALITY_VAR "textureQuality"
+#define JSON_TEXTURE_META_MIP_FILTER_VAR "mipFilter"
+#define JSON_TEXTURE_META_GENERATE_MIPS_VAR "generateMips"
+#define JSON_TEXTURE_META_PREMULTIPLY_VAR "premultiplyAlpha"
+#define JSON_TEXTURE_META_SRGB_VAR "sRGB"
+
+namespace gallus
+{
+	namespace cooking
+	{
+		inline const uint32_t g_iCookCacheVersion = 1;
+
+		//---------------------------------------------------------------------
+		bool isTexture(const fs::path& a_Path)
+		{
+			const std::string extension = string_extensions::StringToLower(a_Path.extension().generic_string());
+			return extension == ".png" || extension == ".jpg" || extension == ".jpeg" || extension == ".tga" || extension == ".bmp";
+		}
+
+		//---------------------------------------------------------------------
+		TextureCookSettings getTextureSettings(const fs::path& a_Path, const TextureCookSettings& a_Defaults)
+		{
+			TextureCookSettings settings = a_Defaults;
+
+			// Textures the editor never saw have no meta file, they use the defaults.
+			core::DataStream data;
+			if (!file::LoadFile(a_Path.generic_string() + ".meta", data))
+			{
+				return settings;
+			}
+
+			rapidjson::Document document;
+			document.Parse(reinterpret_cast<char*>(data.data()), data.size());
+			if (document.HasParseError() || !document.IsObject())
+			{
+				return settings;
+			}
+
+			std::string value;
+			if (rapidjson::GetString(document, JSON_TEXTURE_META_FORMAT_VAR, value) && !ParseTextureFormat(string_extensions::StringToLower(value), settings.m_Format))
+			{
+				LOGF(LOGSEVERITY_WARNING, LOG_CATEGORY_ENGINE, "Unknown texture format \"%s\" in meta file of \"%s\".", value.c_str(), a_Path.generic_string().c_str());
+			}
+			if (rapidjson::GetString(document, JSON_TEXTURE_META_QUALITY_VAR, value) && !ParseCompressionQuality(string_extensions::StringToLower(value), settings.m_Quality))
+			{
+				LOGF(LOGSEVERITY_WARNING, LOG_CATEGORY_ENGINE, "Unknown texture quality \"%s\" in meta file of \"%s\".", value.c_str(), a_Path.generic_string().c_str());
+			}
+			if (rapidjson::GetString(document, JSON_TEXTURE_META_MIP_FILTER_VAR, value) && !ParseMipFilter(string_extensions::StringToLower(value), settings.m_MipFilter))
+			{
+				LOGF(LOGSEVERITY_WARNING, LOG_CATEGORY_ENGINE, "Unknown mip filter \"%s\" in meta file of \"%s\".", value.c_str(), a_Path.generic_string().c_str());
+			}
+			rapidjson::GetBool(document, JSON_TEXTURE_META_GENERATE_MIPS_VAR, settings.m_bGenerateMips);
+			rapidjson::GetBool(document, JSON_TEXTURE_META_PREMULTIPLY_VAR, settings.m_bPremultiplyAlpha);
+			rapidjson::GetBool(document, JSON_TEXTURE_META_SRGB_VAR, settings.m_bSRGB);
+			return settings;
+		}
+
+		//---------------------------------------------------------------------
+		uint64_t hashSettings(const TextureCookSettings& a_Settings)
+		{
+			const uint32_t values[] = {
+				g_iTextureCookerVersion,
+				graphics::g_iCookedTextureVersion,
+				static_cast<uint32_t>(a_Settings.m_Format),
+				static_cast<uint32_t>(a_Settings.m_Quality),
+				static_cast<uint32_t>(a_Settings.m_MipFilter),
+				a_Settings.m_bGenerateMips ? 1u : 0u,
+				a_Settings.m_bPremultiplyAlpha ? 1u : 0u,
+				a_Settings.m_bSRGB ? 1u : 0u,
+			};
+			return core::HashFNV1a(values, sizeof(values));
+		}
+
+		//---------------------------------------------------------------------
+		// AssetCooker
+		//---------------------------------------------------------------------
+		bool AssetCooker::Cook(const fs::path& a_InputFolder, const fs::path& a_OutputFolder, const AssetCookSettings& a_Settings, core::JobSystem& a_JobSystem)
+		{
+			m_Stats = AssetCookStats();
+			m_iProgressDone.store(0);
+			m_iProgressTotal.store(0);
+
+			if (!fs::is_directory(a_InputFolder))
+			{
+				LOGF(LOGSEVERITY_ERROR, LOG_CATEGORY_ENGINE, "Resource folder does not exist: \"%s\".", a_InputFolder.generic_string().c_str());
+				return false;
+			}
+
+			const fs::path cachePath = a_OutputFolder / g_sCookCacheFileName;
+			LoadCache(cachePath);
+
+			// The assets are listed up front, so the progress knows the total. Meta files are not shipped, the ones of
+			// textures are read along with them.
+			std::vector<fs::directory_entry> entries;
+			for (const fs::directory_entry& entry : fs::recursive_directory_iterator(a_InputFolder))
+			{
+				if (entry.is_regular_file() && entry.path().extension() != ".meta")
+				{
+					entries.push_back(entry);
+				}
+			}
+			m_iProgressTotal.store(static_cast<uint32_t>(entries.size()));
+
+			// Only assets that still exist end up in the new cache.
+			std::unordered_map<std::string, CacheEntry> cache;
+			for (size_t i = 0; i < entries.size(); i++)
+			{
+				m_iProgressDone.store(static_cast<uint32_t>(i));
+				const fs::directory_entry& entry = entries[i];
+
+				const std::string name = entry.path().lexically_relative(a_InputFolder).generic_string();
+				const fs::path outputPath = a_OutputFolder / name;
+
+				core::DataStream source;
+				if (!file::LoadFile(entry.path(), source))
+				{
+					LOGF(LOGSEVERITY_ERROR, LOG_CATEGORY_ENGINE, "Failed reading asset: \"%s\".", entry.path().generic_string().c_str());
+					m_Stats.m_iFailed++;
+					continue;
+				}
+
+				// Copied files only depend on their contents.
+				const bool texture = isTexture(entry.path());
+				const TextureCookSettings textureSettings = texture ? getTextureSettings(entry.path(), a_Settings.m_Texture) : a_Settings.m_Texture;
+
+				CacheEntry cacheEntry;
+				cacheEntry.m_iSourceHash = core::HashFNV1a(source.data(), source.size());
+				cacheEntry.m_iSettingsHash = texture ? hashSettings(textureSettings) : 0;
+
+				auto previous = m_aCache.find(name);
+				if (!a_Settings.m_bForce && previous != m_aCache.end() && fs::exists(outputPath) &&
+					previous->second.m_iSourceHash == cacheEntry.m_iSourceHash && previous->second.m_iSettingsHash == cacheEntry.m_iSettingsHash)
+				{
+					cache.emplace(name, cacheEntry);
+					m_Stats.m_iSkipped++;
+					continue;
+				}
+
+				file::CreateDirectory(outputPath.parent_path());
+
+				bool success = false;
+				if (texture)
+				{
+					std::vector<uint8_t> cooked;
+					TextureCookStats textureStats;
+					success = CookTexture(source, textureSettings, a_JobSystem, cooked, a_Settings.m_bReport ? &textureStats : nullptr) && file::SaveFile(outputPath, core::DataStream(cooked.data(), cooked.size()));
+					if (success)
+					{
+						m_Stats.m_iCooked++;
+						m_Stats.m_iTexturePixels += textureStats.m_iPixelCount;
+						m_Stats.m_fTextureTime += textureStats.m_fMipTime + textureStats.m_fEncodeTime;
+					}
+					if (success && a_Settings.m_bReport)
+					{
+						const double time = textureStats.m_fMipTime + textureStats.m_fEncodeTime;
+						LOGF(LOGSEVERITY_INFO, LOG_CATEGORY_ENGINE, "Cooked \"%s\" as %s: %.2f dB, %.1f megapixels per second (mips %.3f ms, encoding %.3f ms).",
+							name.c_str(),
+							GetTextureFormatName(textureSettings.m_Format),
+							textureStats.m_fPSNR,
+							time > 0.0 ? static_cast<double>(textureStats.m_iPixelCount) / time / 1000000.0 : 0.0,
+							textureStats.m_fMipTime * 1000.0,
+							textureStats.m_fEncodeTime * 1000.0);
+					}
+				}
+				else
+				{
+					std::error_code error;
+					success = fs::copy_file(entry.path(), outputPath, fs::copy_options::overwrite_existing, error);
+					m_Stats.m_iCopied += success ? 1 : 0;
+				}
+
+				if (!success)
+				{
+					LOGF(LOGSEVERITY_ERROR, LOG_CATEGORY_ENGINE, "Failed cooking asset: \"%s\".", entry.path().generic_string().c_str());
+					m_Stats.m_iFailed++;
+					continue;
+				}
+				cache.emplace(name, cacheEntry);
+			}
+			m_iProgressDone.store(static_cast<uint32_t>(entries.size()));
+
+			// Assets that were deleted from the resource folder take their cooked output with them.
+			for (const auto& [name, entry] : m_aCache)
+			{
+				std::error_code error;
+				if (cache.find(name) == cache.end() && fs::remove(a_OutputFolder / name, error))
+				{
+					m_Stats.m_iRemoved++;
+				}
+			}
+
+			m_aCache = std::move(cache);
+			SaveCache(cachePath);
+
+			if (a_Settings.m_bReport && m_Stats.m_fTextureTime > 0.0)
+			{
+				LOGF(LOGSEVERITY_INFO, LOG_CATEGORY_ENGINE, "Cooked %llu texture pixels at %.1f megapixels per second, searching blocks with %s.",
+					static_cast<unsigned long long>(m_Stats.m_iTexturePixels),
+					static_cast<double>(m_Stats.m_iTexturePixels) / m_Stats.m_fTextureTime / 1000000.0,
+					GetBlockCompressionInstructionSet());
+			}
+
+			const LogSeverity severity = m_Stats.m_iFailed == 0 ? LOGSEVERITY_INFO_SUCCESS : LOGSEVERITY_WARNING;
+			LOGF(severity, LOG_CATEGORY_ENGINE, "Cooked \"%s\": %u textures cooked, %u files copied, %u unchanged, %u removed, %u failed.",
+				a_InputFolder.generic_string().c_str(), m_Stats.m_iCooked, m_Stats.m_iCopied, m_Stats.m_iSkipped, m_Stats.m_iRemoved, m_Stats.m_iFailed);
+			return m_Stats.m_iFailed == 0;
+		}
+
+		//---------------------------------------------------------------------
+		bool AssetCooker::WriteArchive(const fs::path& a_OutputFolder, const fs::path& a_ArchivePath, bool a_bCompress) const
+		{
+			// The cache lists exactly the assets the resource folder had, leftovers in the output folder are not packed.
+			// Sorted, so the same assets always give the same archive.
+			std::vector<std::string> names;
+			names.reserve(m_aCache.size());
+			for (const auto& [name, entry] : m_aCache)
+			{
+				names.push_back(name);
+			}
+			std::sort(names.begin(), names.end());
+
+			core::PakWriter writer;
+			for (const std::string& name : names)
+			{
+				if (!writer.AddFile(name, a_OutputFolder / name, a_bCompress))
+				{
+					return false;
+				}
+			}
+			return writer.Write(a_ArchivePath);
+		}
+
+		//---------------------------------------------------------------------
+		void AssetCooker::LoadCache(const fs::path& a_Path)
+		{
+			m_aCache.clear();
+
+			core::DataStream data;
+			if (!file::LoadFile(a_Path, data))
+			{
+				return;
+			}
+
+			rapidjson::Document document;
+			document.Parse(reinterpret_cast<char*>(data.data()), data.size());
+
+			if (document.HasParseError() || !document.IsObject() ||
+				!document.HasMember(JSON_COOK_CACHE_VERSION_VAR) || !document[JSON_COOK_CACHE_VERSION_VAR].IsUint() || document[JSON_COOK_CACHE_VERSION_VAR].GetUint() != g_iCookCacheVersion ||
+				!document.HasMember(JSON_COOK_CACHE_ASSETS_VAR) || !document[JSON_COOK_CACHE_ASSETS_VAR].IsObject())
+			{
+				LOGF(LOGSEVERITY_WARNING, LOG_CATEGORY_ENGINE, "Ignoring unreadable cook cache: \"%s\".", a_Path.generic_string().c_str());
+				return;
+			}
+
+			const rapidjson::Value& assets = document[JSON_COOK_CACHE_ASSETS_VAR];
+			for (rapidjson::Value::ConstMemberIterator asset = assets.MemberBegin(); asset != assets.MemberEnd(); ++asset)
+			{
+				if (!asset->value.IsObject() ||
+					!asset->value.HasMember(JSON_COOK_CACHE_SOURCE_VAR) || !asset->value[JSON_COOK_CACHE_SOURCE_VAR].IsUint64() ||
+					!asset->value.HasMember(JSON_COOK_CACHE_SETTINGS_VAR) || !asset->value[JSON_COOK_CACHE_SETTINGS_VAR].IsUint64())
+				{
+					continue;
+				}
+
+				CacheEntry& entry = m_aCache[asset->name.GetString()];
+				entry.m_iSourceHash = asset->value[JSON_COOK_CACHE_SOURCE_VAR].GetUint64();
+				entry.m_iSettingsHash = asset->value[JSON_COOK_CACHE_SETTINGS_VAR].GetUint64();
+			}
+		}
+
+		//---------------------------------------------------------------------
+		bool AssetCooker::SaveCache(const fs::path& a_Path) const
+		{
+			rapidjson::Document document;
+			document.SetObject();
+			rapidjson::Document::AllocatorType& allocator = document.GetAllocator();
+
+			rapidjson::Value assets(rapidjson::kObjectType);
+			for (const auto& [name, entry] : m_aCache)
+			{
+				rapidjson::Value asset(rapidjson::kObjectType);
+				asset.AddMember(JSON_COOK_CACHE_SOURCE_VAR, rapidjson::Value().SetUint64(entry.m_iSourceHash), allocator);
+				asset.AddMember(JSON_COOK_CACHE_SETTINGS_VAR, rapidjson::Value().SetUint64(entry.m_iSettingsHash), allocator);
+				assets.AddMember(rapidjson::Value(name.c_str(), allocator), asset, allocator);
+			}
+			document.AddMember(JSON_COOK_CACHE_VERSION_VAR, g_iCookCacheVersion, allocator);
+			document.AddMember(JSON_COOK_CACHE_ASSETS_VAR, assets, allocator);
+
+			rapidjson::StringBuffer buffer;
+			rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buffer);
+			document.Accept(writer);
+
+			file::CreateDirectory(a_Path.parent_path());
+			if (!file::SaveFile(a_Path, core::Data(buffer.GetString(), buffer.GetSize())))
+			{
+				LOGF(LOGSEVERITY_ERROR, LOG_CATEGORY_ENGINE, "Failed saving cook cache: \"%s\".", a_Path.generic_string().c_str());
+				return false;
+			}
+			return true;
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "utils/file_abstractions.h"
+#include "cooking/TextureCooker.h"
+
+namespace gallus
+{
+	namespace core
+	{
+		class JobSystem;
+	}
+
+	namespace cooking
+	{
+		inline const std::string g_sCookCacheFileName = "cook_cache.json";
+
+		/// <summary>
+		/// How a resource folder gets cooked.
+		/// </summary>
+		struct AssetCookSettings
+		{
+			TextureCookSettings m_Texture; /// Defaults for every texture, the meta file of a texture can override them.
+			bool m_bForce = false; /// Whether to cook assets that did not change since the last cook.
+			bool m_bReport = false; /// Whether to log the timings and the error of every cooked texture.
+		};
+
+		/// <summary>
+		/// What the last cook did.
+		/// </summary>
+		struct AssetCookStats
+		{
+			uint32_t m_iCooked = 0; /// Textures that were cooked.
+			uint32_t m_iCopied = 0; /// Other files that were copied as they are.
+			uint32_t m_iSkipped = 0; /// Assets that did not change since the last cook.
+			uint32_t m_iRemoved = 0; /// Outputs of assets that no longer exist in the resource folder.
+			uint32_t m_iFailed = 0;
+			uint64_t m_iTexturePixels = 0; /// Pixels of all mips of the cooked textures, only counted when reporting.
+			double m_fTextureTime = 0.0; /// Seconds spent making mips and encoding them, only counted when reporting.
+		};
+
+		//---------------------------------------------------------------------
+		// AssetCooker
+		//---------------------------------------------------------------------
+		/// <summary>
+		/// Cooks a resource folder into an output folder with the same layout. Images are replaced by cooked textures under
+		/// the same name, so the runtime finds them where it looked for the source, everything else is copied. The hashes of
+		/// the sources and settings are kept in a cache file next to the output, assets whose hashes did not change are skipped.
+		/// The meta file the editor keeps next to a texture can override its settings, for example "textureFormat": "bc5".
+		/// </summary>
+		class AssetCooker
+		{
+		public:
+			/// <summary>
+			/// Cooks every asset of a folder that changed since the last cook.
+			/// </summary>
+			/// <param name="a_InputFolder">The resource folder.</param>
+			/// <param name="a_OutputFolder">Folder the cooked assets and the cache are written to.</param>
+			/// <param name="a_Settings">How to cook the assets.</param>
+			/// <param name="a_JobSystem">The job system the textures are cooked on.</param>
+			/// <returns>True if every asset was cooked or skipped, otherwise false.</returns>
+			bool Cook(const fs::path& a_InputFolder, const fs::path& a_OutputFolder, const AssetCookSettings& a_Settings, core::JobSystem& a_JobSystem);
+
+			/// <summary>
+			/// Packs the assets of the last cook into an archive the resource atlas can mount. Only the assets in the cache
+			/// are packed, other files in the output folder are left out.
+			/// </summary>
+			/// <param name="a_OutputFolder">The folder Cook wrote to.</param>
+			/// <param name="a_ArchivePath">Path of the archive.</param>
+			/// <param name="a_bCompress">Whether to compress the entries.</param>
+			/// <returns>True if the archive was written, otherwise false.</returns>
+			bool WriteArchive(const fs::path& a_OutputFolder, const fs::path& a_ArchivePath, bool a_bCompress) const;
+
+			/// <summary>
+			/// Retrieves what the last cook did.
+			/// </summary>
+			/// <returns>The counters of the last cook.</returns>
+			const AssetCookStats& GetStats() const
+			{
+				return m_Stats;
+			}
+
+			/// <summary>
+			/// Retrieves how far the running cook is. Safe to call from another thread while Cook runs.
+			/// </summary>
+			/// <param name="a_iDone">Receives the number of assets that were cooked, copied, skipped or failed.</param>
+			/// <param name="a_iTotal">Receives the number of assets in the resource folder, 0 until they have been listed.</param>
+			void GetProgress(uint32_t& a_iDone, uint32_t& a_iTotal) const
+			{
+				a_iTotal = m_iProgressTotal.load(std::memory_order_acquire);
+				a_iDone = m_iProgressDone.load(std::memory_order_acquire);
+			}
+		private:
+			/// <summary>
+			/// Hashes an asset was last cooked with.
+			/// </summary>
+			struct CacheEntry
+			{
+				uint64_t m_iSourceHash = 0;
+				uint64_t m_iSettingsHash = 0;
+			};
+
+			/// <summary>
+			/// Reads the cache of the previous cook, an unreadable cache counts as empty.
+			/// </summary>
+			/// <param name="a_Path">Path to the cache file.</param>
+			void LoadCache(const fs::path& a_Path);
+
+			/// <summary>
+			/// Writes the cache.
+			/// </summary>
+			/// <param name="a_Path">Path to the cache file.</param>
+			/// <returns>True if the cache was written, otherwise false.</returns>
+			bool SaveCache(const fs::path& a_Path) const;
+
+			std::unordered_map<std::string, CacheEntry> m_aCache; /// By name relative to the resource folder.
+			AssetCookStats m_Stats;
+			std::atomic<uint32_t> m_iProgressDone = 0;
+			std::atomic<uint32_t> m_iProgressTotal = 0;
+		};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,895 @@
+#include "cooking/BlockCompression.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+
+// The searches are picked at compile time, like the batched math. MSVC does not define __SSE2__, but SSE2 is always available on x64.
+#if !defined(GALLUS_COOKING_SCALAR) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define GALLUS_COOKING_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace gallus
+{
+	namespace cooking
+	{
+		namespace
+		{
+			/// <summary>
+			/// The pixels of a block channel by channel, so four pixels of a channel fill a register.
+			/// </summary>
+			struct BlockPixels
+			{
+				alignas(16) float m_aChannels[4][16];
+			};
+
+			const float g_aColorWeights[4] = { 1.0f, 1.0f, 1.0f, 0.0f };
+			const float g_aColorAlphaWeights[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+			const float g_aAlphaWeights[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+			const float g_aBC1IndexWeights[4] = { 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f }; /// How far each BC1 index lies towards the second endpoint.
+			const uint32_t g_aBC7Weights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+			const uint32_t g_aBC7Weights2[4] = { 0, 21, 43, 64 };
+			const uint32_t g_aBC7Weights3[8] = { 0, 9, 18, 27, 37, 46, 55, 64 };
+
+			/// <summary>
+			/// Endpoints and indices of the color or the alpha part of a mode 4 or mode 5 block.
+			/// </summary>
+			struct BC7Component
+			{
+				uint32_t m_aValues[2][4] = {}; /// Quantized endpoints, only the channels of the part are used.
+				uint8_t m_aIndices[16] = {};
+				float m_fError = FLT_MAX;
+			};
+
+			//---------------------------------------------------------------------
+			BlockPixels loadBlock(const uint32_t a_aPixels[16])
+			{
+				BlockPixels block;
+				for (uint32_t i = 0; i < 16; i++)
+				{
+					for (uint32_t channel = 0; channel < 4; channel++)
+					{
+						block.m_aChannels[channel][i] = static_cast<float>((a_aPixels[i] >> (channel * 8)) & 0xFF);
+					}
+				}
+				return block;
+			}
+
+			//---------------------------------------------------------------------
+			uint32_t getIterations(CompressionQuality a_Quality)
+			{
+				return a_Quality == CompressionQuality::High ? 4 : (a_Quality == CompressionQuality::Normal ? 1 : 0);
+			}
+
+			//---------------------------------------------------------------------
+			float dot16(const float* a_pA, const float* a_pB)
+			{
+#ifdef GALLUS_COOKING_SSE2
+				__m128 sum = _mm_setzero_ps();
+				for (uint32_t i = 0; i < 16; i += 4)
+				{
+					sum = _mm_add_ps(sum, _mm_mul_ps(_mm_load_ps(a_pA + i), _mm_load_ps(a_pB + i)));
+				}
+				alignas(16) float lanes[4];
+				_mm_store_ps(lanes, sum);
+				return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+#else
+				float sum = 0.0f;
+				for (uint32_t i = 0; i < 16; i++)
+				{
+					sum += a_pA[i] * a_pB[i];
+				}
+				return sum;
+#endif // GALLUS_COOKING_SSE2
+			}
+
+			//---------------------------------------------------------------------
+			void computePrincipalAxis(const BlockPixels& a_Block, const float a_aWeights[4], float a_aMean[4], float a_aAxis[4])
+			{
+				BlockPixels centered;
+				for (uint32_t channel = 0; channel < 4; channel++)
+				{
+					float sum = 0.0f;
+					for (uint32_t i = 0; i < 16; i++)
+					{
+						sum += a_Block.m_aChannels[channel][i];
+					}
+					a_aMean[channel] = sum / 16.0f;
+					for (uint32_t i = 0; i < 16; i++)
+					{
+						centered.m_aChannels[channel][i] = (a_Block.m_aChannels[channel][i] - a_aMean[channel]) * a_aWeights[channel];
+					}
+				}
+
+				float covariance[4][4];
+				for (uint32_t row = 0; row < 4; row++)
+				{
+					for (uint32_t column = row; column < 4; column++)
+					{
+						covariance[row][column] = dot16(centered.m_aChannels[row], centered.m_aChannels[column]);
+						covariance[column][row] = covariance[row][column];
+					}
+				}
+
+				// A few power iterations are plenty for 16 pixels, the axis only seeds the endpoints. They start from the
+				// covariance of the channel that varies most, a fixed start like the gray axis is orthogonal to blocks where
+				// channels run against each other and would never turn towards them.
+				uint32_t widest = 0;
+				for (uint32_t channel = 1; channel < 4; channel++)
+				{
+					widest = covariance[channel][channel] > covariance[widest][widest] ? channel : widest;
+				}
+				float axis[4] = { covariance[0][widest], covariance[1][widest], covariance[2][widest], covariance[3][widest] };
+				for (uint32_t iteration = 0; iteration < 8; iteration++)
+				{
+					float next[4];
+					float largest = 0.0f;
+					for (uint32_t row = 0; row < 4; row++)
+					{
+						next[row] = covariance[row][0] * axis[0] + covariance[row][1] * axis[1] + covariance[row][2] * axis[2] + covariance[row][3] * axis[3];
+						largest = std::max(largest, std::abs(next[row]));
+					}
+					if (largest < FLT_EPSILON)
+					{
+						break;
+					}
+					for (uint32_t row = 0; row < 4; row++)
+					{
+						axis[row] = next[row] / largest;
+					}
+				}
+
+				const float length = std::sqrt(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2] + axis[3] * axis[3]);
+				for (uint32_t channel = 0; channel < 4; channel++)
+				{
+					a_aAxis[channel] = length > FLT_EPSILON ? axis[channel] / length : 0.0f;
+				}
+			}
+
+			//---------------------------------------------------------------------
+			void getAxisEndpoints(const BlockPixels& a_Block, const float a_aWeights[4], float a_aEndpoint0[4], float a_aEndpoint1[4])
+			{
+				float mean[4];
+				float axis[4];
+				computePrincipalAxis(a_Block, a_aWeights, mean, axis);
+
+				float minimum = 0.0f;
+				float maximum = 0.0f;
+#ifdef GALLUS_COOKING_SSE2
+				__m128 lowest = _mm_set1_ps(FLT_MAX);
+				__m128 highest = _mm_set1_ps(-FLT_MAX);
+				for (uint32_t i = 0; i < 16; i += 4)
+				{
+					__m128 projection = _mm_setzero_ps();
+					for (uint32_t channel = 0; channel < 4; channel++)
+					{
+						const __m128 centered = _mm_sub_ps(_mm_load_ps(&a_Block.m_aChannels[channel][i]), _mm_set1_ps(mean[channel]));
+						projection = _mm_add_ps(projection, _mm_mul_ps(centered, _mm_set1_ps(axis[channel])));
+					}
+					lowest = _mm_min_ps(lowest, projection);
+					highest = _mm_max_ps(highest, projection);
+				}
+				alignas(16) float lowestLanes[4];
+				alignas(16) float highestLanes[4];
+				_mm_store_ps(lowestLanes, lowest);
+				_mm_store_ps(highestLanes, highest);
+				minimum = std::min(std::min(lowestLanes[0], lowestLanes[1]), std::min(lowestLanes[2], lowestLanes[3]));
+				maximum = std::max(std::max(highestLanes[0], highestLanes[1]), std::max(highestLanes[2], highestLanes[3]));
+#else
+				minimum = FLT_MAX;
+				maximum = -FLT_MAX;
+				for (uint32_t i = 0; i < 16; i++)
+				{
+					float projection = 0.0f;
+					for (uint32_t channel = 0; channel < 4; channel++)
+					{
+						projection += (a_Block.m_aChannels[channel][i] - mean[channel]) * axis[channel];
+					}
+					minimum = std::min(minimum, projection);
+					maximum = std::max(maximum, projection);
+				}
+#endif // GALLUS_COOKING_SSE2
+
+				for (uint32_t channel = 0; channel < 4; channel++)
+				{
+					a_aEndpoint0[channel] = std::clamp(mean[channel] + axis[channel] * maximum, 0.0f, 255.0f);
+					a_aEndpoint1[channel] = std::clamp(mean[channel] + axis[channel] * minimum, 0.0f, 255.0f);
+				}
+			}
+
+			//---------------------------------------------------------------------
+			float selectIndices(const BlockPixels& a_Block, const float a_aWeights[4], const float a_aPalette[][4], uint32_t a_iPaletteSize, uint8_t a_aIndices[16])
+			{
+				float error = 0.0f;
+#ifdef GALLUS_COOKING_SSE2
+				for (uint32_t i = 0; i < 16; i += 4)
+				{
+					__m128 pixels[4];
+					for (uint32_t channel = 0; channel < 4; channel++)
+					{
+						pixels[channel] = _mm_load_ps(&a_Block.m_aChannels[channel][i]);
+					}
+
+					// Every lane keeps the closest entry so far, ties keep the lowest index like the scalar search.
+					__m128 best = _mm_set1_ps(FLT_MAX);
+					__m128 bestIndex = _mm_setzero_ps();
+					for (uint32_t entry = 0; entry < a_iPaletteSize; entry++)
+					{
+						__m128 distance = _mm_setzero_ps();
+						for (uint32_t channel = 0; channel < 4; channel++)
+						{
+							if (a_aWeights[channel] != 0.0f)
+							{
+								const __m128 difference = _mm_sub_ps(pixels[channel], _mm_set1_ps(a_aPalette[entry][channel]));
+								distance = _mm_add_ps(distance, _mm_mul_ps(_mm_mul_ps(difference, difference), _mm_set1_ps(a_aWeights[channel])));
+							}
+						}
+						const __m128 closer = _mm_cmplt_ps(distance, best);
+						best = _mm_min_ps(distance, best);
+						bestIndex = _mm_or_ps(_mm_and_ps(closer, _mm_set1_ps(static_cast<float>(entry))), _mm_andnot_ps(closer, bestIndex));
+					}
+
+					alignas(16) float distances[4];
+					alignas(16) float indices[4];
+					_mm_store_ps(distances, best);
+					_mm_store_ps(indices, bestIndex);
+					for (uint32_t lane = 0; lane < 4; lane++)
+					{
+						a_aIndices[i + lane] = static_cast<uint8_t>(indices[lane]);
+						error += distances[lane];
+					}
+				}
+#else
+				for (uint32_t i = 0; i < 16; i++)
+				{
+					float best = FLT_MAX;
+					for (uint32_t entry = 0; entry < a_iPaletteSize; entry++)
+					{
+						float distance = 0.0f;
+						for (uint32_t channel = 0; channel < 4; channel++)
+						{
+							if (a_aWeights[channel] != 0.0f)
+							{
+								const float difference = a_Block.m_aChannels[channel][i] - a_aPalette[entry][channel];
+								distance += difference * difference * a_aWeights[channel];
+							}
+						}
+						if (distance < best)
+						{
+							best = distance;
+							a_aIndices[i] = static_cast<uint8_t>(entry);
+						}
+					}
+					error += best;
+				}
+#endif // GALLUS_COOKING_SSE2
+				return error;
+			}
+
+			//---------------------------------------------------------------------
+			bool fitEndpoints(const BlockPixels& a_Block, const uint8_t a_aIndices[16], const float* a_pIndexWeights, float a_aEndpoint0[4], float a_aEndpoint1[4])
+			{
+				// Least squares fit of the endpoints for fixed indices: every pixel is (1 - w) * endpoint0 + w * endpoint1.
+				float weight00 = 0.0f;
+				float weight01 = 0.0f;
+				float weight11 = 0.0f;
+				float sum0[4] = {};
+				float sum1[4] = {};
+				for (uint32_t i = 0; i < 16; i++)
+				{
+					const float weight = a_pIndexWeights[a_aIndices[i]];
+					const float inverse = 1.0f - weight;
+					weight00 += inverse * inverse;
+					weight01 += inverse * weight;
+					weight11 += weight * weight;
+					for (uint32_t channel = 0; channel < 4; channel++)
+					{
+						sum0[channel] += inverse * a_Block.m_aChannels[channel][i];
+						sum1[channel] += weight * a_Block.m_aChannels[channel][i];
+					}
+				}
+
+				const float determinant = weight00 * weight11 - weight01 * weight01;
+				if (std::abs(determinant) < 1e-6f)
+				{
+					return false;
+				}
+
+				for (uint32_t channel = 0; channel < 4; channel++)
+				{
+					a_aEndpoint0[channel] = std::clamp((weight11 * sum0[channel] - weight01 * sum1[channel]) / determinant, 0.0f, 255.0f);
+					a_aEndpoint1[channel] = std::clamp((weight00 * sum1[channel] - weight01 * sum0[channel]) / determinant, 0.0f, 255.0f);
+				}
+				return true;
+			}
+
+			//---------------------------------------------------------------------
+			uint32_t quantize(float a_fValue, uint32_t a_iMaximum)
+			{
+				return static_cast<uint32_t>(std::lrint(std::clamp(a_fValue, 0.0f, 255.0f) * a_iMaximum / 255.0f));
+			}
+
+			//---------------------------------------------------------------------
+			float encodeColorEndpoints(const BlockPixels& a_Block, const float a_aEndpoint0[4], const float a_aEndpoint1[4], bool a_bAllowThreeColors, uint8_t* a_pBlock, uint8_t a_aIndices[16])
+			{
+				uint16_t color0 = static_cast<uint16_t>(quantize(a_aEndpoint0[0], 31) << 11 | quantize(a_aEndpoint0[1], 63) << 5 | quantize(a_aEndpoint0[2], 31));
+				uint16_t color1 = static_cast<uint16_t>(quantize(a_aEndpoint1[0], 31) << 11 | quantize(a_aEndpoint1[1], 63) << 5 | quantize(a_aEndpoint1[2], 31));
+
+				// The first endpoint has to be the larger one, otherwise BC1 would decode the block in the three color mode.
+				if (color0 < color1)
+				{
+					std::swap(color0, color1);
+				}
+
+				// Decoding with the indices 0, 1, 2 and 3 in the first row gives the palette exactly as the gpu builds it.
+				uint8_t block[16] = {};
+				block[8] = static_cast<uint8_t>(color0 & 0xFF);
+				block[9] = static_cast<uint8_t>(color0 >> 8);
+				block[10] = static_cast<uint8_t>(color1 & 0xFF);
+				block[11] = static_cast<uint8_t>(color1 >> 8);
+				block[12] = 0xE4;
+
+				uint32_t decoded[16];
+				if (a_bAllowThreeColors)
+				{
+					graphics::DecodeBC1Block(block + 8, decoded);
+				}
+				else
+				{
+					graphics::DecodeBC3Block(block, decoded);
+				}
+
+				float palette[4][4];
+				for (uint32_t entry = 0; entry < 4; entry++)
+				{
+					for (uint32_t channel = 0; channel < 4; channel++)
+					{
+						palette[entry][channel] = static_cast<float>((decoded[entry] >> (channel * 8)) & 0xFF);
+					}
+				}
+
+				// Equal endpoints decode in the three color mode, where the last index is transparent black.
+				const uint32_t paletteSize = a_bAllowThreeColors && color0 == color1 ? 3 : 4;
+				const float error = selectIndices(a_Block, g_aColorWeights, palette, paletteSize, a_aIndices);
+
+				uint32_t indices = 0;
+				for (uint32_t i = 0; i < 16; i++)
+				{
+					indices |= static_cast<uint32_t>(a_aIndices[i]) << (i * 2);
+				}
+				memcpy(a_pBlock, block + 8, 4);
+				memcpy(a_pBlock + 4, &indices, sizeof(indices));
+				return error;
+			}
+
+			//---------------------------------------------------------------------
+			void encodeColorBlock(const uint32_t a_aPixels[16], uint8_t* a_pBlock, CompressionQuality a_Quality, bool a_bAllowThreeColors)
+			{
+				const BlockPixels block = loadBlock(a_aPixels);
+
+				float endpoint0[4] = {};
+				float endpoint1[4] = {};
+				if (a_Quality == CompressionQuality::Fast)
+				{
+					// Pull the corners of the bounding box a little inwards, the interpolated colors then cover the box better.
+					for (uint32_t channel = 0; channel < 3; channel++)
+					{
+						const float* values = block.m_aChannels[channel];
+						const float minimum = *std::min_element(values, values + 16);
+						const float maximum = *std::max_element(values, values + 16);
+						const float inset = (maximum - minimum) / 16.0f;
+						endpoint0[channel] = maximum - inset;
+						endpoint1[channel] = minimum + inset;
+					}
+				}
+				else
+				{
+					getAxisEndpoints(block, g_aColorWeights, endpoint0, endpoint1);
+				}
+
+				uint8_t indices[16];
+				float error = encodeColorEndpoints(block, endpoint0, endpoint1, a_bAllowThreeColors, a_pBlock, indices);
+
+				// Refit the endpoints to the chosen indices for as long as that lowers the error.
+				const uint32_t iterations = getIterations(a_Quality);
+				for (uint32_t iteration = 0; iteration < iterations && error > 0.0f; iteration++)
+				{
+					if (!fitEndpoints(block, indices, g_aBC1IndexWeights, endpoint0, endpoint1))
+					{
+						break;
+					}
+
+					uint8_t candidate[8];
+					uint8_t candidateIndices[16];
+					const float candidateError = encodeColorEndpoints(block, endpoint0, endpoint1, a_bAllowThreeColors, candidate, candidateIndices);
+					if (candidateError >= error)
+					{
+						break;
+					}
+
+					error = candidateError;
+					memcpy(a_pBlock, candidate, sizeof(candidate));
+					memcpy(indices, candidateIndices, sizeof(indices));
+				}
+			}
+
+			//---------------------------------------------------------------------
+			float encodeSingleChannelEndpoints(const BlockPixels& a_Block, uint32_t a_iChannel, float a_fEndpoint0, float a_fEndpoint1, uint8_t* a_pBlock, uint8_t a_aIndices[16])
+			{
+				uint32_t value0 = quantize(a_fEndpoint0, 255);
+				uint32_t value1 = quantize(a_fEndpoint1, 255);
+
+				// With the first endpoint larger the block interpolates eight values between them.
+				if (value0 < value1)
+				{
+					std::swap(value0, value1);
+				}
+
+				// Equal endpoints decode in the six value mode, whose last two entries are 0 and 255.
+				float palette[8][4] = {};
+				palette[0][a_iChannel] = static_cast<float>(value0);
+				palette[1][a_iChannel] = static_cast<float>(value1);
+				for (uint32_t i = 2; i < 8; i++)
+				{
+					uint32_t value = (value0 * (8 - i) + value1 * (i - 1)) / 7;
+					if (value0 == value1)
+					{
+						value = i < 6 ? value0 : (i == 6 ? 0 : 255);
+					}
+					palette[i][a_iChannel] = static_cast<float>(value);
+				}
+
+				float weights[4] = {};
+				weights[a_iChannel] = 1.0f;
+				const float error = selectIndices(a_Block, weights, palette, 8, a_aIndices);
+
+				a_pBlock[0] = static_cast<uint8_t>(value0);
+				a_pBlock[1] = static_cast<uint8_t>(value1);
+				uint64_t indices = 0;
+				for (uint32_t i = 0; i < 16; i++)
+				{
+					indices |= static_cast<uint64_t>(a_aIndices[i]) << (i * 3);
+				}
+				for (uint32_t i = 0; i < 6; i++)
+				{
+					a_pBlock[2 + i] = static_cast<uint8_t>(indices >> (i * 8));
+				}
+				return error;
+			}
+
+			//---------------------------------------------------------------------
+			void encodeSingleChannelBlock(const BlockPixels& a_Block, uint32_t a_iChannel, uint8_t* a_pBlock, CompressionQuality a_Quality)
+			{
+				// How far each index of the eight value mode lies towards the second endpoint.
+				static const float indexWeights[8] = { 0.0f, 1.0f, 1.0f / 7.0f, 2.0f / 7.0f, 3.0f / 7.0f, 4.0f / 7.0f, 5.0f / 7.0f, 6.0f / 7.0f };
+
+				const float* values = a_Block.m_aChannels[a_iChannel];
+				float endpoint0[4] = {};
+				float endpoint1[4] = {};
+				endpoint0[a_iChannel] = *std::max_element(values, values + 16);
+				endpoint1[a_iChannel] = *std::min_element(values, values + 16);
+
+				uint8_t indices[16];
+				float error = encodeSingleChannelEndpoints(a_Block, a_iChannel, endpoint0[a_iChannel], endpoint1[a_iChannel], a_pBlock, indices);
+
+				const uint32_t iterations = getIterations(a_Quality);
+				for (uint32_t iteration = 0; iteration < iterations && error > 0.0f && a_pBlock[0] > a_pBlock[1]; iteration++)
+				{
+					if (!fitEndpoints(a_Block, indices, indexWeights, endpoint0, endpoint1))
+					{
+						break;
+					}
+
+					uint8_t candidate[8];
+					uint8_t candidateIndices[16];
+					const float candidateError = encodeSingleChannelEndpoints(a_Block, a_iChannel, endpoint0[a_iChannel], endpoint1[a_iChannel], candidate, candidateIndices);
+					if (candidateError >= error)
+					{
+						break;
+					}
+
+					error = candidateError;
+					memcpy(a_pBlock, candidate, sizeof(candidate));
+					memcpy(indices, candidateIndices, sizeof(indices));
+				}
+			}
+
+			//---------------------------------------------------------------------
+			void writeBits(uint8_t* a_pBlock, uint32_t& a_iOffset, uint32_t a_iValue, uint32_t a_iCount)
+			{
+				for (uint32_t i = 0; i < a_iCount; i++, a_iOffset++)
+				{
+					a_pBlock[a_iOffset >> 3] |= static_cast<uint8_t>(((a_iValue >> i) & 1) << (a_iOffset & 7));
+				}
+			}
+
+			//---------------------------------------------------------------------
+			uint32_t quantizeMode6(float a_fValue, uint32_t a_iPBit)
+			{
+				return static_cast<uint32_t>(std::clamp(std::lrint((a_fValue - static_cast<float>(a_iPBit)) / 2.0f), 0l, 127l));
+			}
+
+			//---------------------------------------------------------------------
+			uint32_t getBestPBit(const float a_aEndpoint[4])
+			{
+				float errors[2] = {};
+				for (uint32_t pBit = 0; pBit < 2; pBit++)
+				{
+					for (uint32_t channel = 0; channel < 4; channel++)
+					{
+						const float difference = static_cast<float>(quantizeMode6(a_aEndpoint[channel], pBit) * 2 + pBit) - a_aEndpoint[channel];
+						errors[pBit] += difference * difference;
+					}
+				}
+				return errors[1] < errors[0] ? 1 : 0;
+			}
+
+			//---------------------------------------------------------------------
+			float encodeMode6Endpoints(const BlockPixels& a_Block, const float a_aEndpoint0[4], const float a_aEndpoint1[4], bool a_bSearchPBits, uint8_t* a_pBlock, uint8_t a_aIndices[16])
+			{
+				const float* endpoints[2] = { a_aEndpoint0, a_aEndpoint1 };
+
+				uint32_t bestValues[2][4] = {};
+				uint32_t bestPBits[2] = {};
+				float bestError = FLT_MAX;
+				for (uint32_t combination = 0; combination < (a_bSearchPBits ? 4u : 1u); combination++)
+				{
+					uint32_t pBits[2] = { combination & 1, combination >> 1 };
+					if (!a_bSearchPBits)
+					{
+						pBits[0] = getBestPBit(a_aEndpoint0);
+						pBits[1] = getBestPBit(a_aEndpoint1);
+					}
+
+					uint32_t values[2][4];
+					for (uint32_t endpoint = 0; endpoint < 2; endpoint++)
+					{
+						for (uint32_t channel = 0; channel < 4; channel++)
+						{
+							values[endpoint][channel] = quantizeMode6(endpoints[endpoint][channel], pBits[endpoint]);
+						}
+					}
+
+					float palette[16][4];
+					for (uint32_t entry = 0; entry < 16; entry++)
+					{
+						for (uint32_t channel = 0; channel < 4; channel++)
+						{
+							const uint32_t value0 = values[0][channel] * 2 + pBits[0];
+							const uint32_t value1 = values[1][channel] * 2 + pBits[1];
+							palette[entry][channel] = static_cast<float>(((64 - g_aBC7Weights[entry]) * value0 + g_aBC7Weights[entry] * value1 + 32) >> 6);
+						}
+					}
+
+					uint8_t indices[16];
+					const float error = selectIndices(a_Block, g_aColorAlphaWeights, palette, 16, indices);
+					if (error < bestError)
+					{
+						bestError = error;
+						memcpy(bestValues, values, sizeof(values));
+						memcpy(bestPBits, pBits, sizeof(pBits));
+						memcpy(a_aIndices, indices, sizeof(indices));
+					}
+				}
+
+				// The highest bit of the first index is not stored, swapping the endpoints flips the indices so it is zero.
+				uint32_t order[2] = { 0, 1 };
+				uint32_t flip = 0;
+				if (a_aIndices[0] >= 8)
+				{
+					std::swap(order[0], order[1]);
+					flip = 15;
+				}
+
+				memset(a_pBlock, 0, 16);
+				uint32_t offset = 0;
+				writeBits(a_pBlock, offset, 1 << 6, 7);
+				for (uint32_t channel = 0; channel < 4; channel++)
+				{
+					writeBits(a_pBlock, offset, bestValues[order[0]][channel], 7);
+					writeBits(a_pBlock, offset, bestValues[order[1]][channel], 7);
+				}
+				writeBits(a_pBlock, offset, bestPBits[order[0]], 1);
+				writeBits(a_pBlock, offset, bestPBits[order[1]], 1);
+				for (uint32_t i = 0; i < 16; i++)
+				{
+					writeBits(a_pBlock, offset, a_aIndices[i] ^ flip, i == 0 ? 3 : 4);
+				}
+
+				// Refits work on the stored order of the endpoints.
+				for (uint32_t i = 0; i < 16; i++)
+				{
+					a_aIndices[i] = static_cast<uint8_t>(a_aIndices[i] ^ flip);
+				}
+				return bestError;
+			}
+
+			//---------------------------------------------------------------------
+			float encodeBC7ComponentEndpoints(const BlockPixels& a_Block, const float a_aWeights[4], const float a_aEndpoint0[4], const float a_aEndpoint1[4], uint32_t a_iEndpointBits, uint32_t a_iIndexBits, BC7Component& a_Component)
+			{
+				const uint32_t* weights = a_iIndexBits == 2 ? g_aBC7Weights2 : g_aBC7Weights3;
+				const float* endpoints[2] = { a_aEndpoint0, a_aEndpoint1 };
+
+				// Endpoints are expanded to 8 bits by repeating their highest bits, like the decoder does.
+				float palette[8][4] = {};
+				for (uint32_t channel = 0; channel < 4; channel++)
+				{
+					if (a_aWeights[channel] == 0.0f)
+					{
+						continue;
+					}
+
+					uint32_t expanded[2];
+					for (uint32_t endpoint = 0; endpoint < 2; endpoint++)
+					{
+						const uint32_t value = quantize(endpoints[endpoint][channel], (1u << a_iEndpointBits) - 1);
+						a_Component.m_aValues[endpoint][channel] = value;
+						expanded[endpoint] = (value << (8 - a_iEndpointBits)) | (value >> (2 * a_iEndpointBits - 8));
+					}
+					for (uint32_t entry = 0; entry < (1u << a_iIndexBits); entry++)
+					{
+						palette[entry][channel] = static_cast<float>(((64 - weights[entry]) * expanded[0] + weights[entry] * expanded[1] + 32) >> 6);
+					}
+				}
+
+				a_Component.m_fError = selectIndices(a_Block, a_aWeights, palette, 1u << a_iIndexBits, a_Component.m_aIndices);
+				return a_Component.m_fError;
+			}
+
+			//---------------------------------------------------------------------
+			void encodeBC7Component(const BlockPixels& a_Block, const float a_aWeights[4], uint32_t a_iEndpointBits, uint32_t a_iIndexBits, uint32_t a_iIterations, BC7Component& a_Component)
+			{
+				const uint32_t* weights = a_iIndexBits == 2 ? g_aBC7Weights2 : g_aBC7Weights3;
+				float indexWeights[8];
+				for (uint32_t entry = 0; entry < (1u << a_iIndexBits); entry++)
+				{
+					indexWeights[entry] = static_cast<float>(weights[entry]) / 64.0f;
+				}
+
+				float endpoint0[4];
+				float endpoint1[4];
+				getAxisEndpoints(a_Block, a_aWeights, endpoint0, endpoint1);
+				encodeBC7ComponentEndpoints(a_Block, a_aWeights, endpoint0, endpoint1, a_iEndpointBits, a_iIndexBits, a_Component);
+
+				for (uint32_t iteration = 0; iteration < a_iIterations && a_Component.m_fError > 0.0f; iteration++)
+				{
+					if (!fitEndpoints(a_Block, a_Component.m_aIndices, indexWeights, endpoint0, endpoint1))
+					{
+						break;
+					}
+
+					BC7Component candidate;
+					if (encodeBC7ComponentEndpoints(a_Block, a_aWeights, endpoint0, endpoint1, a_iEndpointBits, a_iIndexBits, candidate) >= a_Component.m_fError)
+					{
+						break;
+					}
+					a_Component = candidate;
+				}
+			}
+
+			//---------------------------------------------------------------------
+			void writeIndices(uint8_t* a_pBlock, uint32_t& a_iOffset, const BC7Component& a_Component, uint32_t a_iIndexBits)
+			{
+				// Same as for mode 6, the highest bit of the first index is not stored.
+				const uint32_t flip = a_Component.m_aIndices[0] >> (a_iIndexBits - 1) ? (1u << a_iIndexBits) - 1 : 0;
+				for (uint32_t i = 0; i < 16; i++)
+				{
+					writeBits(a_pBlock, a_iOffset, a_Component.m_aIndices[i] ^ flip, i == 0 ? a_iIndexBits - 1 : a_iIndexBits);
+				}
+			}
+
+			//---------------------------------------------------------------------
+			void writeMode45Block(uint32_t a_iMode, uint32_t a_iRotation, uint32_t a_iIndexSelection, const BC7Component& a_Color, const BC7Component& a_Alpha, uint8_t* a_pBlock)
+			{
+				const uint32_t colorBits = a_iMode == 4 ? 5 : 7;
+				const uint32_t alphaBits = a_iMode == 4 ? 6 : 8;
+				const bool swapped = a_iMode == 4 && a_iIndexSelection == 1;
+
+				memset(a_pBlock, 0, 16);
+				uint32_t offset = 0;
+				writeBits(a_pBlock, offset, 1u << a_iMode, a_iMode + 1);
+				writeBits(a_pBlock, offset, a_iRotation, 2);
+				if (a_iMode == 4)
+				{
+					writeBits(a_pBlock, offset, a_iIndexSelection, 1);
+				}
+
+				// A part whose first index has its highest bit set is stored with its endpoints swapped.
+				const uint32_t colorIndexBits = swapped ? 3 : 2;
+				const uint32_t alphaIndexBits = a_iMode == 4 && !swapped ? 3 : 2;
+				const uint32_t colorOrder = a_Color.m_aIndices[0] >> (colorIndexBits - 1);
+				const uint32_t alphaOrder = a_Alpha.m_aIndices[0] >> (alphaIndexBits - 1);
+				for (uint32_t channel = 0; channel < 3; channel++)
+				{
+					writeBits(a_pBlock, offset, a_Color.m_aValues[colorOrder][channel], colorBits);
+					writeBits(a_pBlock, offset, a_Color.m_aValues[colorOrder ^ 1][channel], colorBits);
+				}
+				writeBits(a_pBlock, offset, a_Alpha.m_aValues[alphaOrder][3], alphaBits);
+				writeBits(a_pBlock, offset, a_Alpha.m_aValues[alphaOrder ^ 1][3], alphaBits);
+
+				// The two bit indices come first, in mode 4 the index selection decides whether those are the color ones.
+				writeIndices(a_pBlock, offset, swapped ? a_Alpha : a_Color, 2);
+				writeIndices(a_pBlock, offset, swapped ? a_Color : a_Alpha, a_iMode == 4 ? 3 : 2);
+			}
+
+			//---------------------------------------------------------------------
+			float getBlockError(const uint32_t a_aPixels[16], const uint8_t* a_pBlock)
+			{
+				uint32_t decoded[16];
+				graphics::DecodeBC7Block(a_pBlock, decoded);
+
+				float error = 0.0f;
+				for (uint32_t i = 0; i < 16; i++)
+				{
+					for (uint32_t channel = 0; channel < 4; channel++)
+					{
+						const float difference = static_cast<float>((a_aPixels[i] >> (channel * 8)) & 0xFF) - static_cast<float>((decoded[i] >> (channel * 8)) & 0xFF);
+						error += difference * difference;
+					}
+				}
+				return error;
+			}
+		}
+
+		//---------------------------------------------------------------------
+		void EncodeBC1Block(const uint32_t a_aPixels[16], uint8_t* a_pBlock, CompressionQuality a_Quality)
+		{
+			encodeColorBlock(a_aPixels, a_pBlock, a_Quality, true);
+		}
+
+		//---------------------------------------------------------------------
+		void EncodeBC3Block(const uint32_t a_aPixels[16], uint8_t* a_pBlock, CompressionQuality a_Quality)
+		{
+			encodeSingleChannelBlock(loadBlock(a_aPixels), 3, a_pBlock, a_Quality);
+			encodeColorBlock(a_aPixels, a_pBlock + 8, a_Quality, false);
+		}
+
+		//---------------------------------------------------------------------
+		void EncodeBC4Block(const uint32_t a_aPixels[16], uint8_t* a_pBlock, CompressionQuality a_Quality)
+		{
+			encodeSingleChannelBlock(loadBlock(a_aPixels), 0, a_pBlock, a_Quality);
+		}
+
+		//---------------------------------------------------------------------
+		void EncodeBC5Block(const uint32_t a_aPixels[16], uint8_t* a_pBlock, CompressionQuality a_Quality)
+		{
+			const BlockPixels block = loadBlock(a_aPixels);
+			encodeSingleChannelBlock(block, 0, a_pBlock, a_Quality);
+			encodeSingleChannelBlock(block, 1, a_pBlock + 8, a_Quality);
+		}
+
+		//---------------------------------------------------------------------
+		void EncodeBC7Block(const uint32_t a_aPixels[16], uint8_t* a_pBlock, CompressionQuality a_Quality)
+		{
+			// How far each index lies towards the second endpoint.
+			static const float indexWeights[16] = {
+				0.0f / 64.0f, 4.0f / 64.0f, 9.0f / 64.0f, 13.0f / 64.0f, 17.0f / 64.0f, 21.0f / 64.0f, 26.0f / 64.0f, 30.0f / 64.0f,
+				34.0f / 64.0f, 38.0f / 64.0f, 43.0f / 64.0f, 47.0f / 64.0f, 51.0f / 64.0f, 55.0f / 64.0f, 60.0f / 64.0f, 64.0f / 64.0f
+			};
+
+			const BlockPixels block = loadBlock(a_aPixels);
+			const bool searchPBits = a_Quality == CompressionQuality::High;
+
+			float endpoint0[4];
+			float endpoint1[4];
+			getAxisEndpoints(block, g_aColorAlphaWeights, endpoint0, endpoint1);
+
+			uint8_t indices[16];
+			float error = encodeMode6Endpoints(block, endpoint0, endpoint1, searchPBits, a_pBlock, indices);
+
+			const uint32_t iterations = getIterations(a_Quality);
+			for (uint32_t iteration = 0; iteration < iterations && error > 0.0f; iteration++)
+			{
+				// The stored endpoints may have been swapped, the fit follows the stored order.
+				if (!fitEndpoints(block, indices, indexWeights, endpoint0, endpoint1))
+				{
+					break;
+				}
+
+				uint8_t candidate[16];
+				uint8_t candidateIndices[16];
+				const float candidateError = encodeMode6Endpoints(block, endpoint0, endpoint1, searchPBits, candidate, candidateIndices);
+				if (candidateError >= error)
+				{
+					break;
+				}
+
+				error = candidateError;
+				memcpy(a_pBlock, candidate, sizeof(candidate));
+				memcpy(indices, candidateIndices, sizeof(indices));
+			}
+
+			if (a_Quality != CompressionQuality::High)
+			{
+				return;
+			}
+
+			// Modes 4 and 5 give alpha indices of its own, which pays off when alpha does not follow the color. A rotation
+			// swaps alpha with a color channel, so that channel gets the own indices instead. Mode 4 has 3 bit indices for
+			// one of the two parts, the index selection picks which.
+			struct Configuration
+			{
+				uint32_t m_iMode;
+				uint32_t m_iIndexSelection;
+			};
+			static const Configuration configurations[3] = { { 5, 0 }, { 4, 0 }, { 4, 1 } };
+
+			float bestError = getBlockError(a_aPixels, a_pBlock);
+			for (uint32_t rotation = 0; rotation < 4 && bestError > 0.0f; rotation++)
+			{
+				BlockPixels rotated = block;
+				if (rotation > 0)
+				{
+					std::swap(rotated.m_aChannels[rotation - 1], rotated.m_aChannels[3]);
+				}
+
+				for (const Configuration& configuration : configurations)
+				{
+					const bool swapped = configuration.m_iIndexSelection == 1;
+					BC7Component color;
+					BC7Component alpha;
+					encodeBC7Component(rotated, g_aColorWeights, configuration.m_iMode == 4 ? 5 : 7, swapped ? 3 : 2, iterations, color);
+					encodeBC7Component(rotated, g_aAlphaWeights, configuration.m_iMode == 4 ? 6 : 8, configuration.m_iMode == 4 && !swapped ? 3 : 2, iterations, alpha);
+
+					uint8_t candidate[16];
+					writeMode45Block(configuration.m_iMode, rotation, configuration.m_iIndexSelection, color, alpha, candidate);
+					const float candidateError = getBlockError(a_aPixels, candidate);
+					if (candidateError < bestError)
+					{
+						bestError = candidateError;
+						memcpy(a_pBlock, candidate, sizeof(candidate));
+					}
+				}
+			}
+		}
+
+		//---------------------------------------------------------------------
+		void EncodeBlock(graphics::TextureFormat a_Format, const uint32_t a_aPixels[16], uint8_t* a_pBlock, CompressionQuality a_Quality)
+		{
+			switch (a_Format)
+			{
+				case graphics::TextureFormat::BC1:
+				{
+					EncodeBC1Block(a_aPixels, a_pBlock, a_Quality);
+					break;
+				}
+				case graphics::TextureFormat::BC3:
+				{
+					EncodeBC3Block(a_aPixels, a_pBlock, a_Quality);
+					break;
+				}
+				case graphics::TextureFormat::BC4:
+				{
+					EncodeBC4Block(a_aPixels, a_pBlock, a_Quality);
+					break;
+				}
+				case graphics::TextureFormat::BC5:
+				{
+					EncodeBC5Block(a_aPixels, a_pBlock, a_Quality);
+					break;
+				}
+				case graphics::TextureFormat::BC7:
+				{
+					EncodeBC7Block(a_aPixels, a_pBlock, a_Quality);
+					break;
+				}
+				default:
+				{
+					break;
+				}
+			}
+		}
+
+		//---------------------------------------------------------------------
+		const char* GetBlockCompressionInstructionSet()
+		{
+#ifdef GALLUS_COOKING_SSE2
+			return "SSE2";
+#else
+			return "Scalar";
+#endif // GALLUS_COOKING_SSE2
+		}
+	}
+}
\ No newline at end of file
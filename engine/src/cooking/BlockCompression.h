@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+
+#include "graphics/TextureData.h"
+
+namespace gallus
+{
+	namespace cooking
+	{
+		/// <summary>
+		/// How much time the encoders spend searching for endpoints.
+		/// </summary>
+		enum class CompressionQuality
+		{
+			Fast, /// Endpoints from the extents of the block, without refinement.
+			Normal, /// Endpoints along the principal axis of the block, refined once with a least squares fit.
+			High, /// Like Normal with more refinements, and BC7 also tries its shared endpoint bits and modes 4 and 5.
+		};
+
+		/// <summary>
+		/// Encodes 4x4 pixels as a BC1 block, alpha is ignored.
+		/// </summary>
+		/// <param name="a_aPixels">The 16 pixels, row by row, RGBA8 with red in the lowest byte.</param>
+		/// <param name="a_pBlock">Receives the 8 byte block.</param>
+		/// <param name="a_Quality">How long to search for endpoints.</param>
+		void EncodeBC1Block(const uint32_t a_aPixels[16], uint8_t* a_pBlock, CompressionQuality a_Quality);
+
+		/// <summary>
+		/// Encodes 4x4 pixels as a BC3 block, a BC1 color block behind an interpolated alpha block.
+		/// </summary>
+		/// <param name="a_aPixels">The 16 pixels, row by row, RGBA8 with red in the lowest byte.</param>
+		/// <param name="a_pBlock">Receives the 16 byte block.</param>
+		/// <param name="a_Quality">How long to search for endpoints.</param>
+		void EncodeBC3Block(const uint32_t a_aPixels[16], uint8_t* a_pBlock, CompressionQuality a_Quality);
+
+		/// <summary>
+		/// Encodes the red channel of 4x4 pixels as a BC4 block.
+		/// </summary>
+		/// <param name="a_aPixels">The 16 pixels, row by row, RGBA8 with red in the lowest byte.</param>
+		/// <param name="a_pBlock">Receives the 8 byte block.</param>
+		/// <param name="a_Quality">How long to search for endpoints.</param>
+		void EncodeBC4Block(const uint32_t a_aPixels[16], uint8_t* a_pBlock, CompressionQuality a_Quality);
+
+		/// <summary>
+		/// Encodes the red and green channels of 4x4 pixels as a BC5 block, two BC4 blocks.
+		/// </summary>
+		/// <param name="a_aPixels">The 16 pixels, row by row, RGBA8 with red in the lowest byte.</param>
+		/// <param name="a_pBlock">Receives the 16 byte block.</param>
+		/// <param name="a_Quality">How long to search for endpoints.</param>
+		void EncodeBC5Block(const uint32_t a_aPixels[16], uint8_t* a_pBlock, CompressionQuality a_Quality);
+
+		/// <summary>
+		/// Encodes 4x4 pixels as a BC7 block. Blocks use mode 6, a single pair of RGBA endpoints with 16 steps between them,
+		/// which suits the smooth colors of sprites. High also tries modes 4 and 5, which index alpha or one rotated color
+		/// channel separately, and keeps the mode with the lowest error. The partitioned modes are not searched.
+		/// </summary>
+		/// <param name="a_aPixels">The 16 pixels, row by row, RGBA8 with red in the lowest byte.</param>
+		/// <param name="a_pBlock">Receives the 16 byte block.</param>
+		/// <param name="a_Quality">How long to search for endpoints.</param>
+		void EncodeBC7Block(const uint32_t a_aPixels[16], uint8_t* a_pBlock, CompressionQuality a_Quality);
+
+		/// <summary>
+		/// Encodes 4x4 pixels as a block of any block compressed format.
+		/// </summary>
+		/// <param name="a_Format">The format, has to be block compressed.</param>
+		/// <param name="a_aPixels">The 16 pixels, row by row, RGBA8 with red in the lowest byte.</param>
+		/// <param name="a_pBlock">Receives the block, GetTextureBlockSize bytes.</param>
+		/// <param name="a_Quality">How long to search for endpoints.</param>
+		void EncodeBlock(graphics::TextureFormat a_Format, const uint32_t a_aPixels[16], uint8_t* a_pBlock, CompressionQuality a_Quality);
+
+		/// <summary>
+		/// Retrieves the instruction set the endpoint and index search runs with.
+		/// </summary>
+		/// <returns>Name of the instruction set.</returns>
+		const char* GetBlockCompressionInstructionSet();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,301 @@
+#include "cooking/MipGenerator.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+#include <glm/vec4.hpp>
+
+#include "core/JobSystem.h"
+
+namespace gallus
+{
+	namespace cooking
+	{
+		inline const float g_fKaiserBeta = 4.0f;
+		inline const float g_fKaiserRadius = 2.0f; /// Radius of the filter in pixels of the smaller mip.
+
+		//---------------------------------------------------------------------
+		const std::array<float, 256>& getLinearTable()
+		{
+			static const std::array<float, 256> table = []()
+				{
+					std::array<float, 256> values;
+					for (uint32_t i = 0; i < 256; i++)
+					{
+						const float value = static_cast<float>(i) / 255.0f;
+						values[i] = value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+					}
+					return values;
+				}();
+			return table;
+		}
+
+		//---------------------------------------------------------------------
+		float toSRGB(float a_fValue)
+		{
+			return a_fValue <= 0.0031308f ? a_fValue * 12.92f : 1.055f * std::pow(a_fValue, 1.0f / 2.4f) - 0.055f;
+		}
+
+		//---------------------------------------------------------------------
+		uint32_t toByte(float a_fValue)
+		{
+			return static_cast<uint32_t>(std::lrint(std::clamp(a_fValue, 0.0f, 1.0f) * 255.0f));
+		}
+
+		//---------------------------------------------------------------------
+		float besselI0(float a_fValue)
+		{
+			// The series converges quickly for the small arguments of the window.
+			float sum = 1.0f;
+			float term = 1.0f;
+			const float quarterSquare = a_fValue * a_fValue / 4.0f;
+			for (uint32_t k = 1; k < 20; k++)
+			{
+				term *= quarterSquare / static_cast<float>(k * k);
+				sum += term;
+			}
+			return sum;
+		}
+
+		//---------------------------------------------------------------------
+		float kaiser(float a_fDistance)
+		{
+			const float x = a_fDistance / g_fKaiserRadius;
+			if (std::abs(x) >= 1.0f)
+			{
+				return 0.0f;
+			}
+
+			const float sinc = a_fDistance == 0.0f ? 1.0f : std::sin(3.14159265f * a_fDistance) / (3.14159265f * a_fDistance);
+			return sinc * besselI0(g_fKaiserBeta * std::sqrt(1.0f - x * x)) / besselI0(g_fKaiserBeta);
+		}
+
+		/// <summary>
+		/// Weights one pixel of the smaller mip gets from a row or column of the larger mip.
+		/// </summary>
+		struct FilterTaps
+		{
+			uint32_t m_iFirst = 0;
+			std::vector<float> m_aWeights;
+		};
+
+		//---------------------------------------------------------------------
+		std::vector<FilterTaps> getKaiserTaps(uint32_t a_iSourceSize, uint32_t a_iSize)
+		{
+			std::vector<FilterTaps> taps(a_iSize);
+			if (a_iSourceSize == a_iSize)
+			{
+				for (uint32_t i = 0; i < a_iSize; i++)
+				{
+					taps[i].m_iFirst = i;
+					taps[i].m_aWeights = { 1.0f };
+				}
+				return taps;
+			}
+
+			// Distances are measured in pixels of the smaller mip, so the cut off lies at its Nyquist frequency.
+			const float scale = static_cast<float>(a_iSourceSize) / static_cast<float>(a_iSize);
+			for (uint32_t i = 0; i < a_iSize; i++)
+			{
+				const float center = (static_cast<float>(i) + 0.5f) * scale;
+				const int32_t first = static_cast<int32_t>(std::floor(center - g_fKaiserRadius * scale));
+				const int32_t last = static_cast<int32_t>(std::ceil(center + g_fKaiserRadius * scale));
+
+				// Taps outside of the mip repeat the edge, so they are folded into the edge pixels.
+				const int32_t clampedFirst = std::max(first, 0);
+				const int32_t clampedLast = std::min(last, static_cast<int32_t>(a_iSourceSize) - 1);
+				taps[i].m_iFirst = static_cast<uint32_t>(clampedFirst);
+				taps[i].m_aWeights.assign(static_cast<size_t>(clampedLast - clampedFirst + 1), 0.0f);
+
+				float sum = 0.0f;
+				for (int32_t source = first; source <= last; source++)
+				{
+					const float weight = kaiser((static_cast<float>(source) + 0.5f - center) / scale);
+					taps[i].m_aWeights[std::clamp(source, clampedFirst, clampedLast) - clampedFirst] += weight;
+					sum += weight;
+				}
+				for (float& weight : taps[i].m_aWeights)
+				{
+					weight /= sum;
+				}
+			}
+			return taps;
+		}
+
+		//---------------------------------------------------------------------
+		void boxFilter(const std::vector<glm::vec4>& a_aSource, uint32_t a_iWidth, uint32_t a_iHeight, std::vector<glm::vec4>& a_aDestination, uint32_t a_iDestinationWidth, uint32_t a_iDestinationHeight, core::JobSystem& a_JobSystem)
+		{
+			a_aDestination.resize(static_cast<size_t>(a_iDestinationWidth) * a_iDestinationHeight);
+			a_JobSystem.ParallelFor(a_iDestinationHeight, 1, [&](size_t, size_t a_iBegin, size_t a_iEnd)
+				{
+					// Odd sizes repeat their last row or column instead of reading past it.
+					for (uint32_t y = static_cast<uint32_t>(a_iBegin); y < a_iEnd; y++)
+					{
+						const size_t row0 = static_cast<size_t>(std::min(y * 2, a_iHeight - 1)) * a_iWidth;
+						const size_t row1 = static_cast<size_t>(std::min(y * 2 + 1, a_iHeight - 1)) * a_iWidth;
+						for (uint32_t x = 0; x < a_iDestinationWidth; x++)
+						{
+							const uint32_t x0 = std::min(x * 2, a_iWidth - 1);
+							const uint32_t x1 = std::min(x * 2 + 1, a_iWidth - 1);
+							a_aDestination[static_cast<size_t>(y) * a_iDestinationWidth + x] =
+								(a_aSource[row0 + x0] + a_aSource[row0 + x1] + a_aSource[row1 + x0] + a_aSource[row1 + x1]) * 0.25f;
+						}
+					}
+				});
+		}
+
+		//---------------------------------------------------------------------
+		void kaiserFilter(const std::vector<glm::vec4>& a_aSource, uint32_t a_iWidth, uint32_t a_iHeight, std::vector<glm::vec4>& a_aDestination, uint32_t a_iDestinationWidth, uint32_t a_iDestinationHeight, core::JobSystem& a_JobSystem)
+		{
+			const std::vector<FilterTaps> columns = getKaiserTaps(a_iWidth, a_iDestinationWidth);
+			const std::vector<FilterTaps> rows = getKaiserTaps(a_iHeight, a_iDestinationHeight);
+
+			// The filter is separable, rows are shrunk first and the columns of the result after.
+			std::vector<glm::vec4> narrow(static_cast<size_t>(a_iDestinationWidth) * a_iHeight);
+			a_JobSystem.ParallelFor(a_iHeight, 1, [&](size_t, size_t a_iBegin, size_t a_iEnd)
+				{
+					for (size_t y = a_iBegin; y < a_iEnd; y++)
+					{
+						const glm::vec4* source = a_aSource.data() + y * a_iWidth;
+						for (uint32_t x = 0; x < a_iDestinationWidth; x++)
+						{
+							glm::vec4 sum(0.0f);
+							for (size_t tap = 0; tap < columns[x].m_aWeights.size(); tap++)
+							{
+								sum += source[columns[x].m_iFirst + tap] * columns[x].m_aWeights[tap];
+							}
+							narrow[y * a_iDestinationWidth + x] = sum;
+						}
+					}
+				});
+
+			a_aDestination.resize(static_cast<size_t>(a_iDestinationWidth) * a_iDestinationHeight);
+			a_JobSystem.ParallelFor(a_iDestinationHeight, 1, [&](size_t, size_t a_iBegin, size_t a_iEnd)
+				{
+					for (size_t y = a_iBegin; y < a_iEnd; y++)
+					{
+						for (uint32_t x = 0; x < a_iDestinationWidth; x++)
+						{
+							glm::vec4 sum(0.0f);
+							for (size_t tap = 0; tap < rows[y].m_aWeights.size(); tap++)
+							{
+								sum += narrow[(rows[y].m_iFirst + tap) * a_iDestinationWidth + x] * rows[y].m_aWeights[tap];
+							}
+
+							// The negative lobes can overshoot, premultiplied color can never exceed its alpha.
+							sum.a = std::clamp(sum.a, 0.0f, 1.0f);
+							sum.r = std::clamp(sum.r, 0.0f, sum.a);
+							sum.g = std::clamp(sum.g, 0.0f, sum.a);
+							sum.b = std::clamp(sum.b, 0.0f, sum.a);
+							a_aDestination[y * a_iDestinationWidth + x] = sum;
+						}
+					}
+				});
+		}
+
+		//---------------------------------------------------------------------
+		uint32_t GetMipCount(uint32_t a_iWidth, uint32_t a_iHeight)
+		{
+			uint32_t count = 1;
+			for (uint32_t side = std::max(a_iWidth, a_iHeight); side > 1; side /= 2)
+			{
+				count++;
+			}
+			return count;
+		}
+
+		//---------------------------------------------------------------------
+		void GenerateMips(const std::vector<uint32_t>& a_aPixels, uint32_t a_iWidth, uint32_t a_iHeight, uint32_t a_iMipCount, const MipSettings& a_Settings, core::JobSystem& a_JobSystem, std::vector<MipImage>& a_aMips)
+		{
+			a_aMips.resize(std::clamp(a_iMipCount, 1u, GetMipCount(a_iWidth, a_iHeight)));
+
+			// The first mip stays as close to the source as possible, it is only premultiplied in the space it is stored in.
+			MipImage& first = a_aMips[0];
+			first.m_iWidth = a_iWidth;
+			first.m_iHeight = a_iHeight;
+			first.m_aPixels = a_aPixels;
+			if (a_Settings.m_bPremultiplyAlpha)
+			{
+				for (uint32_t& pixel : first.m_aPixels)
+				{
+					const uint32_t alpha = pixel >> 24;
+					uint32_t premultiplied = pixel & 0xFF000000;
+					for (uint32_t shift = 0; shift < 24; shift += 8)
+					{
+						premultiplied |= ((((pixel >> shift) & 0xFF) * alpha + 127) / 255) << shift;
+					}
+					pixel = premultiplied;
+				}
+			}
+
+			if (a_aMips.size() == 1)
+			{
+				return;
+			}
+
+			// The smaller mips are filtered from linear color with premultiplied alpha.
+			const std::array<float, 256>& linear = getLinearTable();
+			std::vector<glm::vec4> level(a_aPixels.size());
+			a_JobSystem.ParallelFor(a_aPixels.size(), 4096, [&](size_t, size_t a_iBegin, size_t a_iEnd)
+				{
+					for (size_t i = a_iBegin; i < a_iEnd; i++)
+					{
+						const uint32_t pixel = a_aPixels[i];
+						const float alpha = static_cast<float>(pixel >> 24) / 255.0f;
+						glm::vec4 value;
+						for (uint32_t channel = 0; channel < 3; channel++)
+						{
+							const uint32_t encoded = (pixel >> (channel * 8)) & 0xFF;
+							value[channel] = (a_Settings.m_bSRGB ? linear[encoded] : static_cast<float>(encoded) / 255.0f) * alpha;
+						}
+						value.a = alpha;
+						level[i] = value;
+					}
+				});
+
+			uint32_t width = a_iWidth;
+			uint32_t height = a_iHeight;
+			std::vector<glm::vec4> next;
+			for (size_t mip = 1; mip < a_aMips.size(); mip++)
+			{
+				const uint32_t nextWidth = std::max(width / 2, 1u);
+				const uint32_t nextHeight = std::max(height / 2, 1u);
+				if (a_Settings.m_Filter == MipFilter::Kaiser)
+				{
+					kaiserFilter(level, width, height, next, nextWidth, nextHeight, a_JobSystem);
+				}
+				else
+				{
+					boxFilter(level, width, height, next, nextWidth, nextHeight, a_JobSystem);
+				}
+				level.swap(next);
+				width = nextWidth;
+				height = nextHeight;
+
+				// Back to straight alpha and the encoding of the source, premultiplied again in that encoding if asked for.
+				MipImage& image = a_aMips[mip];
+				image.m_iWidth = width;
+				image.m_iHeight = height;
+				image.m_aPixels.resize(level.size());
+				a_JobSystem.ParallelFor(level.size(), 4096, [&](size_t, size_t a_iBegin, size_t a_iEnd)
+					{
+						for (size_t i = a_iBegin; i < a_iEnd; i++)
+						{
+							const glm::vec4& value = level[i];
+							const uint32_t alpha = toByte(value.a);
+							uint32_t pixel = alpha << 24;
+							for (uint32_t channel = 0; channel < 3; channel++)
+							{
+								float color = value.a > 0.0f ? std::min(value[channel] / value.a, 1.0f) : 0.0f;
+								color = a_Settings.m_bSRGB ? toSRGB(color) : color;
+								const uint32_t encoded = toByte(color);
+								pixel |= (a_Settings.m_bPremultiplyAlpha ? (encoded * alpha + 127) / 255 : encoded) << (channel * 8);
+							}
+							image.m_aPixels[i] = pixel;
+						}
+					});
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace gallus
+{
+	namespace core
+	{
+		class JobSystem;
+	}
+
+	namespace cooking
+	{
+		/// <summary>
+		/// Filter that shrinks a mip into the next one.
+		/// </summary>
+		enum class MipFilter
+		{
+			Box, /// Averages 2x2 pixels. Fast, but slightly blurry and prone to aliasing.
+			Kaiser, /// Kaiser windowed sinc over 8x8 pixels. Keeps mips sharper, which suits detailed textures.
+		};
+
+		/// <summary>
+		/// How a mip chain gets made.
+		/// </summary>
+		struct MipSettings
+		{
+			MipFilter m_Filter = MipFilter::Box;
+			bool m_bSRGB = true; /// Whether color is sRGB encoded. It is then filtered in linear space, which keeps mips from darkening.
+			bool m_bPremultiplyAlpha = true; /// Whether the mips store color multiplied with alpha.
+		};
+
+		/// <summary>
+		/// A single mip.
+		/// </summary>
+		struct MipImage
+		{
+			uint32_t m_iWidth = 0;
+			uint32_t m_iHeight = 0;
+			std::vector<uint32_t> m_aPixels; /// RGBA8, row by row, with red in the lowest byte.
+		};
+
+		/// <summary>
+		/// Retrieves the number of mips of a full chain, down to 1x1.
+		/// </summary>
+		/// <param name="a_iWidth">Width of the largest mip.</param>
+		/// <param name="a_iHeight">Height of the largest mip.</param>
+		/// <returns>The number of mips.</returns>
+		uint32_t GetMipCount(uint32_t a_iWidth, uint32_t a_iHeight);
+
+		/// <summary>
+		/// Makes a mip chain. Every mip is filtered from the one above it with premultiplied alpha, so transparent pixels do not
+		/// bleed their color into the mips. The first mip is the image itself, only premultiplied if the settings ask for it.
+		/// The rows of every mip are filtered in parallel.
+		/// </summary>
+		/// <param name="a_aPixels">The image, RGBA8 with straight alpha.</param>
+		/// <param name="a_iWidth">Width of the image.</param>
+		/// <param name="a_iHeight">Height of the image.</param>
+		/// <param name="a_iMipCount">The number of mips to make, at most GetMipCount.</param>
+		/// <param name="a_Settings">How to make the mips.</param>
+		/// <param name="a_JobSystem">The job system that filters the rows.</param>
+		/// <param name="a_aMips">Receives the mips, largest first.</param>
+		void GenerateMips(const std::vector<uint32_t>& a_aPixels, uint32_t a_iWidth, uint32_t a_iHeight, uint32_t a_iMipCount, const MipSettings& a_Settings, core::JobSystem& a_JobSystem, std::vector<MipImage>& a_aMips);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,296 @@
+#include "cooking/TextureCooker.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include "core/JobSystem.h"
+#include "logger/Logger.h"
+
+namespace gallus
+{
+	namespace cooking
+	{
+		/// <summary>
+		/// A row of 4x4 blocks of a mip, the unit the encoding is split into.
+		/// </summary>
+		struct BlockRow
+		{
+			uint32_t m_iMip = 0;
+			uint32_t m_iRow = 0;
+			size_t m_iOffset = 0; /// Where the row starts in the cooked mips.
+		};
+
+		//---------------------------------------------------------------------
+		void encodeBlockRow(const MipImage& a_Mip, uint32_t a_iRow, graphics::TextureFormat a_Format, CompressionQuality a_Quality, uint8_t* a_pDestination)
+		{
+			const size_t blockSize = graphics::GetTextureBlockSize(a_Format);
+			const uint32_t blocksWide = (a_Mip.m_iWidth + 3) / 4;
+
+			uint32_t block[16];
+			for (uint32_t blockX = 0; blockX < blocksWide; blockX++)
+			{
+				// Blocks that hang over the edge repeat the last row or column, so they do not pull in colors that are not there.
+				for (uint32_t y = 0; y < 4; y++)
+				{
+					const uint32_t sourceY = std::min(a_iRow * 4 + y, a_Mip.m_iHeight - 1);
+					for (uint32_t x = 0; x < 4; x++)
+					{
+						const uint32_t sourceX = std::min(blockX * 4 + x, a_Mip.m_iWidth - 1);
+						block[y * 4 + x] = a_Mip.m_aPixels[static_cast<size_t>(sourceY) * a_Mip.m_iWidth + sourceX];
+					}
+				}
+				EncodeBlock(a_Format, block, a_pDestination + blockX * blockSize, a_Quality);
+			}
+		}
+
+		//---------------------------------------------------------------------
+		uint32_t getComparedChannels(graphics::TextureFormat a_Format)
+		{
+			// Only the channels a format stores count towards its error.
+			switch (a_Format)
+			{
+				case graphics::TextureFormat::BC1:
+				{
+					return 0x00FFFFFF;
+				}
+				case graphics::TextureFormat::BC4:
+				{
+					return 0x000000FF;
+				}
+				case graphics::TextureFormat::BC5:
+				{
+					return 0x0000FFFF;
+				}
+				default:
+				{
+					return 0xFFFFFFFF;
+				}
+			}
+		}
+
+		//---------------------------------------------------------------------
+		double measurePSNR(const std::vector<MipImage>& a_aMips, const graphics::TextureData& a_Texture)
+		{
+			const uint32_t channels = getComparedChannels(a_Texture.m_Format);
+			double squaredError = 0.0;
+			uint64_t samples = 0;
+
+			std::vector<uint32_t> decoded;
+			for (uint32_t mip = 0; mip < a_aMips.size(); mip++)
+			{
+				if (!graphics::DecodeTextureMip(a_Texture, mip, decoded))
+				{
+					return 0.0;
+				}
+
+				for (size_t i = 0; i < decoded.size(); i++)
+				{
+					for (uint32_t shift = 0; shift < 32; shift += 8)
+					{
+						if ((channels >> shift) & 0xFF)
+						{
+							const double difference = static_cast<double>((a_aMips[mip].m_aPixels[i] >> shift) & 0xFF) - static_cast<double>((decoded[i] >> shift) & 0xFF);
+							squaredError += difference * difference;
+							samples++;
+						}
+					}
+				}
+			}
+
+			if (squaredError == 0.0)
+			{
+				return std::numeric_limits<double>::infinity();
+			}
+			return 10.0 * std::log10(255.0 * 255.0 / (squaredError / static_cast<double>(samples)));
+		}
+
+		//---------------------------------------------------------------------
+		bool CookTexture(const core::Data& a_Source, const TextureCookSettings& a_Settings, core::JobSystem& a_JobSystem, std::vector<uint8_t>& a_aCooked, TextureCookStats* a_pStats)
+		{
+			graphics::TextureData source;
+			if (!graphics::ReadTextureFile(a_Source, source) || source.m_iFlags != graphics::CookedTextureFlags_None || source.m_iMipLevels != 1 || source.m_Format != graphics::TextureFormat::RGBA8)
+			{
+				LOG(LOGSEVERITY_ERROR, LOG_CATEGORY_ENGINE, "Failed decoding source image.");
+				return false;
+			}
+
+			std::vector<uint32_t> pixels(static_cast<size_t>(source.m_iWidth) * source.m_iHeight);
+			memcpy(pixels.data(), source.m_Data.data(), pixels.size() * sizeof(uint32_t));
+
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+			MipSettings mipSettings;
+			mipSettings.m_Filter = a_Settings.m_MipFilter;
+			mipSettings.m_bSRGB = a_Settings.m_bSRGB;
+			mipSettings.m_bPremultiplyAlpha = a_Settings.m_bPremultiplyAlpha;
+
+			std::vector<MipImage> mips;
+			GenerateMips(pixels, source.m_iWidth, source.m_iHeight, a_Settings.m_bGenerateMips ? GetMipCount(source.m_iWidth, source.m_iHeight) : 1, mipSettings, a_JobSystem, mips);
+
+			const double mipTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+			start = std::chrono::steady_clock::now();
+
+			graphics::CookedTextureHeader header;
+			header.m_iWidth = source.m_iWidth;
+			header.m_iHeight = source.m_iHeight;
+			header.m_iMipLevels = static_cast<uint16_t>(mips.size());
+			header.m_Format = a_Settings.m_Format;
+			header.m_iFlags = a_Settings.m_bPremultiplyAlpha ? graphics::CookedTextureFlags_Premultiplied : graphics::CookedTextureFlags_None;
+
+			graphics::TextureData texture;
+			texture.m_iWidth = header.m_iWidth;
+			texture.m_iHeight = header.m_iHeight;
+			texture.m_iMipLevels = header.m_iMipLevels;
+			texture.m_Format = header.m_Format;
+			header.m_iDataSize = graphics::GetTextureMipOffset(texture, texture.m_iMipLevels);
+
+			a_aCooked.resize(sizeof(header) + header.m_iDataSize);
+			memcpy(a_aCooked.data(), &header, sizeof(header));
+			uint8_t* data = a_aCooked.data() + sizeof(header);
+
+			if (!graphics::IsBlockCompressed(a_Settings.m_Format))
+			{
+				for (uint32_t mip = 0; mip < mips.size(); mip++)
+				{
+					memcpy(data + graphics::GetTextureMipOffset(texture, mip), mips[mip].m_aPixels.data(), mips[mip].m_aPixels.size() * sizeof(uint32_t));
+				}
+			}
+			else
+			{
+				// The block rows of every mip form one range, so the small mips do not each wait on their own jobs.
+				std::vector<BlockRow> rows;
+				for (uint32_t mip = 0; mip < mips.size(); mip++)
+				{
+					const size_t mipOffset = graphics::GetTextureMipOffset(texture, mip);
+					const size_t rowPitch = graphics::GetTextureRowPitch(a_Settings.m_Format, mips[mip].m_iWidth);
+					const uint32_t rowCount = graphics::GetTextureRowCount(a_Settings.m_Format, mips[mip].m_iHeight);
+					for (uint32_t row = 0; row < rowCount; row++)
+					{
+						rows.push_back({ mip, row, mipOffset + row * rowPitch });
+					}
+				}
+
+				a_JobSystem.ParallelFor(rows.size(), 1, [&](size_t, size_t a_iBegin, size_t a_iEnd)
+					{
+						for (size_t i = a_iBegin; i < a_iEnd; i++)
+						{
+							encodeBlockRow(mips[rows[i].m_iMip], rows[i].m_iRow, a_Settings.m_Format, a_Settings.m_Quality, data + rows[i].m_iOffset);
+						}
+					});
+			}
+
+			if (a_pStats)
+			{
+				a_pStats->m_fMipTime = mipTime;
+				a_pStats->m_fEncodeTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+				a_pStats->m_iPixelCount = 0;
+				for (const MipImage& mip : mips)
+				{
+					a_pStats->m_iPixelCount += mip.m_aPixels.size();
+				}
+
+				texture.m_Data = core::Data::CreateView(data, header.m_iDataSize);
+				a_pStats->m_fPSNR = measurePSNR(mips, texture);
+			}
+			return true;
+		}
+
+		//---------------------------------------------------------------------
+		const char* GetTextureFormatName(graphics::TextureFormat a_Format)
+		{
+			switch (a_Format)
+			{
+				case graphics::TextureFormat::BC1:
+				{
+					return "bc1";
+				}
+				case graphics::TextureFormat::BC3:
+				{
+					return "bc3";
+				}
+				case graphics::TextureFormat::BC4:
+				{
+					return "bc4";
+				}
+				case graphics::TextureFormat::BC5:
+				{
+					return "bc5";
+				}
+				case graphics::TextureFormat::BC7:
+				{
+					return "bc7";
+				}
+				case graphics::TextureFormat::RGBA8:
+				default:
+				{
+					return "rgba8";
+				}
+			}
+		}
+
+		//---------------------------------------------------------------------
+		bool ParseTextureFormat(const std::string& a_sName, graphics::TextureFormat& a_Format)
+		{
+			const graphics::TextureFormat formats[] = {
+				graphics::TextureFormat::RGBA8,
+				graphics::TextureFormat::BC1,
+				graphics::TextureFormat::BC3,
+				graphics::TextureFormat::BC4,
+				graphics::TextureFormat::BC5,
+				graphics::TextureFormat::BC7,
+			};
+			for (graphics::TextureFormat format : formats)
+			{
+				if (a_sName == GetTextureFormatName(format))
+				{
+					a_Format = format;
+					return true;
+				}
+			}
+			return false;
+		}
+
+		//---------------------------------------------------------------------
+		bool ParseCompressionQuality(const std::string& a_sName, CompressionQuality& a_Quality)
+		{
+			if (a_sName == "fast")
+			{
+				a_Quality = CompressionQuality::Fast;
+			}
+			else if (a_sName == "normal")
+			{
+				a_Quality = CompressionQuality::Normal;
+			}
+			else if (a_sName == "high")
+			{
+				a_Quality = CompressionQuality::High;
+			}
+			else
+			{
+				return false;
+			}
+			return true;
+		}
+
+		//---------------------------------------------------------------------
+		bool ParseMipFilter(const std::string& a_sName, MipFilter& a_Filter)
+		{
+			if (a_sName == "box")
+			{
+				a_Filter = MipFilter::Box;
+			}
+			else if (a_sName == "kaiser")
+			{
+				a_Filter = MipFilter::Kaiser;
+			}
+			else
+			{
+				return false;
+			}
+			return true;
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "core/Data.h"
+#include "graphics/TextureData.h"
+#include "cooking/BlockCompression.h"
+#include "cooking/MipGenerator.h"
+
+namespace gallus
+{
+	namespace core
+	{
+		class JobSystem;
+	}
+
+	namespace cooking
+	{
+		inline const uint32_t g_iTextureCookerVersion = 2; /// Raised whenever the cooked output changes, which invalidates cached textures.
+
+		/// <summary>
+		/// How source images get cooked.
+		/// </summary>
+		struct TextureCookSettings
+		{
+			graphics::TextureFormat m_Format = graphics::TextureFormat::RGBA8;
+			CompressionQuality m_Quality = CompressionQuality::Normal;
+			MipFilter m_MipFilter = MipFilter::Box;
+			bool m_bGenerateMips = true; /// Whether to store the full mip chain down to 1x1.
+			bool m_bPremultiplyAlpha = true; /// Whether to multiply color with alpha.
+			bool m_bSRGB = true; /// Whether color is sRGB encoded, mips are then filtered in linear space. Off for data like masks.
+		};
+
+		/// <summary>
+		/// What cooking a texture cost and how close the result stays to the source.
+		/// </summary>
+		struct TextureCookStats
+		{
+			uint64_t m_iPixelCount = 0; /// Pixels of all mips.
+			double m_fMipTime = 0.0; /// Seconds spent making mips.
+			double m_fEncodeTime = 0.0; /// Seconds spent encoding the mips.
+			double m_fPSNR = 0.0; /// Peak signal to noise ratio of the encoded mips against the uncompressed ones, in decibels. Infinite if lossless.
+		};
+
+		/// <summary>
+		/// Turns a source image into a cooked texture: decoded, optionally premultiplied, with a mip chain and encoded in the
+		/// requested format, behind a CookedTextureHeader. The blocks of all mips are encoded in parallel.
+		/// </summary>
+		/// <param name="a_Source">Contents of the source image, in any format stb_image reads.</param>
+		/// <param name="a_Settings">How to cook the image.</param>
+		/// <param name="a_JobSystem">The job system that makes the mips and encodes the blocks.</param>
+		/// <param name="a_aCooked">Receives the cooked texture file.</param>
+		/// <param name="a_pStats">Optional, receives the timings and the error of the encoding. Measuring the error decodes every mip again.</param>
+		/// <returns>True if the image was cooked, otherwise false.</returns>
+		bool CookTexture(const core::Data& a_Source, const TextureCookSettings& a_Settings, core::JobSystem& a_JobSystem, std::vector<uint8_t>& a_aCooked, TextureCookStats* a_pStats = nullptr);
+
+		/// <summary>
+		/// Retrieves the name of a format, as ParseTextureFormat reads it.
+		/// </summary>
+		/// <param name="a_Format">The format.</param>
+		/// <returns>The name.</returns>
+		const char* GetTextureFormatName(graphics::TextureFormat a_Format);
+
+		/// <summary>
+		/// Reads a format from its name: "rgba8", "bc1", "bc3", "bc4", "bc5" or "bc7".
+		/// </summary>
+		/// <param name="a_sName">The name, in lowercase.</param>
+		/// <param name="a_Format">Receives the format.</param>
+		/// <returns>True if the name is a format, otherwise false.</returns>
+		bool ParseTextureFormat(const std::string& a_sName, graphics::TextureFormat& a_Format);
+
+		/// <summary>
+		/// Reads a compression quality from its name: "fast", "normal" or "high".
+		/// </summary>
+		/// <param name="a_sName">The name, in lowercase.</param>
+		/// <param name="a_Quality">Receives the quality.</param>
+		/// <returns>True if the name is a quality, otherwise false.</returns>
+		bool ParseCompressionQuality(const std::string& a_sName, CompressionQuality& a_Quality);
+
+		/// <summary>
+		/// Reads a mip filter from its name: "box" or "kaiser".
+		/// </summary>
+		/// <param name="a_sName">The name, in lowercase.</param>
+		/// <param name="a_Filter">Receives the filter.</param>
+		/// <returns>True if the name is a filter, otherwise false.</returns>
+		bool ParseMipFilter(const std::string& a_sName, MipFilter& a_Filter);
+	}
+}
\ No newline at end of file
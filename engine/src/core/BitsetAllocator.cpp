@@ -0,0 +1,173 @@
+#include "core/BitsetAllocator.h"
+
+#include <bit>
+
+namespace gallus
+{
+	namespace core
+	{
+		namespace
+		{
+			constexpr size_t WORD_BITS = 64;
+			constexpr uint64_t FULL_WORD = ~0ull;
+		}
+
+		//---------------------------------------------------------------------
+		// BitsetAllocator
+		//---------------------------------------------------------------------
+		void BitsetAllocator::Reset(size_t a_iCount)
+		{
+			const size_t wordCount = (a_iCount + WORD_BITS - 1) / WORD_BITS;
+
+			m_aWords.assign(wordCount, 0);
+			m_aSummary.assign((wordCount + WORD_BITS - 1) / WORD_BITS, 0);
+			m_iCount = a_iCount;
+			m_iFreeCount = a_iCount;
+
+			const size_t tailBits = a_iCount % WORD_BITS;
+			if (tailBits != 0)
+			{
+				m_aWords.back() = FULL_WORD << tailBits;
+			}
+
+			for (size_t i = 0; i < wordCount; ++i)
+			{
+				m_aSummary[i / WORD_BITS] |= 1ull << (i % WORD_BITS);
+			}
+		}
+
+		//---------------------------------------------------------------------
+		size_t BitsetAllocator::Allocate()
+		{
+			for (size_t i = 0; i < m_aSummary.size(); ++i)
+			{
+				if (m_aSummary[i] == 0)
+				{
+					continue;
+				}
+
+				const size_t wordIndex = i * WORD_BITS + std::countr_zero(m_aSummary[i]);
+				const size_t index = wordIndex * WORD_BITS + std::countr_one(m_aWords[wordIndex]);
+				MarkAllocated(index, 1);
+				return index;
+			}
+
+			return INVALID_INDEX;
+		}
+
+		//---------------------------------------------------------------------
+		size_t BitsetAllocator::AllocateRange(size_t a_iCount)
+		{
+			if (a_iCount == 0 || a_iCount > m_iFreeCount)
+			{
+				return INVALID_INDEX;
+			}
+
+			if (a_iCount == 1)
+			{
+				return Allocate();
+			}
+
+			size_t start = 0;
+			size_t length = 0;
+			size_t index = 0;
+			while (index < m_iCount)
+			{
+				const uint64_t word = m_aWords[index / WORD_BITS];
+				const size_t bit = index % WORD_BITS;
+
+				// Whole words are skipped or taken at once, only partially used words are walked bit by bit.
+				if (bit == 0 && word == FULL_WORD)
+				{
+					length = 0;
+					index += WORD_BITS;
+					continue;
+				}
+				if (bit == 0 && word == 0 && length + WORD_BITS < a_iCount)
+				{
+					start = length == 0 ? index : start;
+					length += WORD_BITS;
+					index += WORD_BITS;
+					continue;
+				}
+
+				if (word & (1ull << bit))
+				{
+					length = 0;
+				}
+				else
+				{
+					start = length == 0 ? index : start;
+					if (++length == a_iCount)
+					{
+						MarkAllocated(start, a_iCount);
+						return start;
+					}
+				}
+				index++;
+			}
+
+			return INVALID_INDEX;
+		}
+
+		//---------------------------------------------------------------------
+		bool BitsetAllocator::Free(size_t a_iIndex, size_t a_iCount)
+		{
+			if (a_iCount == 0 || a_iIndex >= m_iCount || a_iCount > m_iCount - a_iIndex)
+			{
+				return false;
+			}
+
+			for (size_t i = a_iIndex; i < a_iIndex + a_iCount; ++i)
+			{
+				if (!IsAllocated(i))
+				{
+					return false;
+				}
+			}
+
+			for (size_t i = a_iIndex; i < a_iIndex + a_iCount; ++i)
+			{
+				const size_t wordIndex = i / WORD_BITS;
+				m_aWords[wordIndex] &= ~(1ull << (i % WORD_BITS));
+				m_aSummary[wordIndex / WORD_BITS] |= 1ull << (wordIndex % WORD_BITS);
+			}
+			m_iFreeCount += a_iCount;
+
+			return true;
+		}
+
+		//---------------------------------------------------------------------
+		bool BitsetAllocator::IsAllocated(size_t a_iIndex) const
+		{
+			return a_iIndex < m_iCount && (m_aWords[a_iIndex / WORD_BITS] & (1ull << (a_iIndex % WORD_BITS))) != 0;
+		}
+
+		//---------------------------------------------------------------------
+		size_t BitsetAllocator::GetCount() const
+		{
+			return m_iCount;
+		}
+
+		//---------------------------------------------------------------------
+		size_t BitsetAllocator::GetFreeCount() const
+		{
+			return m_iFreeCount;
+		}
+
+		//---------------------------------------------------------------------
+		void BitsetAllocator::MarkAllocated(size_t a_iIndex, size_t a_iCount)
+		{
+			for (size_t i = a_iIndex; i < a_iIndex + a_iCount; ++i)
+			{
+				const size_t wordIndex = i / WORD_BITS;
+				m_aWords[wordIndex] |= 1ull << (i % WORD_BITS);
+				if (m_aWords[wordIndex] == FULL_WORD)
+				{
+					m_aSummary[wordIndex / WORD_BITS] &= ~(1ull << (wordIndex % WORD_BITS));
+				}
+			}
+			m_iFreeCount -= a_iCount;
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace gallus
+{
+	namespace core
+	{
+		//---------------------------------------------------------------------
+		// BitsetAllocator
+		//---------------------------------------------------------------------
+		/// <summary>
+		/// Hands out indices from a fixed range, lowest free index first. Every index is a bit in a 64-bit word and a summary
+		/// word keeps a bit per word that still has a free index, so finding a free index is two find-first-set operations
+		/// per 4096 indices. Freeing an index is constant time. Not thread-safe.
+		/// </summary>
+		class BitsetAllocator
+		{
+		public:
+			static constexpr size_t INVALID_INDEX = SIZE_MAX;
+
+			/// <summary>
+			/// Sets the number of indices and frees all of them.
+			/// </summary>
+			/// <param name="a_iCount">The number of indices.</param>
+			void Reset(size_t a_iCount);
+
+			/// <summary>
+			/// Allocates the lowest free index.
+			/// </summary>
+			/// <returns>The index, or INVALID_INDEX if every index is in use.</returns>
+			size_t Allocate();
+
+			/// <summary>
+			/// Allocates the lowest range of consecutive free indices. Scans the words, so it is meant for rare large requests.
+			/// </summary>
+			/// <param name="a_iCount">The number of indices.</param>
+			/// <returns>The first index of the range, or INVALID_INDEX if there is no free range that is large enough.</returns>
+			size_t AllocateRange(size_t a_iCount);
+
+			/// <summary>
+			/// Frees a range of indices.
+			/// </summary>
+			/// <param name="a_iIndex">The first index.</param>
+			/// <param name="a_iCount">The number of indices.</param>
+			/// <returns>True if the indices were freed, false if the range is out of bounds or not fully allocated.</returns>
+			bool Free(size_t a_iIndex, size_t a_iCount = 1);
+
+			/// <summary>
+			/// Checks whether an index is in use.
+			/// </summary>
+			/// <param name="a_iIndex">The index.</param>
+			/// <returns>True if the index is allocated, otherwise false.</returns>
+			bool IsAllocated(size_t a_iIndex) const;
+
+			/// <summary>
+			/// Retrieves the number of indices.
+			/// </summary>
+			/// <returns>The number of indices.</returns>
+			size_t GetCount() const;
+
+			/// <summary>
+			/// Retrieves the number of free indices.
+			/// </summary>
+			/// <returns>The number of free indices.</returns>
+			size_t GetFreeCount() const;
+		private:
+			/// <summary>
+			/// Marks a range of free indices as allocated.
+			/// </summary>
+			/// <param name="a_iIndex">The first index.</param>
+			/// <param name="a_iCount">The number of indices.</param>
+			void MarkAllocated(size_t a_iIndex, size_t a_iCount);
+
+			std::vector<uint64_t> m_aWords; /// A set bit is an allocated index. Bits past the count are set, so they are never handed out.
+			std::vector<uint64_t> m_aSummary; /// A set bit is a word that has a free index.
+			size_t m_iCount = 0;
+			size_t m_iFreeCount = 0;
+		};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,187 @@
+#include "core/Compression.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace gallus
+{
+	namespace core
+	{
+		inline const size_t g_iLZMinMatch = 4;
+		inline const size_t g_iLZMaxOffset = 65535;
+		inline const uint32_t g_iLZHashBits = 14;
+
+		namespace
+		{
+			//---------------------------------------------------------------------
+			void writeLength(std::vector<uint8_t>& a_aCompressed, size_t a_iLength)
+			{
+				while (a_iLength >= 255)
+				{
+					a_aCompressed.push_back(255);
+					a_iLength -= 255;
+				}
+				a_aCompressed.push_back(static_cast<uint8_t>(a_iLength));
+			}
+
+			//---------------------------------------------------------------------
+			bool readLength(const uint8_t*& a_pSource, const uint8_t* a_pEnd, size_t& a_iLength)
+			{
+				uint8_t value = 255;
+				while (value == 255)
+				{
+					if (a_pSource == a_pEnd)
+					{
+						return false;
+					}
+					value = *a_pSource++;
+					a_iLength += value;
+				}
+				return true;
+			}
+
+			//---------------------------------------------------------------------
+			void writeSequence(std::vector<uint8_t>& a_aCompressed, const uint8_t* a_pLiterals, size_t a_iLiteralCount, size_t a_iOffset, size_t a_iMatchLength)
+			{
+				const size_t matchCode = a_iMatchLength > 0 ? a_iMatchLength - g_iLZMinMatch : 0;
+				a_aCompressed.push_back(static_cast<uint8_t>((std::min<size_t>(a_iLiteralCount, 15) << 4) | std::min<size_t>(matchCode, 15)));
+				if (a_iLiteralCount >= 15)
+				{
+					writeLength(a_aCompressed, a_iLiteralCount - 15);
+				}
+				a_aCompressed.insert(a_aCompressed.end(), a_pLiterals, a_pLiterals + a_iLiteralCount);
+
+				// The last sequence only has literals.
+				if (a_iMatchLength == 0)
+				{
+					return;
+				}
+
+				a_aCompressed.push_back(static_cast<uint8_t>(a_iOffset & 0xFF));
+				a_aCompressed.push_back(static_cast<uint8_t>(a_iOffset >> 8));
+				if (matchCode >= 15)
+				{
+					writeLength(a_aCompressed, matchCode - 15);
+				}
+			}
+		}
+
+		//---------------------------------------------------------------------
+		void CompressLZ(const void* a_pSource, size_t a_iSourceSize, std::vector<uint8_t>& a_aCompressed)
+		{
+			const uint8_t* source = static_cast<const uint8_t*>(a_pSource);
+			a_aCompressed.clear();
+			a_aCompressed.reserve(a_iSourceSize + a_iSourceSize / 255 + 16);
+
+			// Last position each hashed 4 byte sequence was seen at, matches are only searched there.
+			std::vector<uint32_t> positions(size_t(1) << g_iLZHashBits, UINT32_MAX);
+
+			size_t anchor = 0;
+			size_t position = 0;
+			while (position + g_iLZMinMatch <= a_iSourceSize)
+			{
+				uint32_t sequence;
+				memcpy(&sequence, source + position, sizeof(sequence));
+				const uint32_t hash = (sequence * 2654435761u) >> (32 - g_iLZHashBits);
+				const uint32_t candidate = positions[hash];
+				positions[hash] = static_cast<uint32_t>(position);
+
+				if (candidate == UINT32_MAX || position - candidate > g_iLZMaxOffset || memcmp(source + candidate, source + position, g_iLZMinMatch) != 0)
+				{
+					position++;
+					continue;
+				}
+
+				size_t matchLength = g_iLZMinMatch;
+				while (position + matchLength < a_iSourceSize && source[candidate + matchLength] == source[position + matchLength])
+				{
+					matchLength++;
+				}
+
+				writeSequence(a_aCompressed, source + anchor, position - anchor, position - candidate, matchLength);
+				position += matchLength;
+				anchor = position;
+			}
+
+			writeSequence(a_aCompressed, source + anchor, a_iSourceSize - anchor, 0, 0);
+		}
+
+		//---------------------------------------------------------------------
+		bool DecompressLZ(const void* a_pSource, size_t a_iSourceSize, void* a_pDestination, size_t a_iDestinationSize)
+		{
+			const uint8_t* source = static_cast<const uint8_t*>(a_pSource);
+			const uint8_t* sourceEnd = source + a_iSourceSize;
+			uint8_t* destination = static_cast<uint8_t*>(a_pDestination);
+			size_t written = 0;
+
+			while (source < sourceEnd)
+			{
+				const uint8_t token = *source++;
+
+				size_t literalCount = token >> 4;
+				if (literalCount == 15 && !readLength(source, sourceEnd, literalCount))
+				{
+					return false;
+				}
+				if (literalCount > static_cast<size_t>(sourceEnd - source) || literalCount > a_iDestinationSize - written)
+				{
+					return false;
+				}
+				if (literalCount > 0)
+				{
+					memcpy(destination + written, source, literalCount);
+				}
+				source += literalCount;
+				written += literalCount;
+
+				if (source == sourceEnd)
+				{
+					break;
+				}
+
+				if (sourceEnd - source < 2)
+				{
+					return false;
+				}
+				const size_t offset = source[0] | (static_cast<size_t>(source[1]) << 8);
+				source += 2;
+
+				size_t matchLength = token & 0xF;
+				if (matchLength == 15 && !readLength(source, sourceEnd, matchLength))
+				{
+					return false;
+				}
+				matchLength += g_iLZMinMatch;
+
+				if (offset == 0 || offset > written || matchLength > a_iDestinationSize - written)
+				{
+					return false;
+				}
+
+				// Matches can overlap the bytes they produce, which repeats the pattern, so those are copied byte by byte.
+				uint8_t* match = destination + written - offset;
+				if (offset >= matchLength)
+				{
+					memcpy(destination + written, match, matchLength);
+				}
+				else
+				{
+					for (size_t i = 0; i < matchLength; i++)
+					{
+						destination[written + i] = match[i];
+					}
+				}
+				written += matchLength;
+			}
+
+			return written == a_iDestinationSize;
+		}
+
+		//---------------------------------------------------------------------
+		size_t GetMaxDecompressedSizeLZ(size_t a_iCompressedSize)
+		{
+			// No byte of a block adds more than 255 bytes, a literal adds one and a length byte at most 255.
+			return a_iCompressedSize > SIZE_MAX / 255 ? SIZE_MAX : a_iCompressedSize * 255;
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace gallus
+{
+	namespace core
+	{
+		// Byte oriented LZ77 block format, decoded without any tables:
+		//   token          High nibble is the literal count, low nibble the match length minus 4. A nibble of 15 means
+		//                  the count continues in the following bytes, each adding up to 255 and ending on a byte below 255.
+		//   literals       Copied as is.
+		//   offset         Two bytes, little endian, how far back the match starts. Absent after the last literals.
+		// Trades ratio for a decoder that runs at memory speed, since archives are decompressed on load.
+
+		/// <summary>
+		/// Compresses a block of memory.
+		/// </summary>
+		/// <param name="a_pSource">The data to compress.</param>
+		/// <param name="a_iSourceSize">Size of the data in bytes.</param>
+		/// <param name="a_aCompressed">Receives the compressed data. Can be larger than the source for data that does not compress.</param>
+		void CompressLZ(const void* a_pSource, size_t a_iSourceSize, std::vector<uint8_t>& a_aCompressed);
+
+		/// <summary>
+		/// Decompresses a block that was compressed with CompressLZ. Malformed input is rejected, it never reads or writes out of bounds.
+		/// </summary>
+		/// <param name="a_pSource">The compressed data.</param>
+		/// <param name="a_iSourceSize">Size of the compressed data in bytes.</param>
+		/// <param name="a_pDestination">Receives the decompressed data.</param>
+		/// <param name="a_iDestinationSize">Size of the decompressed data in bytes.</param>
+		/// <returns>True if the block decompressed to exactly the destination size, otherwise false.</returns>
+		bool DecompressLZ(const void* a_pSource, size_t a_iSourceSize, void* a_pDestination, size_t a_iDestinationSize);
+
+		/// <summary>
+		/// Retrieves the largest size a compressed block can decompress to, so sizes read from a file can be checked before allocating.
+		/// </summary>
+		/// <param name="a_iCompressedSize">Size of the compressed data in bytes.</param>
+		/// <returns>The largest decompressed size in bytes.</returns>
+		size_t GetMaxDecompressedSizeLZ(size_t a_iCompressedSize);
+	}
+}
\ No newline at end of file
@@ -1,9 +1,9 @@
 #include "Data.h"
 
-#include <corecrt_malloc.h>
+#include <cstdlib>
 #include <stdio.h>
 #include <cassert>
-#include <vcruntime_string.h>
+#include <cstring>
 #include <string>
 
 namespace gallus
@@ -54,10 +54,11 @@ namespace gallus
 
 		//---------------------------------------------------------------------
 		Data::Data(Data&& a_Other) noexcept
-			: m_pData(a_Other.m_pData), m_iSize(a_Other.m_iSize)
+			: m_pData(a_Other.m_pData), m_iSize(a_Other.m_iSize), m_bOwnsData(a_Other.m_bOwnsData)
 		{
 			a_Other.m_pData = nullptr;
 			a_Other.m_iSize = 0;
+			a_Other.m_bOwnsData = true;
 		}
 
 		//---------------------------------------------------------------------
@@ -89,9 +90,11 @@ namespace gallus
 
 				m_pData = a_Other.m_pData;
 				m_iSize = a_Other.m_iSize;
+				m_bOwnsData = a_Other.m_bOwnsData;
 
 				a_Other.m_pData = nullptr;
 				a_Other.m_iSize = 0;
+				a_Other.m_bOwnsData = true;
 			}
 			return *this;
 		}
@@ -102,16 +105,30 @@ namespace gallus
 			Free();
 		}
 
+		//---------------------------------------------------------------------
+		Data Data::CreateView(const void* a_pData, size_t a_iSize)
+		{
+			Data view;
+			view.m_pData = const_cast<void*>(a_pData);
+			view.m_iSize = a_iSize;
+			view.m_bOwnsData = false;
+			return view;
+		}
+
 		//---------------------------------------------------------------------
 		void Data::Free()
 		{
 			if (m_pData)
 			{
-				free(m_pData);
+				if (m_bOwnsData)
+				{
+					free(m_pData);
+				}
 
 				m_iSize = 0;
 				m_pData = nullptr;
 			}
+			m_bOwnsData = true;
 		}
 
 		//---------------------------------------------------------------------
@@ -70,6 +70,24 @@ namespace gallus
 			/// </summary>
 			virtual ~Data();
 
+			/// <summary>
+			/// Creates a Data object that refers to memory it does not own, without copying it. Copies of a view own their memory,
+			/// the view itself must not be written to if the memory is read-only.
+			/// </summary>
+			/// <param name="a_pData">Pointer to the raw data, which has to outlive the view.</param>
+			/// <param name="a_iSize">Size of the data in bytes.</param>
+			/// <returns>The view.</returns>
+			static Data CreateView(const void* a_pData, size_t a_iSize);
+
+			/// <summary>
+			/// Checks whether the Data object refers to memory it does not own.
+			/// </summary>
+			/// <returns>True if it is a view, otherwise false.</returns>
+			bool IsView() const
+			{
+				return !m_bOwnsData;
+			}
+
 			/// <summary>
 			/// Retrieves the size of the stored data in bytes.
 			/// </summary>
@@ -154,6 +172,7 @@ namespace gallus
 		protected:
 			void* m_pData = nullptr; /// Pointer to the raw data.
 			size_t m_iSize = 0;      /// Size of the data in bytes.
+			bool m_bOwnsData = true; /// Whether the data gets freed with this object.
 		};
 	}
 }
\ No newline at end of file
@@ -1,6 +1,6 @@
 #include "DataStream.h"
 
-#include <vcruntime_string.h>
+#include <cstring>
 
 #include "Memory.h"
 
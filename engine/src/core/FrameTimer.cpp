@@ -0,0 +1,73 @@
+#include "core/FrameTimer.h"
+
+#include <algorithm>
+
+namespace gallus
+{
+	namespace core
+	{
+		//---------------------------------------------------------------------
+		// FrameTimer
+		//---------------------------------------------------------------------
+		void FrameTimer::Reset()
+		{
+			m_LastTick = std::chrono::steady_clock::now();
+			m_fDeltaTime = 0.0f;
+			m_fTotalTime = 0.0;
+			m_iFrameCount = 0;
+			m_fMinFrameTime = 0.0f;
+			m_fMaxFrameTime = 0.0f;
+		}
+
+		//---------------------------------------------------------------------
+		float FrameTimer::Tick()
+		{
+			const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+			m_fDeltaTime = std::chrono::duration<float>(now - m_LastTick).count();
+			m_LastTick = now;
+
+			m_fMinFrameTime = m_iFrameCount == 0 ? m_fDeltaTime : std::min(m_fMinFrameTime, m_fDeltaTime);
+			m_fMaxFrameTime = std::max(m_fMaxFrameTime, m_fDeltaTime);
+			m_fTotalTime += m_fDeltaTime;
+			m_iFrameCount++;
+
+			return m_fDeltaTime;
+		}
+
+		//---------------------------------------------------------------------
+		float FrameTimer::GetDeltaTime() const
+		{
+			return m_fDeltaTime;
+		}
+
+		//---------------------------------------------------------------------
+		double FrameTimer::GetTotalTime() const
+		{
+			return m_fTotalTime;
+		}
+
+		//---------------------------------------------------------------------
+		uint64_t FrameTimer::GetFrameCount() const
+		{
+			return m_iFrameCount;
+		}
+
+		//---------------------------------------------------------------------
+		float FrameTimer::GetAverageFrameTime() const
+		{
+			return m_iFrameCount == 0 ? 0.0f : static_cast<float>(m_fTotalTime / m_iFrameCount);
+		}
+
+		//---------------------------------------------------------------------
+		float FrameTimer::GetMinFrameTime() const
+		{
+			return m_fMinFrameTime;
+		}
+
+		//---------------------------------------------------------------------
+		float FrameTimer::GetMaxFrameTime() const
+		{
+			return m_fMaxFrameTime;
+		}
+	}
+}
\ No newline at end of file
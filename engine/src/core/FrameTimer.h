@@ -0,0 +1,74 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace gallus
+{
+	namespace core
+	{
+		//---------------------------------------------------------------------
+		// FrameTimer
+		//---------------------------------------------------------------------
+		/// <summary>
+		/// Measures the time between frames and keeps statistics over all frames since the last reset.
+		/// </summary>
+		class FrameTimer
+		{
+		public:
+			/// <summary>
+			/// Clears the statistics and starts measuring from now.
+			/// </summary>
+			void Reset();
+
+			/// <summary>
+			/// Marks the start of a new frame.
+			/// </summary>
+			/// <returns>The time in seconds that has passed since the previous frame.</returns>
+			float Tick();
+
+			/// <summary>
+			/// Retrieves the duration of the last frame.
+			/// </summary>
+			/// <returns>The duration of the last frame in seconds.</returns>
+			float GetDeltaTime() const;
+
+			/// <summary>
+			/// Retrieves the time spent in all frames since the last reset.
+			/// </summary>
+			/// <returns>The total time in seconds.</returns>
+			double GetTotalTime() const;
+
+			/// <summary>
+			/// Retrieves the number of frames since the last reset.
+			/// </summary>
+			/// <returns>The number of frames.</returns>
+			uint64_t GetFrameCount() const;
+
+			/// <summary>
+			/// Retrieves the average duration of a frame.
+			/// </summary>
+			/// <returns>The average frame duration in seconds, or 0 if there were no frames.</returns>
+			float GetAverageFrameTime() const;
+
+			/// <summary>
+			/// Retrieves the duration of the shortest frame.
+			/// </summary>
+			/// <returns>The shortest frame duration in seconds, or 0 if there were no frames.</returns>
+			float GetMinFrameTime() const;
+
+			/// <summary>
+			/// Retrieves the duration of the longest frame.
+			/// </summary>
+			/// <returns>The longest frame duration in seconds.</returns>
+			float GetMaxFrameTime() const;
+		private:
+			std::chrono::steady_clock::time_point m_LastTick = std::chrono::steady_clock::now(); /// Time of the previous frame.
+			float m_fDeltaTime = 0.0f; /// Duration of the last frame.
+			double m_fTotalTime = 0.0; /// Total duration of all frames.
+			uint64_t m_iFrameCount = 0; /// Number of frames.
+			float m_fMinFrameTime = 0.0f; /// Duration of the shortest frame.
+			float m_fMaxFrameTime = 0.0f; /// Duration of the longest frame.
+		};
+	}
+}
\ No newline at end of file
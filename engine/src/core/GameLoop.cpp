@@ -0,0 +1,155 @@
+#include "core/GameLoop.h"
+
+#include <thread>
+
+namespace gallus
+{
+	namespace core
+	{
+		// Sleeping can overshoot by a scheduler quantum, so the last part before a frame is spent yielding instead.
+		constexpr std::chrono::milliseconds SLEEP_MARGIN = std::chrono::milliseconds(2);
+
+		//---------------------------------------------------------------------
+		// GameLoop
+		//---------------------------------------------------------------------
+		void GameLoop::Reset()
+		{
+			m_LastFrame = Clock::now();
+			m_NextFrame = m_LastFrame;
+			m_Accumulator = Clock::duration::zero();
+			m_fAlpha = 0.0f;
+			m_iStepCount = 0;
+			m_fDroppedTime = 0.0;
+		}
+
+		//---------------------------------------------------------------------
+		uint32_t GameLoop::BeginFrame()
+		{
+			const Clock::time_point now = Clock::now();
+			m_Accumulator += now - m_LastFrame;
+			m_LastFrame = now;
+
+			uint64_t steps = static_cast<uint64_t>(m_Accumulator / m_FixedStep);
+			if (steps > m_iMaxStepsPerFrame)
+			{
+				// Catching up would make the next frame even slower, so the time of the extra steps is dropped.
+				const Clock::duration dropped = m_FixedStep * (steps - m_iMaxStepsPerFrame);
+				m_Accumulator -= dropped;
+				m_fDroppedTime += std::chrono::duration<double>(dropped).count();
+				steps = m_iMaxStepsPerFrame;
+			}
+
+			m_Accumulator -= m_FixedStep * steps;
+			m_iStepCount += steps;
+			m_fAlpha = std::chrono::duration<float>(m_Accumulator).count() / std::chrono::duration<float>(m_FixedStep).count();
+
+			return static_cast<uint32_t>(steps);
+		}
+
+		//---------------------------------------------------------------------
+		void GameLoop::WaitForNextFrame()
+		{
+			if (m_FrameDuration == Clock::duration::zero())
+			{
+				return;
+			}
+
+			m_NextFrame += m_FrameDuration;
+
+			Clock::time_point now = Clock::now();
+			if (now >= m_NextFrame)
+			{
+				// When the loop fell more than a frame behind, pacing restarts from now instead of rushing through the missed frames.
+				if (now - m_NextFrame > m_FrameDuration)
+				{
+					m_NextFrame = now;
+				}
+				return;
+			}
+
+			while (now < m_NextFrame)
+			{
+				const Clock::duration remaining = m_NextFrame - now;
+				if (remaining > SLEEP_MARGIN)
+				{
+					std::this_thread::sleep_for(remaining - SLEEP_MARGIN);
+				}
+				else
+				{
+					std::this_thread::yield();
+				}
+				now = Clock::now();
+			}
+		}
+
+		//---------------------------------------------------------------------
+		void GameLoop::SetSimulationRate(float a_fStepsPerSecond)
+		{
+			if (a_fStepsPerSecond <= 0.0f)
+			{
+				return;
+			}
+
+			m_FixedStep = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / a_fStepsPerSecond));
+		}
+
+		//---------------------------------------------------------------------
+		float GameLoop::GetFixedDeltaTime() const
+		{
+			return std::chrono::duration<float>(m_FixedStep).count();
+		}
+
+		//---------------------------------------------------------------------
+		void GameLoop::SetTargetFrameRate(float a_fFramesPerSecond)
+		{
+			if (a_fFramesPerSecond <= 0.0f)
+			{
+				m_FrameDuration = Clock::duration::zero();
+				return;
+			}
+
+			m_FrameDuration = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / a_fFramesPerSecond));
+			m_NextFrame = Clock::now();
+		}
+
+		//---------------------------------------------------------------------
+		float GameLoop::GetTargetFrameRate() const
+		{
+			if (m_FrameDuration == Clock::duration::zero())
+			{
+				return 0.0f;
+			}
+
+			return 1.0f / std::chrono::duration<float>(m_FrameDuration).count();
+		}
+
+		//---------------------------------------------------------------------
+		void GameLoop::SetMaxStepsPerFrame(uint32_t a_iMaxSteps)
+		{
+			if (a_iMaxSteps == 0)
+			{
+				return;
+			}
+
+			m_iMaxStepsPerFrame = a_iMaxSteps;
+		}
+
+		//---------------------------------------------------------------------
+		float GameLoop::GetAlpha() const
+		{
+			return m_fAlpha;
+		}
+
+		//---------------------------------------------------------------------
+		uint64_t GameLoop::GetStepCount() const
+		{
+			return m_iStepCount;
+		}
+
+		//---------------------------------------------------------------------
+		double GameLoop::GetDroppedTime() const
+		{
+			return m_fDroppedTime;
+		}
+	}
+}
\ No newline at end of file
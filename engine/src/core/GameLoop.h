@@ -0,0 +1,99 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace gallus
+{
+	namespace core
+	{
+		//---------------------------------------------------------------------
+		// GameLoop
+		//---------------------------------------------------------------------
+		/// <summary>
+		/// Schedules the frames of the game loop. The simulation advances in fixed steps that are taken from an accumulator
+		/// of real time, and frames are paced to a target rate by sleeping instead of spinning.
+		/// Rendering can use the interpolation alpha to blend between the last two simulation steps.
+		/// </summary>
+		class GameLoop
+		{
+		public:
+			using Clock = std::chrono::steady_clock;
+
+			/// <summary>
+			/// Clears the accumulator and starts measuring from now.
+			/// </summary>
+			void Reset();
+
+			/// <summary>
+			/// Starts a new frame, adding the time that has passed since the previous frame to the accumulator.
+			/// </summary>
+			/// <returns>The number of fixed simulation steps that need to run this frame.</returns>
+			uint32_t BeginFrame();
+
+			/// <summary>
+			/// Ends the frame, sleeping until the next frame should start if a target frame rate has been set.
+			/// </summary>
+			void WaitForNextFrame();
+
+			/// <summary>
+			/// Sets the number of simulation steps per second.
+			/// </summary>
+			/// <param name="a_fStepsPerSecond">The number of steps per second, must be greater than 0.</param>
+			void SetSimulationRate(float a_fStepsPerSecond);
+
+			/// <summary>
+			/// Retrieves the duration of a single simulation step.
+			/// </summary>
+			/// <returns>The duration of a step in seconds.</returns>
+			float GetFixedDeltaTime() const;
+
+			/// <summary>
+			/// Sets the number of frames per second the loop gets paced to.
+			/// </summary>
+			/// <param name="a_fFramesPerSecond">The number of frames per second, or 0 to run frames back to back.</param>
+			void SetTargetFrameRate(float a_fFramesPerSecond);
+
+			/// <summary>
+			/// Retrieves the number of frames per second the loop gets paced to.
+			/// </summary>
+			/// <returns>The number of frames per second, or 0 if frames are not paced.</returns>
+			float GetTargetFrameRate() const;
+
+			/// <summary>
+			/// Sets the maximum number of simulation steps a single frame can run. Time beyond that is dropped,
+			/// so a slow frame cannot cause more and more steps in the frames after it.
+			/// </summary>
+			/// <param name="a_iMaxSteps">The maximum number of steps, must be greater than 0.</param>
+			void SetMaxStepsPerFrame(uint32_t a_iMaxSteps);
+
+			/// <summary>
+			/// Retrieves how far the time in the accumulator is between the last step and the next one.
+			/// </summary>
+			/// <returns>The interpolation alpha, between 0 and 1.</returns>
+			float GetAlpha() const;
+
+			/// <summary>
+			/// Retrieves the number of simulation steps since the last reset.
+			/// </summary>
+			/// <returns>The number of steps.</returns>
+			uint64_t GetStepCount() const;
+
+			/// <summary>
+			/// Retrieves the time that was dropped by the step limit since the last reset.
+			/// </summary>
+			/// <returns>The dropped time in seconds.</returns>
+			double GetDroppedTime() const;
+		private:
+			Clock::time_point m_LastFrame = Clock::now(); /// Start of the previous frame.
+			Clock::time_point m_NextFrame = Clock::now(); /// Time at which the next frame should start when pacing.
+			Clock::duration m_FixedStep = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / 60.0)); /// Duration of a simulation step.
+			Clock::duration m_FrameDuration = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / 60.0)); /// Duration of a frame when pacing, zero if frames are not paced.
+			Clock::duration m_Accumulator = Clock::duration::zero(); /// Real time that has not been simulated yet.
+			uint32_t m_iMaxStepsPerFrame = 5; /// Maximum number of steps in a single frame.
+			float m_fAlpha = 0.0f; /// Interpolation alpha of the current frame.
+			uint64_t m_iStepCount = 0; /// Number of steps since the last reset.
+			double m_fDroppedTime = 0.0; /// Time dropped by the step limit since the last reset.
+		};
+	}
+}
\ No newline at end of file
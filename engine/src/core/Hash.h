@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace gallus
+{
+	namespace core
+	{
+		inline const uint64_t g_iFNV1aOffsetBasis = 14695981039346656037ull;
+
+		/// <summary>
+		/// Hashes a block of memory with 64 bit FNV-1a. Stable across runs and platforms, so it can be stored in files.
+		/// </summary>
+		/// <param name="a_pData">The data to hash.</param>
+		/// <param name="a_iSize">Size of the data in bytes.</param>
+		/// <param name="a_iHash">Hash to continue from, to hash several blocks as one.</param>
+		/// <returns>The hash.</returns>
+		inline uint64_t HashFNV1a(const void* a_pData, size_t a_iSize, uint64_t a_iHash = g_iFNV1aOffsetBasis)
+		{
+			const uint8_t* data = static_cast<const uint8_t*>(a_pData);
+			for (size_t i = 0; i < a_iSize; i++)
+			{
+				a_iHash ^= data[i];
+				a_iHash *= 1099511628211ull;
+			}
+			return a_iHash;
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,265 @@
+#include "core/JobSystem.h"
+
+#include "logger/Logger.h"
+
+namespace gallus
+{
+	namespace core
+	{
+		// Worker index of the calling thread, together with the job system it belongs to.
+		thread_local const JobSystem* t_pWorkerJobSystem = nullptr;
+		thread_local uint32_t t_iWorkerIndex = JobSystem::INVALID_WORKER;
+
+		// Amount of chunks per thread ParallelFor aims for, so threads that finish early can steal the remainder.
+		constexpr size_t CHUNKS_PER_THREAD = 4;
+
+		//---------------------------------------------------------------------
+		// JobSystem
+		//---------------------------------------------------------------------
+		bool JobSystem::Initialize()
+		{
+			const uint32_t hardwareThreads = std::thread::hardware_concurrency();
+			return Initialize(hardwareThreads > 1 ? hardwareThreads - 1 : 0);
+		}
+
+		//---------------------------------------------------------------------
+		bool JobSystem::Initialize(uint32_t a_iWorkerCount)
+		{
+			if (!m_aWorkers.empty())
+			{
+				// Already running
+				return false;
+			}
+
+			System::Initialize();
+
+			m_aWorkQueues.clear();
+			for (uint32_t i = 0; i < a_iWorkerCount; i++)
+			{
+				m_aWorkQueues.push_back(std::make_unique<WorkQueue>());
+			}
+
+			m_aWorkers.reserve(a_iWorkerCount);
+			for (uint32_t i = 0; i < a_iWorkerCount; i++)
+			{
+				m_aWorkers.emplace_back(&JobSystem::WorkerLoop, this, i);
+			}
+
+			LOGF(LOGSEVERITY_SUCCESS, LOG_CATEGORY_CORE, "Job system initialized with %u workers.", a_iWorkerCount);
+			return true;
+		}
+
+		//---------------------------------------------------------------------
+		bool JobSystem::Destroy()
+		{
+			{
+				std::lock_guard<std::mutex> lock(m_SleepMutex);
+				System::Destroy();
+			}
+			m_SleepCondVar.notify_all();
+
+			for (std::thread& worker : m_aWorkers)
+			{
+				if (worker.joinable())
+				{
+					worker.join();
+				}
+			}
+			m_aWorkers.clear();
+
+			// Jobs that were still queued run on the calling thread, so nobody waits on them forever.
+			while (TryExecuteJob())
+			{
+			}
+			m_aWorkQueues.clear();
+
+			LOG(LOGSEVERITY_SUCCESS, LOG_CATEGORY_CORE, "Job system destroyed.");
+			return true;
+		}
+
+		//---------------------------------------------------------------------
+		void JobSystem::Schedule(std::function<void()> a_Job, JobCounter* a_pCounter)
+		{
+			if (a_pCounter)
+			{
+				a_pCounter->m_iPending.fetch_add(1, std::memory_order_relaxed);
+			}
+
+			const uint32_t workerIndex = GetCurrentWorkerIndex();
+			WorkQueue& queue = workerIndex != INVALID_WORKER ? *m_aWorkQueues[workerIndex] : m_SharedQueue;
+			{
+				std::lock_guard<std::mutex> lock(queue.m_Mutex);
+				queue.m_aJobs.push_back({ std::move(a_Job), a_pCounter });
+			}
+			m_iQueuedJobs.fetch_add(1, std::memory_order_release);
+
+			{
+				// Taking the lock makes sure a worker that is about to sleep sees the new job.
+				std::lock_guard<std::mutex> lock(m_SleepMutex);
+			}
+			m_SleepCondVar.notify_one();
+		}
+
+		//---------------------------------------------------------------------
+		void JobSystem::Wait(const JobCounter& a_Counter)
+		{
+			while (!a_Counter.IsDone())
+			{
+				if (!TryExecuteJob())
+				{
+					std::this_thread::yield();
+				}
+			}
+		}
+
+		//---------------------------------------------------------------------
+		bool JobSystem::TryExecuteJob()
+		{
+			Job job;
+			if (!FindJob(GetCurrentWorkerIndex(), job))
+			{
+				return false;
+			}
+
+			Execute(job);
+			return true;
+		}
+
+		//---------------------------------------------------------------------
+		uint32_t JobSystem::GetWorkerCount() const
+		{
+			return static_cast<uint32_t>(m_aWorkers.size());
+		}
+
+		//---------------------------------------------------------------------
+		uint32_t JobSystem::GetCurrentWorkerIndex() const
+		{
+			return t_pWorkerJobSystem == this ? t_iWorkerIndex : INVALID_WORKER;
+		}
+
+		//---------------------------------------------------------------------
+		size_t JobSystem::GetChunkCount(size_t a_iCount, size_t a_iGranularity) const
+		{
+			if (a_iCount == 0)
+			{
+				return 0;
+			}
+
+			const size_t chunkSize = GetChunkSize(a_iCount, a_iGranularity);
+			return (a_iCount + chunkSize - 1) / chunkSize;
+		}
+
+		//---------------------------------------------------------------------
+		size_t JobSystem::GetChunkSize(size_t a_iCount, size_t a_iGranularity) const
+		{
+			const size_t granularity = std::max<size_t>(a_iGranularity, 1);
+			if (m_aWorkers.empty() || !m_bRunning.load())
+			{
+				return std::max(a_iCount, granularity);
+			}
+
+			const size_t targetChunks = (m_aWorkers.size() + 1) * CHUNKS_PER_THREAD;
+			const size_t chunkSize = (a_iCount + targetChunks - 1) / targetChunks;
+
+			// Round up to whole multiples of the granularity.
+			return std::max(granularity, (chunkSize + granularity - 1) / granularity * granularity);
+		}
+
+		//---------------------------------------------------------------------
+		void JobSystem::WorkerLoop(uint32_t a_iWorkerIndex)
+		{
+			t_pWorkerJobSystem = this;
+			t_iWorkerIndex = a_iWorkerIndex;
+
+			while (true)
+			{
+				Job job;
+				if (FindJob(a_iWorkerIndex, job))
+				{
+					Execute(job);
+					continue;
+				}
+
+				std::unique_lock<std::mutex> lock(m_SleepMutex);
+				m_SleepCondVar.wait(lock, [this]()
+					{
+						return m_iQueuedJobs.load(std::memory_order_acquire) > 0 || !m_bRunning.load();
+					});
+
+				if (!m_bRunning.load())
+				{
+					return;
+				}
+			}
+		}
+
+		//---------------------------------------------------------------------
+		bool JobSystem::FindJob(uint32_t a_iWorkerIndex, Job& a_Job)
+		{
+			if (m_iQueuedJobs.load(std::memory_order_acquire) == 0)
+			{
+				return false;
+			}
+
+			// Own queue first, newest job first since its data is most likely still in cache.
+			if (a_iWorkerIndex != INVALID_WORKER)
+			{
+				WorkQueue& queue = *m_aWorkQueues[a_iWorkerIndex];
+				std::lock_guard<std::mutex> lock(queue.m_Mutex);
+				if (!queue.m_aJobs.empty())
+				{
+					a_Job = std::move(queue.m_aJobs.back());
+					queue.m_aJobs.pop_back();
+					m_iQueuedJobs.fetch_sub(1, std::memory_order_relaxed);
+					return true;
+				}
+			}
+
+			{
+				std::lock_guard<std::mutex> lock(m_SharedQueue.m_Mutex);
+				if (!m_SharedQueue.m_aJobs.empty())
+				{
+					a_Job = std::move(m_SharedQueue.m_aJobs.front());
+					m_SharedQueue.m_aJobs.pop_front();
+					m_iQueuedJobs.fetch_sub(1, std::memory_order_relaxed);
+					return true;
+				}
+			}
+
+			// Steal the oldest job of another worker, starting at the next worker so thieves spread out.
+			const uint32_t workerCount = static_cast<uint32_t>(m_aWorkQueues.size());
+			const uint32_t start = a_iWorkerIndex != INVALID_WORKER ? a_iWorkerIndex + 1 : 0;
+			for (uint32_t i = 0; i < workerCount; i++)
+			{
+				const uint32_t victim = (start + i) % workerCount;
+				if (victim == a_iWorkerIndex)
+				{
+					continue;
+				}
+
+				WorkQueue& queue = *m_aWorkQueues[victim];
+				std::lock_guard<std::mutex> lock(queue.m_Mutex);
+				if (!queue.m_aJobs.empty())
+				{
+					a_Job = std::move(queue.m_aJobs.front());
+					queue.m_aJobs.pop_front();
+					m_iQueuedJobs.fetch_sub(1, std::memory_order_relaxed);
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		//---------------------------------------------------------------------
+		void JobSystem::Execute(Job& a_Job)
+		{
+			a_Job.m_Function();
+
+			if (a_Job.m_pCounter)
+			{
+				a_Job.m_pCounter->m_iPending.fetch_sub(1, std::memory_order_acq_rel);
+			}
+		}
+	}
+}
\ No newline at end of file
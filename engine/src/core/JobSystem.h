@@ -0,0 +1,197 @@
+#pragma once
+
+#include "core/System.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace gallus
+{
+	namespace core
+	{
+		//---------------------------------------------------------------------
+		// JobCounter
+		//---------------------------------------------------------------------
+		/// <summary>
+		/// Counts the jobs that are still running for a group of jobs, so the group can be waited on.
+		/// </summary>
+		struct JobCounter
+		{
+			std::atomic<uint32_t> m_iPending{ 0 }; /// Number of jobs that have not finished yet.
+
+			/// <summary>
+			/// Checks whether all jobs in the group have finished.
+			/// </summary>
+			/// <returns>True if no jobs are pending, otherwise false.</returns>
+			bool IsDone() const
+			{
+				return m_iPending.load(std::memory_order_acquire) == 0;
+			}
+		};
+
+		//---------------------------------------------------------------------
+		// JobSystem
+		//---------------------------------------------------------------------
+		/// <summary>
+		/// Work-stealing pool of worker threads that execute small jobs. Every worker has its own queue;
+		/// jobs scheduled from a worker go to that worker's queue and idle workers steal from the others.
+		/// Threads that wait on a job counter help executing jobs until the counter reaches zero.
+		/// </summary>
+		class JobSystem : public System
+		{
+		public:
+			static constexpr uint32_t INVALID_WORKER = UINT32_MAX;
+
+			/// <summary>
+			/// Initializes the system, starting one worker per hardware thread except the calling one.
+			/// </summary>
+			/// <returns>True if the initialization was successful, otherwise false.</returns>
+			bool Initialize() override;
+
+			/// <summary>
+			/// Initializes the system with a specific number of workers.
+			/// </summary>
+			/// <param name="a_iWorkerCount">The number of worker threads. With 0 workers, jobs run on the threads that wait on them.</param>
+			/// <returns>True if the initialization was successful, otherwise false.</returns>
+			bool Initialize(uint32_t a_iWorkerCount);
+
+			/// <summary>
+			/// Destroys the system, finishing the queued jobs and joining the workers.
+			/// </summary>
+			/// <returns>True if the destruction was successful, otherwise false.</returns>
+			bool Destroy() override;
+
+			/// <summary>
+			/// Queues a job for execution.
+			/// </summary>
+			/// <param name="a_Job">The job.</param>
+			/// <param name="a_pCounter">Optional counter that gets incremented now and decremented when the job finished.</param>
+			void Schedule(std::function<void()> a_Job, JobCounter* a_pCounter = nullptr);
+
+			/// <summary>
+			/// Waits until all jobs of a counter have finished, executing queued jobs in the meantime.
+			/// </summary>
+			/// <param name="a_Counter">The counter to wait on.</param>
+			void Wait(const JobCounter& a_Counter);
+
+			/// <summary>
+			/// Executes a single queued job on the calling thread, if there is one.
+			/// </summary>
+			/// <returns>True if a job was executed, otherwise false.</returns>
+			bool TryExecuteJob();
+
+			/// <summary>
+			/// Retrieves the number of worker threads.
+			/// </summary>
+			/// <returns>The number of worker threads.</returns>
+			uint32_t GetWorkerCount() const;
+
+			/// <summary>
+			/// Retrieves the index of the worker the calling thread belongs to.
+			/// </summary>
+			/// <returns>The worker index, or INVALID_WORKER if the calling thread is not one of the workers.</returns>
+			uint32_t GetCurrentWorkerIndex() const;
+
+			/// <summary>
+			/// Splits the range [0, a_iCount) into chunks and runs a function on every chunk, in parallel.
+			/// Returns once all chunks have been processed. The calling thread processes chunks as well.
+			/// </summary>
+			/// <param name="a_iCount">The number of elements in the range.</param>
+			/// <param name="a_iGranularity">Chunk sizes are a multiple of this (except for the last chunk).</param>
+			/// <param name="a_Function">Function that gets called with the chunk index, first element and end of every chunk.</param>
+			template <class Function>
+			void ParallelFor(size_t a_iCount, size_t a_iGranularity, Function&& a_Function)
+			{
+				const size_t chunkSize = GetChunkSize(a_iCount, a_iGranularity);
+				const size_t chunkCount = GetChunkCount(a_iCount, a_iGranularity);
+				if (chunkCount <= 1)
+				{
+					if (a_iCount > 0)
+					{
+						a_Function(size_t(0), size_t(0), a_iCount);
+					}
+					return;
+				}
+
+				JobCounter counter;
+				for (size_t chunk = 1; chunk < chunkCount; chunk++)
+				{
+					Schedule([&a_Function, chunk, chunkSize, a_iCount]()
+						{
+							const size_t begin = chunk * chunkSize;
+							a_Function(chunk, begin, std::min(begin + chunkSize, a_iCount));
+						}, &counter);
+				}
+
+				// The first chunk is processed right away instead of being queued.
+				a_Function(size_t(0), size_t(0), std::min(chunkSize, a_iCount));
+
+				Wait(counter);
+			}
+
+			/// <summary>
+			/// Retrieves the number of chunks ParallelFor splits a range into.
+			/// </summary>
+			/// <param name="a_iCount">The number of elements in the range.</param>
+			/// <param name="a_iGranularity">Chunk sizes are a multiple of this.</param>
+			/// <returns>The number of chunks.</returns>
+			size_t GetChunkCount(size_t a_iCount, size_t a_iGranularity) const;
+		private:
+			/// <summary>
+			/// Retrieves the size of the chunks ParallelFor splits a range into.
+			/// </summary>
+			/// <param name="a_iCount">The number of elements in the range.</param>
+			/// <param name="a_iGranularity">Chunk sizes are a multiple of this.</param>
+			/// <returns>The number of elements per chunk.</returns>
+			size_t GetChunkSize(size_t a_iCount, size_t a_iGranularity) const;
+
+			struct Job
+			{
+				std::function<void()> m_Function;
+				JobCounter* m_pCounter = nullptr;
+			};
+
+			/// <summary>
+			/// Job queue of a single worker. The owner pushes and pops at the back, thieves take from the front.
+			/// </summary>
+			struct WorkQueue
+			{
+				std::deque<Job> m_aJobs;
+				std::mutex m_Mutex;
+			};
+
+			/// <summary>
+			/// Entry point of the worker threads.
+			/// </summary>
+			/// <param name="a_iWorkerIndex">The index of the worker.</param>
+			void WorkerLoop(uint32_t a_iWorkerIndex);
+
+			/// <summary>
+			/// Finds a job for a thread: first from its own queue, then from the shared queue, then by stealing from other workers.
+			/// </summary>
+			/// <param name="a_iWorkerIndex">The index of the worker looking for a job, or INVALID_WORKER.</param>
+			/// <param name="a_Job">The job that was found.</param>
+			/// <returns>True if a job was found, otherwise false.</returns>
+			bool FindJob(uint32_t a_iWorkerIndex, Job& a_Job);
+
+			/// <summary>
+			/// Executes a job and signals its counter.
+			/// </summary>
+			/// <param name="a_Job">The job.</param>
+			void Execute(Job& a_Job);
+
+			std::vector<std::thread> m_aWorkers;
+			std::vector<std::unique_ptr<WorkQueue>> m_aWorkQueues; /// One queue per worker.
+			WorkQueue m_SharedQueue; /// Jobs scheduled from threads that are not workers.
+			std::atomic<uint32_t> m_iQueuedJobs{ 0 }; /// Jobs that have been queued but not picked up yet.
+
+			std::mutex m_SleepMutex;
+			std::condition_variable m_SleepCondVar; /// Wakes up workers when jobs get queued.
+		};
+	}
+}
\ No newline at end of file
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <new>
+#include <numeric>
 
 namespace gallus
 {
@@ -20,6 +23,62 @@ namespace gallus
 #define _128MB _MB(128)
 #define _256MB _MB(256)
 
+		constexpr size_t CACHE_LINE_SIZE = 64;
+
+		/// <summary>
+		/// Wraps a value so it occupies its own cache line(s), avoiding false sharing when neighbouring values are written by different threads.
+		/// </summary>
+		/// <typeparam name="T">The type of the value.</typeparam>
+		template<typename T>
+		struct alignas(CACHE_LINE_SIZE) CacheAligned
+		{
+			T m_Value;
+		};
+
+		/// <summary>
+		/// Allocates arrays that start at a cache line, so ranges of whole cache lines can be split between threads.
+		/// </summary>
+		/// <typeparam name="T">The element type.</typeparam>
+		template<typename T>
+		struct CacheAlignedAllocator
+		{
+			using value_type = T;
+
+			CacheAlignedAllocator() = default;
+
+			template<typename U>
+			CacheAlignedAllocator(const CacheAlignedAllocator<U>&)
+			{}
+
+			T* allocate(size_t a_iCount)
+			{
+				return static_cast<T*>(::operator new(a_iCount * sizeof(T), std::align_val_t(CACHE_LINE_SIZE)));
+			}
+
+			void deallocate(T* a_pData, size_t)
+			{
+				::operator delete(a_pData, std::align_val_t(CACHE_LINE_SIZE));
+			}
+
+			template<typename U>
+			bool operator==(const CacheAlignedAllocator<U>&) const
+			{
+				return true;
+			}
+		};
+
+		/// <summary>
+		/// Retrieves the smallest number of elements of a type that fills whole cache lines. Ranges of a cache-aligned array
+		/// that start at a multiple of it start at the beginning of a cache line.
+		/// </summary>
+		/// <typeparam name="T">The element type.</typeparam>
+		/// <returns>The number of elements, at least 1.</returns>
+		template<typename T>
+		constexpr size_t CacheLineGranularity()
+		{
+			return std::lcm(sizeof(T), CACHE_LINE_SIZE) / sizeof(T);
+		}
+
 		/// <summary>
 		/// Adds specific size to a pointer.
 		/// </summary>
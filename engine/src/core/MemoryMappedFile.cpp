@@ -0,0 +1,116 @@
+#include "core/MemoryMappedFile.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif // _WIN32
+
+#include "logger/Logger.h"
+
+namespace gallus
+{
+	namespace core
+	{
+		//---------------------------------------------------------------------
+		// MemoryMappedFile
+		//---------------------------------------------------------------------
+		MemoryMappedFile::~MemoryMappedFile()
+		{
+			Close();
+		}
+
+		//---------------------------------------------------------------------
+		bool MemoryMappedFile::Open(const fs::path& a_Path)
+		{
+			Close();
+
+#ifdef _WIN32
+			HANDLE file = CreateFileW(a_Path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+			if (file == INVALID_HANDLE_VALUE)
+			{
+				LOGF(LOGSEVERITY_ERROR, LOG_CATEGORY_ENGINE, "Failed opening file for mapping: \"%s\".", a_Path.generic_string().c_str());
+				return false;
+			}
+
+			LARGE_INTEGER size = {};
+			if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+			{
+				LOGF(LOGSEVERITY_ERROR, LOG_CATEGORY_ENGINE, "Cannot map empty file: \"%s\".", a_Path.generic_string().c_str());
+				CloseHandle(file);
+				return false;
+			}
+
+			HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+			if (!view)
+			{
+				LOGF(LOGSEVERITY_ERROR, LOG_CATEGORY_ENGINE, "Failed mapping file: \"%s\".", a_Path.generic_string().c_str());
+				if (mapping)
+				{
+					CloseHandle(mapping);
+				}
+				CloseHandle(file);
+				return false;
+			}
+
+			m_pFile = file;
+			m_pMapping = mapping;
+			m_pData = static_cast<const uint8_t*>(view);
+			m_iSize = static_cast<size_t>(size.QuadPart);
+#else
+			int file = open(a_Path.c_str(), O_RDONLY);
+			if (file < 0)
+			{
+				LOGF(LOGSEVERITY_ERROR, LOG_CATEGORY_ENGINE, "Failed opening file for mapping: \"%s\".", a_Path.generic_string().c_str());
+				return false;
+			}
+
+			struct stat status = {};
+			if (fstat(file, &status) != 0 || status.st_size == 0)
+			{
+				LOGF(LOGSEVERITY_ERROR, LOG_CATEGORY_ENGINE, "Cannot map empty file: \"%s\".", a_Path.generic_string().c_str());
+				close(file);
+				return false;
+			}
+
+			// The mapping keeps its own reference to the file, so the descriptor is not needed anymore.
+			void* view = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+			close(file);
+			if (view == MAP_FAILED)
+			{
+				LOGF(LOGSEVERITY_ERROR, LOG_CATEGORY_ENGINE, "Failed mapping file: \"%s\".", a_Path.generic_string().c_str());
+				return false;
+			}
+
+			m_pData = static_cast<const uint8_t*>(view);
+			m_iSize = static_cast<size_t>(status.st_size);
+#endif // _WIN32
+			return true;
+		}
+
+		//---------------------------------------------------------------------
+		void MemoryMappedFile::Close()
+		{
+			if (!m_pData)
+			{
+				return;
+			}
+
+#ifdef _WIN32
+			UnmapViewOfFile(m_pData);
+			CloseHandle(m_pMapping);
+			CloseHandle(m_pFile);
+			m_pMapping = nullptr;
+			m_pFile = nullptr;
+#else
+			munmap(const_cast<uint8_t*>(m_pData), m_iSize);
+#endif // _WIN32
+			m_pData = nullptr;
+			m_iSize = 0;
+		}
+	}
+}
\ No newline at end of file
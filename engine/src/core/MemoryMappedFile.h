@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "utils/file_abstractions.h"
+
+namespace gallus
+{
+	namespace core
+	{
+		//---------------------------------------------------------------------
+		// MemoryMappedFile
+		//---------------------------------------------------------------------
+		/// <summary>
+		/// Maps a whole file read-only into the address space. Pages are read by the operating system on first access,
+		/// so opening a large file costs nothing until its contents are used.
+		/// </summary>
+		class MemoryMappedFile
+		{
+		public:
+			MemoryMappedFile() = default;
+			MemoryMappedFile(const MemoryMappedFile&) = delete;
+			MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+			~MemoryMappedFile();
+
+			/// <summary>
+			/// Maps a file, unmapping the previous one.
+			/// </summary>
+			/// <param name="a_Path">Path to the file.</param>
+			/// <returns>True if the file was mapped, otherwise false. Empty files cannot be mapped.</returns>
+			bool Open(const fs::path& a_Path);
+
+			/// <summary>
+			/// Unmaps the file. Pointers into it become invalid.
+			/// </summary>
+			void Close();
+
+			/// <summary>
+			/// Retrieves the mapped contents.
+			/// </summary>
+			/// <returns>Pointer to the first byte, or nullptr if no file is mapped.</returns>
+			const uint8_t* GetData() const
+			{
+				return m_pData;
+			}
+
+			/// <summary>
+			/// Retrieves the size of the mapped file.
+			/// </summary>
+			/// <returns>The size in bytes.</returns>
+			size_t GetSize() const
+			{
+				return m_iSize;
+			}
+
+			/// <summary>
+			/// Checks whether a file is mapped.
+			/// </summary>
+			/// <returns>True if a file is mapped, otherwise false.</returns>
+			bool IsOpen() const
+			{
+				return m_pData != nullptr;
+			}
+		private:
+			const uint8_t* m_pData = nullptr;
+			size_t m_iSize = 0;
+#ifdef _WIN32
+			void* m_pFile = nullptr; /// Handle of the file.
+			void* m_pMapping = nullptr; /// Handle of the file mapping object.
+#endif // _WIN32
+		};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,165 @@
+#include "core/PakFile.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "core/Compression.h"
+#include "core/Hash.h"
+#include "logger/Logger.h"
+
+namespace gallus
+{
+	namespace core
+	{
+		//---------------------------------------------------------------------
+		uint64_t HashPakEntryName(const std::string& a_sName)
+		{
+			return HashFNV1a(a_sName.data(), a_sName.size());
+		}
+
+		//---------------------------------------------------------------------
+		// PakFile
+		//---------------------------------------------------------------------
+		bool PakFile::Open(const fs::path& a_Path)
+		{
+			Close();
+
+			if (!m_File.Open(a_Path))
+			{
+				return false;
+			}
+
+			const uint8_t* data = m_File.GetData();
+			const uint64_t size = m_File.GetSize();
+
+			PakHeader header;
+			if (size < sizeof(header))
+			{
+				LOGF(LOGSEVERITY_ERROR, LOG_CATEGORY_ENGINE, "Archive is too small: \"%s\".", a_Path.generic_string().c_str());
+				m_File.Close();
+				return false;
+			}
+			memcpy(&header, data, sizeof(header));
+
+			if (header.m_iMagic != g_iPakMagic || header.m_iVersion != g_iPakVersion)
+			{
+				LOGF(LOGSEVERITY_ERROR, LOG_CATEGORY_ENGINE, "Not an archive of version %u: \"%s\".", g_iPakVersion, a_Path.generic_string().c_str());
+				m_File.Close();
+				return false;
+			}
+
+			// Everything the table of contents points at is checked once here, so lookups can trust it.
+			const uint64_t tocSize = static_cast<uint64_t>(header.m_iEntryCount) * sizeof(PakEntry);
+			if (header.m_iTocOffset % alignof(PakEntry) != 0 || header.m_iTocOffset > size || tocSize > size - header.m_iTocOffset ||
+				header.m_iNamesOffset > size || header.m_iNamesSize > size - header.m_iNamesOffset)
+			{
+				LOGF(LOGSEVERITY_ERROR, LOG_CATEGORY_ENGINE, "Archive has a malformed table of contents: \"%s\".", a_Path.generic_string().c_str());
+				m_File.Close();
+				return false;
+			}
+
+			const PakEntry* entries = reinterpret_cast<const PakEntry*>(data + header.m_iTocOffset);
+			for (uint32_t i = 0; i < header.m_iEntryCount; i++)
+			{
+				const PakEntry& entry = entries[i];
+				const bool validContents = entry.m_iOffset <= size && entry.m_iStoredSize <= size - entry.m_iOffset;
+				const bool validName = static_cast<uint64_t>(entry.m_iNameOffset) + entry.m_iNameSize <= header.m_iNamesSize;
+				const bool validCompression = entry.m_Compression == PakCompression::LZ || (entry.m_Compression == PakCompression::None && entry.m_iStoredSize == entry.m_iSize);
+				const bool sorted = i == 0 || entries[i - 1].m_iHash <= entry.m_iHash;
+				if (!validContents || !validName || !validCompression || !sorted)
+				{
+					LOGF(LOGSEVERITY_ERROR, LOG_CATEGORY_ENGINE, "Archive has a malformed entry %u: \"%s\".", i, a_Path.generic_string().c_str());
+					m_File.Close();
+					return false;
+				}
+			}
+
+			m_pEntries = entries;
+			m_pNames = reinterpret_cast<const char*>(data + header.m_iNamesOffset);
+			m_iEntryCount = header.m_iEntryCount;
+
+			LOGF(LOGSEVERITY_INFO_SUCCESS, LOG_CATEGORY_ENGINE, "Opened archive with %u entries: \"%s\".", m_iEntryCount, a_Path.generic_string().c_str());
+			return true;
+		}
+
+		//---------------------------------------------------------------------
+		void PakFile::Close()
+		{
+			m_File.Close();
+			m_pEntries = nullptr;
+			m_pNames = nullptr;
+			m_iEntryCount = 0;
+		}
+
+		//---------------------------------------------------------------------
+		const PakEntry* PakFile::FindEntry(const std::string& a_sName) const
+		{
+			if (!m_pEntries)
+			{
+				return nullptr;
+			}
+
+			const uint64_t hash = HashPakEntryName(a_sName);
+			const PakEntry* end = m_pEntries + m_iEntryCount;
+			const PakEntry* entry = std::lower_bound(m_pEntries, end, hash, [](const PakEntry& a_Entry, uint64_t a_iHash)
+			{
+				return a_Entry.m_iHash < a_iHash;
+			});
+
+			// Names with the same hash are next to each other, the name decides.
+			for (; entry != end && entry->m_iHash == hash; entry++)
+			{
+				if (entry->m_iNameSize == a_sName.size() && memcmp(m_pNames + entry->m_iNameOffset, a_sName.data(), a_sName.size()) == 0)
+				{
+					return entry;
+				}
+			}
+			return nullptr;
+		}
+
+		//---------------------------------------------------------------------
+		bool PakFile::Read(const std::string& a_sName, Data& a_Data) const
+		{
+			const PakEntry* entry = FindEntry(a_sName);
+			if (!entry)
+			{
+				return false;
+			}
+
+			const uint8_t* contents = m_File.GetData() + entry->m_iOffset;
+			if (entry->m_Compression == PakCompression::None)
+			{
+				a_Data = Data::CreateView(contents, static_cast<size_t>(entry->m_iSize));
+				return true;
+			}
+
+			if (entry->m_iSize == 0)
+			{
+				a_Data = Data();
+				return entry->m_iStoredSize == 0;
+			}
+
+			// The size comes from the file, an entry that claims more than its contents can hold would allocate for nothing.
+			if (entry->m_iSize > GetMaxDecompressedSizeLZ(static_cast<size_t>(entry->m_iStoredSize)))
+			{
+				LOGF(LOGSEVERITY_ERROR, LOG_CATEGORY_ENGINE, "Archive entry is larger than its compressed contents allow: \"%s\".", a_sName.c_str());
+				return false;
+			}
+
+			Data decompressed(static_cast<size_t>(entry->m_iSize));
+			if (!DecompressLZ(contents, static_cast<size_t>(entry->m_iStoredSize), decompressed.data(), decompressed.size()))
+			{
+				LOGF(LOGSEVERITY_ERROR, LOG_CATEGORY_ENGINE, "Failed decompressing archive entry: \"%s\".", a_sName.c_str());
+				return false;
+			}
+			a_Data = std::move(decompressed);
+			return true;
+		}
+
+		//---------------------------------------------------------------------
+		std::string PakFile::GetEntryName(const PakEntry& a_Entry) const
+		{
+			return std::string(m_pNames + a_Entry.m_iNameOffset, a_Entry.m_iNameSize);
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "core/Data.h"
+#include "core/MemoryMappedFile.h"
+
+namespace gallus
+{
+	namespace core
+	{
+		inline const uint32_t g_iPakMagic = 0x4B415047; /// "GPAK" in little endian.
+		inline const uint32_t g_iPakVersion = 1;
+		inline const uint32_t g_iPakDefaultAlignment = 64;
+
+		/// <summary>
+		/// How the contents of an archive entry are stored.
+		/// </summary>
+		enum class PakCompression : uint32_t
+		{
+			None = 0, /// Stored as is, read without copying.
+			LZ = 1, /// Compressed with CompressLZ, decompressed on read.
+		};
+
+		// Layout of an archive:
+		//   PakHeader
+		//   Entry contents, each starting at a multiple of the alignment.
+		//   PakEntry table of contents, sorted by hash.
+		//   Entry names, not terminated, referenced by the table of contents.
+		// All values are little endian.
+
+		/// <summary>
+		/// Start of an archive.
+		/// </summary>
+		struct PakHeader
+		{
+			uint32_t m_iMagic = g_iPakMagic;
+			uint32_t m_iVersion = g_iPakVersion;
+			uint32_t m_iEntryCount = 0;
+			uint32_t m_iAlignment = g_iPakDefaultAlignment; /// Alignment of the entry contents within the file.
+			uint64_t m_iTocOffset = 0; /// Offset of the table of contents.
+			uint64_t m_iNamesOffset = 0; /// Offset of the entry names.
+			uint64_t m_iNamesSize = 0; /// Size of all entry names in bytes.
+		};
+		static_assert(sizeof(PakHeader) == 40, "The archive header is read straight from the file.");
+
+		/// <summary>
+		/// Table of contents entry of an archive.
+		/// </summary>
+		struct PakEntry
+		{
+			uint64_t m_iHash = 0; /// HashPakEntryName of the name.
+			uint64_t m_iOffset = 0; /// Offset of the contents within the file.
+			uint64_t m_iStoredSize = 0; /// Size of the contents within the file.
+			uint64_t m_iSize = 0; /// Size of the contents once decompressed.
+			uint32_t m_iNameOffset = 0; /// Offset of the name within the names.
+			uint32_t m_iNameSize = 0;
+			PakCompression m_Compression = PakCompression::None;
+			uint32_t m_iPadding = 0;
+		};
+		static_assert(sizeof(PakEntry) == 48, "Archive entries are read straight from the file.");
+
+		/// <summary>
+		/// Hashes the name of an archive entry. Names are paths relative to the resource folder, with forward slashes.
+		/// </summary>
+		/// <param name="a_sName">The name.</param>
+		/// <returns>The 64 bit FNV-1a hash of the name.</returns>
+		uint64_t HashPakEntryName(const std::string& a_sName);
+
+		//---------------------------------------------------------------------
+		// PakFile
+		//---------------------------------------------------------------------
+		/// <summary>
+		/// Reads a packed archive through a memory mapping. The table of contents is used in place and uncompressed entries are
+		/// handed out as views of the mapping, so opening is a single file open and reading an entry does not copy anything.
+		/// Reading is thread safe.
+		/// </summary>
+		class PakFile
+		{
+		public:
+			/// <summary>
+			/// Maps an archive and validates its header and table of contents.
+			/// </summary>
+			/// <param name="a_Path">Path to the archive.</param>
+			/// <returns>True if the archive was opened, otherwise false.</returns>
+			bool Open(const fs::path& a_Path);
+
+			/// <summary>
+			/// Closes the archive. Views handed out by Read become invalid.
+			/// </summary>
+			void Close();
+
+			/// <summary>
+			/// Checks whether an archive is open.
+			/// </summary>
+			/// <returns>True if an archive is open, otherwise false.</returns>
+			bool IsOpen() const
+			{
+				return m_pEntries != nullptr;
+			}
+
+			/// <summary>
+			/// Looks up an entry by name, with a binary search over the hashes.
+			/// </summary>
+			/// <param name="a_sName">Name of the entry.</param>
+			/// <returns>The entry, or nullptr if the archive does not contain it.</returns>
+			const PakEntry* FindEntry(const std::string& a_sName) const;
+
+			/// <summary>
+			/// Reads the contents of an entry. Uncompressed entries become a view of the mapping, which is valid until the
+			/// archive is closed. Compressed entries are decompressed into memory owned by the data.
+			/// </summary>
+			/// <param name="a_sName">Name of the entry.</param>
+			/// <param name="a_Data">Receives the contents.</param>
+			/// <returns>True if the entry was read, otherwise false.</returns>
+			bool Read(const std::string& a_sName, Data& a_Data) const;
+
+			/// <summary>
+			/// Retrieves the name of an entry.
+			/// </summary>
+			/// <param name="a_Entry">The entry.</param>
+			/// <returns>The name.</returns>
+			std::string GetEntryName(const PakEntry& a_Entry) const;
+
+			/// <summary>
+			/// Retrieves the table of contents, sorted by hash.
+			/// </summary>
+			/// <returns>Pointer to the first entry.</returns>
+			const PakEntry* GetEntries() const
+			{
+				return m_pEntries;
+			}
+
+			/// <summary>
+			/// Retrieves the number of entries.
+			/// </summary>
+			/// <returns>The number of entries.</returns>
+			uint32_t GetEntryCount() const
+			{
+				return m_iEntryCount;
+			}
+		private:
+			MemoryMappedFile m_File;
+			const PakEntry* m_pEntries = nullptr; /// Table of contents inside the mapping.
+			const char* m_pNames = nullptr; /// Entry names inside the mapping.
+			uint32_t m_iEntryCount = 0;
+		};
+	}
+}
\ No newline at end of file
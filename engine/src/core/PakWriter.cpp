@@ -0,0 +1,151 @@
+#include "core/PakWriter.h"
+
+#include <algorithm>
+#include <cstdio>
+
+#include "core/Compression.h"
+#include "logger/Logger.h"
+
+namespace gallus
+{
+	namespace core
+	{
+		//---------------------------------------------------------------------
+		// PakWriter
+		//---------------------------------------------------------------------
+		bool PakWriter::AddFile(const std::string& a_sName, const fs::path& a_Path, bool a_bCompress)
+		{
+			Data data;
+			if (!file::LoadFile(a_Path, data))
+			{
+				LOGF(LOGSEVERITY_ERROR, LOG_CATEGORY_ENGINE, "Failed reading file for archive: \"%s\".", a_Path.generic_string().c_str());
+				return false;
+			}
+			return AddData(a_sName, data.data(), data.size(), a_bCompress);
+		}
+
+		//---------------------------------------------------------------------
+		bool PakWriter::AddData(const std::string& a_sName, const void* a_pData, size_t a_iSize, bool a_bCompress)
+		{
+			for (const PendingEntry& entry : m_aEntries)
+			{
+				if (entry.m_sName == a_sName)
+				{
+					LOGF(LOGSEVERITY_ERROR, LOG_CATEGORY_ENGINE, "Archive already contains an entry named \"%s\".", a_sName.c_str());
+					return false;
+				}
+			}
+
+			PendingEntry entry;
+			entry.m_sName = a_sName;
+			entry.m_iHash = HashPakEntryName(a_sName);
+			entry.m_iSize = a_iSize;
+
+			if (a_bCompress && a_iSize > 0)
+			{
+				CompressLZ(a_pData, a_iSize, entry.m_aData);
+				if (entry.m_aData.size() < a_iSize)
+				{
+					entry.m_Compression = PakCompression::LZ;
+				}
+			}
+			if (entry.m_Compression == PakCompression::None)
+			{
+				const uint8_t* data = static_cast<const uint8_t*>(a_pData);
+				entry.m_aData.assign(data, data + a_iSize);
+			}
+
+			m_aEntries.push_back(std::move(entry));
+			return true;
+		}
+
+		//---------------------------------------------------------------------
+		bool PakWriter::Write(const fs::path& a_Path, uint32_t a_iAlignment) const
+		{
+			if (a_iAlignment == 0 || (a_iAlignment & (a_iAlignment - 1)) != 0)
+			{
+				LOGF(LOGSEVERITY_ERROR, LOG_CATEGORY_ENGINE, "Archive alignment %u is not a power of two.", a_iAlignment);
+				return false;
+			}
+
+			std::vector<const PendingEntry*> sorted;
+			sorted.reserve(m_aEntries.size());
+			for (const PendingEntry& entry : m_aEntries)
+			{
+				sorted.push_back(&entry);
+			}
+			std::sort(sorted.begin(), sorted.end(), [](const PendingEntry* a_pA, const PendingEntry* a_pB)
+			{
+				return a_pA->m_iHash != a_pB->m_iHash ? a_pA->m_iHash < a_pB->m_iHash : a_pA->m_sName < a_pB->m_sName;
+			});
+
+			// Lay out the contents first, then the table of contents and names behind them.
+			PakHeader header;
+			header.m_iEntryCount = static_cast<uint32_t>(sorted.size());
+			header.m_iAlignment = a_iAlignment;
+
+			std::vector<PakEntry> toc(sorted.size());
+			std::string names;
+			uint64_t offset = sizeof(PakHeader);
+			for (size_t i = 0; i < sorted.size(); i++)
+			{
+				offset = (offset + a_iAlignment - 1) & ~static_cast<uint64_t>(a_iAlignment - 1);
+
+				PakEntry& entry = toc[i];
+				entry.m_iHash = sorted[i]->m_iHash;
+				entry.m_iOffset = offset;
+				entry.m_iStoredSize = sorted[i]->m_aData.size();
+				entry.m_iSize = sorted[i]->m_iSize;
+				entry.m_iNameOffset = static_cast<uint32_t>(names.size());
+				entry.m_iNameSize = static_cast<uint32_t>(sorted[i]->m_sName.size());
+				entry.m_Compression = sorted[i]->m_Compression;
+
+				names += sorted[i]->m_sName;
+				offset += entry.m_iStoredSize;
+			}
+			header.m_iTocOffset = (offset + alignof(PakEntry) - 1) & ~static_cast<uint64_t>(alignof(PakEntry) - 1);
+			header.m_iNamesOffset = header.m_iTocOffset + toc.size() * sizeof(PakEntry);
+			header.m_iNamesSize = names.size();
+
+			FILE* file = nullptr;
+#ifdef _WIN32
+			fopen_s(&file, a_Path.generic_string().c_str(), "wb");
+#else
+			file = fopen(a_Path.generic_string().c_str(), "wb");
+#endif // _WIN32
+			if (!file)
+			{
+				LOGF(LOGSEVERITY_ERROR, LOG_CATEGORY_ENGINE, "Failed opening archive for writing: \"%s\".", a_Path.generic_string().c_str());
+				return false;
+			}
+
+			const std::vector<uint8_t> padding(std::max<size_t>(a_iAlignment, alignof(PakEntry)), 0);
+			uint64_t position = 0;
+			auto write = [file, &position](const void* a_pData, size_t a_iSize)
+			{
+				position += a_iSize;
+				return a_iSize == 0 || fwrite(a_pData, a_iSize, 1, file) == 1;
+			};
+
+			bool success = write(&header, sizeof(header));
+			for (size_t i = 0; i < sorted.size() && success; i++)
+			{
+				success = write(padding.data(), static_cast<size_t>(toc[i].m_iOffset - position)) && write(sorted[i]->m_aData.data(), sorted[i]->m_aData.size());
+			}
+			success = success && write(padding.data(), static_cast<size_t>(header.m_iTocOffset - position));
+			success = success && write(toc.data(), toc.size() * sizeof(PakEntry));
+			success = success && write(names.data(), names.size());
+
+			fclose(file);
+
+			if (!success)
+			{
+				LOGF(LOGSEVERITY_ERROR, LOG_CATEGORY_ENGINE, "Failed writing archive: \"%s\".", a_Path.generic_string().c_str());
+				return false;
+			}
+
+			LOGF(LOGSEVERITY_INFO_SUCCESS, LOG_CATEGORY_ENGINE, "Wrote archive with %u entries: \"%s\".", header.m_iEntryCount, a_Path.generic_string().c_str());
+			return true;
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "core/PakFile.h"
+
+namespace gallus
+{
+	namespace core
+	{
+		//---------------------------------------------------------------------
+		// PakWriter
+		//---------------------------------------------------------------------
+		/// <summary>
+		/// Collects files in memory and writes them as a packed archive that PakFile can read.
+		/// </summary>
+		class PakWriter
+		{
+		public:
+			/// <summary>
+			/// Adds the contents of a file.
+			/// </summary>
+			/// <param name="a_sName">Name of the entry, a path relative to the resource folder with forward slashes.</param>
+			/// <param name="a_Path">Path to the file.</param>
+			/// <param name="a_bCompress">Whether to compress the contents. They are stored as is if compressing does not make them smaller.</param>
+			/// <returns>True if the file was added, otherwise false.</returns>
+			bool AddFile(const std::string& a_sName, const fs::path& a_Path, bool a_bCompress);
+
+			/// <summary>
+			/// Adds a block of memory.
+			/// </summary>
+			/// <param name="a_sName">Name of the entry, a path relative to the resource folder with forward slashes.</param>
+			/// <param name="a_pData">The contents.</param>
+			/// <param name="a_iSize">Size of the contents in bytes.</param>
+			/// <param name="a_bCompress">Whether to compress the contents. They are stored as is if compressing does not make them smaller.</param>
+			/// <returns>True if the entry was added, false if an entry with the name already exists.</returns>
+			bool AddData(const std::string& a_sName, const void* a_pData, size_t a_iSize, bool a_bCompress);
+
+			/// <summary>
+			/// Writes the archive.
+			/// </summary>
+			/// <param name="a_Path">Path of the archive.</param>
+			/// <param name="a_iAlignment">Alignment of the entry contents within the file, has to be a power of two.</param>
+			/// <returns>True if the archive was written, otherwise false.</returns>
+			bool Write(const fs::path& a_Path, uint32_t a_iAlignment = g_iPakDefaultAlignment) const;
+
+			/// <summary>
+			/// Retrieves the number of entries that were added.
+			/// </summary>
+			/// <returns>The number of entries.</returns>
+			size_t GetEntryCount() const
+			{
+				return m_aEntries.size();
+			}
+		private:
+			/// <summary>
+			/// Entry waiting to be written.
+			/// </summary>
+			struct PendingEntry
+			{
+				std::string m_sName;
+				uint64_t m_iHash = 0;
+				uint64_t m_iSize = 0; /// Size of the contents once decompressed.
+				PakCompression m_Compression = PakCompression::None;
+				std::vector<uint8_t> m_aData; /// The contents as they get stored.
+			};
+
+			std::vector<PendingEntry> m_aEntries;
+		};
+	}
+}
\ No newline at end of file
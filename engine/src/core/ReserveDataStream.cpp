@@ -1,7 +1,7 @@
 #include "core/ReserveDataStream.h"
 
-#include <vcruntime_string.h>
-#include <corecrt_malloc.h>
+#include <cstring>
+#include <cstdlib>
 
 #include "Memory.h"
 
@@ -2,10 +2,20 @@
 
 #include <algorithm>
 
+#include "core/Tool.h"
+#include "logger/Logger.h"
+
+#ifdef _HEADLESS
+#include "graphics/null/Texture.h"
+#include "graphics/null/Shader.h"
+#include "graphics/null/Mesh.h"
+#else
 #include "graphics/dx12/Texture.h"
 #include "graphics/dx12/Shader.h"
 #include "graphics/dx12/Mesh.h"
 #include "graphics/dx12/CommandList.h"
+#include "graphics/dx12/CommandQueue.h"
+#endif // _HEADLESS
 
 namespace gallus
 {
@@ -15,194 +25,471 @@ namespace gallus
 		// ResourceAtlas
 		//---------------------------------------------------------------------
 		template<class T>
-		std::shared_ptr<T> ResourceAtlas::GetResource(std::vector<std::shared_ptr<T>>& a_aVector, const std::string& a_sName, const fs::path& a_Path)
+		ResourceHandle<T> ResourceAtlas::GetResource(ResourcePool<T>& a_Pool, const std::string& a_sName, const fs::path& a_Path)
 		{
-			int32_t index = HasResource(a_aVector, a_sName, a_Path);
+			std::lock_guard<std::mutex> lock(a_Pool.m_Mutex);
+			ResourceHandle<T> handle = HasResource(a_Pool, a_sName, a_Path);
 
-			// Resource exists → Return it immediately.
-			if (index != -1)
+			// Resource exists → Return it immediately. A different name for the same path becomes an alias.
+			if (handle.IsValid())
 			{
-				return a_aVector[index];
+				a_Pool.m_aNames.emplace(a_sName, handle);
+				return handle;
 			}
 
-			// Look for an empty slot.
-			for (size_t i = 0; i < a_aVector.size(); i++)
+			handle = a_Pool.m_Slots.Add(std::make_shared<T>());
+			if (!handle.IsValid())
 			{
-				if (!a_aVector[i])
-				{
-					index = static_cast<int32_t>(i);
-					break;
-				}
+				LOGF(LOGSEVERITY_ERROR, LOG_CATEGORY_ENGINE, "Resource atlas is full, cannot add resource \"%s\".", a_sName.c_str());
+				return handle;
 			}
 
-			// If no empty slots were found, push a new one.
-			if (index == -1)
+			a_Pool.m_aNames[a_sName] = handle;
+			if (!a_Path.empty())
 			{
-				// Check if adding exceeds MAX_RESOURCES
-				if (a_aVector.size() >= MAX_RESOURCES)
-				{
-					return a_aVector[MISSING]; // Return missing resource
-				}
+				a_Pool.m_aPaths[a_Path.generic_string()] = handle;
+			}
 
-				index = static_cast<int32_t>(a_aVector.size());
-				a_aVector.push_back(std::make_shared<T>());
+			return handle;
+		}
+
+		//---------------------------------------------------------------------
+		template<class T>
+		ResourceHandle<T> ResourceAtlas::HasResource(const ResourcePool<T>& a_Pool, const std::string& a_sName, const fs::path& a_Path) const
+		{
+			auto name = a_Pool.m_aNames.find(a_sName);
+			if (name != a_Pool.m_aNames.end())
+			{
+				return name->second;
 			}
-			else
+
+			if (!a_Path.empty())
 			{
-				a_aVector[index] = std::make_shared<T>();
+				auto path = a_Pool.m_aPaths.find(a_Path.generic_string());
+				if (path != a_Pool.m_aPaths.end())
+				{
+					return path->second;
+				}
 			}
 
-			return a_aVector[index];
+			return ResourceHandle<T>();
 		}
 
 		//---------------------------------------------------------------------
 		template<class T>
-		int32_t ResourceAtlas::HasResource(std::vector<std::shared_ptr<T>>& a_aVector, const std::string& a_sName, const fs::path& a_Path)
+		bool ResourceAtlas::UnloadResource(ResourcePool<T>& a_Pool, ResourceHandle<T> a_Handle)
 		{
-			for (size_t i = 0; i < a_aVector.size(); i++)
+			std::shared_ptr<T> resource = nullptr;
 			{
-				if (a_aVector[i])
+				std::lock_guard<std::mutex> lock(a_Pool.m_Mutex);
+				resource = a_Pool.m_Slots.GetShared(a_Handle);
+				if (!a_Pool.m_Slots.Remove(a_Handle))
 				{
-					if (a_aVector[i]->GetName() == a_sName || (!a_Path.empty() && a_Path == a_aVector[i]->GetPath()))
-					{
-						return i;
-					}
+					return false;
 				}
+
+				// Unloading is rare, so the indices are searched instead of keeping reverse lookups around.
+				std::erase_if(a_Pool.m_aNames, [a_Handle](const auto& a_Entry) { return a_Entry.second == a_Handle; });
+				std::erase_if(a_Pool.m_aPaths, [a_Handle](const auto& a_Entry) { return a_Entry.second == a_Handle; });
 			}
-			return -1;
+
+			// The packet of this frame may have been extracted already, so the resource lives until the gpu drew the next one.
+			m_aUnloadedResources.push_back({ TOOL->GetFrameTimer().GetFrameCount(), std::move(resource) });
+			return true;
 		}
 
 		//---------------------------------------------------------------------
-		std::shared_ptr<graphics::dx12::Texture> ResourceAtlas::LoadTexture(const std::string& a_sName, std::shared_ptr<graphics::dx12::CommandList> a_pCommandList)
+		void ResourceAtlas::DecodeTexture(TextureHandle a_Handle, const fs::path& a_Path)
 		{
-			std::shared_ptr<graphics::dx12::Texture> texture = GetResource(m_aTextures, a_sName, fs::path());
-			if (!texture->IsValid())
+			DecodedTexture decoded;
+			decoded.m_Handle = a_Handle;
+			decoded.m_Path = a_Path;
+
+			// Cooked textures only get their header read here, the decoding of other images is what runs on the job.
+			Data file;
+			decoded.m_bDecoded = ReadFile(a_Path, file) && graphics::ReadTextureFile(file, decoded.m_Texture);
+
+			std::lock_guard<std::mutex> lock(m_LoadMutex);
+			m_aDecodedTextures.push_back(std::move(decoded));
+		}
+
+		//---------------------------------------------------------------------
+		TextureHandle ResourceAtlas::LoadTexture(const std::string& a_sName, std::shared_ptr<graphics::backend::CommandList> a_pCommandList)
+		{
+			fs::path texturePath = fs::path(m_sResourceFolder + "/textures/" + a_sName).lexically_normal();
+			TextureHandle handle = GetResource(m_Textures, a_sName, texturePath);
+
+			graphics::backend::Texture* texture = GetTexture(handle);
+			if (texture && !texture->IsValid() && GetTextureState(handle) != ResourceLoadState::Pending)
 			{
-//#ifdef _EDITOR
-				fs::path texturePath = fs::path(m_sResourceFolder + "/textures/" + a_sName).lexically_normal();
-				texture->LoadByPath(texturePath, a_pCommandList);
-//#else
-//				texture->LoadByName(a_sName, a_pCommandList);
-//#endif // _EDITOR
+				const bool loaded = m_Archive.IsOpen() ? texture->LoadByName(a_sName, a_pCommandList) : texture->LoadByPath(texturePath, a_pCommandList);
+
+				std::lock_guard<std::mutex> lock(m_LoadMutex);
+				if (loaded)
+				{
+					m_aFailedTextures.erase(handle.GetValue());
+				}
+				else
+				{
+					m_aFailedTextures.insert(handle.GetValue());
+				}
 			}
-			return texture;
+			return handle;
 		}
 
+#ifndef _HEADLESS
 		//---------------------------------------------------------------------
 		std::shared_ptr<graphics::dx12::Texture> ResourceAtlas::LoadTextureByDescription(const std::string& a_sName, D3D12_RESOURCE_DESC& a_Description)
 		{
-			std::shared_ptr<graphics::dx12::Texture> texture = GetResource(m_aTextures, a_sName, fs::path());
-			if (!texture->IsValid())
+			const TextureHandle handle = GetResource(m_Textures, a_sName, fs::path());
+			std::shared_ptr<graphics::dx12::Texture> texture = nullptr;
+			{
+				std::lock_guard<std::mutex> lock(m_Textures.m_Mutex);
+				texture = m_Textures.m_Slots.GetShared(handle);
+			}
+			if (texture && !texture->IsValid())
 			{
 				texture->LoadByName(a_sName, a_Description);
 			}
 			return texture;
 		}
+#endif // _HEADLESS
 
 		//---------------------------------------------------------------------
-		std::shared_ptr<graphics::dx12::Texture> ResourceAtlas::LoadTextureEmpty(const std::string& a_sName)
+		TextureHandle ResourceAtlas::LoadTextureEmpty(const std::string& a_sName)
 		{
-			std::shared_ptr<graphics::dx12::Texture> texture = GetResource(m_aTextures, a_sName, fs::path());
-			return texture;
+			return GetResource(m_Textures, a_sName, fs::path());
+		}
+
+		//---------------------------------------------------------------------
+		TextureHandle ResourceAtlas::LoadTextureAsync(const std::string& a_sName)
+		{
+			fs::path texturePath = fs::path(m_sResourceFolder + "/textures/" + a_sName).lexically_normal();
+			TextureHandle handle = GetResource(m_Textures, a_sName, texturePath);
+
+			graphics::backend::Texture* texture = GetTexture(handle);
+			if (!texture || texture->IsValid())
+			{
+				return handle;
+			}
+
+			{
+				std::lock_guard<std::mutex> lock(m_LoadMutex);
+				if (!m_aLoadingTextures.insert(handle.GetValue()).second)
+				{
+					return handle;
+				}
+				m_aFailedTextures.erase(handle.GetValue());
+			}
+
+			// Without workers, scheduled jobs only run while somebody waits, so the texture is decoded right away.
+			JobSystem& jobSystem = TOOL->GetJobSystem();
+			if (jobSystem.GetWorkerCount() == 0)
+			{
+				DecodeTexture(handle, texturePath);
+			}
+			else
+			{
+				jobSystem.Schedule([this, handle, texturePath]()
+				{
+					DecodeTexture(handle, texturePath);
+				}, &m_DecodeJobs);
+			}
+			return handle;
+		}
+
+		//---------------------------------------------------------------------
+		ResourceLoadState ResourceAtlas::GetTextureState(TextureHandle a_Handle)
+		{
+			{
+				std::lock_guard<std::mutex> lock(m_LoadMutex);
+				if (m_aLoadingTextures.contains(a_Handle.GetValue()))
+				{
+					return ResourceLoadState::Pending;
+				}
+				if (m_aFailedTextures.contains(a_Handle.GetValue()))
+				{
+					return ResourceLoadState::Failed;
+				}
+			}
+
+			const graphics::backend::Texture* texture = GetTexture(a_Handle);
+			return texture && texture->IsValid() ? ResourceLoadState::Ready : ResourceLoadState::Failed;
+		}
+
+		//---------------------------------------------------------------------
+		void ResourceAtlas::Update()
+		{
+			const uint64_t completedFrame = m_iCompletedFrame.load();
+			size_t releasedCount = 0;
+			while (releasedCount < m_aUnloadedResources.size() && m_aUnloadedResources[releasedCount].m_iFrame < completedFrame)
+			{
+				releasedCount++;
+			}
+			m_aUnloadedResources.erase(m_aUnloadedResources.begin(), m_aUnloadedResources.begin() + releasedCount);
+
+			std::vector<DecodedTexture> decodedTextures;
+			{
+				std::lock_guard<std::mutex> lock(m_LoadMutex);
+				decodedTextures.swap(m_aDecodedTextures);
+			}
+
+			if (decodedTextures.empty())
+			{
+				return;
+			}
+
+#ifdef _HEADLESS
+			// The null backend has nothing to upload, so textures are ready as soon as they are decoded.
+			std::shared_ptr<graphics::backend::CommandList> cCommandList = nullptr;
+#else
+			std::shared_ptr<graphics::dx12::CommandQueue> cCommandQueue = TOOL->GetDX12().GetCommandQueue(D3D12_COMMAND_LIST_TYPE_COPY);
+			std::shared_ptr<graphics::dx12::CommandList> cCommandList = cCommandQueue->GetCommandList();
+			UploadBatch batch;
+#endif // _HEADLESS
+
+			std::vector<TextureHandle> failedTextures;
+			for (const DecodedTexture& decoded : decodedTextures)
+			{
+				graphics::backend::Texture* texture = GetTexture(decoded.m_Handle);
+				if (!texture || !decoded.m_bDecoded || !texture->LoadFromData(decoded.m_Path, decoded.m_Texture, cCommandList))
+				{
+					LOGF(LOGSEVERITY_ERROR, LOG_CATEGORY_ENGINE, "Failed to load texture: \"%s\".", decoded.m_Path.generic_string().c_str());
+					failedTextures.push_back(decoded.m_Handle);
+					continue;
+				}
+#ifndef _HEADLESS
+				batch.m_aTextures.push_back(decoded.m_Handle);
+#endif // _HEADLESS
+			}
+
+#ifdef _HEADLESS
+			std::lock_guard<std::mutex> lock(m_LoadMutex);
+			for (const DecodedTexture& decoded : decodedTextures)
+			{
+				m_aLoadingTextures.erase(decoded.m_Handle.GetValue());
+			}
+			for (TextureHandle handle : failedTextures)
+			{
+				m_aFailedTextures.insert(handle.GetValue());
+			}
+#else
+			// One execute for every texture that finished decoding this frame, nobody waits on it.
+			batch.m_iFenceValue = cCommandQueue->ExecuteCommandList(cCommandList);
+
+			std::lock_guard<std::mutex> lock(m_LoadMutex);
+			for (TextureHandle handle : failedTextures)
+			{
+				m_aLoadingTextures.erase(handle.GetValue());
+				m_aFailedTextures.insert(handle.GetValue());
+			}
+			m_aUploadBatches.push_back(std::move(batch));
+#endif // _HEADLESS
+		}
+
+		//---------------------------------------------------------------------
+		void ResourceAtlas::WaitForAsyncLoads()
+		{
+			TOOL->GetJobSystem().Wait(m_DecodeJobs);
+			Update();
+		}
+
+		//---------------------------------------------------------------------
+		bool ResourceAtlas::MountArchive(const fs::path& a_Path)
+		{
+			return m_Archive.Open(a_Path);
+		}
+
+		//---------------------------------------------------------------------
+		bool ResourceAtlas::ReadFile(const fs::path& a_Path, Data& a_Data) const
+		{
+			if (m_Archive.IsOpen())
+			{
+				const fs::path name = a_Path.lexically_normal().lexically_relative(fs::path(m_sResourceFolder).lexically_normal());
+				if (!name.empty() && m_Archive.Read(name.generic_string(), a_Data))
+				{
+					return true;
+				}
+			}
+			return file::LoadFile(a_Path, a_Data);
 		}
 
 		//---------------------------------------------------------------------
 		bool ResourceAtlas::HasTexture(const std::string& a_sName)
 		{
-			return HasResource(m_aTextures, a_sName, fs::path());
+			std::lock_guard<std::mutex> lock(m_Textures.m_Mutex);
+			return HasResource(m_Textures, a_sName, fs::path()).IsValid();
 		}
 
 		//---------------------------------------------------------------------
-		std::shared_ptr<graphics::dx12::Shader> ResourceAtlas::LoadShader(const std::string& a_sVertexShader, const std::string& a_sPixelShader)
+		ShaderHandle ResourceAtlas::LoadShader(const std::string& a_sVertexShader, const std::string& a_sPixelShader)
 		{
-			std::shared_ptr<graphics::dx12::Shader> shader = GetResource(m_aShaders, a_sVertexShader, fs::path());
-			if (!shader->IsValid())
+			fs::path vertexShaderPath = fs::path(m_sResourceFolder + "/shaders/" + a_sVertexShader).lexically_normal();
+			fs::path pixelShaderPath = fs::path(m_sResourceFolder + "/shaders/" + a_sPixelShader).lexically_normal();
+			ShaderHandle handle = GetResource(m_Shaders, a_sVertexShader, fs::path());
+
+			graphics::backend::Shader* shader = GetShader(handle);
+			if (shader && !shader->IsValid())
 			{
 //#ifdef _EDITOR
-				fs::path vertexShaderPath = fs::path(m_sResourceFolder + "/shaders/" + a_sVertexShader).lexically_normal();
-				fs::path pixelShaderPath = fs::path(m_sResourceFolder + "/shaders/" + a_sPixelShader).lexically_normal();
-//
 				shader->LoadByPath(vertexShaderPath, pixelShaderPath);
 //#else
 //				shader->LoadByName(a_sVertexShader, a_sPixelShader);
 //#endif // _EDITOR
 			}
-			return shader;
+			return handle;
 		}
 
 		//---------------------------------------------------------------------
 		bool ResourceAtlas::HasShader(const std::string& a_sName)
 		{
-			return HasResource(m_aShaders, a_sName, fs::path());
+			std::lock_guard<std::mutex> lock(m_Shaders.m_Mutex);
+			return HasResource(m_Shaders, a_sName, fs::path()).IsValid();
 		}
 
 		//---------------------------------------------------------------------
-		std::shared_ptr<graphics::dx12::Mesh> ResourceAtlas::LoadMesh(const std::string& a_sName, std::shared_ptr<graphics::dx12::CommandList> a_pCommandList)
+		MeshHandle ResourceAtlas::LoadMesh(const std::string& a_sName, std::shared_ptr<graphics::backend::CommandList> a_pCommandList)
 		{
-			std::shared_ptr<graphics::dx12::Mesh> mesh = GetResource(m_aMeshes, a_sName, fs::path());
-			if (!mesh->IsValid())
+			MeshHandle handle = GetResource(m_Meshes, a_sName, fs::path());
+
+			graphics::backend::Mesh* mesh = GetMesh(handle);
+			if (mesh && !mesh->IsValid())
 			{
 				mesh->LoadByName(a_sName, a_pCommandList);
 			}
-			return mesh;
+			return handle;
 		}
 
 		//---------------------------------------------------------------------
 		bool ResourceAtlas::HasMesh(const std::string& a_sName)
 		{
-			return HasResource(m_aMeshes, a_sName, fs::path());
+			std::lock_guard<std::mutex> lock(m_Meshes.m_Mutex);
+			return HasResource(m_Meshes, a_sName, fs::path()).IsValid();
 		}
 
 		//---------------------------------------------------------------------
-		std::shared_ptr<graphics::dx12::Shader> ResourceAtlas::GetDefaultShader()
+		bool ResourceAtlas::UnloadTexture(TextureHandle a_Handle)
 		{
-			return m_aShaders[MISSING];
+			{
+				std::lock_guard<std::mutex> lock(m_LoadMutex);
+				m_aFailedTextures.erase(a_Handle.GetValue());
+			}
+			return UnloadResource(m_Textures, a_Handle);
 		}
 
 		//---------------------------------------------------------------------
-		std::shared_ptr<graphics::dx12::Texture> ResourceAtlas::GetDefaultTexture()
+		bool ResourceAtlas::UnloadShader(ShaderHandle a_Handle)
 		{
-#ifdef _EDITOR
-			return m_aTextures[MISSING + 1];
-#else
-			return m_aTextures[MISSING];
-#endif // _EDITOR
+			return UnloadResource(m_Shaders, a_Handle);
 		}
 
 		//---------------------------------------------------------------------
-		std::shared_ptr<graphics::dx12::Mesh> ResourceAtlas::GetDefaultMesh()
+		bool ResourceAtlas::UnloadMesh(MeshHandle a_Handle)
 		{
-			return m_aMeshes[MISSING];
+			return UnloadResource(m_Meshes, a_Handle);
 		}
 
+		//---------------------------------------------------------------------
+		void ResourceAtlas::SetCompletedFrame(uint64_t a_iFrame)
+		{
+			// A packet that is drawn again is older than the latest one the gpu finished.
+			if (a_iFrame > m_iCompletedFrame.load())
+			{
+				m_iCompletedFrame.store(a_iFrame);
+			}
+		}
+
+		//---------------------------------------------------------------------
+		graphics::backend::Texture* ResourceAtlas::GetTexture(TextureHandle a_Handle) const
+		{
+			return m_Textures.m_Slots.Get(a_Handle);
+		}
+
+		//---------------------------------------------------------------------
+		graphics::backend::Shader* ResourceAtlas::GetShader(ShaderHandle a_Handle) const
+		{
+			return m_Shaders.m_Slots.Get(a_Handle);
+		}
+
+		//---------------------------------------------------------------------
+		graphics::backend::Mesh* ResourceAtlas::GetMesh(MeshHandle a_Handle) const
+		{
+			return m_Meshes.m_Slots.Get(a_Handle);
+		}
+
+		//---------------------------------------------------------------------
+		void ResourceAtlas::SetDefaultResources(TextureHandle a_Texture, ShaderHandle a_Shader, MeshHandle a_Mesh)
+		{
+			m_DefaultTexture = a_Texture;
+			m_DefaultShader = a_Shader;
+			m_DefaultMesh = a_Mesh;
+		}
+
+		//---------------------------------------------------------------------
+		ShaderHandle ResourceAtlas::GetDefaultShader() const
+		{
+			return m_DefaultShader;
+		}
+
+		//---------------------------------------------------------------------
+		TextureHandle ResourceAtlas::GetDefaultTexture() const
+		{
+			return m_DefaultTexture;
+		}
+
+		//---------------------------------------------------------------------
+		MeshHandle ResourceAtlas::GetDefaultMesh() const
+		{
+			return m_DefaultMesh;
+		}
+
+#ifndef _HEADLESS
 		//---------------------------------------------------------------------
 		void ResourceAtlas::TransitionResources(std::shared_ptr<graphics::dx12::CommandList> a_CommandList)
 		{
-			for (std::shared_ptr<graphics::dx12::Texture> texture : m_aTextures)
+			std::lock_guard<std::mutex> lock(m_LoadMutex);
+
+			// Textures of upload batches the copy queue finished are no longer loading and get their srv below.
+			std::shared_ptr<graphics::dx12::CommandQueue> cCommandQueue = TOOL->GetDX12().GetCommandQueue(D3D12_COMMAND_LIST_TYPE_COPY);
+			size_t completedBatches = 0;
+			while (completedBatches < m_aUploadBatches.size() && cCommandQueue->IsFenceComplete(m_aUploadBatches[completedBatches].m_iFenceValue))
 			{
-				if (texture && !texture->IsValid())
+				for (TextureHandle handle : m_aUploadBatches[completedBatches].m_aTextures)
 				{
-					texture->CreateSRV(a_CommandList);
+					m_aLoadingTextures.erase(handle.GetValue());
 				}
+				completedBatches++;
 			}
+			m_aUploadBatches.erase(m_aUploadBatches.begin(), m_aUploadBatches.begin() + completedBatches);
+
+			std::lock_guard<std::mutex> texturesLock(m_Textures.m_Mutex);
+			// Textures that failed to load have nothing to create a view of, they are skipped until they are loaded again.
+			m_Textures.m_Slots.ForEach([this, &a_CommandList](TextureHandle a_Handle, graphics::dx12::Texture& a_Texture)
+			{
+				if (!a_Texture.IsValid() && !m_aLoadingTextures.contains(a_Handle.GetValue()) && !m_aFailedTextures.contains(a_Handle.GetValue()))
+				{
+					a_Texture.CreateSRV(a_CommandList);
+				}
+			});
 		}
+#endif // _HEADLESS
 
 		//---------------------------------------------------------------------
-		const std::vector<std::shared_ptr<graphics::dx12::Texture>>& ResourceAtlas::GetTextures() const
+		const SlotPool<graphics::backend::Texture>& ResourceAtlas::GetTextures() const
 		{
-			return m_aTextures;
+			return m_Textures.m_Slots;
 		}
 
 		//---------------------------------------------------------------------
-		const std::vector<std::shared_ptr<graphics::dx12::Shader>>& ResourceAtlas::GetShaders() const
+		const SlotPool<graphics::backend::Shader>& ResourceAtlas::GetShaders() const
 		{
-			return m_aShaders;
+			return m_Shaders.m_Slots;
 		}
 
 		//---------------------------------------------------------------------
-		const std::vector<std::shared_ptr<graphics::dx12::Mesh>>& ResourceAtlas::GetMeshes() const
+		const SlotPool<graphics::backend::Mesh>& ResourceAtlas::GetMeshes() const
 		{
-			return m_aMeshes;
+			return m_Meshes.m_Slots;
 		}
 	}
 }
\ No newline at end of file
@@ -1,62 +1,154 @@
 #pragma once
 
+#ifndef _HEADLESS
 #include "graphics/dx12/DX12PCH.h"
+#endif // _HEADLESS
 
-#include <vector>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 #include "utils/file_abstractions.h"
+#include "graphics/GraphicsBackend.h"
+#include "graphics/TextureData.h"
+#include "core/ResourceHandle.h"
+#include "core/SlotPool.h"
+#include "core/JobSystem.h"
+#include "core/PakFile.h"
 
 namespace gallus
 {
-	namespace graphics
-	{
-		namespace dx12
-		{
-			class Texture;
-			class Shader;
-			class Mesh;
-
-			class CommandList;
-		}
-	}
 	namespace core
 	{
-		constexpr uint32_t MAX_RESOURCES = 64;
-		constexpr uint32_t MISSING = 0;
+		using TextureHandle = ResourceHandle<graphics::backend::Texture>;
+		using ShaderHandle = ResourceHandle<graphics::backend::Shader>;
+		using MeshHandle = ResourceHandle<graphics::backend::Mesh>;
+
+		/// <summary>
+		/// Progress of an asynchronous load.
+		/// </summary>
+		enum class ResourceLoadState
+		{
+			Pending, /// Being read, decoded or uploaded.
+			Ready, /// Loaded and usable by the gpu.
+			Failed, /// Not loading and not usable, for example because the file could not be decoded.
+		};
 
 		//---------------------------------------------------------------------
 		// ResourceAtlas
 		//---------------------------------------------------------------------
+		/// <summary>
+		/// Owns the loaded textures, shaders and meshes. Resources are found by name or path through hash maps and referenced
+		/// by generational handles, which users resolve into plain pointers without touching a reference count.
+		/// </summary>
 		class ResourceAtlas
 		{
 		public:
+			/// <summary>
+			/// Resources of a single type with their name and path indices. Loading, unloading and iterating lock the pool,
+			/// since the game thread, the job system and the render thread use it at the same time. Resolving a handle does not, it
+			/// only reads the address the slot publishes.
+			/// </summary>
 			template<class T>
-			std::shared_ptr<T> GetResource(std::vector<std::shared_ptr<T>>& a_vVector, const std::string& a_sName, const fs::path& a_Path);
-
-			template<class T>
-			int32_t HasResource(std::vector<std::shared_ptr<T>>& a_vVector, const std::string& a_sName, const fs::path& a_Path);
+			struct ResourcePool
+			{
+				std::mutex m_Mutex; /// Guards adding and removing slots, iterating them and the indices.
+				SlotPool<T> m_Slots;
+				std::unordered_map<std::string, ResourceHandle<T>> m_aNames;
+				std::unordered_map<std::string, ResourceHandle<T>> m_aPaths; /// Keyed by the generic string of the normalized path.
+			};
 
-			std::shared_ptr<graphics::dx12::Texture> LoadTexture(const std::string& a_sName, std::shared_ptr<graphics::dx12::CommandList> a_pCommandList);
+			TextureHandle LoadTexture(const std::string& a_sName, std::shared_ptr<graphics::backend::CommandList> a_pCommandList);
+#ifndef _HEADLESS
 			std::shared_ptr<graphics::dx12::Texture> LoadTextureByDescription(const std::string& a_sName, D3D12_RESOURCE_DESC& a_Description);
-			std::shared_ptr<graphics::dx12::Texture> LoadTextureEmpty(const std::string& a_sName);
+#endif // _HEADLESS
+			TextureHandle LoadTextureEmpty(const std::string& a_sName);
+
+			/// <summary>
+			/// Starts loading a texture and returns its handle right away. The file is read and decoded on the job system,
+			/// Update records the uploads of the decoded textures in a single batch and the texture becomes ready once the
+			/// gpu finished that batch. Until then the texture is not valid, and renderers fall back on the default texture.
+			/// </summary>
+			/// <param name="a_sName">Name of the texture, relative to the textures folder.</param>
+			/// <returns>Handle to the texture.</returns>
+			TextureHandle LoadTextureAsync(const std::string& a_sName);
+
+			/// <summary>
+			/// Retrieves how far the loading of a texture is.
+			/// </summary>
+			/// <param name="a_Handle">Handle to the texture.</param>
+			/// <returns>The load state.</returns>
+			ResourceLoadState GetTextureState(TextureHandle a_Handle);
+
+			/// <summary>
+			/// Hands the textures that finished decoding to the backend, recording all their uploads on one copy command list,
+			/// and destroys the unloaded resources the gpu is done with. Called once per frame by the game thread.
+			/// </summary>
+			void Update();
+
+			/// <summary>
+			/// Waits until every texture that is being loaded asynchronously is decoded, then calls Update.
+			/// </summary>
+			void WaitForAsyncLoads();
 			bool HasTexture(const std::string& a_sName);
 
-			std::shared_ptr<graphics::dx12::Shader> LoadShader(const std::string& a_sVertexShader, const std::string& a_sPixelShader);
+			ShaderHandle LoadShader(const std::string& a_sVertexShader, const std::string& a_sPixelShader);
 			bool HasShader(const std::string& a_sName);
 
-			std::shared_ptr<graphics::dx12::Mesh> LoadMesh(const std::string& a_sName, std::shared_ptr<graphics::dx12::CommandList> a_pCommandList);
+			MeshHandle LoadMesh(const std::string& a_sName, std::shared_ptr<graphics::backend::CommandList> a_pCommandList);
 			bool HasMesh(const std::string& a_sName);
 
-			std::shared_ptr<graphics::dx12::Shader> GetDefaultShader();
-			std::shared_ptr<graphics::dx12::Texture> GetDefaultTexture();
-			std::shared_ptr<graphics::dx12::Mesh> GetDefaultMesh();
+			/// <summary>
+			/// Removes a resource from the atlas, which makes every handle to it stale. Render packets that were already extracted
+			/// may still point at the resource, so it is destroyed by Update once the gpu finished drawing the frames after it.
+			/// Called by the game thread.
+			/// </summary>
+			/// <param name="a_Handle">Handle to the resource.</param>
+			/// <returns>True if the resource was removed, false if the handle was stale.</returns>
+			bool UnloadTexture(TextureHandle a_Handle);
+			bool UnloadShader(ShaderHandle a_Handle);
+			bool UnloadMesh(MeshHandle a_Handle);
 
+			/// <summary>
+			/// Tells the atlas the gpu finished drawing the render packet of a frame and every packet before it.
+			/// Called by the renderer.
+			/// </summary>
+			/// <param name="a_iFrame">Frame the packet was extracted in.</param>
+			void SetCompletedFrame(uint64_t a_iFrame);
+
+			/// <summary>
+			/// Resolves a handle.
+			/// </summary>
+			/// <param name="a_Handle">Handle to the resource.</param>
+			/// <returns>Pointer to the resource, or nullptr if the handle is empty or stale.</returns>
+			graphics::backend::Texture* GetTexture(TextureHandle a_Handle) const;
+			graphics::backend::Shader* GetShader(ShaderHandle a_Handle) const;
+			graphics::backend::Mesh* GetMesh(MeshHandle a_Handle) const;
+
+			/// <summary>
+			/// Sets the resources components fall back on.
+			/// </summary>
+			/// <param name="a_Texture">The default texture.</param>
+			/// <param name="a_Shader">The default shader.</param>
+			/// <param name="a_Mesh">The default mesh.</param>
+			void SetDefaultResources(TextureHandle a_Texture, ShaderHandle a_Shader, MeshHandle a_Mesh);
+
+			ShaderHandle GetDefaultShader() const;
+			TextureHandle GetDefaultTexture() const;
+			MeshHandle GetDefaultMesh() const;
+
+#ifndef _HEADLESS
 			void TransitionResources(std::shared_ptr<graphics::dx12::CommandList> a_pCommandList);
+#endif // _HEADLESS
 
-			const std::vector<std::shared_ptr<graphics::dx12::Texture>>& GetTextures() const;
-			const std::vector<std::shared_ptr<graphics::dx12::Shader>>& GetShaders() const;
-			const std::vector<std::shared_ptr<graphics::dx12::Mesh>>& GetMeshes() const;
+			const SlotPool<graphics::backend::Texture>& GetTextures() const;
+			const SlotPool<graphics::backend::Shader>& GetShaders() const;
+			const SlotPool<graphics::backend::Mesh>& GetMeshes() const;
 
 			void SetResourceFolder(const std::string& a_sResourceFolder)
 			{
@@ -67,12 +159,101 @@ namespace gallus
 			{
 				return m_sResourceFolder;
 			}
+
+			/// <summary>
+			/// Opens a packed archive that resources are read from before falling back on loose files. Entries are named
+			/// by their path relative to the resource folder.
+			/// </summary>
+			/// <param name="a_Path">Path to the archive.</param>
+			/// <returns>True if the archive was opened, otherwise false.</returns>
+			bool MountArchive(const fs::path& a_Path);
+
+			/// <summary>
+			/// Reads a resource file, from the mounted archive if it contains the file and otherwise from disk.
+			/// Safe to call from the job system.
+			/// </summary>
+			/// <param name="a_Path">Path to the file inside the resource folder.</param>
+			/// <param name="a_Data">Receives the contents. Uncompressed archive entries are a view of the archive.</param>
+			/// <returns>True if the file was read, otherwise false.</returns>
+			bool ReadFile(const fs::path& a_Path, Data& a_Data) const;
+
+			const PakFile& GetArchive() const
+			{
+				return m_Archive;
+			}
 		private:
-			std::vector<std::shared_ptr<graphics::dx12::Texture>> m_aTextures;
-			std::vector<std::shared_ptr<graphics::dx12::Shader>> m_aShaders;
-			std::vector<std::shared_ptr<graphics::dx12::Mesh>> m_aMeshes;
+			template<class T>
+			ResourceHandle<T> GetResource(ResourcePool<T>& a_Pool, const std::string& a_sName, const fs::path& a_Path);
+
+			/// <summary>
+			/// Looks a resource up by name, then by path. The pool has to be locked.
+			/// </summary>
+			template<class T>
+			ResourceHandle<T> HasResource(const ResourcePool<T>& a_Pool, const std::string& a_sName, const fs::path& a_Path) const;
+
+			template<class T>
+			bool UnloadResource(ResourcePool<T>& a_Pool, ResourceHandle<T> a_Handle);
+
+			/// <summary>
+			/// Reads and decodes a texture file. Runs on the job system.
+			/// </summary>
+			/// <param name="a_Handle">Handle to the texture.</param>
+			/// <param name="a_Path">Path to the texture file.</param>
+			void DecodeTexture(TextureHandle a_Handle, const fs::path& a_Path);
+
+			/// <summary>
+			/// Texture that was read or decoded on the job system and waits to be uploaded.
+			/// </summary>
+			struct DecodedTexture
+			{
+				TextureHandle m_Handle;
+				fs::path m_Path;
+				graphics::TextureData m_Texture;
+				bool m_bDecoded = false;
+			};
+
+			/// <summary>
+			/// Resource that was removed from the atlas but may still be drawn.
+			/// </summary>
+			struct UnloadedResource
+			{
+				uint64_t m_iFrame = 0; /// Frame the resource was unloaded in, packets of later frames do not point at it.
+				std::shared_ptr<void> m_pResource;
+			};
+
+#ifndef _HEADLESS
+			/// <summary>
+			/// Textures whose uploads were executed on the copy queue together.
+			/// </summary>
+			struct UploadBatch
+			{
+				uint64_t m_iFenceValue = 0;
+				std::vector<TextureHandle> m_aTextures;
+			};
+#endif // _HEADLESS
+
+			ResourcePool<graphics::backend::Texture> m_Textures;
+			ResourcePool<graphics::backend::Shader> m_Shaders;
+			ResourcePool<graphics::backend::Mesh> m_Meshes;
+
+			TextureHandle m_DefaultTexture;
+			ShaderHandle m_DefaultShader;
+			MeshHandle m_DefaultMesh;
 
 			std::string m_sResourceFolder;
+			PakFile m_Archive;
+
+			std::vector<UnloadedResource> m_aUnloadedResources; /// Oldest first, only used by the game thread.
+			std::atomic<uint64_t> m_iCompletedFrame = 0; /// Latest frame whose render packet the gpu finished drawing.
+
+			JobCounter m_DecodeJobs;
+			std::mutex m_LoadMutex; /// Guards the asynchronous load state below, which is shared with the job system and render thread.
+			std::unordered_set<uint32_t> m_aLoadingTextures; /// Handle values of the textures that are not ready yet.
+			std::unordered_set<uint32_t> m_aFailedTextures; /// Handle values of the textures whose last load failed, until they are loaded again.
+			std::vector<DecodedTexture> m_aDecodedTextures;
+#ifndef _HEADLESS
+			std::vector<UploadBatch> m_aUploadBatches; /// Executed batches whose fence has not been seen complete yet, oldest first.
+#endif // _HEADLESS
 		};
 	}
 }
\ No newline at end of file
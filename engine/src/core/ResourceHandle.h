@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstdint>
+
+namespace gallus
+{
+	namespace core
+	{
+		//---------------------------------------------------------------------
+		// ResourceHandle
+		//---------------------------------------------------------------------
+		/// <summary>
+		/// 32-bit reference to a resource in a slot pool: the slot index and the generation of the slot. A slot gets a new
+		/// generation when its resource is removed, so handles to the removed resource stop resolving instead of pointing
+		/// at whatever is stored in the slot next. A value of 0 is never handed out and means no resource.
+		/// </summary>
+		/// <typeparam name="T">The type of the resource, so handles of different resource types cannot be mixed up.</typeparam>
+		template <class T>
+		class ResourceHandle
+		{
+		public:
+			static constexpr uint32_t INDEX_BITS = 20;
+			static constexpr uint32_t MAX_INDEX = (1u << INDEX_BITS) - 1;
+			static constexpr uint32_t MAX_GENERATION = (1u << (32 - INDEX_BITS)) - 1;
+
+			ResourceHandle() = default;
+
+			/// <summary>
+			/// Creates a handle.
+			/// </summary>
+			/// <param name="a_iIndex">The slot index, at most MAX_INDEX.</param>
+			/// <param name="a_iGeneration">The generation of the slot, from 1 up to MAX_GENERATION.</param>
+			ResourceHandle(uint32_t a_iIndex, uint32_t a_iGeneration) : m_iValue((a_iGeneration << INDEX_BITS) | a_iIndex)
+			{}
+
+			/// <summary>
+			/// Retrieves the slot index.
+			/// </summary>
+			/// <returns>The slot index.</returns>
+			uint32_t GetIndex() const
+			{
+				return m_iValue & MAX_INDEX;
+			}
+
+			/// <summary>
+			/// Retrieves the generation of the slot the handle was created for.
+			/// </summary>
+			/// <returns>The generation.</returns>
+			uint32_t GetGeneration() const
+			{
+				return m_iValue >> INDEX_BITS;
+			}
+
+			/// <summary>
+			/// Retrieves the index and generation packed into a single value, for use as a key.
+			/// </summary>
+			/// <returns>The packed value.</returns>
+			uint32_t GetValue() const
+			{
+				return m_iValue;
+			}
+
+			/// <summary>
+			/// Checks whether the handle was handed out by a pool. It can still be stale.
+			/// </summary>
+			/// <returns>True if the handle is not empty, otherwise false.</returns>
+			bool IsValid() const
+			{
+				return m_iValue != 0;
+			}
+
+			bool operator==(const ResourceHandle& a_Other) const = default;
+		private:
+			uint32_t m_iValue = 0;
+		};
+	}
+}
\ No newline at end of file
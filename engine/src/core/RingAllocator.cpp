@@ -0,0 +1,118 @@
+#include "core/RingAllocator.h"
+
+namespace gallus
+{
+	namespace core
+	{
+		//---------------------------------------------------------------------
+		// RingAllocator
+		//---------------------------------------------------------------------
+		void RingAllocator::Reset(size_t a_iCapacity)
+		{
+			m_aBlocks.clear();
+			m_iCapacity = a_iCapacity;
+			m_iHead = 0;
+			m_iTail = 0;
+			m_iUsedSize = 0;
+		}
+
+		//---------------------------------------------------------------------
+		size_t RingAllocator::Allocate(size_t a_iSize, size_t a_iAlignment, uint64_t a_iOwner)
+		{
+			if (a_iSize == 0 || a_iSize > m_iCapacity || m_iUsedSize == m_iCapacity)
+			{
+				return INVALID_OFFSET;
+			}
+
+			// Nothing is in use, so the allocation can start from the beginning of the ring.
+			if (m_aBlocks.empty())
+			{
+				m_iHead = 0;
+				m_iTail = 0;
+			}
+
+			const size_t alignedHead = (m_iHead + a_iAlignment - 1) & ~(a_iAlignment - 1);
+
+			size_t offset = INVALID_OFFSET;
+			if (m_iHead >= m_iTail)
+			{
+				// The free space is the end of the ring and the start of the ring up to the tail.
+				if (alignedHead + a_iSize <= m_iCapacity)
+				{
+					offset = alignedHead;
+				}
+				else if (a_iSize <= m_iTail)
+				{
+					offset = 0;
+				}
+			}
+			else if (alignedHead + a_iSize <= m_iTail)
+			{
+				offset = alignedHead;
+			}
+
+			if (offset == INVALID_OFFSET)
+			{
+				return INVALID_OFFSET;
+			}
+
+			// Padding and the end of the ring that gets skipped when wrapping around stay in use until the block is released.
+			const size_t end = offset + a_iSize;
+			const size_t usedSize = offset >= m_iHead ? end - m_iHead : m_iCapacity - m_iHead + end;
+			m_iUsedSize += usedSize;
+			m_iHead = end == m_iCapacity ? 0 : end;
+
+			// Allocations of another owner in between start a new block, so every block gets the fence value of its own owner.
+			if (m_aBlocks.empty() || m_aBlocks.back().m_iOwner != a_iOwner || m_aBlocks.back().m_iFenceValue != UNFINISHED)
+			{
+				m_aBlocks.push_back({ a_iOwner, UNFINISHED, 0, 0 });
+			}
+			m_aBlocks.back().m_iEnd = m_iHead;
+			m_aBlocks.back().m_iSize += usedSize;
+
+			return offset;
+		}
+
+		//---------------------------------------------------------------------
+		void RingAllocator::Finish(uint64_t a_iOwner, uint64_t a_iFenceValue)
+		{
+			for (Block& block : m_aBlocks)
+			{
+				if (block.m_iOwner == a_iOwner && block.m_iFenceValue == UNFINISHED)
+				{
+					block.m_iFenceValue = a_iFenceValue;
+				}
+			}
+		}
+
+		//---------------------------------------------------------------------
+		void RingAllocator::ReleaseCompleted(uint64_t a_iCompletedFenceValue)
+		{
+			// Blocks are released in order, an unfinished block keeps the ones after it alive even if those completed.
+			while (!m_aBlocks.empty() && m_aBlocks.front().m_iFenceValue != UNFINISHED && m_aBlocks.front().m_iFenceValue <= a_iCompletedFenceValue)
+			{
+				m_iTail = m_aBlocks.front().m_iEnd;
+				m_iUsedSize -= m_aBlocks.front().m_iSize;
+				m_aBlocks.pop_front();
+			}
+		}
+
+		//---------------------------------------------------------------------
+		size_t RingAllocator::GetCapacity() const
+		{
+			return m_iCapacity;
+		}
+
+		//---------------------------------------------------------------------
+		size_t RingAllocator::GetUsedSize() const
+		{
+			return m_iUsedSize;
+		}
+
+		//---------------------------------------------------------------------
+		size_t RingAllocator::GetBlockCount() const
+		{
+			return m_aBlocks.size();
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+
+namespace gallus
+{
+	namespace core
+	{
+		//---------------------------------------------------------------------
+		// RingAllocator
+		//---------------------------------------------------------------------
+		/// <summary>
+		/// Bookkeeping of a ring buffer that hands out sub-allocations which get freed by fence value. Every allocation belongs
+		/// to an owner, like a command list. Allocating moves the head, finishing an owner tags its allocations with a fence value
+		/// and releasing moves the tail past every allocation whose fence value was reached. Owners can allocate at the same
+		/// time and finish in any order, the tail stops at the oldest allocation that is not finished or not completed.
+		/// It only works with offsets, the memory itself is owned by the caller. It does not lock, callers do.
+		/// </summary>
+		class RingAllocator
+		{
+		public:
+			static constexpr size_t INVALID_OFFSET = SIZE_MAX;
+
+			/// <summary>
+			/// Sets the size of the ring and frees everything.
+			/// </summary>
+			/// <param name="a_iCapacity">Size of the ring in bytes.</param>
+			void Reset(size_t a_iCapacity);
+
+			/// <summary>
+			/// Allocates a range from the ring. Ranges never wrap around the end of the ring.
+			/// </summary>
+			/// <param name="a_iSize">Size of the range in bytes.</param>
+			/// <param name="a_iAlignment">Alignment of the offset, has to be a power of two.</param>
+			/// <param name="a_iOwner">The owner of the range, which finishes it.</param>
+			/// <returns>Offset of the range, or INVALID_OFFSET if the ring does not have enough free space.</returns>
+			size_t Allocate(size_t a_iSize, size_t a_iAlignment, uint64_t a_iOwner);
+
+			/// <summary>
+			/// Tags everything an owner allocated since it was last finished with a fence value.
+			/// </summary>
+			/// <param name="a_iOwner">The owner.</param>
+			/// <param name="a_iFenceValue">The fence value that is signalled once the gpu is done with the allocations.</param>
+			void Finish(uint64_t a_iOwner, uint64_t a_iFenceValue);
+
+			/// <summary>
+			/// Frees the finished allocations whose fence value was reached, oldest first.
+			/// </summary>
+			/// <param name="a_iCompletedFenceValue">The fence value the gpu has completed.</param>
+			void ReleaseCompleted(uint64_t a_iCompletedFenceValue);
+
+			/// <summary>
+			/// Retrieves the size of the ring.
+			/// </summary>
+			/// <returns>Size of the ring in bytes.</returns>
+			size_t GetCapacity() const;
+
+			/// <summary>
+			/// Retrieves the number of bytes in use, including padding and the unused end of the ring skipped when wrapping around.
+			/// </summary>
+			/// <returns>Number of bytes in use.</returns>
+			size_t GetUsedSize() const;
+
+			/// <summary>
+			/// Retrieves the number of blocks that have not been released yet, finished or not.
+			/// </summary>
+			/// <returns>The number of blocks.</returns>
+			size_t GetBlockCount() const;
+		private:
+			static constexpr uint64_t UNFINISHED = UINT64_MAX;
+
+			/// <summary>
+			/// Consecutive allocations of one owner.
+			/// </summary>
+			struct Block
+			{
+				uint64_t m_iOwner = 0;
+				uint64_t m_iFenceValue = UNFINISHED; /// UNFINISHED until the owner is finished.
+				size_t m_iEnd = 0; /// Head of the ring after the last allocation of the block.
+				size_t m_iSize = 0; /// Bytes used by the block, including padding.
+			};
+
+			std::deque<Block> m_aBlocks; /// Blocks in allocation order, oldest first.
+			size_t m_iCapacity = 0;
+			size_t m_iHead = 0; /// Offset the next allocation starts from.
+			size_t m_iTail = 0; /// Offset of the oldest allocation that is in use.
+			size_t m_iUsedSize = 0;
+		};
+	}
+}
\ No newline at end of file
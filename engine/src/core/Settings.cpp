@@ -1,6 +1,7 @@
 #include "core/Settings.h"
 
 // # Rapidjson
+#include "utils/rapidjson_config.h"
 #include <rapidjson/document.h>
 #include <rapidjson/stringbuffer.h>
 #include <rapidjson/prettywriter.h>
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include "utils/rapidjson_config.h"
 #include <rapidjson/document.h>
 
 namespace gallus
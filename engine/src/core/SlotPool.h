@@ -0,0 +1,197 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "core/ResourceHandle.h"
+
+namespace gallus
+{
+	namespace core
+	{
+		//---------------------------------------------------------------------
+		// SlotPool
+		//---------------------------------------------------------------------
+		/// <summary>
+		/// Stores resources in slots that are addressed by generational handles. Slots live in fixed-size pages, so the pool
+		/// grows without moving slots that are in use, and removed slots are reused. Adding, removing and resolving a handle
+		/// are constant time.
+		/// Every slot publishes the address of its resource next to its generation. Resolving a handle only reads those and
+		/// the fixed-size page table, so it does not lock and is safe while another thread adds or removes. The resource
+		/// itself has to outlive the resolved pointer, the pool does not keep it alive.
+		/// Adding, removing, iterating and retrieving shared ownership are not synchronized with each other, callers lock around those.
+		/// </summary>
+		/// <typeparam name="T">The type of the resources.</typeparam>
+		template <class T>
+		class SlotPool
+		{
+		public:
+			using Handle = ResourceHandle<T>;
+
+			static constexpr uint32_t PAGE_SIZE = 256; /// Number of slots per page.
+			static constexpr uint32_t PAGE_COUNT = (Handle::MAX_INDEX + PAGE_SIZE) / PAGE_SIZE; /// Number of pages every slot index fits in.
+
+			SlotPool() = default;
+			SlotPool(const SlotPool&) = delete;
+			SlotPool& operator=(const SlotPool&) = delete;
+
+			~SlotPool()
+			{
+				for (std::atomic<Page*>& page : m_aPages)
+				{
+					delete page.load();
+				}
+			}
+
+			/// <summary>
+			/// Stores a resource in a free slot.
+			/// </summary>
+			/// <param name="a_pResource">The resource.</param>
+			/// <returns>Handle to the resource, or an empty handle if the pool has run out of slot indices.</returns>
+			Handle Add(std::shared_ptr<T> a_pResource)
+			{
+				uint32_t index = 0;
+				if (!m_aFreeSlots.empty())
+				{
+					index = m_aFreeSlots.back();
+					m_aFreeSlots.pop_back();
+				}
+				else
+				{
+					index = m_iSlotCount.load(std::memory_order_relaxed);
+					if (index > Handle::MAX_INDEX)
+					{
+						return Handle();
+					}
+
+					// The page is published before the slot count, so a thread that sees the slot also sees its page.
+					if (index % PAGE_SIZE == 0)
+					{
+						m_aPages[index / PAGE_SIZE].store(new Page(), std::memory_order_release);
+					}
+					m_iSlotCount.store(index + 1, std::memory_order_release);
+				}
+
+				Slot& slot = GetSlot(index);
+				slot.m_pResource = std::move(a_pResource);
+				slot.m_pAddress.store(slot.m_pResource.get(), std::memory_order_release);
+				m_iSize++;
+				return Handle(index, slot.m_iGeneration.load(std::memory_order_relaxed));
+			}
+
+			/// <summary>
+			/// Removes a resource, which makes every handle to it stale.
+			/// </summary>
+			/// <param name="a_Handle">Handle to the resource.</param>
+			/// <returns>True if the resource was removed, false if the handle was stale.</returns>
+			bool Remove(Handle a_Handle)
+			{
+				if (!Get(a_Handle))
+				{
+					return false;
+				}
+
+				// The address is cleared before the generation changes, so a thread that sees the new generation no longer
+				// sees the resource.
+				Slot& slot = GetSlot(a_Handle.GetIndex());
+				slot.m_pAddress.store(nullptr, std::memory_order_release);
+				const uint32_t generation = slot.m_iGeneration.load(std::memory_order_relaxed);
+				slot.m_iGeneration.store(generation == Handle::MAX_GENERATION ? 1 : generation + 1, std::memory_order_release);
+				slot.m_pResource.reset();
+				m_aFreeSlots.push_back(a_Handle.GetIndex());
+				m_iSize--;
+				return true;
+			}
+
+			/// <summary>
+			/// Resolves a handle.
+			/// </summary>
+			/// <param name="a_Handle">Handle to the resource.</param>
+			/// <returns>Pointer to the resource, or nullptr if the handle is empty or stale.</returns>
+			T* Get(Handle a_Handle) const
+			{
+				if (!a_Handle.IsValid() || a_Handle.GetIndex() >= m_iSlotCount.load(std::memory_order_acquire))
+				{
+					return nullptr;
+				}
+
+				const Slot& slot = GetSlot(a_Handle.GetIndex());
+				const uint32_t generation = slot.m_iGeneration.load(std::memory_order_acquire);
+				if (generation != a_Handle.GetGeneration())
+				{
+					return nullptr;
+				}
+
+				// A resource added to the slot after it was removed is published after the new generation, so reading its
+				// address means the generation is read as changed as well.
+				T* resource = slot.m_pAddress.load(std::memory_order_acquire);
+				return slot.m_iGeneration.load(std::memory_order_acquire) == generation ? resource : nullptr;
+			}
+
+			/// <summary>
+			/// Resolves a handle into shared ownership of the resource. This reads the owning pointer, so callers lock around it
+			/// like around adding and removing.
+			/// </summary>
+			/// <param name="a_Handle">Handle to the resource.</param>
+			/// <returns>The resource, or nullptr if the handle is empty or stale.</returns>
+			std::shared_ptr<T> GetShared(Handle a_Handle) const
+			{
+				return Get(a_Handle) ? GetSlot(a_Handle.GetIndex()).m_pResource : nullptr;
+			}
+
+			/// <summary>
+			/// Calls a function for every resource in the pool, in slot order.
+			/// </summary>
+			/// <param name="a_Function">The function, called with the handle and a reference to the resource.</param>
+			template <class Function>
+			void ForEach(Function a_Function) const
+			{
+				const uint32_t slotCount = m_iSlotCount.load(std::memory_order_acquire);
+				for (uint32_t i = 0; i < slotCount; i++)
+				{
+					const Slot& slot = GetSlot(i);
+					if (slot.m_pResource)
+					{
+						a_Function(Handle(i, slot.m_iGeneration.load(std::memory_order_relaxed)), *slot.m_pResource);
+					}
+				}
+			}
+
+			/// <summary>
+			/// Retrieves the number of resources in the pool.
+			/// </summary>
+			/// <returns>The number of resources.</returns>
+			size_t GetSize() const
+			{
+				return m_iSize;
+			}
+		private:
+			struct Slot
+			{
+				std::shared_ptr<T> m_pResource = nullptr; /// Owns the resource, only touched by callers that lock.
+				std::atomic<T*> m_pAddress = nullptr; /// The resource, read when resolving a handle.
+				std::atomic<uint32_t> m_iGeneration = 1;
+			};
+
+			using Page = std::array<Slot, PAGE_SIZE>;
+
+			Slot& GetSlot(uint32_t a_iIndex)
+			{
+				return (*m_aPages[a_iIndex / PAGE_SIZE].load(std::memory_order_acquire))[a_iIndex % PAGE_SIZE];
+			}
+
+			const Slot& GetSlot(uint32_t a_iIndex) const
+			{
+				return (*m_aPages[a_iIndex / PAGE_SIZE].load(std::memory_order_acquire))[a_iIndex % PAGE_SIZE];
+			}
+
+			std::array<std::atomic<Page*>, PAGE_COUNT> m_aPages = {}; /// Pages are created as the pool grows and never move or go away.
+			std::vector<uint32_t> m_aFreeSlots; /// Indices of removed slots, reused before new slots are created.
+			std::atomic<uint32_t> m_iSlotCount = 0; /// Number of slots that have been handed out at least once.
+			size_t m_iSize = 0;
+		};
+	}
+}
\ No newline at end of file
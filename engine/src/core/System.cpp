@@ -59,9 +59,14 @@ namespace gallus
 
 		void ThreadedSystem::ThreadEntry(std::promise<bool> promise)
 		{
+			m_ThreadID.store(std::this_thread::get_id());
+
 			bool success = false;
 			success = InitThreadWorker();
 
+			// Running has to be set before the init is signalled, otherwise a Destroy right after Initialize could be overwritten.
+			m_bRunning.store(success);
+
 			{
 				std::unique_lock lock(m_ReadyMutex);
 				m_bInitialized.store(success);
@@ -75,7 +80,6 @@ namespace gallus
 				return;
 			}
 
-			m_bRunning.store(true);
 			std::unique_lock lock(m_RunningMutex);
 
 			while (m_bRunning.load())
@@ -106,7 +110,10 @@ namespace gallus
 
 			// NOTE: Called from main thread.
 
-			m_bRunning.store(false);
+			{
+				std::unique_lock lock(m_RunningMutex);
+				m_bRunning.store(false);
+			}
 			m_RunningCondVar.notify_all();
 
 			if (m_Thread.joinable())
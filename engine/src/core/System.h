@@ -75,6 +75,12 @@ namespace gallus
 			/// </summary>
 			void WakeUp()
 			{
+				// Taking the mutex makes sure the thread is either waiting or has not checked Sleep yet,
+				// so the notification cannot get lost. The thread itself already holds it while looping.
+				if (std::this_thread::get_id() != m_ThreadID.load())
+				{
+					std::lock_guard lock(m_RunningMutex);
+				}
 				m_RunningCondVar.notify_one();
 			}
 
@@ -105,6 +111,7 @@ namespace gallus
 			void ThreadEntry(std::promise<bool> promise);
 
 			std::thread m_Thread; /// The thread.
+			std::atomic<std::thread::id> m_ThreadID; /// Id of the thread, set as soon as it starts.
 
 			std::mutex m_ReadyMutex; /// Mutex for initialization synchronization.
 			std::condition_variable m_ReadyCondVar; /// Condition variable to notify init complete.
@@ -3,6 +3,9 @@
 #include "logger/Logger.h"
 #include <glm/vec2.hpp>
 
+#include "gameplay/systems/TransformSystem.h"
+#include "gameplay/systems/MeshSystem.h"
+
 namespace gallus
 {
 	namespace core
@@ -10,7 +13,11 @@ namespace gallus
 		//---------------------------------------------------------------------
 		// Tool
 		//---------------------------------------------------------------------
+#ifdef _HEADLESS
+		bool Tool::Initialize(const std::string& a_sName)
+#else
 		bool Tool::Initialize(HINSTANCE a_hInstance, const std::string& a_sName)
+#endif // _HEADLESS
 		{
 			TOOL = this;
 
@@ -23,15 +30,29 @@ namespace gallus
 
 			LOG(LOGSEVERITY_INFO, LOG_CATEGORY_ENGINE, "Initializing tool.");
 
+#ifdef _HEADLESS
+			// There is no window or gpu, the null versions only keep the size and title and load the default resources.
+			m_Window.Initialize();
+			m_Window.SetTitle(a_sName);
+
+			m_Renderer.Initialize(m_Window.GetRealSize());
+#else
 			// We initialize the window first and set the size and title after it has been created.
 			m_Window.Initialize(true, a_hInstance);
 			m_Window.SetTitle(a_sName);
 
 			const glm::ivec2 size = m_Window.GetRealSize();
 			m_DX12.Initialize(true, m_Window.GetHWnd(), size, &m_Window);
+#endif // _HEADLESS
+
+			m_JobSystem.Initialize();
 
+			m_ECS.SetJobSystem(&m_JobSystem);
 			m_ECS.Initialize();
 
+			m_FrameTimer.Reset();
+			m_GameLoop.Reset();
+
 			System::Initialize();
 
 			LOG(LOGSEVERITY_INFO, LOG_CATEGORY_ENGINE, "Initialized tool.");
@@ -59,7 +80,13 @@ namespace gallus
 
 			m_ECS.Destroy();
 
+			m_JobSystem.Destroy();
+
+#ifdef _HEADLESS
+			m_Renderer.Destroy();
+#else
 			m_DX12.Destroy();
+#endif // _HEADLESS
 
 			m_Window.Destroy();
 
@@ -69,12 +96,76 @@ namespace gallus
 			return System::Destroy();
 		}
 
+		//---------------------------------------------------------------------
+		void Tool::Update()
+		{
+			m_FrameTimer.Tick();
+
+			const uint32_t steps = m_GameLoop.BeginFrame();
+			for (uint32_t i = 0; i < steps; i++)
+			{
+				m_ECS.Update(m_GameLoop.GetFixedDeltaTime());
+			}
+
+			m_ResourceAtlas.Update();
+			ExtractRenderPacket();
+
+#ifdef _HEADLESS
+			// There is no render thread, so the frame gets rendered right after the update.
+			m_Renderer.Render();
+
+			if (m_iFrameLimit > 0 && m_FrameTimer.GetFrameCount() >= m_iFrameLimit)
+			{
+				m_Window.Quit();
+			}
+			m_Window.ProcessEvents();
+#endif // _HEADLESS
+
+			m_GameLoop.WaitForNextFrame();
+		}
+
+		//---------------------------------------------------------------------
+		void Tool::ExtractRenderPacket()
+		{
+			std::lock_guard<std::recursive_mutex> lock(m_ECS.m_EntityMutex);
+
+			// Only transforms that changed since the last update get recomputed.
+			m_ECS.GetSystem<gameplay::TransformSystem>().UpdateHierarchy();
+
+			graphics::RenderPacket& packet = m_RenderPackets.GetWriteBuffer();
+			packet.Clear();
+			packet.m_iFrame = m_FrameTimer.GetFrameCount();
+			packet.m_fAlpha = m_GameLoop.GetAlpha();
+			m_ECS.GetSystem<gameplay::MeshSystem>().ExtractDrawItems(packet);
+
+			m_RenderPackets.Publish();
+		}
+
 		//---------------------------------------------------------------------
 		ResourceAtlas& Tool::GetResourceAtlas()
 		{
 			return m_ResourceAtlas;
 		}
 
+#ifdef _HEADLESS
+		//---------------------------------------------------------------------
+		graphics::null::NullWindow& Tool::GetWindow()
+		{
+			return m_Window;
+		}
+
+		//---------------------------------------------------------------------
+		graphics::null::NullRenderer& Tool::GetRenderer()
+		{
+			return m_Renderer;
+		}
+
+		//---------------------------------------------------------------------
+		void Tool::SetFrameLimit(uint64_t a_iFrameLimit)
+		{
+			m_iFrameLimit = a_iFrameLimit;
+		}
+#else
 		//---------------------------------------------------------------------
 		graphics::win32::Window& Tool::GetWindow()
 		{
@@ -86,6 +177,31 @@ namespace gallus
 		{
 			return m_DX12;
 		}
+#endif // _HEADLESS
+
+		//---------------------------------------------------------------------
+		const FrameTimer& Tool::GetFrameTimer() const
+		{
+			return m_FrameTimer;
+		}
+
+		//---------------------------------------------------------------------
+		GameLoop& Tool::GetGameLoop()
+		{
+			return m_GameLoop;
+		}
+
+		//---------------------------------------------------------------------
+		TripleBuffer<graphics::RenderPacket>& Tool::GetRenderPackets()
+		{
+			return m_RenderPackets;
+		}
+
+		//---------------------------------------------------------------------
+		JobSystem& Tool::GetJobSystem()
+		{
+			return m_JobSystem;
+		}
 
 		//---------------------------------------------------------------------
 		gameplay::EntityComponentSystem& Tool::GetECS()
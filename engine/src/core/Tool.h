@@ -2,12 +2,24 @@
 
 #include "System.h"
 
+#ifndef _HEADLESS
 #include <wtypes.h>
+#endif // _HEADLESS
 
 #include "utils/file_abstractions.h"
+#include "core/FrameTimer.h"
+#include "core/GameLoop.h"
+#include "core/JobSystem.h"
 #include "core/ResourceAtlas.h"
+#include "core/TripleBuffer.h"
+#ifdef _HEADLESS
+#include "graphics/null/NullRenderer.h"
+#include "graphics/null/NullWindow.h"
+#else
 #include "graphics/dx12/DX12System2D.h"
 #include "graphics/win32/Window.h"
+#endif // _HEADLESS
+#include "graphics/RenderPacket.h"
 #include "gameplay/EntityComponentSystem.h"
 
 namespace gallus
@@ -19,12 +31,21 @@ namespace gallus
 		//---------------------------------------------------------------------
 		/// <summary>
 		/// Main tool that manages all systems in the program, like initialization, startup, update and shutdown.
+		/// Headless builds (_HEADLESS) replace the window and dx12 system with null versions, so the engine runs without a display or gpu.
 		/// </summary>
 		class Tool : public System
 		{
 		public:
 			Tool() = default;
 
+#ifdef _HEADLESS
+			/// <summary>
+			/// Initializes the engine and all necessary subsystems without a window or gpu.
+			/// </summary>
+			/// <param name="a_sName">Name of the program.</param>
+			/// <returns>True if the engine initializes successfully, otherwise false.</returns>
+			virtual bool Initialize(const std::string& a_sName);
+#else
 			/// <summary>
 			/// Initializes the engine and all necessary subsystems with the specified parameters.
 			/// </summary>
@@ -32,6 +53,7 @@ namespace gallus
 			/// <param name="a_sName">Name of the program and window.</param>
 			/// <returns>True if the engine initializes successfully, otherwise false.</returns>
 			virtual bool Initialize(HINSTANCE a_hInstance, const std::string& a_sName);
+#endif // _HEADLESS
 
 			/// <summary>
 			/// Shuts down the engine and cleans up all subsystems.
@@ -39,12 +61,38 @@ namespace gallus
 			/// <returns>True if the destruction is successful, otherwise false.</returns>
 			virtual bool Destroy() override;
 
+			/// <summary>
+			/// Runs a single frame: advances the frame timer, updates the ecs in fixed steps for the time that has passed,
+			/// extracts the render packet and waits until the next frame should start.
+			/// Headless builds also render the frame with the null renderer and process quit requests.
+			/// </summary>
+			void Update();
+
 			/// <summary>
 			/// Retrieves the resource atlas.
 			/// </summary>
 			/// <returns>Reference to the resource atlas.</returns>
 			ResourceAtlas& GetResourceAtlas();
 
+#ifdef _HEADLESS
+			/// <summary>
+			/// Retrieves the window.
+			/// </summary>
+			/// <returns>Reference to the null window.</returns>
+			graphics::null::NullWindow& GetWindow();
+
+			/// <summary>
+			/// Retrieves the renderer.
+			/// </summary>
+			/// <returns>Reference to the null renderer.</returns>
+			graphics::null::NullRenderer& GetRenderer();
+
+			/// <summary>
+			/// Sets the number of frames after which the program quits.
+			/// </summary>
+			/// <param name="a_iFrameLimit">The number of frames, or 0 to run until a quit is requested.</param>
+			void SetFrameLimit(uint64_t a_iFrameLimit);
+#else
 			/// <summary>
 			/// Retrieves the window.
 			/// </summary>
@@ -56,6 +104,31 @@ namespace gallus
 			/// </summary>
 			/// <returns>Reference to the dx12 system.</returns>
 			graphics::dx12::DX12System2D& GetDX12();
+#endif // _HEADLESS
+
+			/// <summary>
+			/// Retrieves the frame timer.
+			/// </summary>
+			/// <returns>Reference to the frame timer.</returns>
+			const FrameTimer& GetFrameTimer() const;
+
+			/// <summary>
+			/// Retrieves the game loop that schedules the simulation steps and paces the frames.
+			/// </summary>
+			/// <returns>Reference to the game loop.</returns>
+			GameLoop& GetGameLoop();
+
+			/// <summary>
+			/// Retrieves the render packets the game thread extracts and the render thread consumes.
+			/// </summary>
+			/// <returns>Reference to the render packet buffer.</returns>
+			TripleBuffer<graphics::RenderPacket>& GetRenderPackets();
+
+			/// <summary>
+			/// Retrieves the job system.
+			/// </summary>
+			/// <returns>Reference to the job system.</returns>
+			JobSystem& GetJobSystem();
 
 			/// <summary>
 			/// Retrieves the ecs.
@@ -82,10 +155,25 @@ namespace gallus
 				file::CreateDirectory(a_sSaveDirectory);
 			}
 		private:
+			/// <summary>
+			/// Copies the draw data of the current state of the ecs into the next render packet and publishes it.
+			/// </summary>
+			void ExtractRenderPacket();
+
+			JobSystem m_JobSystem;
 			ResourceAtlas m_ResourceAtlas;
+#ifdef _HEADLESS
+			graphics::null::NullWindow m_Window;
+			graphics::null::NullRenderer m_Renderer;
+			uint64_t m_iFrameLimit = 0; /// Number of frames after which the program quits, 0 if there is no limit.
+#else
 			graphics::win32::Window m_Window;
 			graphics::dx12::DX12System2D m_DX12;
+#endif // _HEADLESS
 			gameplay::EntityComponentSystem m_ECS;
+			FrameTimer m_FrameTimer;
+			GameLoop m_GameLoop;
+			TripleBuffer<graphics::RenderPacket> m_RenderPackets;
 
 			std::filesystem::path m_sSaveDirectory;
 		};
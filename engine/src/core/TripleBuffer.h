@@ -0,0 +1,75 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace gallus
+{
+	namespace core
+	{
+		//---------------------------------------------------------------------
+		// TripleBuffer
+		//---------------------------------------------------------------------
+		/// <summary>
+		/// Hands values from one producer thread to one consumer thread without locks.
+		/// The producer fills the write buffer and publishes it, the consumer picks up the latest published buffer.
+		/// The third buffer sits between them, so neither side ever waits on the other and a buffer is never read while it is written.
+		/// </summary>
+		/// <typeparam name="T">The type of the values.</typeparam>
+		template <class T>
+		class TripleBuffer
+		{
+		public:
+			/// <summary>
+			/// Retrieves the buffer the producer fills. Only the producer thread may call this.
+			/// </summary>
+			/// <returns>Reference to the write buffer.</returns>
+			T& GetWriteBuffer()
+			{
+				return m_aBuffers[m_iWrite];
+			}
+
+			/// <summary>
+			/// Publishes the write buffer to the consumer and hands the producer a new buffer to write to.
+			/// Only the producer thread may call this.
+			/// </summary>
+			void Publish()
+			{
+				m_iWrite = m_iShared.exchange(m_iWrite | NEW_BIT, std::memory_order_acq_rel) & INDEX_MASK;
+			}
+
+			/// <summary>
+			/// Swaps the read buffer for the latest published buffer, if one has been published since the last call.
+			/// Only the consumer thread may call this.
+			/// </summary>
+			/// <returns>True if a new buffer was picked up, otherwise false and the read buffer stays the same.</returns>
+			bool Consume()
+			{
+				if ((m_iShared.load(std::memory_order_relaxed) & NEW_BIT) == 0)
+				{
+					return false;
+				}
+
+				m_iRead = m_iShared.exchange(m_iRead, std::memory_order_acq_rel) & INDEX_MASK;
+				return true;
+			}
+
+			/// <summary>
+			/// Retrieves the buffer the consumer reads from. Only the consumer thread may call this.
+			/// </summary>
+			/// <returns>Reference to the read buffer.</returns>
+			const T& GetReadBuffer() const
+			{
+				return m_aBuffers[m_iRead];
+			}
+		private:
+			static constexpr uint8_t INDEX_MASK = 0x3;
+			static constexpr uint8_t NEW_BIT = 0x4; /// Set on the shared index when it holds a buffer the consumer has not seen.
+
+			T m_aBuffers[3];
+			uint8_t m_iWrite = 0; /// Index of the buffer owned by the producer.
+			uint8_t m_iRead = 1; /// Index of the buffer owned by the consumer.
+			std::atomic<uint8_t> m_iShared{ 2 }; /// Index of the buffer in between, with NEW_BIT if it was published.
+		};
+	}
+}
\ No newline at end of file
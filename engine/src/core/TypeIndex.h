@@ -0,0 +1,47 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace gallus
+{
+	namespace core
+	{
+		//---------------------------------------------------------------------
+		// TypeIndex
+		//---------------------------------------------------------------------
+		/// <summary>
+		/// Hands out sequential indices to types, starting at 0 for every family.
+		/// Indices are assigned on first use through a static counter, so no RTTI is needed.
+		/// Indices are only stable within a single run of the program and should not be serialized.
+		/// </summary>
+		/// <typeparam name="Family">Tag type that groups the types that share a counter.</typeparam>
+		template <class Family>
+		class TypeIndex
+		{
+		public:
+			/// <summary>
+			/// Retrieves the index of a type within the family.
+			/// </summary>
+			/// <typeparam name="T">The type to retrieve the index for.</typeparam>
+			/// <returns>The index of the type.</returns>
+			template <class T>
+			static uint32_t Get()
+			{
+				static const uint32_t index = m_iNextIndex.fetch_add(1);
+				return index;
+			}
+
+			/// <summary>
+			/// Retrieves the number of types that have been assigned an index so far.
+			/// </summary>
+			/// <returns>The number of indexed types.</returns>
+			static uint32_t Count()
+			{
+				return m_iNextIndex.load();
+			}
+		private:
+			static inline std::atomic<uint32_t> m_iNextIndex = 0;
+		};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+
+namespace gallus
+{
+	namespace gameplay
+	{
+		//---------------------------------------------------------------------
+		// ComponentTicks
+		//---------------------------------------------------------------------
+		/// <summary>
+		/// Change ticks of a single component. Ticks come from the ECS change tick, which advances every time a system
+		/// gets updated, so comparing a component's tick with the tick a system last ran at tells whether the system has seen it.
+		/// </summary>
+		struct ComponentTicks
+		{
+			uint32_t m_iAdded = 0; /// Tick at which the component was added.
+			uint32_t m_iChanged = 0; /// Tick at which the component was last accessed mutably.
+		};
+
+		/// <summary>
+		/// Checks whether a tick is newer than another tick. Handles the tick counter wrapping around.
+		/// </summary>
+		/// <param name="a_iTick">The tick that will be checked.</param>
+		/// <param name="a_iSinceTick">The tick to compare against.</param>
+		/// <returns>True if a_iTick is newer than a_iSinceTick, otherwise false.</returns>
+		inline bool IsNewerTick(uint32_t a_iTick, uint32_t a_iSinceTick)
+		{
+			return static_cast<int32_t>(a_iTick - a_iSinceTick) > 0;
+		}
+
+		//---------------------------------------------------------------------
+		// Added
+		//---------------------------------------------------------------------
+		/// <summary>
+		/// Iteration filter that matches components that were added after a tick.
+		/// </summary>
+		/// <typeparam name="T">The component class the filter applies to.</typeparam>
+		template <class T>
+		struct Added
+		{
+			using ComponentType = T;
+
+			static bool Matches(const ComponentTicks& a_Ticks, uint32_t a_iSinceTick)
+			{
+				return IsNewerTick(a_Ticks.m_iAdded, a_iSinceTick);
+			}
+		};
+
+		//---------------------------------------------------------------------
+		// Changed
+		//---------------------------------------------------------------------
+		/// <summary>
+		/// Iteration filter that matches components that were added or changed after a tick.
+		/// </summary>
+		/// <typeparam name="T">The component class the filter applies to.</typeparam>
+		template <class T>
+		struct Changed
+		{
+			using ComponentType = T;
+
+			static bool Matches(const ComponentTicks& a_Ticks, uint32_t a_iSinceTick)
+			{
+				return IsNewerTick(a_Ticks.m_iChanged, a_iSinceTick);
+			}
+		};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <bitset>
+#include <cstdint>
+
+#include "core/TypeIndex.h"
+
+namespace gallus
+{
+	namespace gameplay
+	{
+		constexpr uint32_t MAX_COMPONENT_TYPES = 64;
+
+		/// <summary>
+		/// Bitset with one bit per component type, used to describe which components an entity has.
+		/// </summary>
+		using ComponentSignature = std::bitset<MAX_COMPONENT_TYPES>;
+
+		/// <summary>
+		/// Tag type for the component type index family.
+		/// </summary>
+		struct ComponentTypeFamily
+		{};
+
+		/// <summary>
+		/// Retrieves the index of a component type, used as its bit in a ComponentSignature.
+		/// </summary>
+		/// <typeparam name="ComponentType">The component class.</typeparam>
+		/// <returns>The index of the component type.</returns>
+		template <class ComponentType>
+		uint32_t GetComponentTypeID()
+		{
+			return core::TypeIndex<ComponentTypeFamily>::Get<ComponentType>();
+		}
+
+		/// <summary>
+		/// Builds a signature that contains the bits of all given component types.
+		/// </summary>
+		/// <typeparam name="ComponentTypes">The component classes.</typeparam>
+		/// <returns>The signature of the component types.</returns>
+		template <class... ComponentTypes>
+		ComponentSignature MakeComponentSignature()
+		{
+			ComponentSignature signature;
+			(signature.set(GetComponentTypeID<ComponentTypes>()), ...);
+			return signature;
+		}
+	}
+}
\ No newline at end of file
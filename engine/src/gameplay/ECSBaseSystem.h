@@ -4,11 +4,17 @@
 
 // std::is_base_of
 #include <type_traits> 
-#include <map>
+#include <algorithm>
 #include <string>
 #include <vector>
 
+#include "core/JobSystem.h"
+#include "core/Memory.h"
 #include "gameplay/EntityID.h"
+#include "gameplay/SparseSet.h"
+#include "gameplay/ComponentSignature.h"
+#include "gameplay/ChangeTracking.h"
+#include "gameplay/EntityComponentSystem.h"
 #include "gameplay/systems/components/Component.h"
 #include "core/Tool.h"
 
@@ -43,21 +49,51 @@ namespace gallus
 			virtual void Clear() = 0;
 
 			/// <summary>
-			/// Deletes a component from the system.
+			/// Marks a component for deletion. The component gets removed the next time UpdateComponents is called.
 			/// </summary>
 			/// <param name="a_ID">The entity ID that needs to get deleted.</param>
 			virtual void DeleteComponent(const EntityID& a_ID) = 0;
 
 			/// <summary>
-			/// Updates the system.
+			/// Updates the system. Unless RunsOnGameThread returns true, the update can run on a worker thread,
+			/// at the same time as other systems whose component access does not conflict with this one.
 			/// </summary>
 			/// <param name="a_fDeltaTime">The time that has passed since the last frame.</param>
 			virtual void Update(float a_fDeltaTime) = 0;
 
 			/// <summary>
-			/// Updates the components in the system.
+			/// Retrieves the component types the system reads during Update.
 			/// </summary>
-			virtual void UpdateComponents() = 0;
+			/// <returns>Signature containing the component types that are read.</returns>
+			virtual ComponentSignature GetReadComponents() const
+			{
+				return ComponentSignature();
+			}
+
+			/// <summary>
+			/// Retrieves the component types the system writes during Update.
+			/// </summary>
+			/// <returns>Signature containing the component types that are written.</returns>
+			virtual ComponentSignature GetWriteComponents() const = 0;
+
+			/// <summary>
+			/// Checks whether the system has to be updated on the game thread. This is needed for systems that
+			/// create entities, add components or lock m_EntityMutex during Update.
+			/// Systems on workers can use the lookups of the ECS (Query, ForEach, GetEntity, IsEntityValid, FindEntity,
+			/// GetSignature) and the existing components of their own system, and can delete entities and components, which only
+			/// get removed at the start of the next update. Queries do not change for those deletes until then.
+			/// </summary>
+			/// <returns>True if the system has to be updated on the game thread, otherwise false.</returns>
+			virtual bool RunsOnGameThread() const
+			{
+				return false;
+			}
+
+			/// <summary>
+			/// Updates the components in the system, removing all components that were marked for deletion.
+			/// </summary>
+			/// <returns>True if components were removed, otherwise false.</returns>
+			virtual bool UpdateComponents() = 0;
 
 			/// <summary>
 			/// Checks whether an entity is using the system.
@@ -78,6 +114,27 @@ namespace gallus
 			/// </summary>
 			/// <param name="a_ID"></param>
 			virtual Component* CreateBaseComponent(const EntityID& a_ID) = 0;
+
+			/// <summary>
+			/// Retrieves the type id of the component the system stores.
+			/// </summary>
+			/// <returns>The component type id, used as the component's bit in entity signatures.</returns>
+			virtual uint32_t GetComponentTypeID() const = 0;
+
+			/// <summary>
+			/// Retrieves the change tick the system was last updated at. Passing it to a change filter during Update
+			/// selects the components that were added or changed since the previous update of this system.
+			/// </summary>
+			/// <returns>The tick of the last update, or 0 if the system has not been updated yet.</returns>
+			uint32_t GetLastRunTick() const
+			{
+				return m_iLastRunTick;
+			}
+		protected:
+			friend class EntityComponentSystem;
+
+			EntityComponentSystem* m_pECS = nullptr; /// The ECS that owns the system.
+			uint32_t m_iLastRunTick = 0; /// Change tick of the last update, set by the ECS.
 		};
 
 		//---------------------------------------------------------------------
@@ -89,6 +146,8 @@ namespace gallus
 			static_assert(std::is_base_of<Component, ComponentType>::value,
 				"ComponentType must be derived from Component");
 		public:
+			using ComponentVector = typename SparseSet<ComponentType>::ValueVector;
+
 			/// <summary>
 			/// Destroys the system, releasing resources and performing necessary cleanup.
 			/// </summary>
@@ -102,16 +161,30 @@ namespace gallus
 
 			/// <summary>
 			/// Creates a component in the entity component system.
+			/// Creating a component may grow the component storage, which invalidates previously retrieved component pointers.
 			/// </summary>
 			/// <param name="a_ID"></param>
 			Component* CreateBaseComponent(const EntityID& a_ID) override
 			{
-				if (!HasComponent(a_ID))
-				{
-					ComponentType t;
-					m_mComponents.insert(std::make_pair(a_ID, t));
-				}
-				return &m_mComponents.at(a_ID);
+				return &GetComponent(a_ID);
+			}
+
+			/// <summary>
+			/// Retrieves the type id of the component the system stores.
+			/// </summary>
+			/// <returns>The component type id, used as the component's bit in entity signatures.</returns>
+			uint32_t GetComponentTypeID() const override
+			{
+				return gameplay::GetComponentTypeID<ComponentType>();
+			}
+
+			/// <summary>
+			/// Retrieves the component types the system writes during Update. By default a system writes its own components.
+			/// </summary>
+			/// <returns>Signature containing the component types that are written.</returns>
+			ComponentSignature GetWriteComponents() const override
+			{
+				return MakeComponentSignature<ComponentType>();
 			}
 
 			/// <summary>
@@ -120,7 +193,7 @@ namespace gallus
 			/// <returns>Number representing the amount of entities that use this system.</returns>
 			size_t GetSize() const
 			{
-				return m_mComponents.size();
+				return m_Components.Size();
 			}
 
 			/// <summary>
@@ -130,38 +203,119 @@ namespace gallus
 			/// <returns>True if the entity existed, otherwise false.</returns>
 			bool HasComponent(const EntityID& a_ID)
 			{
-				return m_mComponents.count(a_ID) == 1;
+				return m_Components.Contains(a_ID);
 			}
 
 			/// <summary>
-			/// Retrieves a component by entity id.
+			/// Retrieves a component by entity id. The access counts as a change, use TryGetComponent for reading.
 			/// </summary>
 			/// <param name="a_ID">The entity that will be checked.</param>
-			/// <returns>Reference to the component if the entity existed, otherwise it gets created and returns that.</returns>
+			/// <returns>Reference to the component if the entity existed, otherwise it gets created and returns that.
+			/// A component that was marked for deletion is replaced by a new one, which is no longer removed.</returns>
 			ComponentType& GetComponent(const EntityID& a_ID)
 			{
-				if (HasComponent(a_ID))
+				const uint32_t denseIndex = m_Components.GetDenseIndex(a_ID);
+				if (denseIndex != SparseSet<ComponentType>::INVALID_INDEX)
 				{
-					return m_mComponents.at(a_ID);
+					if (!m_Components.GetValues()[denseIndex].IsDestroyed())
+					{
+						m_Components.MarkChanged(denseIndex, GetChangeTick());
+						return m_Components.GetValues()[denseIndex];
+					}
+
+					m_aDeletedComponents.erase(std::remove(m_aDeletedComponents.begin(), m_aDeletedComponents.end(), a_ID), m_aDeletedComponents.end());
+					ComponentType& component = m_Components.Reset(denseIndex, GetChangeTick());
+					if (m_pECS)
+					{
+						m_pECS->OnComponentAdded(a_ID, GetComponentTypeID());
+					}
+					return component;
 				}
 
-				CreateBaseComponent(a_ID);
-				return m_mComponents.at(a_ID);
+				ComponentType& component = m_Components.Emplace(a_ID, GetChangeTick());
+				if (m_pECS)
+				{
+					m_pECS->OnComponentAdded(a_ID, GetComponentTypeID());
+				}
+				return component;
 			}
 
 			/// <summary>
-			/// Deletes a component from the system.
+			/// Retrieves a component by entity id without creating it.
 			/// </summary>
-			/// <param name="a_ID">The entity ID that needs to get deleted.</param>
-			void DeleteComponent(const EntityID& a_ID)
+			/// <param name="a_ID">The entity that will be checked.</param>
+			/// <returns>Pointer to the component if the entity has one, otherwise nullptr.</returns>
+			ComponentType* TryGetComponent(const EntityID& a_ID)
+			{
+				return m_Components.TryGet(a_ID);
+			}
+
+			/// <summary>
+			/// Marks a component as changed. Needed after writing to a component that was retrieved
+			/// through TryGetComponent, a query or ParallelForEach.
+			/// </summary>
+			/// <param name="a_ID">The entity the component belongs to.</param>
+			void MarkChanged(const EntityID& a_ID)
+			{
+				const uint32_t denseIndex = m_Components.GetDenseIndex(a_ID);
+				if (denseIndex != SparseSet<ComponentType>::INVALID_INDEX)
+				{
+					m_Components.MarkChanged(denseIndex, GetChangeTick());
+				}
+			}
+
+			/// <summary>
+			/// Retrieves the change ticks of a component.
+			/// </summary>
+			/// <param name="a_ID">The entity the component belongs to.</param>
+			/// <returns>Pointer to the ticks if the entity has a component, otherwise nullptr.</returns>
+			const ComponentTicks* TryGetComponentTicks(const EntityID& a_ID) const
+			{
+				return m_Components.TryGetTicks(a_ID);
+			}
+
+			/// <summary>
+			/// Calls a function for every component that passes a change filter, e.g. ForEach&lt;Changed&lt;ComponentType&gt;&gt;(GetLastRunTick(), ...).
+			/// </summary>
+			/// <typeparam name="Filter">Added&lt;ComponentType&gt; or Changed&lt;ComponentType&gt;.</typeparam>
+			/// <param name="a_iSinceTick">Only changes after this tick pass the filter.</param>
+			/// <param name="a_Function">Function that gets called with the entity id and the component.</param>
+			template <class Filter, class Function>
+			void ForEach(uint32_t a_iSinceTick, Function&& a_Function)
 			{
-				auto it = std::find_if(m_mComponents.begin(), m_mComponents.end(), [&](auto& e)
+				static_assert(std::is_same<typename Filter::ComponentType, ComponentType>::value,
+					"Filter must apply to the component type of the system");
+
+				ComponentVector& components = m_Components.GetValues();
+				const std::vector<EntityID>& entities = m_Components.GetEntities();
+				const std::vector<ComponentTicks>& ticks = m_Components.GetTicks();
+				for (size_t i = 0; i < components.size(); i++)
+				{
+					if (Filter::Matches(ticks[i], a_iSinceTick))
 					{
-						return e.first == a_ID;
-					});
-				if (it != m_mComponents.end())
+						a_Function(entities[i], components[i]);
+					}
+				}
+			}
+
+			/// <summary>
+			/// Marks a component for deletion. The component gets removed the next time UpdateComponents is called.
+			/// </summary>
+			/// <param name="a_ID">The entity ID that needs to get deleted.</param>
+			void DeleteComponent(const EntityID& a_ID) override
+			{
+				ComponentType* component = m_Components.TryGet(a_ID);
+				if (!component || component->IsDestroyed())
 				{
-					it->second.Destroy();
+					return;
+				}
+
+				component->Destroy();
+				m_aDeletedComponents.push_back(a_ID);
+
+				if (m_pECS)
+				{
+					m_pECS->OnComponentRemoved(a_ID, GetComponentTypeID());
 				}
 			}
 
@@ -170,7 +324,16 @@ namespace gallus
 			/// </summary>
 			void Clear() override
 			{
-				m_mComponents.clear();
+				if (m_pECS)
+				{
+					for (const EntityID& id : m_Components.GetEntities())
+					{
+						m_pECS->OnComponentRemoved(id, GetComponentTypeID());
+					}
+				}
+
+				m_Components.Clear();
+				m_aDeletedComponents.clear();
 			}
 
 			/// <summary>
@@ -185,24 +348,115 @@ namespace gallus
 			};
 
 			/// <summary>
-			/// Updates the system's components.
+			/// Updates the system's components, removing all components that were marked for deletion.
 			/// </summary>
-			virtual void UpdateComponents() override
+			/// <returns>True if components were removed, otherwise false.</returns>
+			virtual bool UpdateComponents() override
 			{
-				// TODO: delete components.
+				if (m_aDeletedComponents.empty())
+				{
+					return false;
+				}
+
+				for (const EntityID& id : m_aDeletedComponents)
+				{
+					m_Components.Remove(id);
+				}
+				m_aDeletedComponents.clear();
+				return true;
 			}
 
 			/// <summary>
-			/// Retrieves all mesh components.
+			/// Calls a function for every component, spread over the workers of a job system.
+			/// The components are split into chunks of whole cache lines, so two threads never write to the same line.
+			/// The function must not add or remove components. Writes are not tracked, call MarkChanged for components that were changed.
 			/// </summary>
-			/// <returns>A vector containing the entity info and component data of all entities.</returns>
-			std::map<EntityID, ComponentType>& GetComponents()
+			/// <param name="a_JobSystem">The job system that runs the chunks.</param>
+			/// <param name="a_Function">Function that gets called with the entity id and the component.</param>
+			template <class Function>
+			void ParallelForEach(core::JobSystem& a_JobSystem, Function&& a_Function)
 			{
-				return m_mComponents;
+				ComponentVector& components = m_Components.GetValues();
+				const std::vector<EntityID>& entities = m_Components.GetEntities();
+
+				a_JobSystem.ParallelFor(components.size(), core::CacheLineGranularity<ComponentType>(),
+					[&components, &entities, &a_Function](size_t, size_t a_iBegin, size_t a_iEnd)
+					{
+						for (size_t i = a_iBegin; i < a_iEnd; i++)
+						{
+							a_Function(entities[i], components[i]);
+						}
+					});
+			}
+
+			/// <summary>
+			/// Calls a function for every component, spread over the workers of a job system, and combines the results.
+			/// Every chunk accumulates into its own scratch value, starting from a copy of a_Identity. The scratch values are
+			/// combined in chunk order afterwards, so the result does not depend on which thread processed which chunk.
+			/// The function must not add or remove components.
+			/// </summary>
+			/// <param name="a_JobSystem">The job system that runs the chunks.</param>
+			/// <param name="a_Identity">The value every scratch value and the result start from.</param>
+			/// <param name="a_Function">Function that gets called with the chunk's scratch value, the entity id and the component.</param>
+			/// <param name="a_Reduce">Function that combines a scratch value (second argument) into the result (first argument).</param>
+			/// <returns>The combined result of all chunks.</returns>
+			template <class Scratch, class Function, class Reduce>
+			Scratch ParallelReduce(core::JobSystem& a_JobSystem, const Scratch& a_Identity, Function&& a_Function, Reduce&& a_Reduce)
+			{
+				ComponentVector& components = m_Components.GetValues();
+				const std::vector<EntityID>& entities = m_Components.GetEntities();
+
+				const size_t granularity = core::CacheLineGranularity<ComponentType>();
+				std::vector<core::CacheAligned<Scratch>> scratch(a_JobSystem.GetChunkCount(components.size(), granularity), core::CacheAligned<Scratch>{ a_Identity });
+
+				a_JobSystem.ParallelFor(components.size(), granularity,
+					[&components, &entities, &scratch, &a_Function](size_t a_iChunk, size_t a_iBegin, size_t a_iEnd)
+					{
+						Scratch& chunkScratch = scratch[a_iChunk].m_Value;
+						for (size_t i = a_iBegin; i < a_iEnd; i++)
+						{
+							a_Function(chunkScratch, entities[i], components[i]);
+						}
+					});
+
+				Scratch result = a_Identity;
+				for (const core::CacheAligned<Scratch>& chunkScratch : scratch)
+				{
+					a_Reduce(result, chunkScratch.m_Value);
+				}
+				return result;
+			}
+
+			/// <summary>
+			/// Retrieves all components, densely packed.
+			/// </summary>
+			/// <returns>A vector containing the component data of all entities, in the same order as GetComponentEntities.</returns>
+			ComponentVector& GetComponents()
+			{
+				return m_Components.GetValues();
+			}
+
+			/// <summary>
+			/// Retrieves the entities that own the components.
+			/// </summary>
+			/// <returns>A vector containing the entity ids, in the same order as GetComponents.</returns>
+			const std::vector<EntityID>& GetComponentEntities() const
+			{
+				return m_Components.GetEntities();
 			}
 		protected:
+			/// <summary>
+			/// Retrieves the tick that added and changed components get stamped with.
+			/// </summary>
+			/// <returns>The current change tick of the ECS, or 0 if the system is not part of an ECS.</returns>
+			uint32_t GetChangeTick() const
+			{
+				return m_pECS ? m_pECS->GetChangeTick() : 0;
+			}
+
 			// TODO: We can only have one for each entity. If I want multiple components this will be a problem.
-			std::map<EntityID, ComponentType> m_mComponents;
+			SparseSet<ComponentType> m_Components;
+			std::vector<EntityID> m_aDeletedComponents; /// Components marked for deletion since the last UpdateComponents.
 		};
 	}
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include <string>
 
 #include "EntityID.h"
+#include "EntityNameIndex.h"
 
 namespace gallus
 {
@@ -13,14 +14,14 @@ namespace gallus
 		//---------------------------------------------------------------------
 		/// <summary>
 		/// Wrapper class that contains specific info all entities have.
+		/// The name is interned in the ECS's name index, renaming goes through EntityComponentSystem::RenameEntity.
 		/// </summary>
 		class Entity
 		{
 		public:
 			Entity() = default;
-			Entity(const EntityID& a_EntityID, const std::string& a_sName) :
-				m_EntityID(a_EntityID),
-				m_sName(a_sName)
+			Entity(const EntityID& a_EntityID) :
+				m_EntityID(a_EntityID)
 			{}
 
 			EntityID& GetEntityID()
@@ -33,14 +34,10 @@ namespace gallus
 				return m_EntityID;
 			}
 
-			void SetName(const std::string& a_sName)
-			{
-				m_sName = a_sName;
-			}
-
 			const std::string& GetName() const
 			{
-				return m_sName;
+				static const std::string EMPTY_NAME;
+				return m_pName ? m_pName->m_sName : EMPTY_NAME;
 			}
 
 			bool IsDestroyed() const
@@ -63,8 +60,11 @@ namespace gallus
 				m_bIsActive = a_bIsActive;
 			}
 		private:
+			friend class EntityComponentSystem;
+
 			EntityID m_EntityID;
-			std::string m_sName;
+			const EntityName* m_pName = nullptr; /// Interned name, owned by the name index of the ECS.
+			uint32_t m_iNameIndex = 0; /// Position of the entity in the entity list of its name.
 			bool m_bIsDestroyed = false;
 			bool m_bIsActive = true;
 		};
@@ -2,6 +2,8 @@
 
 #include "logger/Logger.h"
 
+#include "core/JobSystem.h"
+
 #include "gameplay/ECSBaseSystem.h"
 
 #include "gameplay/systems/TransformSystem.h"
@@ -37,6 +39,12 @@ namespace gallus
 				system->Destroy();
 				delete system;
 			}
+			m_aSystems.clear();
+			m_aSystemsByType.clear();
+			m_aComponentSystems.clear();
+			m_aQueryCaches.clear();
+			m_aSystemNodes.clear();
+			m_bScheduleDirty = true;
 			LOG(LOGSEVERITY_SUCCESS, LOG_CATEGORY_ECS, "ECS destroyed.");
 			return System::Destroy();
 		}
@@ -46,51 +54,195 @@ namespace gallus
 		{
 			std::lock_guard<std::recursive_mutex> lock(m_EntityMutex);
 
-			for (const Entity& entity : m_aEntities)
+			ApplyPendingDeletes();
+
+			if (!m_bStarted)
 			{
-				for (AbstractECSSystem* sys : m_aSystems)
+				return;
+			}
+
+			if (m_bPaused)
+			{
+				return;
+			}
+
+			m_UpdateThreadID.store(std::this_thread::get_id(), std::memory_order_relaxed);
+			m_bUpdatingSystems.store(true, std::memory_order_release);
+			UpdateSystems(a_fDeltaTime);
+
+			// All systems are done, queries can pick up the changes that were held back during the update.
+			if (m_bStructureChangedWhileUpdating)
+			{
+				m_bStructureChangedWhileUpdating = false;
+				m_iStructureVersion++;
+			}
+			m_bUpdatingSystems.store(false, std::memory_order_release);
+		}
+
+		//---------------------------------------------------------------------
+		std::unique_lock<std::recursive_mutex> EntityComponentSystem::LockEntities() const
+		{
+			// While the systems update, the game thread holds m_EntityMutex and waits for the workers. Those and the game thread
+			// take m_UpdateMutex instead, so systems on workers can use the ECS while other threads still wait for the update.
+			if (m_bUpdatingSystems.load(std::memory_order_acquire) &&
+				(std::this_thread::get_id() == m_UpdateThreadID.load(std::memory_order_relaxed) ||
+				(m_pJobSystem && m_pJobSystem->GetCurrentWorkerIndex() != core::JobSystem::INVALID_WORKER)))
+			{
+				return std::unique_lock<std::recursive_mutex>(m_UpdateMutex);
+			}
+			return std::unique_lock<std::recursive_mutex>(m_EntityMutex);
+		}
+
+		//---------------------------------------------------------------------
+		void EntityComponentSystem::SetJobSystem(core::JobSystem* a_pJobSystem)
+		{
+			m_pJobSystem = a_pJobSystem;
+		}
+
+		//---------------------------------------------------------------------
+		void EntityComponentSystem::BuildSchedule()
+		{
+			const uint32_t systemCount = static_cast<uint32_t>(m_aSystems.size());
+
+			m_aSystemNodes.clear();
+			m_aSystemNodes.resize(systemCount);
+			m_aPendingDependencies = std::make_unique<std::atomic<uint32_t>[]>(systemCount);
+
+			std::vector<ComponentSignature> reads(systemCount), writes(systemCount);
+			for (uint32_t i = 0; i < systemCount; i++)
+			{
+				m_aSystemNodes[i].m_pSystem = m_aSystems[i];
+				m_aSystemNodes[i].m_bGameThread = m_aSystems[i]->RunsOnGameThread();
+				reads[i] = m_aSystems[i]->GetReadComponents();
+				writes[i] = m_aSystems[i]->GetWriteComponents();
+			}
+
+			for (uint32_t later = 0; later < systemCount; later++)
+			{
+				for (uint32_t earlier = 0; earlier < later; earlier++)
 				{
-					sys->DeleteComponent(entity.GetEntityID());
+					const bool conflicts =
+						(writes[earlier] & (reads[later] | writes[later])).any() ||
+						(writes[later] & reads[earlier]).any();
+					if (conflicts)
+					{
+						m_aSystemNodes[earlier].m_aDependents.push_back(later);
+						m_aSystemNodes[later].m_iDependencyCount++;
+					}
 				}
 			}
 
-			size_t oldSize = m_aEntities.size();
-			m_aEntities.erase(
-				std::remove_if(m_aEntities.begin(), m_aEntities.end(),
-				[](const Entity& e)
+			m_bScheduleDirty = false;
+		}
+
+		//---------------------------------------------------------------------
+		void EntityComponentSystem::UpdateSystems(float a_fDeltaTime)
+		{
+			if (m_aSystems.size() < 2 || !m_pJobSystem || !m_pJobSystem->Running() || m_pJobSystem->GetWorkerCount() == 0)
+			{
+				for (AbstractECSSystem* sys : m_aSystems)
 				{
-					return e.IsDestroyed();
-				}),
-				m_aEntities.end()
-			);
+					UpdateSystem(sys, a_fDeltaTime);
+				}
+			}
+			else
+			{
+				UpdateSystemsParallel(a_fDeltaTime);
+			}
 
-			if (oldSize != m_aEntities.size())
+			// Changes made between updates get a tick newer than every system's last run tick.
+			AdvanceChangeTick();
+		}
+
+		//---------------------------------------------------------------------
+		void EntityComponentSystem::UpdateSystemsParallel(float a_fDeltaTime)
+		{
+			if (m_bScheduleDirty)
 			{
-				m_eOnEntitiesUpdated();
-				m_eOnEntityComponentsUpdated();
+				BuildSchedule();
 			}
 
-			// Delete components if applicable.
-			for (auto& sys : m_aSystems)
+			const uint32_t systemCount = static_cast<uint32_t>(m_aSystemNodes.size());
+			for (uint32_t i = 0; i < systemCount; i++)
 			{
-				sys->UpdateComponents();
+				m_aPendingDependencies[i].store(m_aSystemNodes[i].m_iDependencyCount, std::memory_order_relaxed);
 			}
+			m_iRemainingSystems.store(systemCount, std::memory_order_release);
 
-			if (!m_bStarted)
+			for (uint32_t i = 0; i < systemCount; i++)
 			{
-				return;
+				if (m_aSystemNodes[i].m_iDependencyCount == 0)
+				{
+					DispatchSystem(i, a_fDeltaTime);
+				}
 			}
 
-			if (m_bPaused)
+			// The game thread updates the systems that need it and helps out with the other ones while waiting.
+			while (m_iRemainingSystems.load(std::memory_order_acquire) != 0)
 			{
+				uint32_t node = 0;
+				bool hasNode = false;
+				{
+					std::lock_guard<std::mutex> lock(m_GameThreadQueueMutex);
+					if (!m_aGameThreadQueue.empty())
+					{
+						node = m_aGameThreadQueue.back();
+						m_aGameThreadQueue.pop_back();
+						hasNode = true;
+					}
+				}
+
+				if (hasNode)
+				{
+					RunSystem(node, a_fDeltaTime);
+				}
+				else if (!m_pJobSystem->TryExecuteJob())
+				{
+					std::this_thread::yield();
+				}
+			}
+		}
+
+		//---------------------------------------------------------------------
+		void EntityComponentSystem::UpdateSystem(AbstractECSSystem* a_pSystem, float a_fDeltaTime)
+		{
+			const uint32_t runTick = AdvanceChangeTick();
+			a_pSystem->Update(a_fDeltaTime);
+			a_pSystem->m_iLastRunTick = runTick;
+		}
+
+		//---------------------------------------------------------------------
+		void EntityComponentSystem::DispatchSystem(uint32_t a_iNode, float a_fDeltaTime)
+		{
+			if (m_aSystemNodes[a_iNode].m_bGameThread)
+			{
+				std::lock_guard<std::mutex> lock(m_GameThreadQueueMutex);
+				m_aGameThreadQueue.push_back(a_iNode);
 				return;
 			}
 
-			for (auto& sys : m_aSystems)
+			m_pJobSystem->Schedule([this, a_iNode, a_fDeltaTime]()
+				{
+					RunSystem(a_iNode, a_fDeltaTime);
+				});
+		}
+
+		//---------------------------------------------------------------------
+		void EntityComponentSystem::RunSystem(uint32_t a_iNode, float a_fDeltaTime)
+		{
+			const SystemNode& node = m_aSystemNodes[a_iNode];
+			UpdateSystem(node.m_pSystem, a_fDeltaTime);
+
+			for (uint32_t dependent : node.m_aDependents)
 			{
-				sys->Update(a_fDeltaTime);
+				if (m_aPendingDependencies[dependent].fetch_sub(1, std::memory_order_acq_rel) == 1)
+				{
+					DispatchSystem(dependent, a_fDeltaTime);
+				}
 			}
 
+			// Decremented last, so the game thread keeps waiting until all dependents have been dispatched.
+			m_iRemainingSystems.fetch_sub(1, std::memory_order_acq_rel);
 		}
 
 		//---------------------------------------------------------------------
@@ -120,53 +272,181 @@ namespace gallus
 		//---------------------------------------------------------------------
 		EntityID EntityComponentSystem::CreateEntity(const std::string& a_sName)
 		{
-			std::lock_guard<std::recursive_mutex> lock(m_EntityMutex);
+			std::unique_lock<std::recursive_mutex> lock = LockEntities();
 
-			const EntityID id(++m_iNextID);
-			m_aEntities.emplace_back(id, a_sName);
+			if (!CanCreateEntities(1))
+			{
+				LOGF(LOGSEVERITY_ERROR, LOG_CATEGORY_ECS, "Failed creating entity \"%s\": maximum amount of entities reached.", a_sName.c_str());
+				return EntityID();
+			}
 
-			m_eOnEntitiesUpdated();
+			Entity& entity = AllocateEntity();
+			const EntityID id = entity.GetEntityID();
+			entity.m_pName = m_NameIndex.Add(a_sName, id, entity.m_iNameIndex);
+
+			m_eOnEntitiesUpdated(std::span<const EntityID>(&id, 1));
 
 			return id;
 		}
 
+		//---------------------------------------------------------------------
+		std::vector<EntityID> EntityComponentSystem::CreateEntities(uint32_t a_iCount, const std::string& a_sName)
+		{
+			std::unique_lock<std::recursive_mutex> lock = LockEntities();
+
+			std::vector<EntityID> ids;
+			if (a_iCount == 0)
+			{
+				return ids;
+			}
+
+			if (!CanCreateEntities(a_iCount))
+			{
+				LOGF(LOGSEVERITY_ERROR, LOG_CATEGORY_ECS, "Failed creating %u entities \"%s\": maximum amount of entities reached.", a_iCount, a_sName.c_str());
+				return ids;
+			}
+
+			const size_t firstEntity = m_aEntities.size();
+			m_aEntities.reserve(firstEntity + a_iCount);
+			ids.reserve(a_iCount);
+			for (uint32_t i = 0; i < a_iCount; i++)
+			{
+				ids.push_back(AllocateEntity().GetEntityID());
+			}
+
+			// All entities share the interned name and take consecutive positions in its entity list.
+			uint32_t nameIndex = 0;
+			const EntityName* name = m_NameIndex.Add(a_sName, ids, nameIndex);
+			for (uint32_t i = 0; i < a_iCount; i++)
+			{
+				Entity& entity = m_aEntities[firstEntity + i];
+				entity.m_pName = name;
+				entity.m_iNameIndex = nameIndex + i;
+			}
+
+			m_eOnEntitiesUpdated(ids);
+
+			return ids;
+		}
+
+		//---------------------------------------------------------------------
+		std::vector<EntityID> EntityComponentSystem::CreateEntities(std::span<const std::string> a_aNames)
+		{
+			std::unique_lock<std::recursive_mutex> lock = LockEntities();
+
+			std::vector<EntityID> ids;
+			if (a_aNames.empty())
+			{
+				return ids;
+			}
+
+			if (!CanCreateEntities(a_aNames.size()))
+			{
+				LOGF(LOGSEVERITY_ERROR, LOG_CATEGORY_ECS, "Failed creating %zu entities: maximum amount of entities reached.", a_aNames.size());
+				return ids;
+			}
+
+			m_aEntities.reserve(m_aEntities.size() + a_aNames.size());
+			ids.reserve(a_aNames.size());
+			for (const std::string& name : a_aNames)
+			{
+				Entity& entity = AllocateEntity();
+				entity.m_pName = m_NameIndex.Add(name, entity.GetEntityID(), entity.m_iNameIndex);
+				ids.push_back(entity.GetEntityID());
+			}
+
+			m_eOnEntitiesUpdated(ids);
+
+			return ids;
+		}
+
+		//---------------------------------------------------------------------
+		bool EntityComponentSystem::CanCreateEntities(size_t a_iCount) const
+		{
+			return a_iCount <= m_aFreeSlots.size() + (EntityID::MAX_ENTITIES - m_aEntitySlots.size());
+		}
+
+		//---------------------------------------------------------------------
+		Entity& EntityComponentSystem::AllocateEntity()
+		{
+			uint32_t slotIndex = 0;
+			if (!m_aFreeSlots.empty())
+			{
+				slotIndex = m_aFreeSlots.front();
+				m_aFreeSlots.pop_front();
+			}
+			else
+			{
+				slotIndex = static_cast<uint32_t>(m_aEntitySlots.size());
+				m_aEntitySlots.emplace_back();
+			}
+
+			EntitySlot& slot = m_aEntitySlots[slotIndex];
+			slot.m_iEntityIndex = static_cast<uint32_t>(m_aEntities.size());
+			return m_aEntities.emplace_back(EntityID(slotIndex, slot.m_iGeneration));
+		}
+
 		//---------------------------------------------------------------------
 		bool EntityComponentSystem::IsEntityValid(const EntityID& a_ID) const
 		{
-			std::lock_guard<std::recursive_mutex> lock(m_EntityMutex);
+			std::unique_lock<std::recursive_mutex> lock = LockEntities();
 
-			return a_ID.IsValid();
+			const uint32_t index = GetEntityIndex(a_ID);
+			return index != INVALID_ENTITY_INDEX && !m_aEntities[index].IsDestroyed();
 		}
 
 		//---------------------------------------------------------------------
 		void EntityComponentSystem::DeleteEntity(const EntityID& a_ID)
 		{
-			std::lock_guard<std::recursive_mutex> lock(m_EntityMutex);
+			std::unique_lock<std::recursive_mutex> lock = LockEntities();
 
-			auto it = std::find_if(m_aEntities.begin(), m_aEntities.end(), [&](Entity& e)
-				{
-					return e.GetEntityID() == a_ID;
-				});
-			if (it != m_aEntities.end())
+			const uint32_t index = GetEntityIndex(a_ID);
+			if (index == INVALID_ENTITY_INDEX || m_aEntities[index].IsDestroyed())
 			{
-				it->Destroy();
+				return;
 			}
+
+			m_aEntities[index].Destroy();
+			m_aDeletedEntities.push_back(a_ID);
+			OnStructureChanged();
 		}
 
 		//---------------------------------------------------------------------
-		const Entity* EntityComponentSystem::GetEntity(const EntityID& a_ID) const
+		void EntityComponentSystem::DeleteEntities(std::span<const EntityID> a_aIDs)
 		{
-			std::lock_guard<std::recursive_mutex> lock(m_EntityMutex);
+			std::unique_lock<std::recursive_mutex> lock = LockEntities();
+
+			m_aDeletedEntities.reserve(m_aDeletedEntities.size() + a_aIDs.size());
 
-			auto it = std::find_if(m_aEntities.begin(), m_aEntities.end(),
-				[&](const Entity& e)
+			bool deleted = false;
+			for (const EntityID& id : a_aIDs)
+			{
+				const uint32_t index = GetEntityIndex(id);
+				if (index == INVALID_ENTITY_INDEX || m_aEntities[index].IsDestroyed())
 				{
-					return e.GetEntityID() == a_ID;
-				});
+					continue;
+				}
 
-			if (it != m_aEntities.end())
+				m_aEntities[index].Destroy();
+				m_aDeletedEntities.push_back(id);
+				deleted = true;
+			}
+
+			if (deleted)
+			{
+				OnStructureChanged();
+			}
+		}
+
+		//---------------------------------------------------------------------
+		const Entity* EntityComponentSystem::GetEntity(const EntityID& a_ID) const
+		{
+			std::unique_lock<std::recursive_mutex> lock = LockEntities();
+
+			const uint32_t index = GetEntityIndex(a_ID);
+			if (index != INVALID_ENTITY_INDEX)
 			{
-				return &(*it);
+				return &m_aEntities[index];
 			}
 
 			return nullptr;
@@ -175,69 +455,297 @@ namespace gallus
 		//---------------------------------------------------------------------
 		Entity* EntityComponentSystem::GetEntity(const EntityID& a_ID)
 		{
-			std::lock_guard<std::recursive_mutex> lock(m_EntityMutex);
+			std::unique_lock<std::recursive_mutex> lock = LockEntities();
 
-			auto it = std::find_if(m_aEntities.begin(), m_aEntities.end(), [&](Entity& e)
+			const uint32_t index = GetEntityIndex(a_ID);
+			if (index != INVALID_ENTITY_INDEX)
+				return &m_aEntities[index];
+
+			return nullptr;
+		}
+
+		//---------------------------------------------------------------------
+		void EntityComponentSystem::OnComponentAdded(const EntityID& a_ID, uint32_t a_iComponentTypeID)
+		{
+			std::unique_lock<std::recursive_mutex> lock = LockEntities();
+
+			if (!GetEntitySlot(a_ID))
+			{
+				return;
+			}
+
+			m_aEntitySlots[a_ID.GetIndex()].m_Signature.set(a_iComponentTypeID);
+			OnStructureChanged(ComponentSignature().set(a_iComponentTypeID));
+		}
+
+		//---------------------------------------------------------------------
+		void EntityComponentSystem::OnComponentRemoved(const EntityID& a_ID, uint32_t a_iComponentTypeID)
+		{
+			std::unique_lock<std::recursive_mutex> lock = LockEntities();
+
+			if (!GetEntitySlot(a_ID))
+			{
+				return;
+			}
+
+			m_aEntitySlots[a_ID.GetIndex()].m_Signature.reset(a_iComponentTypeID);
+			OnStructureChanged();
+		}
+
+		//---------------------------------------------------------------------
+		void EntityComponentSystem::OnStructureChanged(const ComponentSignature& a_AddedComponents)
+		{
+			if (!m_bUpdatingSystems.load(std::memory_order_acquire))
+			{
+				m_iStructureVersion++;
+				return;
+			}
+
+			// Other systems can be iterating query results right now. Deleted components stay in storage until the next update,
+			// so those results stay valid. Added components can move their storage, but the scheduler keeps the systems that
+			// read those types from running at the same time as the system that adds them.
+			m_bStructureChangedWhileUpdating = true;
+			if (a_AddedComponents.none())
+			{
+				return;
+			}
+
+			std::lock_guard<std::mutex> lock(m_QueryMutex);
+			for (std::unique_ptr<AbstractQueryCache>& cache : m_aQueryCaches)
+			{
+				if (cache && (cache->m_Signature & a_AddedComponents).any())
 				{
-					return e.GetEntityID() == a_ID;
-				});
+					cache->m_iStructureVersion = UINT64_MAX;
+				}
+			}
+		}
 
-			if (it != m_aEntities.end())
-				return &(*it);
+		//---------------------------------------------------------------------
+		ComponentSignature EntityComponentSystem::GetSignature(const EntityID& a_ID) const
+		{
+			std::unique_lock<std::recursive_mutex> lock = LockEntities();
 
-			return nullptr;
+			const EntitySlot* slot = GetEntitySlot(a_ID);
+			return slot ? slot->m_Signature : ComponentSignature();
+		}
+
+		//---------------------------------------------------------------------
+		void EntityComponentSystem::RegisterSystem(AbstractECSSystem* a_pSystem)
+		{
+			a_pSystem->m_pECS = this;
+			m_aSystems.push_back(a_pSystem);
+			m_bScheduleDirty = true;
+
+			const uint32_t componentTypeID = a_pSystem->GetComponentTypeID();
+			if (componentTypeID >= MAX_COMPONENT_TYPES)
+			{
+				LOGF(LOGSEVERITY_ERROR, LOG_CATEGORY_ECS, "Failed registering system \"%s\": more than %u component types.", a_pSystem->GetPropertyName().c_str(), MAX_COMPONENT_TYPES);
+				return;
+			}
+
+			if (componentTypeID >= m_aComponentSystems.size())
+			{
+				m_aComponentSystems.resize(componentTypeID + 1, nullptr);
+			}
+			m_aComponentSystems[componentTypeID] = a_pSystem;
+		}
+
+		//---------------------------------------------------------------------
+		const EntityComponentSystem::EntitySlot* EntityComponentSystem::GetEntitySlot(const EntityID& a_ID) const
+		{
+			if (!a_ID.IsValid() || a_ID.GetIndex() >= m_aEntitySlots.size())
+			{
+				return nullptr;
+			}
+
+			const EntitySlot& slot = m_aEntitySlots[a_ID.GetIndex()];
+			if (slot.m_iGeneration != a_ID.GetGeneration() || slot.m_iEntityIndex == INVALID_ENTITY_INDEX)
+			{
+				return nullptr;
+			}
+
+			return &slot;
+		}
+
+		//---------------------------------------------------------------------
+		uint32_t EntityComponentSystem::GetEntityIndex(const EntityID& a_ID) const
+		{
+			const EntitySlot* slot = GetEntitySlot(a_ID);
+			return slot ? slot->m_iEntityIndex : INVALID_ENTITY_INDEX;
+		}
+
+		//---------------------------------------------------------------------
+		void EntityComponentSystem::ApplyPendingDeletes()
+		{
+			// Components of deleted entities are marked first, so every system removes its components in a single pass.
+			for (const EntityID& id : m_aDeletedEntities)
+			{
+				for (AbstractECSSystem* sys : m_aSystems)
+				{
+					sys->DeleteComponent(id);
+				}
+			}
+
+			bool componentsRemoved = false;
+			for (AbstractECSSystem* sys : m_aSystems)
+			{
+				componentsRemoved |= sys->UpdateComponents();
+			}
+
+			// Removing components moves other components in the storage, cached query pointers are no longer valid.
+			if (componentsRemoved)
+			{
+				m_iStructureVersion++;
+			}
+
+			if (m_aDeletedEntities.empty())
+			{
+				if (componentsRemoved)
+				{
+					m_eOnEntityComponentsUpdated();
+				}
+				return;
+			}
+
+			for (const EntityID& id : m_aDeletedEntities)
+			{
+				const uint32_t index = GetEntityIndex(id);
+				if (index != INVALID_ENTITY_INDEX)
+				{
+					ReleaseEntity(index);
+				}
+			}
+
+			// All entities deleted since the last update are reported in one notification.
+			m_eOnEntitiesUpdated(m_aDeletedEntities);
+			m_aDeletedEntities.clear();
+
+			m_eOnEntityComponentsUpdated();
+		}
+
+		//---------------------------------------------------------------------
+		void EntityComponentSystem::RemoveEntityName(Entity& a_Entity)
+		{
+			// The last entity with the same name takes over the position in the name's entity list.
+			const EntityID moved = m_NameIndex.Remove(a_Entity.m_pName, a_Entity.m_iNameIndex);
+			const uint32_t movedIndex = GetEntityIndex(moved);
+			if (movedIndex != INVALID_ENTITY_INDEX)
+			{
+				m_aEntities[movedIndex].m_iNameIndex = a_Entity.m_iNameIndex;
+			}
+			a_Entity.m_pName = nullptr;
+			a_Entity.m_iNameIndex = 0;
+		}
+
+		//---------------------------------------------------------------------
+		void EntityComponentSystem::ReleaseEntity(uint32_t a_iEntityIndex)
+		{
+			const EntityID id = m_aEntities[a_iEntityIndex].GetEntityID();
+			RemoveEntityName(m_aEntities[a_iEntityIndex]);
+
+			EntitySlot& slot = m_aEntitySlots[id.GetIndex()];
+			slot.m_iGeneration = EntityID::NextGeneration(slot.m_iGeneration);
+			slot.m_iEntityIndex = INVALID_ENTITY_INDEX;
+			slot.m_Signature.reset();
+			m_aFreeSlots.push_back(id.GetIndex());
+
+			// Swap and pop, the last entity takes the place of the released one.
+			const uint32_t lastIndex = static_cast<uint32_t>(m_aEntities.size() - 1);
+			if (a_iEntityIndex != lastIndex)
+			{
+				m_aEntities[a_iEntityIndex] = std::move(m_aEntities[lastIndex]);
+				m_aEntitySlots[m_aEntities[a_iEntityIndex].GetEntityID().GetIndex()].m_iEntityIndex = a_iEntityIndex;
+			}
+			m_aEntities.pop_back();
 		}
 
 		//---------------------------------------------------------------------
 		void EntityComponentSystem::Clear()
 		{
-			std::lock_guard<std::recursive_mutex> lock(m_EntityMutex);
+			std::unique_lock<std::recursive_mutex> lock = LockEntities();
 
 			for (Entity& entity : m_aEntities)
 			{
-				entity.Destroy();
+				if (!entity.IsDestroyed())
+				{
+					entity.Destroy();
+					m_aDeletedEntities.push_back(entity.GetEntityID());
+				}
+
+				// Names are freed right away, so entities created before the next update (like a scene that gets loaded) can reuse them.
+				entity.m_pName = nullptr;
+				entity.m_iNameIndex = 0;
 			}
+			m_NameIndex.Clear();
+			OnStructureChanged();
 		}
 
 		//---------------------------------------------------------------------
 		std::string EntityComponentSystem::GetUniqueName(const std::string& a_sName)
 		{
-			std::lock_guard<std::recursive_mutex> lock(m_EntityMutex);
+			std::unique_lock<std::recursive_mutex> lock = LockEntities();
+
+			return m_NameIndex.GetUniqueName(a_sName);
+		}
+
+		//---------------------------------------------------------------------
+		bool EntityComponentSystem::RenameEntity(const EntityID& a_ID, const std::string& a_sName)
+		{
+			std::unique_lock<std::recursive_mutex> lock = LockEntities();
+
+			const uint32_t index = GetEntityIndex(a_ID);
+			if (index == INVALID_ENTITY_INDEX)
+			{
+				LOGF(LOGSEVERITY_ERROR, LOG_CATEGORY_ECS, "Failed renaming entity to \"%s\": entity does not exist.", a_sName.c_str());
+				return false;
+			}
 
-			std::string name = a_sName;
+			Entity& entity = m_aEntities[index];
+			if (entity.GetName() == a_sName)
+			{
+				return true;
+			}
+
+			RemoveEntityName(entity);
+			entity.m_pName = m_NameIndex.Add(a_sName, a_ID, entity.m_iNameIndex);
+
+			m_eOnEntitiesUpdated(std::span<const EntityID>(&a_ID, 1));
+
+			return true;
+		}
+
+		//---------------------------------------------------------------------
+		EntityID EntityComponentSystem::FindEntity(const std::string& a_sName) const
+		{
+			std::unique_lock<std::recursive_mutex> lock = LockEntities();
 
-			bool found = true;
-			int i = 0;
-			while (found)
+			const EntityName* name = m_NameIndex.Find(a_sName);
+			if (!name)
 			{
-				found = false;
-				for (Entity& entity : m_aEntities)
+				return EntityID();
+			}
+
+			for (const EntityID& id : name->m_aEntities)
+			{
+				if (!m_aEntities[GetEntityIndex(id)].IsDestroyed())
 				{
-					if (entity.GetName() == name)
-					{
-						i++;
-						if (i != 0)
-						{
-							name = a_sName + " (" + std::to_string(i) + ")";
-							found = true;
-						}
-					}
+					return id;
 				}
 			}
-			return name;
+			return EntityID();
 		}
 
 		//---------------------------------------------------------------------
 		std::vector<Entity>& EntityComponentSystem::GetEntities()
 		{
-			std::lock_guard<std::recursive_mutex> lock(m_EntityMutex);
+			std::unique_lock<std::recursive_mutex> lock = LockEntities();
 			return m_aEntities;
 		}
 
 		//---------------------------------------------------------------------
 		std::vector<AbstractECSSystem*> EntityComponentSystem::GetSystemsContainingEntity(const EntityID& a_ID)
 		{
-			std::lock_guard<std::recursive_mutex> lock(m_EntityMutex);
+			std::unique_lock<std::recursive_mutex> lock = LockEntities();
 
 			std::vector<AbstractECSSystem*> systems;
 			for (AbstractECSSystem* system : m_aSystems)
@@ -253,7 +761,7 @@ namespace gallus
 		//---------------------------------------------------------------------
 		std::vector<AbstractECSSystem*> EntityComponentSystem::GetSystemsContainingEntity(const Entity& a_Entity)
 		{
-			std::lock_guard<std::recursive_mutex> lock(m_EntityMutex);
+			std::unique_lock<std::recursive_mutex> lock = LockEntities();
 
 			return GetSystemsContainingEntity(a_Entity.GetEntityID());
 		}
@@ -261,7 +769,7 @@ namespace gallus
 		//---------------------------------------------------------------------
 		std::vector<AbstractECSSystem*> EntityComponentSystem::GetSystems()
 		{
-			std::lock_guard<std::recursive_mutex> lock(m_EntityMutex);
+			std::unique_lock<std::recursive_mutex> lock = LockEntities();
 
 			return m_aSystems;
 		}
@@ -3,18 +3,42 @@
 #include "core/System.h"
 
 #include <vector>
+#include <deque>
 #include <string>
 #include <mutex>
+#include <memory>
+#include <tuple>
+#include <atomic>
+#include <span>
+#include <thread>
 
 #include "Entity.h"
+#include "gameplay/EntityNameIndex.h"
 #include "core/Event.h"
+#include "core/TypeIndex.h"
+#include "gameplay/ComponentSignature.h"
+#include "gameplay/ChangeTracking.h"
+#include "gameplay/QueryCache.h"
 
 namespace gallus
 {
+	namespace core
+	{
+		class JobSystem;
+	}
 	namespace gameplay
 	{
 		class AbstractECSSystem;
 
+		template <class ComponentType>
+		class ECSBaseSystem;
+
+		/// <summary>
+		/// Tag type for the system type index family.
+		/// </summary>
+		struct SystemTypeFamily
+		{};
+
 		/// <summary>
 		/// Class that contains all gameplay elements in the engine.
 		/// </summary>
@@ -42,6 +66,12 @@ namespace gallus
 			/// <param name="a_fDeltaTime">The time that has passed since the last frame.</param>
 			void Update(const float& a_fDeltaTime);
 
+			/// <summary>
+			/// Sets the job system that is used to update systems in parallel. Without a job system, systems are updated one after another.
+			/// </summary>
+			/// <param name="a_pJobSystem">The job system, or nullptr.</param>
+			void SetJobSystem(core::JobSystem* a_pJobSystem);
+
 			/// <summary>
 			/// Retrieves the current play state of the ECS. The ECS can be started and paused at the same time.
 			/// </summary>
@@ -74,18 +104,39 @@ namespace gallus
 			EntityID CreateEntity(const std::string& a_sName);
 
 			/// <summary>
-			/// Checks whether an entity is valid.
+			/// Creates multiple entities that share the same name, firing a single change notification for all of them.
+			/// </summary>
+			/// <param name="a_iCount">The number of entities to create.</param>
+			/// <param name="a_sName">The name of the entities.</param>
+			/// <returns>The entity IDs that got created, or an empty vector if there was no room for all of them.</returns>
+			std::vector<EntityID> CreateEntities(uint32_t a_iCount, const std::string& a_sName);
+
+			/// <summary>
+			/// Creates one entity per name, firing a single change notification for all of them.
+			/// </summary>
+			/// <param name="a_aNames">The names of the entities.</param>
+			/// <returns>The entity IDs that got created, in the same order as the names, or an empty vector if there was no room for all of them.</returns>
+			std::vector<EntityID> CreateEntities(std::span<const std::string> a_aNames);
+
+			/// <summary>
+			/// Checks whether an entity is valid. Ids of deleted entities are no longer valid, even after their slot gets reused.
 			/// </summary>
 			/// <param name="a_ID"></param>
 			/// <returns>True if the entity was valid, otherwise false.</returns>
 			bool IsEntityValid(const EntityID& a_ID) const;
 
 			/// <summary>
-			/// Deletes an entity.
+			/// Deletes an entity. The entity and its components get removed at the start of the next update.
 			/// </summary>
 			/// <param name="a_ID">The entity that will be deleted.</param>
 			void DeleteEntity(const EntityID& a_ID);
 
+			/// <summary>
+			/// Deletes multiple entities. The entities and their components get removed at the start of the next update.
+			/// </summary>
+			/// <param name="a_aIDs">The entities that will be deleted.</param>
+			void DeleteEntities(std::span<const EntityID> a_aIDs);
+
 			/// <summary>
 			/// Gets entity info from a specific entity.
 			/// </summary>
@@ -104,12 +155,27 @@ namespace gallus
 			void Clear();
 
 			/// <summary>
-			/// Returns a unique name and looks through all entities if a name already exists.
+			/// Returns a unique name, appending " (n)" to the name if an entity with that name already exists.
 			/// </summary>
 			/// <param name="a_Name">The name to check against.</param>
 			/// <returns>A string containing a unique name for an entity.</returns>
 			std::string GetUniqueName(const std::string& a_Name);
 
+			/// <summary>
+			/// Renames an entity.
+			/// </summary>
+			/// <param name="a_ID">The entity.</param>
+			/// <param name="a_sName">The new name of the entity.</param>
+			/// <returns>True if the entity was renamed, otherwise false.</returns>
+			bool RenameEntity(const EntityID& a_ID, const std::string& a_sName);
+
+			/// <summary>
+			/// Finds an entity by its name. If multiple entities share the name, any of them can be returned.
+			/// </summary>
+			/// <param name="a_sName">The name of the entity.</param>
+			/// <returns>The entity id, or an invalid id if no entity has that name.</returns>
+			EntityID FindEntity(const std::string& a_sName) const;
+
 			/// <summary>
 			/// Creates a system in the ECS.
 			/// </summary>
@@ -119,29 +185,149 @@ namespace gallus
 			T& CreateSystem()
 			{
 				T* system = new T();
-				m_aSystems.push_back(system);
+				RegisterSystem(system);
+
+				const uint32_t systemTypeID = core::TypeIndex<SystemTypeFamily>::Get<T>();
+				if (systemTypeID >= m_aSystemsByType.size())
+				{
+					m_aSystemsByType.resize(systemTypeID + 1, nullptr);
+				}
+				m_aSystemsByType[systemTypeID] = system;
+
 				return *system;
 			}
 
 			/// <summary>
 			/// Retrieves a system from the ECS. Creates one if not present.
+			/// The system is looked up by its type index, so this is O(1) and does not need RTTI.
 			/// </summary>
 			/// <typeparam name="T">The system class.</typeparam>
 			/// <returns>A reference to the created system.</returns>
 			template <class T>
 			T& GetSystem()
 			{
-				for (AbstractECSSystem* sys : m_aSystems)
+				const uint32_t systemTypeID = core::TypeIndex<SystemTypeFamily>::Get<T>();
+				if (systemTypeID < m_aSystemsByType.size() && m_aSystemsByType[systemTypeID])
 				{
-					T* result = dynamic_cast<T*>(sys);
-					if (result)
-					{
-						return *result;
-					}
+					return *static_cast<T*>(m_aSystemsByType[systemTypeID]);
 				}
 				return CreateSystem<T>();
 			};
 
+			/// <summary>
+			/// Retrieves all entities that have all of the given components, together with those components.
+			/// The match list is cached and only gets rebuilt after the structure of the ECS changed (components added
+			/// or removed, entities deleted). The result and the component pointers in it stay valid until then.
+			/// Callers need to hold m_EntityMutex, systems can call it from Update since the ECS holds the mutex while updating them.
+			/// While the systems update, the structure is frozen for queries: entities and components deleted during the update
+			/// stay in the results until the next update, so systems on other threads can keep iterating them. Only adding a
+			/// component rebuilds the queries over its type, which is why that is limited to game thread systems that list
+			/// the type in GetWriteComponents.
+			/// </summary>
+			/// <typeparam name="ComponentTypes">The component classes an entity needs to have to match.</typeparam>
+			/// <returns>A vector containing a tuple of the entity id and pointers to its components for every matching entity.</returns>
+			template <class... ComponentTypes>
+			const QueryResult<ComponentTypes...>& Query()
+			{
+				// Systems running on worker threads can query at the same time, the cache gets its own lock.
+				std::lock_guard<std::mutex> lock(m_QueryMutex);
+
+				using Cache = QueryCache<ComponentTypes...>;
+
+				const uint32_t queryID = core::TypeIndex<QueryFamily>::Get<Cache>();
+				if (queryID >= m_aQueryCaches.size())
+				{
+					m_aQueryCaches.resize(queryID + 1);
+				}
+
+				std::unique_ptr<AbstractQueryCache>& baseCache = m_aQueryCaches[queryID];
+				if (!baseCache)
+				{
+					baseCache = std::make_unique<Cache>();
+					baseCache->m_Signature = MakeComponentSignature<ComponentTypes...>();
+				}
+
+				Cache& cache = static_cast<Cache&>(*baseCache);
+				if (cache.m_iStructureVersion != m_iStructureVersion)
+				{
+					RebuildQuery(cache);
+					cache.m_iStructureVersion = m_iStructureVersion;
+				}
+				return cache.m_aMatches;
+			}
+
+			/// <summary>
+			/// Calls a function for every entity that matches a query and passes a change filter, e.g.
+			/// ForEach&lt;Changed&lt;TransformComponent&gt;, TransformComponent, MeshComponent&gt;(GetLastRunTick(), ...)
+			/// only visits entities whose transform changed since the calling system last ran.
+			/// Callers need to hold m_EntityMutex, like for Query.
+			/// </summary>
+			/// <typeparam name="Filter">Added&lt;T&gt; or Changed&lt;T&gt;. Entities without a T component are skipped.</typeparam>
+			/// <typeparam name="ComponentTypes">The component classes an entity needs to have to match.</typeparam>
+			/// <param name="a_iSinceTick">Only changes after this tick pass the filter.</param>
+			/// <param name="a_Function">Function that gets called with the entity id followed by pointers to its components.</param>
+			template <class Filter, class... ComponentTypes, class Function>
+			void ForEach(uint32_t a_iSinceTick, Function&& a_Function)
+			{
+				using FilterComponentType = typename Filter::ComponentType;
+
+				const uint32_t filterTypeID = GetComponentTypeID<FilterComponentType>();
+				if (filterTypeID >= m_aComponentSystems.size() || !m_aComponentSystems[filterTypeID])
+				{
+					return;
+				}
+
+				const ECSBaseSystem<FilterComponentType>* filterSystem = static_cast<const ECSBaseSystem<FilterComponentType>*>(m_aComponentSystems[filterTypeID]);
+				for (const std::tuple<EntityID, ComponentTypes*...>& match : Query<ComponentTypes...>())
+				{
+					const ComponentTicks* ticks = filterSystem->TryGetComponentTicks(std::get<0>(match));
+					if (ticks && Filter::Matches(*ticks, a_iSinceTick))
+					{
+						std::apply(a_Function, match);
+					}
+				}
+			}
+
+			/// <summary>
+			/// Retrieves the current change tick. Components that get added or accessed mutably are stamped with it.
+			/// The tick advances before every system update and once more after all systems have been updated.
+			/// </summary>
+			/// <returns>The current change tick.</returns>
+			uint32_t GetChangeTick() const
+			{
+				return m_iChangeTick.load(std::memory_order_relaxed);
+			}
+
+			/// <summary>
+			/// Advances the change tick, so changes made from now on are newer than the current tick.
+			/// </summary>
+			/// <returns>The new change tick.</returns>
+			uint32_t AdvanceChangeTick()
+			{
+				return m_iChangeTick.fetch_add(1, std::memory_order_relaxed) + 1;
+			}
+
+			/// <summary>
+			/// Updates the signature of an entity after a component got added to it. Called by the systems.
+			/// </summary>
+			/// <param name="a_ID">The entity the component belongs to.</param>
+			/// <param name="a_iComponentTypeID">The type id of the component.</param>
+			void OnComponentAdded(const EntityID& a_ID, uint32_t a_iComponentTypeID);
+
+			/// <summary>
+			/// Updates the signature of an entity after a component got removed from it. Called by the systems.
+			/// </summary>
+			/// <param name="a_ID">The entity the component belonged to.</param>
+			/// <param name="a_iComponentTypeID">The type id of the component.</param>
+			void OnComponentRemoved(const EntityID& a_ID, uint32_t a_iComponentTypeID);
+
+			/// <summary>
+			/// Retrieves the component signature of an entity.
+			/// </summary>
+			/// <param name="a_ID">The entity.</param>
+			/// <returns>The signature of the entity, or an empty signature if the entity is not valid.</returns>
+			ComponentSignature GetSignature(const EntityID& a_ID) const;
+
 			/// <summary>
 			/// Retrieves all entities in the ECS.
 			/// </summary>
@@ -170,7 +356,11 @@ namespace gallus
 
 			mutable std::recursive_mutex m_EntityMutex;
 
-			SimpleEvent<>& OnEntitiesUpdated()
+			/// <summary>
+			/// Event that fires after entities got created, renamed or removed. Bulk operations fire it once, with all affected entities.
+			/// </summary>
+			/// <returns>The event.</returns>
+			SimpleEvent<std::span<const EntityID>>& OnEntitiesUpdated()
 			{
 				return m_eOnEntitiesUpdated;
 			}
@@ -180,12 +370,202 @@ namespace gallus
 				return m_eOnEntityComponentsUpdated;
 			}
 		private:
-			SimpleEvent<> m_eOnEntitiesUpdated;
+			static constexpr uint32_t INVALID_ENTITY_INDEX = UINT32_MAX;
+
+			/// <summary>
+			/// Slot that an entity id points to.
+			/// </summary>
+			struct EntitySlot
+			{
+				uint32_t m_iGeneration = 1; /// Generation of the entity that currently owns (or will next own) the slot.
+				uint32_t m_iEntityIndex = INVALID_ENTITY_INDEX; /// Index of the entity in m_aEntities.
+				ComponentSignature m_Signature; /// Components the entity has.
+			};
+
+			/// <summary>
+			/// Node in the system dependency graph.
+			/// </summary>
+			struct SystemNode
+			{
+				AbstractECSSystem* m_pSystem = nullptr;
+				std::vector<uint32_t> m_aDependents; /// Nodes that can only start after this node finished.
+				uint32_t m_iDependencyCount = 0; /// Number of nodes that need to finish before this node can start.
+				bool m_bGameThread = false; /// Whether the system needs to be updated on the game thread.
+			};
+
+			/// <summary>
+			/// Builds the system dependency graph. Two systems conflict when one of them writes a component type the
+			/// other one reads or writes. Conflicting systems are updated in the order they were created in.
+			/// </summary>
+			void BuildSchedule();
+
+			/// <summary>
+			/// Updates all systems, in parallel where their component access allows it, and advances the change tick.
+			/// </summary>
+			/// <param name="a_fDeltaTime">The time that has passed since the last frame.</param>
+			void UpdateSystems(float a_fDeltaTime);
+
+			/// <summary>
+			/// Updates all systems on the job system, following the dependency graph.
+			/// </summary>
+			/// <param name="a_fDeltaTime">The time that has passed since the last frame.</param>
+			void UpdateSystemsParallel(float a_fDeltaTime);
+
+			/// <summary>
+			/// Updates a single system, advancing the change tick first and recording it as the system's last run tick afterwards.
+			/// </summary>
+			/// <param name="a_pSystem">The system.</param>
+			/// <param name="a_fDeltaTime">The time that has passed since the last frame.</param>
+			void UpdateSystem(AbstractECSSystem* a_pSystem, float a_fDeltaTime);
+
+			/// <summary>
+			/// Hands a system node whose dependencies have finished to the thread that will update it.
+			/// </summary>
+			/// <param name="a_iNode">The node index.</param>
+			/// <param name="a_fDeltaTime">The time that has passed since the last frame.</param>
+			void DispatchSystem(uint32_t a_iNode, float a_fDeltaTime);
+
+			/// <summary>
+			/// Updates the system of a node and dispatches the dependents that became ready.
+			/// </summary>
+			/// <param name="a_iNode">The node index.</param>
+			/// <param name="a_fDeltaTime">The time that has passed since the last frame.</param>
+			void RunSystem(uint32_t a_iNode, float a_fDeltaTime);
+
+			/// <summary>
+			/// Adds a system to the ECS and registers it as the owner of its component type.
+			/// </summary>
+			/// <param name="a_pSystem">The system.</param>
+			void RegisterSystem(AbstractECSSystem* a_pSystem);
+
+			/// <summary>
+			/// Retrieves the slot of an entity.
+			/// </summary>
+			/// <param name="a_ID">The entity.</param>
+			/// <returns>Pointer to the slot if the id is still alive, otherwise nullptr.</returns>
+			const EntitySlot* GetEntitySlot(const EntityID& a_ID) const;
+
+			/// <summary>
+			/// Rebuilds the match list of a query.
+			/// </summary>
+			/// <param name="a_Cache">The query cache that gets rebuilt.</param>
+			template <class... ComponentTypes>
+			void RebuildQuery(QueryCache<ComponentTypes...>& a_Cache)
+			{
+				a_Cache.m_aMatches.clear();
+
+				const uint32_t componentTypeIDs[] = { GetComponentTypeID<ComponentTypes>()... };
+				for (uint32_t componentTypeID : componentTypeIDs)
+				{
+					if (componentTypeID >= m_aComponentSystems.size() || !m_aComponentSystems[componentTypeID])
+					{
+						return;
+					}
+				}
+
+				std::tuple<ECSBaseSystem<ComponentTypes>*...> systems = {
+					static_cast<ECSBaseSystem<ComponentTypes>*>(m_aComponentSystems[GetComponentTypeID<ComponentTypes>()])...
+				};
+
+				// Only the smallest storage needs to be walked, every match has to be in it.
+				const std::vector<EntityID>* candidates = nullptr;
+				std::apply([&candidates](auto*... a_pSystem)
+					{
+						((candidates = (!candidates || a_pSystem->GetSize() < candidates->size()) ? &a_pSystem->GetComponentEntities() : candidates), ...);
+					}, systems);
+
+				const ComponentSignature signature = MakeComponentSignature<ComponentTypes...>();
+				for (const EntityID& id : *candidates)
+				{
+					const EntitySlot* slot = GetEntitySlot(id);
+					if (!slot || (slot->m_Signature & signature) != signature || m_aEntities[slot->m_iEntityIndex].IsDestroyed())
+					{
+						continue;
+					}
+
+					a_Cache.m_aMatches.emplace_back(id, std::get<ECSBaseSystem<ComponentTypes>*>(systems)->TryGetComponent(id)...);
+				}
+			}
+
+			/// <summary>
+			/// Retrieves the index of an entity in the entity vector.
+			/// </summary>
+			/// <param name="a_ID">The entity.</param>
+			/// <returns>The index of the entity if the id is still alive, otherwise INVALID_ENTITY_INDEX.</returns>
+			uint32_t GetEntityIndex(const EntityID& a_ID) const;
+
+			/// <summary>
+			/// Removes all entities and components that were deleted since the last update in one batch.
+			/// </summary>
+			void ApplyPendingDeletes();
+
+			/// <summary>
+			/// Invalidates the query caches after the structure of the ECS changed. While the systems update, only the
+			/// queries over added component types are invalidated and the rest waits until the update is done.
+			/// </summary>
+			/// <param name="a_AddedComponents">The component types that got added, the storage of those may have moved.</param>
+			void OnStructureChanged(const ComponentSignature& a_AddedComponents = ComponentSignature());
+
+			/// <summary>
+			/// Checks whether there are enough free slots left to create entities.
+			/// </summary>
+			/// <param name="a_iCount">The number of entities.</param>
+			/// <returns>True if the entities fit, otherwise false.</returns>
+			bool CanCreateEntities(size_t a_iCount) const;
+
+			/// <summary>
+			/// Takes a free slot and appends an unnamed entity for it. Callers need to make sure a slot is available.
+			/// </summary>
+			/// <returns>The entity that got created.</returns>
+			Entity& AllocateEntity();
+
+			/// <summary>
+			/// Locks the entities for the calling thread. This is m_EntityMutex, except for the game thread and the job workers
+			/// while the systems update, which share m_UpdateMutex since the game thread already holds m_EntityMutex.
+			/// The calls systems on workers are allowed to make are listed at AbstractECSSystem::RunsOnGameThread.
+			/// </summary>
+			/// <returns>The lock.</returns>
+			std::unique_lock<std::recursive_mutex> LockEntities() const;
+
+			/// <summary>
+			/// Removes the name of an entity from the name index.
+			/// </summary>
+			/// <param name="a_Entity">The entity.</param>
+			void RemoveEntityName(Entity& a_Entity);
+
+			/// <summary>
+			/// Removes an entity from the entity vector and frees its slot for reuse.
+			/// </summary>
+			/// <param name="a_iEntityIndex">The index of the entity in the entity vector.</param>
+			void ReleaseEntity(uint32_t a_iEntityIndex);
+
+			SimpleEvent<std::span<const EntityID>> m_eOnEntitiesUpdated;
 			SimpleEvent<> m_eOnEntityComponentsUpdated;
 
 			std::vector<AbstractECSSystem*> m_aSystems;
+			std::vector<AbstractECSSystem*> m_aSystemsByType; /// Systems indexed by the type index of their class.
+			std::vector<AbstractECSSystem*> m_aComponentSystems; /// Systems indexed by the type id of their component.
+			std::vector<std::unique_ptr<AbstractQueryCache>> m_aQueryCaches; /// Query caches indexed by query type id.
+			std::mutex m_QueryMutex;
+			uint64_t m_iStructureVersion = 0; /// Incremented whenever components get added or removed or entities get deleted.
+			std::atomic<uint32_t> m_iChangeTick = 1; /// Tick that added and changed components get stamped with.
+
+			core::JobSystem* m_pJobSystem = nullptr;
+			std::vector<SystemNode> m_aSystemNodes;
+			std::unique_ptr<std::atomic<uint32_t>[]> m_aPendingDependencies; /// Per node, the dependencies that have not finished this update.
+			std::atomic<uint32_t> m_iRemainingSystems = 0; /// Systems that have not finished this update.
+			std::vector<uint32_t> m_aGameThreadQueue; /// Game thread nodes that are ready to be updated.
+			std::mutex m_GameThreadQueueMutex;
+			mutable std::recursive_mutex m_UpdateMutex; /// Taken instead of m_EntityMutex by the game thread and the workers while the systems update.
+			std::atomic<bool> m_bUpdatingSystems = false;
+			bool m_bStructureChangedWhileUpdating = false; /// Set when the structure version needs to be bumped once the systems are done.
+			std::atomic<std::thread::id> m_UpdateThreadID; /// The thread that updates the systems.
+			bool m_bScheduleDirty = true;
 			std::vector<Entity> m_aEntities;
-			unsigned int m_iNextID = 0;
+			std::vector<EntitySlot> m_aEntitySlots;
+			std::deque<uint32_t> m_aFreeSlots; /// Freed slots, reused oldest first so generations wrap as late as possible.
+			EntityNameIndex m_NameIndex;
+			std::vector<EntityID> m_aDeletedEntities; /// Entities deleted since the last update.
 			bool m_bPaused = false;
 #ifdef _EDITOR
 			bool m_bStarted = false;
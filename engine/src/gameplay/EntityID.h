@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 
 namespace gallus
@@ -11,14 +12,39 @@ namespace gallus
 		//---------------------------------------------------------------------
 		// EntityID
 		//---------------------------------------------------------------------
+		/// <summary>
+		/// Handle to an entity, made up of a slot index and a generation.
+		/// The generation is bumped every time the slot gets freed, so ids of
+		/// deleted entities stop resolving once their slot gets reused.
+		/// </summary>
 		struct EntityID
 		{
+			static constexpr uint32_t INDEX_BITS = 22;
+			static constexpr uint32_t GENERATION_BITS = 32 - INDEX_BITS;
+			static constexpr uint32_t INDEX_MASK = (1u << INDEX_BITS) - 1;
+			static constexpr uint32_t GENERATION_MASK = (1u << GENERATION_BITS) - 1;
+			static constexpr uint32_t MAX_ENTITIES = INDEX_MASK + 1;
+
 			EntityID(unsigned int a_ID) : m_iID(a_ID)
 			{};
+			EntityID(uint32_t a_iIndex, uint32_t a_iGeneration) :
+				m_iID(((a_iGeneration & GENERATION_MASK) << INDEX_BITS) | (a_iIndex & INDEX_MASK))
+			{};
 			EntityID()
 			{};
 			~EntityID() = default;
 
+			/// <summary>
+			/// Retrieves the next generation for a slot, skipping the generation that would make an id invalid.
+			/// </summary>
+			/// <param name="a_iGeneration">The current generation of the slot.</param>
+			/// <returns>The generation the slot gets after it is freed.</returns>
+			static uint32_t NextGeneration(uint32_t a_iGeneration)
+			{
+				const uint32_t generation = (a_iGeneration + 1) & GENERATION_MASK;
+				return generation == 0 ? 1 : generation;
+			}
+
 			/// <summary>
 			/// Checks whether the entity is valid or not.
 			/// </summary>
@@ -45,6 +71,24 @@ namespace gallus
 				return m_iID;
 			}
 
+			/// <summary>
+			/// Retrieves the slot index of the entity.
+			/// </summary>
+			/// <returns>An integer containing the slot index.</returns>
+			uint32_t GetIndex() const
+			{
+				return m_iID & INDEX_MASK;
+			}
+
+			/// <summary>
+			/// Retrieves the generation of the entity's slot at the time the entity was created.
+			/// </summary>
+			/// <returns>An integer containing the generation.</returns>
+			uint32_t GetGeneration() const
+			{
+				return (m_iID >> INDEX_BITS) & GENERATION_MASK;
+			}
+
 			bool operator==(const EntityID& a_Other) const
 			{
 				return m_iID == a_Other.m_iID;
@@ -0,0 +1,106 @@
+#include "gameplay/EntityNameIndex.h"
+
+namespace gallus
+{
+	namespace gameplay
+	{
+		//---------------------------------------------------------------------
+		// EntityNameIndex
+		//---------------------------------------------------------------------
+		const EntityName* EntityNameIndex::Add(std::string_view a_sName, const EntityID& a_ID, uint32_t& a_iNameIndex)
+		{
+			return Add(a_sName, std::span<const EntityID>(&a_ID, 1), a_iNameIndex);
+		}
+
+		//---------------------------------------------------------------------
+		const EntityName* EntityNameIndex::Add(std::string_view a_sName, std::span<const EntityID> a_aIDs, uint32_t& a_iFirstNameIndex)
+		{
+			auto it = m_mNames.find(a_sName);
+			if (it == m_mNames.end())
+			{
+				std::unique_ptr<EntityName> name = std::make_unique<EntityName>();
+				name->m_sName = a_sName;
+
+				const std::string_view key = name->m_sName;
+				it = m_mNames.emplace(key, std::move(name)).first;
+			}
+
+			EntityName& name = *it->second;
+			a_iFirstNameIndex = static_cast<uint32_t>(name.m_aEntities.size());
+			name.m_aEntities.insert(name.m_aEntities.end(), a_aIDs.begin(), a_aIDs.end());
+			return &name;
+		}
+
+		//---------------------------------------------------------------------
+		EntityID EntityNameIndex::Remove(const EntityName* a_pName, uint32_t a_iNameIndex)
+		{
+			if (!a_pName)
+			{
+				return EntityID();
+			}
+
+			auto it = m_mNames.find(a_pName->m_sName);
+			if (it == m_mNames.end() || a_iNameIndex >= it->second->m_aEntities.size())
+			{
+				return EntityID();
+			}
+
+			std::vector<EntityID>& entities = it->second->m_aEntities;
+
+			EntityID moved;
+			if (a_iNameIndex != entities.size() - 1)
+			{
+				entities[a_iNameIndex] = entities.back();
+				moved = entities[a_iNameIndex];
+			}
+			entities.pop_back();
+
+			if (entities.empty())
+			{
+				// Suffixes for the name start over once no entity has it anymore.
+				auto suffix = m_mNextSuffix.find(it->second->m_sName);
+				if (suffix != m_mNextSuffix.end())
+				{
+					m_mNextSuffix.erase(suffix);
+				}
+				m_mNames.erase(it);
+			}
+
+			return moved;
+		}
+
+		//---------------------------------------------------------------------
+		const EntityName* EntityNameIndex::Find(std::string_view a_sName) const
+		{
+			auto it = m_mNames.find(a_sName);
+			return it != m_mNames.end() ? it->second.get() : nullptr;
+		}
+
+		//---------------------------------------------------------------------
+		std::string EntityNameIndex::GetUniqueName(const std::string& a_sName)
+		{
+			if (!Find(a_sName))
+			{
+				return a_sName;
+			}
+
+			uint32_t& suffix = m_mNextSuffix.try_emplace(a_sName, 1).first->second;
+			while (true)
+			{
+				std::string name = a_sName + " (" + std::to_string(suffix) + ")";
+				if (!Find(name))
+				{
+					return name;
+				}
+				suffix++;
+			}
+		}
+
+		//---------------------------------------------------------------------
+		void EntityNameIndex::Clear()
+		{
+			m_mNames.clear();
+			m_mNextSuffix.clear();
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "gameplay/EntityID.h"
+
+namespace gallus
+{
+	namespace gameplay
+	{
+		//---------------------------------------------------------------------
+		// EntityName
+		//---------------------------------------------------------------------
+		/// <summary>
+		/// Interned entity name, shared by all entities that have that name.
+		/// </summary>
+		struct EntityName
+		{
+			std::string m_sName;
+			std::vector<EntityID> m_aEntities; /// Entities that have this name.
+		};
+
+		//---------------------------------------------------------------------
+		// EntityNameIndex
+		//---------------------------------------------------------------------
+		/// <summary>
+		/// Hashed index of entity names. Names are interned, every entity with the same name points to the same
+		/// EntityName, which lives as long as at least one entity uses it.
+		/// </summary>
+		class EntityNameIndex
+		{
+		public:
+			/// <summary>
+			/// Adds an entity to the index.
+			/// </summary>
+			/// <param name="a_sName">The name of the entity.</param>
+			/// <param name="a_ID">The entity.</param>
+			/// <param name="a_iNameIndex">Receives the position of the entity in the name's entity list.</param>
+			/// <returns>The interned name.</returns>
+			const EntityName* Add(std::string_view a_sName, const EntityID& a_ID, uint32_t& a_iNameIndex);
+
+			/// <summary>
+			/// Adds multiple entities with the same name to the index.
+			/// </summary>
+			/// <param name="a_sName">The name of the entities.</param>
+			/// <param name="a_aIDs">The entities.</param>
+			/// <param name="a_iFirstNameIndex">Receives the position of the first entity in the name's entity list, the others follow it.</param>
+			/// <returns>The interned name.</returns>
+			const EntityName* Add(std::string_view a_sName, std::span<const EntityID> a_aIDs, uint32_t& a_iFirstNameIndex);
+
+			/// <summary>
+			/// Removes an entity from the index. The last entity with the same name takes over its position.
+			/// </summary>
+			/// <param name="a_pName">The interned name of the entity.</param>
+			/// <param name="a_iNameIndex">The position of the entity in the name's entity list.</param>
+			/// <returns>The entity that moved to a_iNameIndex, or an invalid id if no entity moved.</returns>
+			EntityID Remove(const EntityName* a_pName, uint32_t a_iNameIndex);
+
+			/// <summary>
+			/// Retrieves the interned name for a string.
+			/// </summary>
+			/// <param name="a_sName">The name.</param>
+			/// <returns>The interned name if an entity has that name, otherwise nullptr.</returns>
+			const EntityName* Find(std::string_view a_sName) const;
+
+			/// <summary>
+			/// Returns a name that no entity has yet, by appending " (n)" to the name when it is taken.
+			/// The suffix search continues where the previous search for the same name stopped, until no entity has the name anymore.
+			/// </summary>
+			/// <param name="a_sName">The preferred name.</param>
+			/// <returns>A string containing a unique name for an entity.</returns>
+			std::string GetUniqueName(const std::string& a_sName);
+
+			/// <summary>
+			/// Removes all names from the index.
+			/// </summary>
+			void Clear();
+		private:
+			std::unordered_map<std::string_view, std::unique_ptr<EntityName>> m_mNames; /// Keys point into the EntityName's string.
+			std::unordered_map<std::string, uint32_t> m_mNextSuffix; /// Per base name, the suffix to try first.
+		};
+	}
+}
\ No newline at end of file
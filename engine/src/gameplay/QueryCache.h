@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include <tuple>
+#include <vector>
+
+#include "gameplay/ComponentSignature.h"
+#include "gameplay/EntityID.h"
+
+namespace gallus
+{
+	namespace gameplay
+	{
+		/// <summary>
+		/// Result of a query, one tuple per matching entity containing the entity id followed by its components.
+		/// </summary>
+		template <class... ComponentTypes>
+		using QueryResult = std::vector<std::tuple<EntityID, ComponentTypes*...>>;
+
+		//---------------------------------------------------------------------
+		// AbstractQueryCache
+		//---------------------------------------------------------------------
+		/// <summary>
+		/// Type-erased base of a cached query, so the ECS can store caches of different queries together.
+		/// </summary>
+		class AbstractQueryCache
+		{
+		public:
+			virtual ~AbstractQueryCache() = default;
+
+			uint64_t m_iStructureVersion = UINT64_MAX; /// Structure version of the ECS the matches were built for.
+			ComponentSignature m_Signature; /// Component types the query matches.
+		};
+
+		//---------------------------------------------------------------------
+		// QueryCache
+		//---------------------------------------------------------------------
+		/// <summary>
+		/// Cached match list of a query over a set of component types.
+		/// </summary>
+		/// <typeparam name="ComponentTypes">The component classes the query matches.</typeparam>
+		template <class... ComponentTypes>
+		class QueryCache : public AbstractQueryCache
+		{
+		public:
+			QueryResult<ComponentTypes...> m_aMatches;
+		};
+
+		/// <summary>
+		/// Tag type for the query type index family.
+		/// </summary>
+		struct QueryFamily
+		{};
+	}
+}
\ No newline at end of file
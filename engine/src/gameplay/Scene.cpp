@@ -1,5 +1,8 @@
 #include "Scene.h"
 
+#include <unordered_set>
+
+#include "utils/rapidjson_config.h"
 #include <rapidjson/document.h>
 
 #include "core/Tool.h"
@@ -42,6 +45,10 @@ namespace gallus
 			// Load entities and systems.
 			if (document.HasMember(JSON_SCENE_ENTITIES_VAR) && document[JSON_SCENE_ENTITIES_VAR].IsArray())
 			{
+				// Collect the names first, so all entities get created in one batch.
+				std::vector<const rapidjson::Value*> elements;
+				std::vector<std::string> names;
+				std::vector<size_t> unnamed;
 				for (auto& element : document[JSON_SCENE_ENTITIES_VAR].GetArray())
 				{
 					if (!element.IsObject())
@@ -49,13 +56,39 @@ namespace gallus
 						continue;
 					}
 
-					std::string name = core::TOOL->GetECS().GetUniqueName("New GameObject");
 					if (element.HasMember(JSON_SCENE_ENTITIES_VAR_NAME) && element[JSON_SCENE_ENTITIES_VAR_NAME].IsString())
 					{
-						name = element[JSON_SCENE_ENTITIES_VAR_NAME].GetString();
+						names.push_back(element[JSON_SCENE_ENTITIES_VAR_NAME].GetString());
+					}
+					else
+					{
+						unnamed.push_back(names.size());
+						names.emplace_back();
+					}
+					elements.push_back(&element);
+				}
+
+				// Unnamed entities get unique names up front, so they are part of the batch instead of being renamed one by one.
+				// A name is taken if an entity has it or the scene gives it to another entity.
+				const std::string defaultName = "New GameObject";
+				std::unordered_set<std::string> takenNames(names.begin(), names.end());
+				uint32_t suffix = 0;
+				for (size_t i : unnamed)
+				{
+					std::string name = defaultName;
+					while (takenNames.contains(name) || core::TOOL->GetECS().FindEntity(name).IsValid())
+					{
+						name = defaultName + " (" + std::to_string(++suffix) + ")";
 					}
+					takenNames.insert(name);
+					names[i] = std::move(name);
+				}
 
-					gameplay::EntityID id = core::TOOL->GetECS().CreateEntity(name);
+				const std::vector<gameplay::EntityID> ids = core::TOOL->GetECS().CreateEntities(names);
+				for (size_t i = 0; i < ids.size(); i++)
+				{
+					const rapidjson::Value& element = *elements[i];
+					gameplay::EntityID id = ids[i];
 					gameplay::Entity* entity = core::TOOL->GetECS().GetEntity(id);
 					if (!entity)
 					{
@@ -0,0 +1,249 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "core/Memory.h"
+#include "gameplay/EntityID.h"
+#include "gameplay/ChangeTracking.h"
+
+namespace gallus
+{
+	namespace gameplay
+	{
+		//---------------------------------------------------------------------
+		// SparseSet
+		//---------------------------------------------------------------------
+		/// <summary>
+		/// Stores values keyed by entity id in a densely packed array.
+		/// A sparse index maps the entity's slot index to a position in the dense array,
+		/// giving O(1) lookup, insertion and removal (swap-and-pop) and
+		/// linear iteration over the packed values.
+		/// Every value has change ticks next to it, stored in a separate array so iterating the values stays tightly packed.
+		/// The values start at a cache line, so ranges of whole cache lines can be handed to different threads.
+		/// </summary>
+		/// <typeparam name="ValueType">The type of value stored per entity.</typeparam>
+		template <class ValueType>
+		class SparseSet
+		{
+		public:
+			using ValueVector = std::vector<ValueType, core::CacheAlignedAllocator<ValueType>>;
+
+			static constexpr uint32_t INVALID_INDEX = UINT32_MAX;
+
+			/// <summary>
+			/// Checks whether an entity has a value in the set.
+			/// </summary>
+			/// <param name="a_ID">The entity that will be checked.</param>
+			/// <returns>True if the entity has a value, otherwise false.</returns>
+			bool Contains(const EntityID& a_ID) const
+			{
+				return GetDenseIndex(a_ID) != INVALID_INDEX;
+			}
+
+			/// <summary>
+			/// Retrieves the position of an entity's value in the dense array.
+			/// </summary>
+			/// <param name="a_ID">The entity that will be checked.</param>
+			/// <returns>The dense index if the entity has a value, otherwise INVALID_INDEX.</returns>
+			uint32_t GetDenseIndex(const EntityID& a_ID) const
+			{
+				const uint32_t sparseIndex = a_ID.GetIndex();
+				if (sparseIndex >= m_aSparse.size())
+				{
+					return INVALID_INDEX;
+				}
+
+				const uint32_t denseIndex = m_aSparse[sparseIndex];
+				if (denseIndex == INVALID_INDEX || m_aEntities[denseIndex] != a_ID)
+				{
+					return INVALID_INDEX;
+				}
+				return denseIndex;
+			}
+
+			/// <summary>
+			/// Adds a default constructed value for an entity. If the entity already has a value the existing one is returned.
+			/// Adding a value may grow the dense array, which invalidates previously retrieved references.
+			/// </summary>
+			/// <param name="a_ID">The entity the value belongs to.</param>
+			/// <param name="a_iTick">The tick the value gets added at.</param>
+			/// <returns>Reference to the value of the entity.</returns>
+			ValueType& Emplace(const EntityID& a_ID, uint32_t a_iTick = 0)
+			{
+				const uint32_t existing = GetDenseIndex(a_ID);
+				if (existing != INVALID_INDEX)
+				{
+					return m_aValues[existing];
+				}
+
+				const uint32_t sparseIndex = a_ID.GetIndex();
+				if (sparseIndex >= m_aSparse.size())
+				{
+					m_aSparse.resize(sparseIndex + 1, INVALID_INDEX);
+				}
+
+				m_aSparse[sparseIndex] = static_cast<uint32_t>(m_aValues.size());
+				m_aEntities.push_back(a_ID);
+				m_aTicks.push_back({ a_iTick, a_iTick });
+				return m_aValues.emplace_back();
+			}
+
+			/// <summary>
+			/// Replaces a value with a default constructed one, as if it was just added.
+			/// </summary>
+			/// <param name="a_iDenseIndex">The position of the value in the dense array.</param>
+			/// <param name="a_iTick">The tick the value gets added at.</param>
+			/// <returns>Reference to the new value.</returns>
+			ValueType& Reset(uint32_t a_iDenseIndex, uint32_t a_iTick)
+			{
+				m_aValues[a_iDenseIndex] = ValueType();
+				m_aTicks[a_iDenseIndex] = { a_iTick, a_iTick };
+				return m_aValues[a_iDenseIndex];
+			}
+
+			/// <summary>
+			/// Removes the value of an entity by moving the last value into its place.
+			/// </summary>
+			/// <param name="a_ID">The entity whose value will be removed.</param>
+			/// <returns>True if a value was removed, otherwise false.</returns>
+			bool Remove(const EntityID& a_ID)
+			{
+				const uint32_t denseIndex = GetDenseIndex(a_ID);
+				if (denseIndex == INVALID_INDEX)
+				{
+					return false;
+				}
+
+				const uint32_t lastIndex = static_cast<uint32_t>(m_aValues.size() - 1);
+				if (denseIndex != lastIndex)
+				{
+					m_aValues[denseIndex] = std::move(m_aValues[lastIndex]);
+					m_aEntities[denseIndex] = m_aEntities[lastIndex];
+					m_aTicks[denseIndex] = m_aTicks[lastIndex];
+					m_aSparse[m_aEntities[denseIndex].GetIndex()] = denseIndex;
+				}
+
+				m_aValues.pop_back();
+				m_aEntities.pop_back();
+				m_aTicks.pop_back();
+				m_aSparse[a_ID.GetIndex()] = INVALID_INDEX;
+				return true;
+			}
+
+			/// <summary>
+			/// Retrieves the value of an entity.
+			/// </summary>
+			/// <param name="a_ID">The entity that will be checked.</param>
+			/// <returns>Pointer to the value if the entity has one, otherwise nullptr.</returns>
+			ValueType* TryGet(const EntityID& a_ID)
+			{
+				const uint32_t denseIndex = GetDenseIndex(a_ID);
+				return denseIndex == INVALID_INDEX ? nullptr : &m_aValues[denseIndex];
+			}
+
+			/// <summary>
+			/// Retrieves the value of an entity.
+			/// </summary>
+			/// <param name="a_ID">The entity that will be checked.</param>
+			/// <returns>Pointer to the value if the entity has one, otherwise nullptr.</returns>
+			const ValueType* TryGet(const EntityID& a_ID) const
+			{
+				const uint32_t denseIndex = GetDenseIndex(a_ID);
+				return denseIndex == INVALID_INDEX ? nullptr : &m_aValues[denseIndex];
+			}
+
+			/// <summary>
+			/// Retrieves the change ticks of an entity's value.
+			/// </summary>
+			/// <param name="a_ID">The entity that will be checked.</param>
+			/// <returns>Pointer to the ticks if the entity has a value, otherwise nullptr.</returns>
+			const ComponentTicks* TryGetTicks(const EntityID& a_ID) const
+			{
+				const uint32_t denseIndex = GetDenseIndex(a_ID);
+				return denseIndex == INVALID_INDEX ? nullptr : &m_aTicks[denseIndex];
+			}
+
+			/// <summary>
+			/// Marks a value as changed.
+			/// </summary>
+			/// <param name="a_iDenseIndex">The position of the value in the dense array.</param>
+			/// <param name="a_iTick">The tick the value changed at.</param>
+			void MarkChanged(uint32_t a_iDenseIndex, uint32_t a_iTick)
+			{
+				m_aTicks[a_iDenseIndex].m_iChanged = a_iTick;
+			}
+
+			/// <summary>
+			/// Removes all values from the set.
+			/// </summary>
+			void Clear()
+			{
+				m_aValues.clear();
+				m_aEntities.clear();
+				m_aTicks.clear();
+				m_aSparse.clear();
+			}
+
+			/// <summary>
+			/// Retrieves the number of values in the set.
+			/// </summary>
+			/// <returns>The number of values.</returns>
+			size_t Size() const
+			{
+				return m_aValues.size();
+			}
+
+			/// <summary>
+			/// Checks whether the set contains any values.
+			/// </summary>
+			/// <returns>True if the set is empty, otherwise false.</returns>
+			bool Empty() const
+			{
+				return m_aValues.empty();
+			}
+
+			/// <summary>
+			/// Retrieves the densely packed values.
+			/// </summary>
+			/// <returns>Vector containing the values, in the same order as GetEntities.</returns>
+			ValueVector& GetValues()
+			{
+				return m_aValues;
+			}
+
+			/// <summary>
+			/// Retrieves the densely packed values.
+			/// </summary>
+			/// <returns>Vector containing the values, in the same order as GetEntities.</returns>
+			const ValueVector& GetValues() const
+			{
+				return m_aValues;
+			}
+
+			/// <summary>
+			/// Retrieves the entities that own the values.
+			/// </summary>
+			/// <returns>Vector containing the entity ids, in the same order as GetValues.</returns>
+			const std::vector<EntityID>& GetEntities() const
+			{
+				return m_aEntities;
+			}
+
+			/// <summary>
+			/// Retrieves the change ticks of the values.
+			/// </summary>
+			/// <returns>Vector containing the ticks, in the same order as GetValues.</returns>
+			const std::vector<ComponentTicks>& GetTicks() const
+			{
+				return m_aTicks;
+			}
+		private:
+			ValueVector m_aValues; /// Densely packed values.
+			std::vector<EntityID> m_aEntities; /// Entity that owns the value at the same position.
+			std::vector<ComponentTicks> m_aTicks; /// Change ticks of the value at the same position.
+			std::vector<uint32_t> m_aSparse; /// Entity slot index to dense index.
+		};
+	}
+}
\ No newline at end of file
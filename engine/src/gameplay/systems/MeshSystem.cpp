@@ -1,7 +1,11 @@
 #include "gameplay/systems/MeshSystem.h"
 
 #include "graphics/imgui/font_icon.h"
+#include "graphics/RenderPacket.h"
 #include "logger/Logger.h"
+#include "core/Tool.h"
+
+#include "gameplay/systems/TransformSystem.h"
 
 namespace gallus
 {
@@ -34,5 +38,55 @@ namespace gallus
 
 		void MeshSystem::Update(float a_fDeltaTime)
 		{}
+
+		//---------------------------------------------------------------------
+		void MeshSystem::ExtractDrawItems(graphics::RenderPacket& a_Packet)
+		{
+			EntityComponentSystem& ecs = core::TOOL->GetECS();
+			TransformSystem& transformSystem = ecs.GetSystem<TransformSystem>();
+
+			const core::ResourceAtlas& resourceAtlas = core::TOOL->GetResourceAtlas();
+
+			ComponentVector& components = GetComponents();
+			const std::vector<EntityID>& entities = GetComponentEntities();
+
+			a_Packet.m_aDrawItems.reserve(components.size());
+			for (size_t i = 0; i < components.size(); i++)
+			{
+				MeshComponent& component = components[i];
+				if (component.IsDestroyed())
+				{
+					continue;
+				}
+
+				// Handles resolve without reference counting, a mesh that was unloaded resolves to nullptr.
+				graphics::backend::Mesh* mesh = resourceAtlas.GetMesh(component.GetMesh());
+				if (!mesh)
+				{
+					continue;
+				}
+
+				const Entity* entity = ecs.GetEntity(entities[i]);
+				if (!entity || !entity->IsActive())
+				{
+					continue;
+				}
+
+				// Entities without a transform have no place or size, the unit mesh would cover a single pixel.
+				const TransformComponent* transform = transformSystem.TryGetComponent(entities[i]);
+				if (!transform || transform->IsDestroyed())
+				{
+					continue;
+				}
+
+				graphics::DrawItem& item = a_Packet.m_aDrawItems.emplace_back();
+				item.m_WorldMatrix = transform->GetWorldMatrix();
+				item.m_pMesh = mesh;
+				item.m_pShader = resourceAtlas.GetShader(component.GetShader());
+				item.m_pTexture = resourceAtlas.GetTexture(component.GetTexture());
+				item.m_fDepth = component.GetDepth();
+				item.m_iLayer = component.GetLayer();
+			}
+		}
 	}
 }
\ No newline at end of file
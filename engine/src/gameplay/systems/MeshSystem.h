@@ -3,6 +3,14 @@
 #include "gameplay/ECSBaseSystem.h"
 #include "gameplay/systems/components/MeshComponent.h"
 
+namespace gallus
+{
+	namespace graphics
+	{
+		struct RenderPacket;
+	}
+}
+
 namespace gallus
 {
 	namespace gameplay
@@ -10,7 +18,7 @@ namespace gallus
 		//---------------------------------------------------------------------
 		// MeshSystem
 		//---------------------------------------------------------------------
-		class MeshSystem : public ECSBaseSystem<MeshComponent>
+		class MeshSystem final : public ECSBaseSystem<MeshComponent>
 		{
 		public:
 			/// <summary>
@@ -36,6 +44,12 @@ namespace gallus
 			/// </summary>
 			/// <param name="a_fDeltaTime">The time that has passed since the last frame.</param>
 			void Update(float a_fDeltaTime) override;
+
+			/// <summary>
+			/// Copies the draw data of all active meshes into a render packet. World matrices have to be up to date.
+			/// </summary>
+			/// <param name="a_Packet">The render packet the draw items get added to.</param>
+			void ExtractDrawItems(graphics::RenderPacket& a_Packet);
 		};
 	}
 }
\ No newline at end of file
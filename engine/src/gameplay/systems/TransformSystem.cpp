@@ -1,5 +1,7 @@
 #include "gameplay/systems/TransformSystem.h"
 
+#include <algorithm>
+
 #include "graphics/imgui/font_icon.h"
 #include "logger/Logger.h"
 
@@ -32,7 +34,178 @@ namespace gallus
 			return name;
 		}
 
-		void TransformSystem::Update(float a_fDeltaTime)
-		{}
+		//---------------------------------------------------------------------
+		void TransformSystem::Update(float /*a_fDeltaTime*/)
+		{
+			UpdateHierarchy();
+		}
+
+		//---------------------------------------------------------------------
+		void TransformSystem::Clear()
+		{
+			ECSBaseSystem::Clear();
+			m_bHierarchyDirty = true;
+		}
+
+		//---------------------------------------------------------------------
+		bool TransformSystem::UpdateComponents()
+		{
+			// Removing components moves other components in the storage, so the hierarchy has to be rebuilt.
+			const bool removed = ECSBaseSystem::UpdateComponents();
+			m_bHierarchyDirty |= removed;
+			return removed;
+		}
+
+		//---------------------------------------------------------------------
+		bool TransformSystem::SetParent(const EntityID& a_ID, const EntityID& a_ParentID)
+		{
+			TransformComponent* component = TryGetComponent(a_ID);
+			if (!component)
+			{
+				LOG(LOGSEVERITY_ERROR, LOG_CATEGORY_ECS, "Failed setting parent: entity has no transform.");
+				return false;
+			}
+
+			if (a_ParentID.IsValid())
+			{
+				if (!HasComponent(a_ParentID))
+				{
+					LOG(LOGSEVERITY_ERROR, LOG_CATEGORY_ECS, "Failed setting parent: parent has no transform.");
+					return false;
+				}
+
+				for (EntityID ancestor = a_ParentID; ancestor.IsValid();)
+				{
+					if (ancestor == a_ID)
+					{
+						LOG(LOGSEVERITY_ERROR, LOG_CATEGORY_ECS, "Failed setting parent: an entity cannot be parented to itself or one of its children.");
+						return false;
+					}
+
+					const TransformComponent* ancestorComponent = TryGetComponent(ancestor);
+					ancestor = ancestorComponent ? ancestorComponent->m_Parent : EntityID();
+				}
+			}
+
+			component->m_Parent = a_ParentID;
+			m_bHierarchyDirty = true;
+			return true;
+		}
+
+		//---------------------------------------------------------------------
+		void TransformSystem::RebuildHierarchy()
+		{
+			ComponentVector& components = m_Components.GetValues();
+			const uint32_t componentCount = static_cast<uint32_t>(components.size());
+
+			// Depth of every component, found by walking up to the first ancestor whose depth is known.
+			m_aDepths.assign(componentCount, INVALID_NODE);
+			uint32_t maxDepth = 0;
+			for (uint32_t i = 0; i < componentCount; i++)
+			{
+				uint32_t current = i;
+				uint32_t chainLength = 0;
+				while (m_aDepths[current] == INVALID_NODE)
+				{
+					TransformComponent& component = components[current];
+					const uint32_t parent = component.m_Parent.IsValid() ? m_Components.GetDenseIndex(component.m_Parent) : INVALID_NODE;
+					if (parent == INVALID_NODE)
+					{
+						component.m_Parent.SetInvalid();
+						m_aDepths[current] = 0;
+						break;
+					}
+					current = parent;
+					chainLength++;
+				}
+
+				// Walk the chain again, assigning depths from the known ancestor downwards.
+				uint32_t depth = m_aDepths[current] + chainLength;
+				maxDepth = std::max(maxDepth, depth);
+				for (uint32_t node = i; m_aDepths[node] == INVALID_NODE; node = m_Components.GetDenseIndex(components[node].m_Parent))
+				{
+					m_aDepths[node] = depth--;
+				}
+			}
+
+			// Counting sort by depth.
+			std::vector<uint32_t> depthStarts(maxDepth + 2, 0);
+			for (uint32_t depth : m_aDepths)
+			{
+				depthStarts[depth + 1]++;
+			}
+			for (uint32_t depth = 1; depth < depthStarts.size(); depth++)
+			{
+				depthStarts[depth] += depthStarts[depth - 1];
+			}
+
+			m_aNodeIndices.resize(componentCount);
+			for (uint32_t i = 0; i < componentCount; i++)
+			{
+				m_aNodeIndices[i] = depthStarts[m_aDepths[i]]++;
+			}
+
+			m_aHierarchy.resize(componentCount);
+			for (uint32_t i = 0; i < componentCount; i++)
+			{
+				HierarchyNode& node = m_aHierarchy[m_aNodeIndices[i]];
+				node.m_iComponentIndex = i;
+				node.m_iParentNode = components[i].m_Parent.IsValid() ? m_aNodeIndices[m_Components.GetDenseIndex(components[i].m_Parent)] : INVALID_NODE;
+			}
+
+			m_aWorldDirty.assign(componentCount, 0);
+			m_bHierarchyDirty = false;
+		}
+
+		//---------------------------------------------------------------------
+		void TransformSystem::UpdateHierarchy()
+		{
+			// Components that got added are appended to the storage, which is noticed by the size changing.
+			const bool rebuild = m_bHierarchyDirty || m_aHierarchy.size() != m_Components.Size();
+			if (rebuild)
+			{
+				RebuildHierarchy();
+			}
+
+			ComponentVector& components = m_Components.GetValues();
+			const std::vector<ComponentTicks>& ticks = m_Components.GetTicks();
+			const uint32_t tick = GetChangeTick();
+
+			for (uint32_t i = 0; i < m_aHierarchy.size(); i++)
+			{
+				const HierarchyNode& node = m_aHierarchy[i];
+				TransformComponent& component = components[node.m_iComponentIndex];
+
+				const bool localDirty = rebuild || IsNewerTick(ticks[node.m_iComponentIndex].m_iChanged, m_iHierarchyTick);
+				if (localDirty)
+				{
+					component.m_mLocalMatrix = component.m_Transform.GetMatrix();
+				}
+
+				const bool parentDirty = node.m_iParentNode != INVALID_NODE && m_aWorldDirty[node.m_iParentNode];
+				m_aWorldDirty[i] = localDirty || parentDirty;
+				if (!m_aWorldDirty[i])
+				{
+					continue;
+				}
+
+				if (node.m_iParentNode == INVALID_NODE)
+				{
+					component.m_mWorldMatrix = component.m_mLocalMatrix;
+				}
+				else
+				{
+					const TransformComponent& parent = components[m_aHierarchy[node.m_iParentNode].m_iComponentIndex];
+					component.m_mWorldMatrix = component.m_mLocalMatrix * parent.m_mWorldMatrix;
+				}
+			}
+
+			// Changes made from now on get a newer tick than the one recorded here.
+			m_iHierarchyTick = tick;
+			if (m_pECS)
+			{
+				m_pECS->AdvanceChangeTick();
+			}
+		}
 	}
 }
\ No newline at end of file
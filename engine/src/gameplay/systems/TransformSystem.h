@@ -3,6 +3,8 @@
 #include "gameplay/ECSBaseSystem.h"
 #include "gameplay/systems/components/TransformComponent.h"
 
+#include <vector>
+
 namespace gallus
 {
 	namespace gameplay
@@ -10,7 +12,12 @@ namespace gallus
 		//---------------------------------------------------------------------
 		// TransformSystem
 		//---------------------------------------------------------------------
-		class TransformSystem : public ECSBaseSystem<TransformComponent>
+		/// <summary>
+		/// Owns the transform components and the transform hierarchy. Transforms are kept in a flat array sorted by depth,
+		/// so parents always come before their children and world matrices can be updated in a single linear pass.
+		/// Only transforms that changed, and the subtrees below them, get their matrices recomputed.
+		/// </summary>
+		class TransformSystem final : public ECSBaseSystem<TransformComponent>
 		{
 		public:
 			/// <summary>
@@ -36,6 +43,55 @@ namespace gallus
 			/// </summary>
 			/// <param name="a_fDeltaTime">The time that has passed since the last frame.</param>
 			void Update(float a_fDeltaTime) override;
+
+			/// <summary>
+			/// Clears the system and removes all entities.
+			/// </summary>
+			void Clear() override;
+
+			/// <summary>
+			/// Updates the system's components, removing all components that were marked for deletion.
+			/// </summary>
+			/// <returns>True if components were removed, otherwise false.</returns>
+			bool UpdateComponents() override;
+
+			/// <summary>
+			/// Attaches a transform to a parent. The local transform is kept, so the world transform becomes relative to the parent.
+			/// </summary>
+			/// <param name="a_ID">The entity whose transform gets attached.</param>
+			/// <param name="a_ParentID">The new parent, or an invalid id to detach the transform.</param>
+			/// <returns>True if the parent was set, otherwise false.</returns>
+			bool SetParent(const EntityID& a_ID, const EntityID& a_ParentID);
+
+			/// <summary>
+			/// Recomputes the cached matrices of all transforms that changed since the last call, and of their children.
+			/// Called during Update and by the renderer, so matrices are up to date even when the ECS is not running.
+			/// Callers need to hold m_EntityMutex.
+			/// </summary>
+			void UpdateHierarchy();
+		private:
+			static constexpr uint32_t INVALID_NODE = UINT32_MAX;
+
+			/// <summary>
+			/// Transform in the depth sorted hierarchy.
+			/// </summary>
+			struct HierarchyNode
+			{
+				uint32_t m_iComponentIndex = 0; /// Position of the component in the component storage.
+				uint32_t m_iParentNode = INVALID_NODE; /// Position of the parent in the hierarchy.
+			};
+
+			/// <summary>
+			/// Rebuilds the depth sorted hierarchy. Transforms whose parent no longer has a transform get detached.
+			/// </summary>
+			void RebuildHierarchy();
+
+			std::vector<HierarchyNode> m_aHierarchy; /// Transforms sorted by depth, parents before children.
+			std::vector<uint8_t> m_aWorldDirty; /// Per node, whether its world matrix got recomputed this pass.
+			std::vector<uint32_t> m_aDepths; /// Scratch space used while rebuilding the hierarchy.
+			std::vector<uint32_t> m_aNodeIndices; /// Scratch space used while rebuilding the hierarchy.
+			uint32_t m_iHierarchyTick = 0; /// Change tick of the last hierarchy update.
+			bool m_bHierarchyDirty = true; /// Whether parents changed or components got removed since the last rebuild.
 		};
 	}
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "utils/rapidjson_config.h"
 #include <rapidjson/document.h>
 #include <string>
 
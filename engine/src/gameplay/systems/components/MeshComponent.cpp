@@ -1,15 +1,26 @@
 #include "gameplay/systems/components/MeshComponent.h"
 
+#ifdef _HEADLESS
+#include "graphics/null/Texture.h"
+#include "graphics/null/Mesh.h"
+#include "graphics/null/Shader.h"
+#else
 #include "graphics/dx12/Texture.h"
 #include "graphics/dx12/Mesh.h"
 #include "graphics/dx12/Shader.h"
-#include "graphics/dx12/DX12Transform.h"
+#endif // _HEADLESS
 #include "core/Tool.h"
 
 #include "gameplay/systems/TransformSystem.h"
 
+#include <algorithm>
+#include "utils/rapidjson_config.h"
+#include <rapidjson/utils.h>
+
+#ifndef _HEADLESS
 #include "graphics/dx12/CommandList.h"
 #include "graphics/dx12/CommandQueue.h"
+#endif // _HEADLESS
 
 #define JSON_MESH_COMPONENT_TEX_VAR "texture"
 #define JSON_MESH_COMPONENT_MESH_VAR "mesh"
@@ -17,6 +28,8 @@
 #define JSON_MESH_COMPONENT_SHADER_PIXEL_VAR "pixel"
 #define JSON_MESH_COMPONENT_SHADER_VERTEX_VAR "vertex"
 #define JSON_MESH_COMPONENT_MATERIAL_VAR "material"
+#define JSON_MESH_COMPONENT_LAYER_VAR "layer"
+#define JSON_MESH_COMPONENT_DEPTH_VAR "depth"
 
 namespace gallus
 {
@@ -27,70 +40,27 @@ namespace gallus
 		//---------------------------------------------------------------------
 		void MeshComponent::Init()
 		{
-			m_pShader = core::TOOL->GetResourceAtlas().GetDefaultShader();
-			m_pTexture = core::TOOL->GetResourceAtlas().GetDefaultTexture();
-			m_pMesh = core::TOOL->GetResourceAtlas().GetDefaultMesh();
-		}
-
-		//---------------------------------------------------------------------
-		void MeshComponent::SetMesh(std::shared_ptr<graphics::dx12::Mesh> a_pMesh)
-		{
-			m_pMesh = a_pMesh;
+			m_Shader = core::TOOL->GetResourceAtlas().GetDefaultShader();
+			m_Texture = core::TOOL->GetResourceAtlas().GetDefaultTexture();
+			m_Mesh = core::TOOL->GetResourceAtlas().GetDefaultMesh();
 		}
 
 		//---------------------------------------------------------------------
-		void MeshComponent::SetShader(std::shared_ptr<graphics::dx12::Shader> a_pShader)
+		void MeshComponent::SetMesh(core::MeshHandle a_Mesh)
 		{
-			m_pShader = a_pShader;
+			m_Mesh = a_Mesh;
 		}
 
 		//---------------------------------------------------------------------
-		void MeshComponent::SetTexture(std::shared_ptr<graphics::dx12::Texture> a_pTexture)
+		void MeshComponent::SetShader(core::ShaderHandle a_Shader)
 		{
-			m_pTexture = a_pTexture;
+			m_Shader = a_Shader;
 		}
 
 		//---------------------------------------------------------------------
-		void MeshComponent::Render(std::shared_ptr<graphics::dx12::CommandList> a_pCommandList, const EntityID& a_EntityID, const graphics::dx12::Camera& a_Camera)
+		void MeshComponent::SetTexture(core::TextureHandle a_Texture)
 		{
-			const DirectX::XMMATRIX viewMatrix = a_Camera.GetViewMatrix();
-			const DirectX::XMMATRIX& projectionMatrix = a_Camera.GetProjectionMatrix();
-
-			if (!core::TOOL->GetECS().GetEntity(a_EntityID))
-			{
-				return;
-			}
-
-			if (!core::TOOL->GetECS().GetEntity(a_EntityID)->IsActive())
-			{
-				return;
-			}
-
-			if (m_pTexture && m_pTexture->IsValid())
-			{
-				m_pTexture->Bind(a_pCommandList);
-			}
-
-			if (m_pShader)
-			{
-				m_pShader->Bind(a_pCommandList);
-			}
-
-			if (m_pMesh)
-			{
-				graphics::dx12::DX12Transform transform;
-				transform.SetScale({ 128.0f, 128.0f });
-				transform.SetPosition({ 300, 300 });
-				static float rot = 0;
-				rot += 0.1f;
-				transform.SetRotation(rot);
-				m_pMesh->Render(a_pCommandList, transform, viewMatrix, projectionMatrix);
-			}
-
-			if (m_pTexture && m_pTexture->IsValid())
-			{
-				m_pTexture->Unbind(a_pCommandList);
-			}
+			m_Texture = a_Texture;
 		}
 
 		//---------------------------------------------------------------------
@@ -101,10 +71,15 @@ namespace gallus
 				return;
 			}
 
-			std::string texPath = m_pTexture->GetName();
-			std::string meshPath = m_pMesh->GetName();
-			std::string vertexShaderPath = m_pShader->GetVertexPath();
-			std::string pixelShaderPath = m_pShader->GetPixelPath();
+			const core::ResourceAtlas& resourceAtlas = core::TOOL->GetResourceAtlas();
+			const graphics::backend::Texture* texture = resourceAtlas.GetTexture(m_Texture);
+			const graphics::backend::Mesh* mesh = resourceAtlas.GetMesh(m_Mesh);
+			const graphics::backend::Shader* shader = resourceAtlas.GetShader(m_Shader);
+
+			std::string texPath = texture ? texture->GetName() : "";
+			std::string meshPath = mesh ? mesh->GetName() : "";
+			std::string vertexShaderPath = shader ? shader->GetVertexPath() : "";
+			std::string pixelShaderPath = shader ? shader->GetPixelPath() : "";
 			a_Document.AddMember(
 				JSON_MESH_COMPONENT_TEX_VAR,
 				rapidjson::Value(texPath.c_str(), a_Allocator),
@@ -130,6 +105,9 @@ namespace gallus
 				rapidjson::Value(meshPath.c_str(), a_Allocator),
 				a_Allocator
 			);
+
+			a_Document.AddMember(JSON_MESH_COMPONENT_LAYER_VAR, static_cast<int>(m_iLayer), a_Allocator);
+			a_Document.AddMember(JSON_MESH_COMPONENT_DEPTH_VAR, m_fDepth, a_Allocator);
 		}
 
 		//---------------------------------------------------------------------
@@ -160,22 +138,45 @@ namespace gallus
 				meshPath = a_Document[JSON_MESH_COMPONENT_MESH_VAR].GetString();
 			}
 
-			std::shared_ptr<graphics::dx12::CommandQueue> cCommandQueue = core::TOOL->GetDX12().GetCommandQueue(D3D12_COMMAND_LIST_TYPE_COPY);
-			std::shared_ptr<graphics::dx12::CommandList> cCommandList = cCommandQueue->GetCommandList();
+			int layer = 0;
+			if (rapidjson::GetInt(a_Document, JSON_MESH_COMPONENT_LAYER_VAR, layer))
+			{
+				m_iLayer = static_cast<uint8_t>(std::clamp(layer, 0, 255));
+			}
+			rapidjson::GetFloat(a_Document, JSON_MESH_COMPONENT_DEPTH_VAR, m_fDepth);
+
+			core::ResourceAtlas& atlas = core::TOOL->GetResourceAtlas();
 			if (!meshPath.empty())
 			{
-				SetMesh(core::TOOL->GetResourceAtlas().LoadMesh(meshPath, cCommandList));
+				// Meshes are uploaded and flushed right away, but only the first component that uses one pays for it.
+#ifdef _HEADLESS
+				// The null backend has nothing to upload, so there is no command list.
+				std::shared_ptr<graphics::backend::CommandList> cCommandList = nullptr;
+				SetMesh(atlas.LoadMesh(meshPath, cCommandList));
+#else
+				if (atlas.HasMesh(meshPath))
+				{
+					SetMesh(atlas.LoadMesh(meshPath, nullptr));
+				}
+				else
+				{
+					std::shared_ptr<graphics::dx12::CommandQueue> cCommandQueue = core::TOOL->GetDX12().GetCommandQueue(D3D12_COMMAND_LIST_TYPE_COPY);
+					std::shared_ptr<graphics::dx12::CommandList> cCommandList = cCommandQueue->GetCommandList();
+					SetMesh(atlas.LoadMesh(meshPath, cCommandList));
+					cCommandQueue->ExecuteCommandList(cCommandList);
+					cCommandQueue->Flush();
+				}
+#endif // _HEADLESS
 			}
 			if (!texPath.empty())
 			{
-				SetTexture(core::TOOL->GetResourceAtlas().LoadTexture(texPath, cCommandList));
+				// Decoded on the job system and uploaded by the atlas, the texture stays pending until then.
+				SetTexture(atlas.LoadTextureAsync(texPath));
 			}
 			if (!shaderPathVertex.empty() && !shaderPathPixel.empty())
 			{
-				SetShader(core::TOOL->GetResourceAtlas().LoadShader(shaderPathVertex, shaderPathPixel));
+				SetShader(atlas.LoadShader(shaderPathVertex, shaderPathPixel));
 			}
-			cCommandQueue->ExecuteCommandList(cCommandList);
-			cCommandQueue->Flush();
 		}
 	}
 }
\ No newline at end of file
@@ -1,9 +1,14 @@
 #pragma once
 
+#ifndef _HEADLESS
 #include "graphics/dx12/DX12PCH.h"
+#endif // _HEADLESS
 
 #include "gameplay/systems/components/Component.h"
+#include "graphics/GraphicsBackend.h"
+#include "core/ResourceAtlas.h"
 
+#include <cstdint>
 #include <memory>
 
 namespace gallus
@@ -12,13 +17,7 @@ namespace gallus
 	{
 		namespace dx12
 		{
-			class CommandList;
-
 			class DX12Transform;
-			class Texture;
-			class Shader;
-			class Mesh;
-			class Camera;
 		}
 	}
 	namespace gameplay
@@ -36,55 +35,83 @@ namespace gallus
 			/// <summary>
 			/// Sets the mesh used by the mesh component.
 			/// </summary>
-			/// <param name="a_Mesh">Reference to the mesh that the mesh component will use.</param>
-			void SetMesh(std::shared_ptr<graphics::dx12::Mesh> a_pMesh);
+			/// <param name="a_Mesh">Handle to the mesh that the mesh component will use.</param>
+			void SetMesh(core::MeshHandle a_Mesh);
 
 			/// <summary>
 			/// Sets the shader used by the mesh component.
 			/// </summary>
-			/// <param name="a_Shader">Reference to the shader that the mesh component will use.</param>
-			void SetShader(std::shared_ptr<graphics::dx12::Shader> a_pShader);
+			/// <param name="a_Shader">Handle to the shader that the mesh component will use.</param>
+			void SetShader(core::ShaderHandle a_Shader);
 
 			/// <summary>
 			/// Sets the texture used by the mesh component.
 			/// </summary>
-			/// <param name="a_Texture">Reference to the texture that the mesh component will use.</param>
-			void SetTexture(std::shared_ptr<graphics::dx12::Texture> a_pTexture);
+			/// <param name="a_Texture">Handle to the texture that the mesh component will use.</param>
+			void SetTexture(core::TextureHandle a_Texture);
 
 			/// <summary>
 			/// Retrieves the mesh used by the mesh component.
 			/// </summary>
-			/// <returns>Pointer to the mesh if the mesh exists, otherwise nullptr.</returns>
-			std::shared_ptr<graphics::dx12::Mesh> GetMesh() const
+			/// <returns>Handle to the mesh, resolved through the resource atlas.</returns>
+			core::MeshHandle GetMesh() const
 			{
-				return m_pMesh;
+				return m_Mesh;
 			}
 
 			/// <summary>
 			/// Retrieves the shader used by the mesh component.
 			/// </summary>
-			/// <returns>Pointer to the mesh if the mesh exists, otherwise nullptr.</returns>
-			std::shared_ptr<graphics::dx12::Shader> GetShader()
+			/// <returns>Handle to the shader, resolved through the resource atlas.</returns>
+			core::ShaderHandle GetShader() const
 			{
-				return m_pShader;
+				return m_Shader;
 			}
 
 			/// <summary>
 			/// Retrieves the texture used by the mesh component.
 			/// </summary>
-			/// <returns>Pointer to the mesh if the mesh exists, otherwise nullptr.</returns>
-			std::shared_ptr<graphics::dx12::Texture> GetTexture()
+			/// <returns>Handle to the texture, resolved through the resource atlas.</returns>
+			core::TextureHandle GetTexture() const
+			{
+				return m_Texture;
+			}
+
+			/// <summary>
+			/// Sets the layer the mesh is drawn in. Layers are drawn in ascending order.
+			/// </summary>
+			/// <param name="a_iLayer">The layer.</param>
+			void SetLayer(uint8_t a_iLayer)
+			{
+				m_iLayer = a_iLayer;
+			}
+
+			/// <summary>
+			/// Retrieves the layer the mesh is drawn in.
+			/// </summary>
+			/// <returns>The layer.</returns>
+			uint8_t GetLayer() const
 			{
-				return m_pTexture;
+				return m_iLayer;
 			}
 
 			/// <summary>
-			/// Renders the mesh.
+			/// Sets the depth of the mesh within its layer. Meshes with a higher depth are drawn later, on top of the others.
 			/// </summary>
-			/// <param name="a_pCommandList">The command list used for rendering.</param>
-			/// <param name="a_EntityID">The entity ID to get the data from.</param>
-			/// <param name="a_Camera">The camera.</param>
-			void Render(std::shared_ptr<graphics::dx12::CommandList> a_pCommandList, const EntityID& a_EntityID, const graphics::dx12::Camera& a_Camera);
+			/// <param name="a_fDepth">The depth.</param>
+			void SetDepth(float a_fDepth)
+			{
+				m_fDepth = a_fDepth;
+			}
+
+			/// <summary>
+			/// Retrieves the depth of the mesh within its layer.
+			/// </summary>
+			/// <returns>The depth.</returns>
+			float GetDepth() const
+			{
+				return m_fDepth;
+			}
 
 			/// <summary>
 			/// Serialized the component to a json document.
@@ -100,9 +127,11 @@ namespace gallus
 			/// <param name="a_Allocator">The allocator used by the json document.</param>
 			void Deserialize(const rapidjson::Value& a_Document, rapidjson::Document::AllocatorType& a_Allocator) override;
 		private:
-			std::shared_ptr<graphics::dx12::Mesh> m_pMesh = nullptr;
-			std::shared_ptr<graphics::dx12::Shader> m_pShader = nullptr;
-			std::shared_ptr<graphics::dx12::Texture> m_pTexture = nullptr;
+			core::MeshHandle m_Mesh;
+			core::ShaderHandle m_Shader;
+			core::TextureHandle m_Texture;
+			uint8_t m_iLayer = 0;
+			float m_fDepth = 0.0f;
 		};
 	}
 }
\ No newline at end of file
@@ -1,9 +1,8 @@
 #include "gameplay/systems/components/TransformComponent.h"
 
+#include "utils/rapidjson_config.h"
 #include <rapidjson/utils.h>
 
-#include <DirectXMath.h>
-
 #define JSON_ENTITY_TRANSFORM_COMPONENT_POSITION_VAR "position"
 #define JSON_ENTITY_TRANSFORM_COMPONENT_ROTATION_VAR "rotation"
 #define JSON_ENTITY_TRANSFORM_COMPONENT_SCALE_VAR "scale"
@@ -17,11 +16,29 @@ namespace gallus
 		//---------------------------------------------------------------------
 		// TransformComponent
 		//---------------------------------------------------------------------
-		graphics::dx12::DX12Transform& TransformComponent::Transform()
+		math::Transform2D& TransformComponent::Transform()
 		{
 			return m_Transform;
 		}
 
+		//---------------------------------------------------------------------
+		const EntityID& TransformComponent::GetParent() const
+		{
+			return m_Parent;
+		}
+
+		//---------------------------------------------------------------------
+		const math::Affine2D& TransformComponent::GetLocalMatrix() const
+		{
+			return m_mLocalMatrix;
+		}
+
+		//---------------------------------------------------------------------
+		const math::Affine2D& TransformComponent::GetWorldMatrix() const
+		{
+			return m_mWorldMatrix;
+		}
+
 		//---------------------------------------------------------------------
 		void TransformComponent::Serialize(rapidjson::Value& a_Document, rapidjson::Document::AllocatorType& a_Allocator) const
 		{
@@ -55,7 +72,7 @@ namespace gallus
 
 			if (a_Document.HasMember(JSON_ENTITY_TRANSFORM_COMPONENT_POSITION_VAR) && a_Document[JSON_ENTITY_TRANSFORM_COMPONENT_POSITION_VAR].IsObject())
 			{
-				DirectX::XMFLOAT2 position;
+				math::Vector2 position;
 				rapidjson::GetFloat(a_Document[JSON_ENTITY_TRANSFORM_COMPONENT_POSITION_VAR], JSON_ENTITY_TRANSFORM_COMPONENT_X_VAR, position.x);
 				rapidjson::GetFloat(a_Document[JSON_ENTITY_TRANSFORM_COMPONENT_POSITION_VAR], JSON_ENTITY_TRANSFORM_COMPONENT_Y_VAR, position.y);
 				m_Transform.SetPosition(position);
@@ -70,7 +87,7 @@ namespace gallus
 
 			if (a_Document.HasMember(JSON_ENTITY_TRANSFORM_COMPONENT_SCALE_VAR) && a_Document[JSON_ENTITY_TRANSFORM_COMPONENT_SCALE_VAR].IsObject())
 			{
-				DirectX::XMFLOAT2 scale;
+				math::Vector2 scale;
 				rapidjson::GetFloat(a_Document[JSON_ENTITY_TRANSFORM_COMPONENT_SCALE_VAR], JSON_ENTITY_TRANSFORM_COMPONENT_X_VAR, scale.x);
 				rapidjson::GetFloat(a_Document[JSON_ENTITY_TRANSFORM_COMPONENT_SCALE_VAR], JSON_ENTITY_TRANSFORM_COMPONENT_Y_VAR, scale.y);
 				m_Transform.SetScale(scale);
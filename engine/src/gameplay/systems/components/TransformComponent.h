@@ -2,7 +2,8 @@
 
 #include "gameplay/systems/components/Component.h"
 
-#include "graphics/dx12/DX12Transform.h"
+#include "gameplay/EntityID.h"
+#include "math/Affine2D.h"
 
 namespace gallus
 {
@@ -15,10 +16,29 @@ namespace gallus
 		{
 		public:
 			/// <summary>
-			/// Retrieves the transform.
+			/// Retrieves the local transform, relative to the parent.
+			/// Changes are picked up by the transform system if the component was retrieved through GetComponent or marked changed.
 			/// </summary>
 			/// <returns>Reference to the transform used in the transform component.</returns>
-			graphics::dx12::DX12Transform& Transform();
+			math::Transform2D& Transform();
+
+			/// <summary>
+			/// Retrieves the parent of the transform.
+			/// </summary>
+			/// <returns>The parent entity, or an invalid id if the transform has no parent.</returns>
+			const EntityID& GetParent() const;
+
+			/// <summary>
+			/// Retrieves the cached local matrix, as of the last hierarchy update.
+			/// </summary>
+			/// <returns>The local matrix.</returns>
+			const math::Affine2D& GetLocalMatrix() const;
+
+			/// <summary>
+			/// Retrieves the cached world matrix, as of the last hierarchy update.
+			/// </summary>
+			/// <returns>The world matrix.</returns>
+			const math::Affine2D& GetWorldMatrix() const;
 
 			/// <summary>
 			/// Serialized the component to a json document.
@@ -34,7 +54,12 @@ namespace gallus
 			/// <param name="a_Allocator">The allocator used by the json document.</param>
 			void Deserialize(const rapidjson::Value& a_Document, rapidjson::Document::AllocatorType& a_Allocator) override;
 		private:
-			graphics::dx12::DX12Transform m_Transform;
+			friend class TransformSystem;
+
+			math::Transform2D m_Transform;
+			EntityID m_Parent; /// Parent entity, set through TransformSystem::SetParent.
+			math::Affine2D m_mLocalMatrix; /// Cached local matrix, updated by the transform system.
+			math::Affine2D m_mWorldMatrix; /// Cached world matrix, updated by the transform system.
 		};
 	}
 }
\ No newline at end of file
@@ -0,0 +1,35 @@
+#pragma once
+
+namespace gallus
+{
+	namespace graphics
+	{
+#ifdef _HEADLESS
+		namespace null
+		{
+			class CommandList;
+			class Texture;
+			class Shader;
+			class Mesh;
+		}
+
+		/// <summary>
+		/// Graphics implementation the engine is built against. Headless builds use the null implementation, which needs no window or gpu.
+		/// </summary>
+		namespace backend = null;
+#else
+		namespace dx12
+		{
+			class CommandList;
+			class Texture;
+			class Shader;
+			class Mesh;
+		}
+
+		/// <summary>
+		/// Graphics implementation the engine is built against.
+		/// </summary>
+		namespace backend = dx12;
+#endif // _HEADLESS
+	}
+}
\ No newline at end of file
@@ -0,0 +1,36 @@
+#include "graphics/RenderDevice.h"
+
+#include "graphics/SpriteBatcher.h"
+
+namespace gallus
+{
+	namespace graphics
+	{
+		//---------------------------------------------------------------------
+		// RenderDevice
+		//---------------------------------------------------------------------
+		void RenderDevice::DrawBatches(const SpriteBatcher& a_Batcher)
+		{
+			const std::vector<SpriteInstance>& instances = a_Batcher.GetInstances();
+			if (instances.empty() || !SetInstances(instances))
+			{
+				return;
+			}
+
+			for (const SpriteBatch& batch : a_Batcher.GetBatches())
+			{
+				if (batch.m_bBindTexture && batch.m_pTexture)
+				{
+					BindTexture(batch.m_pTexture);
+				}
+
+				if (batch.m_bBindShader && batch.m_pShader)
+				{
+					BindShader(batch.m_pShader);
+				}
+
+				DrawInstanced(batch.m_pMesh, batch.m_iFirstInstance, batch.m_iInstanceCount);
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec4.hpp>
+
+#include "graphics/GraphicsBackend.h"
+
+namespace gallus
+{
+	namespace graphics
+	{
+		struct SpriteInstance;
+		class SpriteBatcher;
+
+		//---------------------------------------------------------------------
+		// RenderDevice
+		//---------------------------------------------------------------------
+		/// <summary>
+		/// Records the draw commands of a frame without knowing what executes them. The dx12 system records them into a
+		/// command list, the software device rasterizes them straight into a frame buffer. Everything the renderers share,
+		/// like walking the sprite batches, is written once against this interface.
+		/// </summary>
+		class RenderDevice
+		{
+		public:
+			virtual ~RenderDevice() = default;
+
+			/// <summary>
+			/// Clears the render target.
+			/// </summary>
+			/// <param name="a_vColor">The clear color.</param>
+			virtual void Clear(const glm::vec4& a_vColor) = 0;
+
+			/// <summary>
+			/// Sets the matrix that maps world positions to clip space, for the draws that follow.
+			/// </summary>
+			/// <param name="a_ViewProjection">The view projection matrix, for column vectors.</param>
+			virtual void SetViewProjection(const glm::mat4& a_ViewProjection) = 0;
+
+			/// <summary>
+			/// Sets the instance data the draws that follow index into.
+			/// </summary>
+			/// <param name="a_aInstances">The instances. Has to stay alive until the last draw that uses it.</param>
+			/// <returns>True if the instances could be used, otherwise false.</returns>
+			virtual bool SetInstances(const std::vector<SpriteInstance>& a_aInstances) = 0;
+
+			/// <summary>
+			/// Binds a shader for the draws that follow.
+			/// </summary>
+			/// <param name="a_pShader">The shader.</param>
+			virtual void BindShader(backend::Shader* a_pShader) = 0;
+
+			/// <summary>
+			/// Binds a texture for the draws that follow.
+			/// </summary>
+			/// <param name="a_pTexture">The texture.</param>
+			virtual void BindTexture(backend::Texture* a_pTexture) = 0;
+
+			/// <summary>
+			/// Draws a range of the instances with a mesh.
+			/// </summary>
+			/// <param name="a_pMesh">The mesh.</param>
+			/// <param name="a_iFirstInstance">Index of the first instance.</param>
+			/// <param name="a_iInstanceCount">The number of instances.</param>
+			virtual void DrawInstanced(backend::Mesh* a_pMesh, uint32_t a_iFirstInstance, uint32_t a_iInstanceCount) = 0;
+
+			/// <summary>
+			/// Draws all batches of a sprite batcher, only binding the shaders and textures that differ from the previous batch.
+			/// </summary>
+			/// <param name="a_Batcher">The sprite batcher.</param>
+			void DrawBatches(const SpriteBatcher& a_Batcher);
+		};
+	}
+}
\ No newline at end of file
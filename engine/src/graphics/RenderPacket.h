@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/vec4.hpp>
+
+#include "graphics/GraphicsBackend.h"
+#include "math/Affine2D.h"
+
+namespace gallus
+{
+	namespace graphics
+	{
+		//---------------------------------------------------------------------
+		// DrawItem
+		//---------------------------------------------------------------------
+		/// <summary>
+		/// Everything the renderer needs to draw a single mesh, copied out of the ecs so rendering never touches components.
+		/// The resources are owned by the resource atlas, which keeps unloaded resources alive until the gpu finished drawing
+		/// every packet that may point at them.
+		/// </summary>
+		struct DrawItem
+		{
+			math::Affine2D m_WorldMatrix; /// World matrix of the entity.
+			glm::vec4 m_vUVRect = { 0.0f, 0.0f, 1.0f, 1.0f }; /// Offset (xy) and size (zw) of the part of the texture that is drawn.
+			glm::vec4 m_vColor = { 1.0f, 1.0f, 1.0f, 1.0f }; /// Color the texture gets multiplied with.
+			backend::Mesh* m_pMesh = nullptr;
+			backend::Shader* m_pShader = nullptr;
+			backend::Texture* m_pTexture = nullptr;
+			float m_fDepth = 0.0f; /// Depth within the layer, higher depths are drawn on top.
+			uint8_t m_iLayer = 0; /// Layer the draw belongs to, higher layers are drawn on top.
+		};
+
+		//---------------------------------------------------------------------
+		// RenderPacket
+		//---------------------------------------------------------------------
+		/// <summary>
+		/// Draw data of a single simulated frame, handed from the game thread to the render thread.
+		/// </summary>
+		struct RenderPacket
+		{
+			std::vector<DrawItem> m_aDrawItems;
+			uint64_t m_iFrame = 0; /// Frame the packet was extracted in.
+			float m_fAlpha = 0.0f; /// Interpolation alpha of the game loop at the time of extraction.
+
+			/// <summary>
+			/// Removes all draw items, keeping the memory for the next frame.
+			/// </summary>
+			void Clear()
+			{
+				m_aDrawItems.clear();
+				m_iFrame = 0;
+				m_fAlpha = 0.0f;
+			}
+		};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,140 @@
+#include "graphics/RenderQueue.h"
+
+#include <array>
+#include <cstring>
+
+#include "graphics/RenderPacket.h"
+
+namespace gallus
+{
+	namespace graphics
+	{
+		namespace
+		{
+			/// <summary>
+			/// Maps a float to an unsigned integer with the same ordering, so depths can be compared as bits.
+			/// </summary>
+			/// <param name="a_fValue">The float.</param>
+			/// <returns>The sortable bits.</returns>
+			uint32_t FloatToSortableBits(float a_fValue)
+			{
+				uint32_t bits = 0;
+				memcpy(&bits, &a_fValue, sizeof(bits));
+
+				// Negative floats get all bits flipped so they order in reverse, positive floats only get the sign bit set so they come after.
+				return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+			}
+		}
+
+		//---------------------------------------------------------------------
+		// RenderQueue
+		//---------------------------------------------------------------------
+		uint64_t RenderQueue::MakeKey(uint8_t a_iLayer, float a_fDepth, uint32_t a_iShaderID, uint32_t a_iTextureID, uint32_t a_iMeshID)
+		{
+			constexpr uint32_t MESH_SHIFT = 0;
+			constexpr uint32_t TEXTURE_SHIFT = MESH_SHIFT + MESH_BITS;
+			constexpr uint32_t SHADER_SHIFT = TEXTURE_SHIFT + TEXTURE_BITS;
+			constexpr uint32_t DEPTH_SHIFT = SHADER_SHIFT + SHADER_BITS;
+			constexpr uint32_t LAYER_SHIFT = DEPTH_SHIFT + DEPTH_BITS;
+			static_assert(LAYER_SHIFT + LAYER_BITS == 64, "The sort key fields have to fill 64 bits.");
+
+			// Only the highest bits of the depth fit, which keeps the order but merges depths that are very close together.
+			const uint64_t depth = FloatToSortableBits(a_fDepth) >> (32 - DEPTH_BITS);
+
+			return (static_cast<uint64_t>(a_iLayer) << LAYER_SHIFT) |
+				(depth << DEPTH_SHIFT) |
+				(static_cast<uint64_t>(a_iShaderID & ((1u << SHADER_BITS) - 1)) << SHADER_SHIFT) |
+				(static_cast<uint64_t>(a_iTextureID & ((1u << TEXTURE_BITS) - 1)) << TEXTURE_SHIFT) |
+				(static_cast<uint64_t>(a_iMeshID & ((1u << MESH_BITS) - 1)) << MESH_SHIFT);
+		}
+
+		//---------------------------------------------------------------------
+		void RenderQueue::Clear()
+		{
+			m_aEntries.clear();
+		}
+
+		//---------------------------------------------------------------------
+		void RenderQueue::Submit(const DrawItem& a_Item, uint32_t a_iIndex)
+		{
+			Entry& entry = m_aEntries.emplace_back();
+			entry.m_iKey = MakeKey(a_Item.m_iLayer, a_Item.m_fDepth,
+				GetResourceID(m_aShaderIDs, a_Item.m_pShader),
+				GetResourceID(m_aTextureIDs, a_Item.m_pTexture),
+				GetResourceID(m_aMeshIDs, a_Item.m_pMesh));
+			entry.m_iIndex = a_iIndex;
+		}
+
+		//---------------------------------------------------------------------
+		void RenderQueue::Sort()
+		{
+			constexpr uint32_t RADIX_BITS = 8;
+			constexpr uint32_t BUCKET_COUNT = 1 << RADIX_BITS;
+			constexpr uint32_t PASS_COUNT = 64 / RADIX_BITS;
+
+			const size_t count = m_aEntries.size();
+			if (count < 2)
+			{
+				return;
+			}
+
+			// Counting all digits in one go saves a read of the entries per pass.
+			std::array<std::array<uint32_t, BUCKET_COUNT>, PASS_COUNT> histograms{};
+			for (const Entry& entry : m_aEntries)
+			{
+				for (uint32_t pass = 0; pass < PASS_COUNT; pass++)
+				{
+					histograms[pass][(entry.m_iKey >> (pass * RADIX_BITS)) & (BUCKET_COUNT - 1)]++;
+				}
+			}
+
+			m_aScratch.resize(count);
+			for (uint32_t pass = 0; pass < PASS_COUNT; pass++)
+			{
+				std::array<uint32_t, BUCKET_COUNT>& histogram = histograms[pass];
+
+				// When every key has the same digit the pass would not change anything. This skips most passes,
+				// because the high bits (layers) and the resource ids rarely use their full range.
+				const uint32_t shift = pass * RADIX_BITS;
+				if (histogram[(m_aEntries[0].m_iKey >> shift) & (BUCKET_COUNT - 1)] == count)
+				{
+					continue;
+				}
+
+				uint32_t offset = 0;
+				for (uint32_t& bucket : histogram)
+				{
+					const uint32_t bucketCount = bucket;
+					bucket = offset;
+					offset += bucketCount;
+				}
+
+				for (const Entry& entry : m_aEntries)
+				{
+					m_aScratch[histogram[(entry.m_iKey >> shift) & (BUCKET_COUNT - 1)]++] = entry;
+				}
+				m_aEntries.swap(m_aScratch);
+			}
+		}
+
+		//---------------------------------------------------------------------
+		const std::vector<RenderQueue::Entry>& RenderQueue::GetEntries() const
+		{
+			return m_aEntries;
+		}
+
+		//---------------------------------------------------------------------
+		uint32_t RenderQueue::GetResourceID(std::unordered_map<const void*, uint32_t>& a_aIDs, const void* a_pResource)
+		{
+			const auto it = a_aIDs.find(a_pResource);
+			if (it != a_aIDs.end())
+			{
+				return it->second;
+			}
+
+			const uint32_t id = static_cast<uint32_t>(a_aIDs.size());
+			a_aIDs.emplace(a_pResource, id);
+			return id;
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace gallus
+{
+	namespace graphics
+	{
+		struct DrawItem;
+
+		//---------------------------------------------------------------------
+		// RenderQueue
+		//---------------------------------------------------------------------
+		/// <summary>
+		/// Orders the draws of a frame by a 64-bit key, so draws end up in layer and depth order and draws that share
+		/// state end up next to each other. From the highest to the lowest bits the key holds the layer, the depth,
+		/// the shader, the texture and the mesh. Submissions are sorted with a stable radix sort, so draws with equal
+		/// keys keep the order they were submitted in.
+		/// </summary>
+		class RenderQueue
+		{
+		public:
+			static constexpr uint32_t LAYER_BITS = 8;
+			static constexpr uint32_t DEPTH_BITS = 16;
+			static constexpr uint32_t SHADER_BITS = 12;
+			static constexpr uint32_t TEXTURE_BITS = 16;
+			static constexpr uint32_t MESH_BITS = 12;
+
+			/// <summary>
+			/// A submitted draw.
+			/// </summary>
+			struct Entry
+			{
+				uint64_t m_iKey = 0;
+				uint32_t m_iIndex = 0; /// Index of the draw item in the render packet.
+			};
+
+			/// <summary>
+			/// Packs the sort key of a draw. Ids that do not fit in their bits wrap around, which only costs batching, not correctness.
+			/// </summary>
+			/// <param name="a_iLayer">The layer.</param>
+			/// <param name="a_fDepth">The depth within the layer.</param>
+			/// <param name="a_iShaderID">Id of the shader.</param>
+			/// <param name="a_iTextureID">Id of the texture.</param>
+			/// <param name="a_iMeshID">Id of the mesh.</param>
+			/// <returns>The sort key.</returns>
+			static uint64_t MakeKey(uint8_t a_iLayer, float a_fDepth, uint32_t a_iShaderID, uint32_t a_iTextureID, uint32_t a_iMeshID);
+
+			/// <summary>
+			/// Removes all submissions. The resource ids are kept.
+			/// </summary>
+			void Clear();
+
+			/// <summary>
+			/// Submits a draw.
+			/// </summary>
+			/// <param name="a_Item">The draw item.</param>
+			/// <param name="a_iIndex">Index of the draw item in the render packet.</param>
+			void Submit(const DrawItem& a_Item, uint32_t a_iIndex);
+
+			/// <summary>
+			/// Sorts the submissions by their key.
+			/// </summary>
+			void Sort();
+
+			/// <summary>
+			/// Retrieves the submissions, sorted if Sort has been called since the last submission.
+			/// </summary>
+			/// <returns>The submissions.</returns>
+			const std::vector<Entry>& GetEntries() const;
+		private:
+			/// <summary>
+			/// Retrieves the id of a resource, assigning the next free id the first time a resource is seen.
+			/// </summary>
+			/// <param name="a_aIDs">The ids of the resources of one type.</param>
+			/// <param name="a_pResource">The resource.</param>
+			/// <returns>The id of the resource.</returns>
+			static uint32_t GetResourceID(std::unordered_map<const void*, uint32_t>& a_aIDs, const void* a_pResource);
+
+			std::vector<Entry> m_aEntries;
+			std::vector<Entry> m_aScratch; /// Second buffer for the radix sort passes.
+
+			// Resources do not move and outlive the packets that point at them, so their addresses identify them. A resource that
+			// is created at the address of an unloaded one gets its id, which only costs batching.
+			std::unordered_map<const void*, uint32_t> m_aShaderIDs;
+			std::unordered_map<const void*, uint32_t> m_aTextureIDs;
+			std::unordered_map<const void*, uint32_t> m_aMeshIDs;
+		};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,88 @@
+#include "graphics/SpriteBatcher.h"
+
+#include "graphics/RenderPacket.h"
+
+namespace gallus
+{
+	namespace graphics
+	{
+		//---------------------------------------------------------------------
+		// SpriteBatcher
+		//---------------------------------------------------------------------
+		void SpriteBatcher::Build(const RenderPacket& a_Packet)
+		{
+			const std::vector<DrawItem>& items = a_Packet.m_aDrawItems;
+
+			m_RenderQueue.Clear();
+			m_aInstances.clear();
+			m_aBatches.clear();
+			m_Stats = {};
+
+			for (uint32_t i = 0; i < static_cast<uint32_t>(items.size()); i++)
+			{
+				if (items[i].m_pMesh)
+				{
+					m_RenderQueue.Submit(items[i], i);
+				}
+			}
+			m_RenderQueue.Sort();
+
+			const std::vector<RenderQueue::Entry>& entries = m_RenderQueue.GetEntries();
+			m_aInstances.reserve(entries.size());
+
+			uint64_t batchKey = 0;
+			for (const RenderQueue::Entry& entry : entries)
+			{
+				const DrawItem& item = items[entry.m_iIndex];
+
+				// Resource ids can wrap around in the key, so the resources themselves decide where a batch ends as well.
+				if (m_aBatches.empty() ||
+					batchKey != entry.m_iKey ||
+					m_aBatches.back().m_pMesh != item.m_pMesh ||
+					m_aBatches.back().m_pShader != item.m_pShader ||
+					m_aBatches.back().m_pTexture != item.m_pTexture)
+				{
+					const SpriteBatch* previous = m_aBatches.empty() ? nullptr : &m_aBatches.back();
+					const bool bindShader = !previous || previous->m_pShader != item.m_pShader;
+					const bool bindTexture = !previous || previous->m_pTexture != item.m_pTexture;
+
+					SpriteBatch& batch = m_aBatches.emplace_back();
+					batch.m_pMesh = item.m_pMesh;
+					batch.m_pShader = item.m_pShader;
+					batch.m_pTexture = item.m_pTexture;
+					batch.m_iFirstInstance = static_cast<uint32_t>(m_aInstances.size());
+					batch.m_bBindShader = bindShader;
+					batch.m_bBindTexture = bindTexture;
+					batchKey = entry.m_iKey;
+
+					(bindShader ? m_Stats.m_iShaderBinds : m_Stats.m_iShaderBindsSkipped)++;
+					(bindTexture ? m_Stats.m_iTextureBinds : m_Stats.m_iTextureBindsSkipped)++;
+				}
+
+				m_aInstances.push_back({ item.m_WorldMatrix, item.m_vUVRect, item.m_vColor });
+				m_aBatches.back().m_iInstanceCount++;
+			}
+
+			m_Stats.m_iDrawCount = static_cast<uint32_t>(m_aInstances.size());
+			m_Stats.m_iBatchCount = static_cast<uint32_t>(m_aBatches.size());
+		}
+
+		//---------------------------------------------------------------------
+		const std::vector<SpriteInstance>& SpriteBatcher::GetInstances() const
+		{
+			return m_aInstances;
+		}
+
+		//---------------------------------------------------------------------
+		const std::vector<SpriteBatch>& SpriteBatcher::GetBatches() const
+		{
+			return m_aBatches;
+		}
+
+		//---------------------------------------------------------------------
+		const RenderStats& SpriteBatcher::GetStats() const
+		{
+			return m_Stats;
+		}
+	}
+}
\ No newline at end of file
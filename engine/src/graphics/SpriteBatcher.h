@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/vec4.hpp>
+
+#include "graphics/GraphicsBackend.h"
+#include "graphics/RenderQueue.h"
+#include "math/Affine2D.h"
+
+namespace gallus
+{
+	namespace graphics
+	{
+		struct RenderPacket;
+
+		//---------------------------------------------------------------------
+		// SpriteInstance
+		//---------------------------------------------------------------------
+		/// <summary>
+		/// Per-instance data of a sprite, uploaded to the gpu as is. The layout matches the instance input layout of the sprite shaders.
+		/// </summary>
+		struct SpriteInstance
+		{
+			math::Affine2D m_WorldMatrix; /// World matrix of the sprite.
+			glm::vec4 m_vUVRect; /// Offset (xy) and size (zw) of the part of the texture that is drawn.
+			glm::vec4 m_vColor; /// Color the texture gets multiplied with.
+		};
+		static_assert(sizeof(SpriteInstance) == 56, "SpriteInstance has to match the instance input layout.");
+
+		//---------------------------------------------------------------------
+		// SpriteBatch
+		//---------------------------------------------------------------------
+		/// <summary>
+		/// Range of instances that share a shader, texture and mesh and can be drawn with a single instanced draw call.
+		/// </summary>
+		struct SpriteBatch
+		{
+			backend::Mesh* m_pMesh = nullptr;
+			backend::Shader* m_pShader = nullptr;
+			backend::Texture* m_pTexture = nullptr;
+			uint32_t m_iFirstInstance = 0; /// Index of the first instance of the batch.
+			uint32_t m_iInstanceCount = 0; /// Number of instances in the batch.
+			bool m_bBindShader = false; /// Whether the shader differs from the one of the previous batch.
+			bool m_bBindTexture = false; /// Whether the texture differs from the one of the previous batch.
+		};
+
+		//---------------------------------------------------------------------
+		// RenderStats
+		//---------------------------------------------------------------------
+		/// <summary>
+		/// Counters of the last built frame.
+		/// </summary>
+		struct RenderStats
+		{
+			uint32_t m_iDrawCount = 0; /// Number of sprites.
+			uint32_t m_iBatchCount = 0; /// Number of instanced draw calls.
+			uint32_t m_iShaderBinds = 0; /// Number of shader changes.
+			uint32_t m_iShaderBindsSkipped = 0; /// Number of batches that kept the shader of the previous batch.
+			uint32_t m_iTextureBinds = 0; /// Number of texture changes.
+			uint32_t m_iTextureBindsSkipped = 0; /// Number of batches that kept the texture of the previous batch.
+		};
+
+		//---------------------------------------------------------------------
+		// SpriteBatcher
+		//---------------------------------------------------------------------
+		/// <summary>
+		/// Turns the draw items of a render packet into instance data and batches. The draws are ordered by a render queue,
+		/// so every combination of layer, depth, shader, texture and mesh takes a single draw call and state only gets
+		/// bound when it changes. Does not touch the gpu.
+		/// </summary>
+		class SpriteBatcher
+		{
+		public:
+			/// <summary>
+			/// Builds the instances and batches for a render packet, replacing the previous ones.
+			/// Draws with the same sort key keep the order they had in the packet.
+			/// </summary>
+			/// <param name="a_Packet">The render packet.</param>
+			void Build(const RenderPacket& a_Packet);
+
+			/// <summary>
+			/// Retrieves the instances of all batches, stored back to back in batch order.
+			/// </summary>
+			/// <returns>The instances.</returns>
+			const std::vector<SpriteInstance>& GetInstances() const;
+
+			/// <summary>
+			/// Retrieves the batches.
+			/// </summary>
+			/// <returns>The batches, in the order they should be drawn.</returns>
+			const std::vector<SpriteBatch>& GetBatches() const;
+
+			/// <summary>
+			/// Retrieves the counters of the last build.
+			/// </summary>
+			/// <returns>The counters.</returns>
+			const RenderStats& GetStats() const;
+		private:
+			RenderQueue m_RenderQueue;
+			RenderStats m_Stats;
+			std::vector<SpriteInstance> m_aInstances;
+			std::vector<SpriteBatch> m_aBatches;
+		};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,479 @@
+#include "graphics/TextureData.h"
+
+// Every build decodes images through this file, so it owns the stb_image implementation.
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+
+#include <algorithm>
+#include <cstring>
+
+#include "logger/Logger.h"
+
+namespace gallus
+{
+	namespace graphics
+	{
+		//---------------------------------------------------------------------
+		bool IsBlockCompressed(TextureFormat a_Format)
+		{
+			return a_Format != TextureFormat::RGBA8;
+		}
+
+		//---------------------------------------------------------------------
+		size_t GetTextureBlockSize(TextureFormat a_Format)
+		{
+			switch (a_Format)
+			{
+				case TextureFormat::BC1:
+				case TextureFormat::BC4:
+				{
+					return 8;
+				}
+				case TextureFormat::BC3:
+				case TextureFormat::BC5:
+				case TextureFormat::BC7:
+				{
+					return 16;
+				}
+				case TextureFormat::RGBA8:
+				default:
+				{
+					return 4;
+				}
+			}
+		}
+
+		//---------------------------------------------------------------------
+		size_t GetTextureRowPitch(TextureFormat a_Format, uint32_t a_iWidth)
+		{
+			const uint32_t columns = IsBlockCompressed(a_Format) ? (a_iWidth + 3) / 4 : a_iWidth;
+			return static_cast<size_t>(columns) * GetTextureBlockSize(a_Format);
+		}
+
+		//---------------------------------------------------------------------
+		uint32_t GetTextureRowCount(TextureFormat a_Format, uint32_t a_iHeight)
+		{
+			return IsBlockCompressed(a_Format) ? (a_iHeight + 3) / 4 : a_iHeight;
+		}
+
+		//---------------------------------------------------------------------
+		size_t GetTextureMipSize(const TextureData& a_Texture, uint32_t a_iMip)
+		{
+			// Shifting by 32 or more is undefined, every side is down to 1 by then anyway.
+			const uint32_t width = a_iMip < g_iMaxTextureMipLevels ? std::max(a_Texture.m_iWidth >> a_iMip, 1u) : 1u;
+			const uint32_t height = a_iMip < g_iMaxTextureMipLevels ? std::max(a_Texture.m_iHeight >> a_iMip, 1u) : 1u;
+			return GetTextureRowPitch(a_Texture.m_Format, width) * GetTextureRowCount(a_Texture.m_Format, height);
+		}
+
+		//---------------------------------------------------------------------
+		size_t GetTextureMipOffset(const TextureData& a_Texture, uint32_t a_iMip)
+		{
+			size_t offset = 0;
+			for (uint32_t i = 0; i < a_iMip; i++)
+			{
+				offset += GetTextureMipSize(a_Texture, i);
+			}
+			return offset;
+		}
+
+		namespace
+		{
+			//---------------------------------------------------------------------
+			bool readCookedTexture(const core::Data& a_File, TextureData& a_Texture)
+			{
+				CookedTextureHeader header;
+				memcpy(&header, a_File.data(), sizeof(header));
+
+				const bool validFormat = header.m_Format == TextureFormat::RGBA8 || header.m_Format == TextureFormat::BC1 || header.m_Format == TextureFormat::BC3 ||
+					header.m_Format == TextureFormat::BC4 || header.m_Format == TextureFormat::BC5 || header.m_Format == TextureFormat::BC7;
+				const uint32_t largestSide = std::max(header.m_iWidth, header.m_iHeight);
+				if (header.m_iVersion != g_iCookedTextureVersion || header.m_iDimension != g_iTextureDimension2D || header.m_iDepthOrArraySize != 1 ||
+					header.m_iWidth == 0 || header.m_iHeight == 0 || !validFormat || header.m_iMipLevels == 0 || header.m_iMipLevels > g_iMaxTextureMipLevels || (largestSide >> (header.m_iMipLevels - 1)) == 0)
+				{
+					LOG(LOGSEVERITY_ERROR, LOG_CATEGORY_ENGINE, "Cooked texture has an unsupported header.");
+					return false;
+				}
+
+				a_Texture.m_iWidth = header.m_iWidth;
+				a_Texture.m_iHeight = header.m_iHeight;
+				a_Texture.m_iMipLevels = header.m_iMipLevels;
+				a_Texture.m_Format = header.m_Format;
+				a_Texture.m_iFlags = header.m_iFlags;
+
+				const size_t dataSize = GetTextureMipOffset(a_Texture, header.m_iMipLevels);
+				if (header.m_iDataSize != dataSize || dataSize > a_File.size() - sizeof(header))
+				{
+					LOG(LOGSEVERITY_ERROR, LOG_CATEGORY_ENGINE, "Cooked texture is truncated.");
+					return false;
+				}
+
+				// The mips are used in place, views stay views so archive entries are never copied.
+				const uint8_t* mips = a_File.dataAs<uint8_t>() + sizeof(header);
+				a_Texture.m_Data = a_File.IsView() ? core::Data::CreateView(mips, dataSize) : core::Data(mips, dataSize);
+				return true;
+			}
+		}
+
+		//---------------------------------------------------------------------
+		bool ReadTextureFile(const core::Data& a_File, TextureData& a_Texture)
+		{
+			if (a_File.size() >= sizeof(CookedTextureHeader) && *a_File.dataAs<uint32_t>() == g_iCookedTextureMagic)
+			{
+				return readCookedTexture(a_File, a_Texture);
+			}
+
+			int width, height, channels;
+			stbi_uc* imageData = stbi_load_from_memory(a_File.dataAs<stbi_uc>(), static_cast<int>(a_File.size()), &width, &height, &channels, STBI_rgb_alpha);
+			if (!imageData)
+			{
+				return false;
+			}
+
+			a_Texture.m_iWidth = static_cast<uint32_t>(width);
+			a_Texture.m_iHeight = static_cast<uint32_t>(height);
+			a_Texture.m_iMipLevels = 1;
+			a_Texture.m_Format = TextureFormat::RGBA8;
+			a_Texture.m_iFlags = CookedTextureFlags_None;
+			a_Texture.m_Data = core::Data(imageData, static_cast<size_t>(width) * height * 4);
+
+			stbi_image_free(imageData);
+			return true;
+		}
+
+		namespace
+		{
+			//---------------------------------------------------------------------
+			uint32_t expand565(uint16_t a_iColor)
+			{
+				const uint32_t r = (a_iColor >> 11) & 31;
+				const uint32_t g = (a_iColor >> 5) & 63;
+				const uint32_t b = a_iColor & 31;
+				return ((r << 3) | (r >> 2)) | (((g << 2) | (g >> 4)) << 8) | (((b << 3) | (b >> 2)) << 16);
+			}
+
+			//---------------------------------------------------------------------
+			uint32_t mixColors(uint32_t a_iA, uint32_t a_iB, uint32_t a_iWeightA, uint32_t a_iWeightB)
+			{
+				uint32_t result = 0;
+				for (uint32_t shift = 0; shift < 24; shift += 8)
+				{
+					const uint32_t a = (a_iA >> shift) & 0xFF;
+					const uint32_t b = (a_iB >> shift) & 0xFF;
+					result |= ((a * a_iWeightA + b * a_iWeightB) / (a_iWeightA + a_iWeightB)) << shift;
+				}
+				return result;
+			}
+
+			//---------------------------------------------------------------------
+			void decodeColorBlock(const uint8_t* a_pBlock, uint32_t a_aPixels[16], bool a_bAllowTransparent)
+			{
+				const uint16_t color0 = static_cast<uint16_t>(a_pBlock[0] | (a_pBlock[1] << 8));
+				const uint16_t color1 = static_cast<uint16_t>(a_pBlock[2] | (a_pBlock[3] << 8));
+
+				uint32_t palette[4];
+				palette[0] = expand565(color0) | 0xFF000000;
+				palette[1] = expand565(color1) | 0xFF000000;
+				if (color0 > color1 || !a_bAllowTransparent)
+				{
+					palette[2] = mixColors(palette[0], palette[1], 2, 1) | 0xFF000000;
+					palette[3] = mixColors(palette[0], palette[1], 1, 2) | 0xFF000000;
+				}
+				else
+				{
+					palette[2] = mixColors(palette[0], palette[1], 1, 1) | 0xFF000000;
+					palette[3] = 0;
+				}
+
+				uint32_t indices;
+				memcpy(&indices, a_pBlock + 4, sizeof(indices));
+				for (uint32_t i = 0; i < 16; i++)
+				{
+					a_aPixels[i] = palette[(indices >> (i * 2)) & 3];
+				}
+			}
+		}
+
+		//---------------------------------------------------------------------
+		void DecodeBC1Block(const uint8_t* a_pBlock, uint32_t a_aPixels[16])
+		{
+			decodeColorBlock(a_pBlock, a_aPixels, true);
+		}
+
+		namespace
+		{
+			//---------------------------------------------------------------------
+			void decodeAlphaBlock(const uint8_t* a_pBlock, uint32_t a_aValues[16])
+			{
+				const uint32_t alpha0 = a_pBlock[0];
+				const uint32_t alpha1 = a_pBlock[1];
+				uint32_t palette[8] = { alpha0, alpha1 };
+				if (alpha0 > alpha1)
+				{
+					for (uint32_t i = 1; i < 7; i++)
+					{
+						palette[i + 1] = (alpha0 * (7 - i) + alpha1 * i) / 7;
+					}
+				}
+				else
+				{
+					for (uint32_t i = 1; i < 5; i++)
+					{
+						palette[i + 1] = (alpha0 * (5 - i) + alpha1 * i) / 5;
+					}
+					palette[6] = 0;
+					palette[7] = 255;
+				}
+
+				uint64_t indices = 0;
+				for (uint32_t i = 0; i < 6; i++)
+				{
+					indices |= static_cast<uint64_t>(a_pBlock[2 + i]) << (i * 8);
+				}
+				for (uint32_t i = 0; i < 16; i++)
+				{
+					a_aValues[i] = palette[(indices >> (i * 3)) & 7];
+				}
+			}
+		}
+
+		//---------------------------------------------------------------------
+		void DecodeBC3Block(const uint8_t* a_pBlock, uint32_t a_aPixels[16])
+		{
+			decodeColorBlock(a_pBlock + 8, a_aPixels, false);
+
+			uint32_t alpha[16];
+			decodeAlphaBlock(a_pBlock, alpha);
+			for (uint32_t i = 0; i < 16; i++)
+			{
+				a_aPixels[i] = (a_aPixels[i] & 0x00FFFFFF) | (alpha[i] << 24);
+			}
+		}
+
+		//---------------------------------------------------------------------
+		void DecodeBC4Block(const uint8_t* a_pBlock, uint32_t a_aPixels[16])
+		{
+			uint32_t red[16];
+			decodeAlphaBlock(a_pBlock, red);
+			for (uint32_t i = 0; i < 16; i++)
+			{
+				a_aPixels[i] = red[i] | 0xFF000000;
+			}
+		}
+
+		//---------------------------------------------------------------------
+		void DecodeBC5Block(const uint8_t* a_pBlock, uint32_t a_aPixels[16])
+		{
+			uint32_t red[16];
+			uint32_t green[16];
+			decodeAlphaBlock(a_pBlock, red);
+			decodeAlphaBlock(a_pBlock + 8, green);
+			for (uint32_t i = 0; i < 16; i++)
+			{
+				a_aPixels[i] = red[i] | (green[i] << 8) | 0xFF000000;
+			}
+		}
+
+		namespace
+		{
+			//---------------------------------------------------------------------
+			uint32_t readBits(const uint8_t* a_pBlock, uint32_t& a_iOffset, uint32_t a_iCount)
+			{
+				uint32_t value = 0;
+				for (uint32_t i = 0; i < a_iCount; i++, a_iOffset++)
+				{
+					value |= ((a_pBlock[a_iOffset >> 3] >> (a_iOffset & 7)) & 1) << i;
+				}
+				return value;
+			}
+
+			//---------------------------------------------------------------------
+			uint32_t expandBits(uint32_t a_iValue, uint32_t a_iBits)
+			{
+				return (a_iValue << (8 - a_iBits)) | (a_iValue >> (2 * a_iBits - 8));
+			}
+
+			//---------------------------------------------------------------------
+			uint32_t interpolateBC7(uint32_t a_iEndpoint0, uint32_t a_iEndpoint1, uint32_t a_iIndex, uint32_t a_iIndexBits)
+			{
+				static const uint32_t weights2[4] = { 0, 21, 43, 64 };
+				static const uint32_t weights3[8] = { 0, 9, 18, 27, 37, 46, 55, 64 };
+				static const uint32_t weights4[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+				const uint32_t weight = a_iIndexBits == 2 ? weights2[a_iIndex] : (a_iIndexBits == 3 ? weights3[a_iIndex] : weights4[a_iIndex]);
+				return ((64 - weight) * a_iEndpoint0 + weight * a_iEndpoint1 + 32) >> 6;
+			}
+		}
+
+		//---------------------------------------------------------------------
+		void DecodeBC7Block(const uint8_t* a_pBlock, uint32_t a_aPixels[16])
+		{
+			uint32_t mode = 0;
+			while (mode < 8 && !((a_pBlock[0] >> mode) & 1))
+			{
+				mode++;
+			}
+
+			if (mode < 4 || mode > 6)
+			{
+				memset(a_aPixels, 0, sizeof(uint32_t) * 16);
+				return;
+			}
+
+			uint32_t offset = mode + 1;
+			uint32_t rotation = 0;
+			uint32_t indexSelection = 0;
+			if (mode == 4 || mode == 5)
+			{
+				rotation = readBits(a_pBlock, offset, 2);
+			}
+			if (mode == 4)
+			{
+				indexSelection = readBits(a_pBlock, offset, 1);
+			}
+
+			// Endpoints are stored channel by channel, the first endpoint before the second.
+			const uint32_t colorBits = mode == 4 ? 5 : 7;
+			const uint32_t alphaBits = mode == 4 ? 6 : (mode == 5 ? 8 : 7);
+			uint32_t endpoints[2][4];
+			for (uint32_t channel = 0; channel < 4; channel++)
+			{
+				for (uint32_t endpoint = 0; endpoint < 2; endpoint++)
+				{
+					endpoints[endpoint][channel] = readBits(a_pBlock, offset, channel < 3 ? colorBits : alphaBits);
+				}
+			}
+
+			if (mode == 6)
+			{
+				// Both endpoints have a shared lowest bit, which makes them 8 bits wide.
+				for (uint32_t endpoint = 0; endpoint < 2; endpoint++)
+				{
+					const uint32_t pBit = readBits(a_pBlock, offset, 1);
+					for (uint32_t channel = 0; channel < 4; channel++)
+					{
+						endpoints[endpoint][channel] = (endpoints[endpoint][channel] << 1) | pBit;
+					}
+				}
+			}
+			else
+			{
+				for (uint32_t endpoint = 0; endpoint < 2; endpoint++)
+				{
+					for (uint32_t channel = 0; channel < 4; channel++)
+					{
+						endpoints[endpoint][channel] = expandBits(endpoints[endpoint][channel], channel < 3 ? colorBits : alphaBits);
+					}
+				}
+			}
+
+			// Mode 6 has one set of indices for all channels, modes 4 and 5 have a second set. The first index of every set
+			// lost its highest bit, which the encoder keeps zero.
+			const uint32_t primaryBits = mode == 6 ? 4 : 2;
+			const uint32_t secondaryBits = mode == 4 ? 3 : 2;
+			uint32_t primary[16];
+			uint32_t secondary[16];
+			for (uint32_t i = 0; i < 16; i++)
+			{
+				primary[i] = readBits(a_pBlock, offset, i == 0 ? primaryBits - 1 : primaryBits);
+			}
+			if (mode != 6)
+			{
+				for (uint32_t i = 0; i < 16; i++)
+				{
+					secondary[i] = readBits(a_pBlock, offset, i == 0 ? secondaryBits - 1 : secondaryBits);
+				}
+			}
+
+			// Color uses the first set and alpha the second, unless the index selection bit of mode 4 swaps them.
+			const bool swapped = mode == 4 && indexSelection == 1;
+			for (uint32_t i = 0; i < 16; i++)
+			{
+				uint32_t channels[4];
+				for (uint32_t channel = 0; channel < 4; channel++)
+				{
+					const bool usePrimary = mode == 6 || ((channel < 3) != swapped);
+					channels[channel] = usePrimary ?
+						interpolateBC7(endpoints[0][channel], endpoints[1][channel], primary[i], primaryBits) :
+						interpolateBC7(endpoints[0][channel], endpoints[1][channel], secondary[i], secondaryBits);
+				}
+
+				if (rotation > 0)
+				{
+					std::swap(channels[rotation - 1], channels[3]);
+				}
+				a_aPixels[i] = channels[0] | (channels[1] << 8) | (channels[2] << 16) | (channels[3] << 24);
+			}
+		}
+
+		//---------------------------------------------------------------------
+		bool DecodeTextureMip(const TextureData& a_Texture, uint32_t a_iMip, std::vector<uint32_t>& a_aPixels)
+		{
+			if (a_iMip >= a_Texture.m_iMipLevels || GetTextureMipOffset(a_Texture, a_iMip + 1) > a_Texture.m_Data.size())
+			{
+				return false;
+			}
+
+			// Shifting by 32 or more is undefined, every side is down to 1 by then anyway.
+			const uint32_t width = a_iMip < g_iMaxTextureMipLevels ? std::max(a_Texture.m_iWidth >> a_iMip, 1u) : 1u;
+			const uint32_t height = a_iMip < g_iMaxTextureMipLevels ? std::max(a_Texture.m_iHeight >> a_iMip, 1u) : 1u;
+			const uint8_t* mip = a_Texture.m_Data.dataAs<uint8_t>() + GetTextureMipOffset(a_Texture, a_iMip);
+			a_aPixels.resize(static_cast<size_t>(width) * height);
+
+			if (!IsBlockCompressed(a_Texture.m_Format))
+			{
+				memcpy(a_aPixels.data(), mip, a_aPixels.size() * sizeof(uint32_t));
+				return true;
+			}
+
+			const size_t blockSize = GetTextureBlockSize(a_Texture.m_Format);
+			const uint32_t blocksWide = (width + 3) / 4;
+			const uint32_t blocksHigh = (height + 3) / 4;
+			uint32_t block[16];
+			for (uint32_t blockY = 0; blockY < blocksHigh; blockY++)
+			{
+				for (uint32_t blockX = 0; blockX < blocksWide; blockX++)
+				{
+					const uint8_t* source = mip + (static_cast<size_t>(blockY) * blocksWide + blockX) * blockSize;
+					switch (a_Texture.m_Format)
+					{
+						case TextureFormat::BC1:
+						{
+							DecodeBC1Block(source, block);
+							break;
+						}
+						case TextureFormat::BC3:
+						{
+							DecodeBC3Block(source, block);
+							break;
+						}
+						case TextureFormat::BC4:
+						{
+							DecodeBC4Block(source, block);
+							break;
+						}
+						case TextureFormat::BC5:
+						{
+							DecodeBC5Block(source, block);
+							break;
+						}
+						case TextureFormat::BC7:
+						default:
+						{
+							DecodeBC7Block(source, block);
+							break;
+						}
+					}
+
+					// Blocks on the right and bottom edge can hang over the mip.
+					for (uint32_t y = 0; y < 4 && blockY * 4 + y < height; y++)
+					{
+						for (uint32_t x = 0; x < 4 && blockX * 4 + x < width; x++)
+						{
+							a_aPixels[static_cast<size_t>(blockY * 4 + y) * width + blockX * 4 + x] = block[y * 4 + x];
+						}
+					}
+				}
+			}
+			return true;
+		}
+	}
+}
\ No newline at end of file
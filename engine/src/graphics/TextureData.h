@@ -0,0 +1,171 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "core/Data.h"
+
+namespace gallus
+{
+	namespace graphics
+	{
+		/// <summary>
+		/// Pixel formats of textures. The values are the matching DXGI_FORMAT values, so they map straight onto a resource description.
+		/// </summary>
+		enum class TextureFormat : uint32_t
+		{
+			RGBA8 = 28, /// DXGI_FORMAT_R8G8B8A8_UNORM, 4 bytes per pixel.
+			BC1 = 71, /// DXGI_FORMAT_BC1_UNORM, 8 bytes per 4x4 block, opaque.
+			BC3 = 77, /// DXGI_FORMAT_BC3_UNORM, 16 bytes per 4x4 block, interpolated alpha.
+			BC4 = 80, /// DXGI_FORMAT_BC4_UNORM, 8 bytes per 4x4 block, only red.
+			BC5 = 83, /// DXGI_FORMAT_BC5_UNORM, 16 bytes per 4x4 block, only red and green.
+			BC7 = 98, /// DXGI_FORMAT_BC7_UNORM, 16 bytes per 4x4 block, color and alpha.
+		};
+
+		inline const uint32_t g_iCookedTextureMagic = 0x58455447; /// "GTEX" in little endian.
+		inline const uint32_t g_iCookedTextureVersion = 1;
+		inline const uint32_t g_iTextureDimension2D = 3; /// D3D12_RESOURCE_DIMENSION_TEXTURE2D.
+		inline const uint32_t g_iMaxTextureMipLevels = 32; /// A side of 32 bits halves to 1 within 32 mips.
+
+		/// <summary>
+		/// Flags of a cooked texture.
+		/// </summary>
+		enum CookedTextureFlags : uint32_t
+		{
+			CookedTextureFlags_None = 0,
+			CookedTextureFlags_Premultiplied = 1 << 0, /// Color was multiplied with alpha before the mips were made.
+		};
+
+		/// <summary>
+		/// Start of a cooked texture file. The fields up to the format mirror D3D12_RESOURCE_DESC, the mips follow the header
+		/// largest first, each tightly packed in rows of pixels or rows of 4x4 blocks.
+		/// </summary>
+		struct CookedTextureHeader
+		{
+			uint32_t m_iMagic = g_iCookedTextureMagic;
+			uint32_t m_iVersion = g_iCookedTextureVersion;
+			uint32_t m_iDimension = g_iTextureDimension2D;
+			uint32_t m_iWidth = 0;
+			uint32_t m_iHeight = 0;
+			uint16_t m_iDepthOrArraySize = 1;
+			uint16_t m_iMipLevels = 1;
+			TextureFormat m_Format = TextureFormat::RGBA8;
+			uint32_t m_iFlags = CookedTextureFlags_None;
+			uint64_t m_iDataSize = 0; /// Size of all mips in bytes.
+		};
+		static_assert(sizeof(CookedTextureHeader) == 40, "The cooked texture header is read straight from the file.");
+
+		/// <summary>
+		/// Texture contents ready to be uploaded: every mip, in a format the gpu samples directly.
+		/// </summary>
+		struct TextureData
+		{
+			uint32_t m_iWidth = 0;
+			uint32_t m_iHeight = 0;
+			uint32_t m_iMipLevels = 1;
+			TextureFormat m_Format = TextureFormat::RGBA8;
+			uint32_t m_iFlags = CookedTextureFlags_None;
+			core::Data m_Data; /// All mips, largest first. A view when the file was a view, for example an archive entry.
+		};
+
+		/// <summary>
+		/// Checks whether a format stores 4x4 blocks instead of pixels.
+		/// </summary>
+		/// <param name="a_Format">The format.</param>
+		/// <returns>True if the format is block compressed, otherwise false.</returns>
+		bool IsBlockCompressed(TextureFormat a_Format);
+
+		/// <summary>
+		/// Retrieves the size of a 4x4 block of a block compressed format, or of a pixel of other formats.
+		/// </summary>
+		/// <param name="a_Format">The format.</param>
+		/// <returns>The size in bytes.</returns>
+		size_t GetTextureBlockSize(TextureFormat a_Format);
+
+		/// <summary>
+		/// Retrieves the size of a row of a mip, which is a row of pixels or a row of 4x4 blocks.
+		/// </summary>
+		/// <param name="a_Format">The format.</param>
+		/// <param name="a_iWidth">Width of the mip in pixels.</param>
+		/// <returns>The size in bytes.</returns>
+		size_t GetTextureRowPitch(TextureFormat a_Format, uint32_t a_iWidth);
+
+		/// <summary>
+		/// Retrieves the number of rows of a mip, which are rows of pixels or rows of 4x4 blocks.
+		/// </summary>
+		/// <param name="a_Format">The format.</param>
+		/// <param name="a_iHeight">Height of the mip in pixels.</param>
+		/// <returns>The number of rows.</returns>
+		uint32_t GetTextureRowCount(TextureFormat a_Format, uint32_t a_iHeight);
+
+		/// <summary>
+		/// Retrieves the size of a mip of a texture.
+		/// </summary>
+		/// <param name="a_Texture">The texture.</param>
+		/// <param name="a_iMip">Index of the mip, 0 is the largest.</param>
+		/// <returns>The size in bytes.</returns>
+		size_t GetTextureMipSize(const TextureData& a_Texture, uint32_t a_iMip);
+
+		/// <summary>
+		/// Retrieves where a mip of a texture starts within its data.
+		/// </summary>
+		/// <param name="a_Texture">The texture.</param>
+		/// <param name="a_iMip">Index of the mip, 0 is the largest.</param>
+		/// <returns>The offset in bytes.</returns>
+		size_t GetTextureMipOffset(const TextureData& a_Texture, uint32_t a_iMip);
+
+		/// <summary>
+		/// Reads a texture file. Cooked textures are used as they are, other images are decoded with stb_image into a single RGBA8 mip.
+		/// </summary>
+		/// <param name="a_File">Contents of the file. Cooked textures of a view stay views of it, so it has to outlive the texture.</param>
+		/// <param name="a_Texture">Receives the texture.</param>
+		/// <returns>True if the file could be read, otherwise false.</returns>
+		bool ReadTextureFile(const core::Data& a_File, TextureData& a_Texture);
+
+		/// <summary>
+		/// Decodes a mip of a texture into RGBA8 pixels, for users that cannot sample compressed formats.
+		/// </summary>
+		/// <param name="a_Texture">The texture.</param>
+		/// <param name="a_iMip">Index of the mip, 0 is the largest.</param>
+		/// <param name="a_aPixels">Receives the pixels, row by row, with red in the lowest byte.</param>
+		/// <returns>True if the mip was decoded, otherwise false.</returns>
+		bool DecodeTextureMip(const TextureData& a_Texture, uint32_t a_iMip, std::vector<uint32_t>& a_aPixels);
+
+		/// <summary>
+		/// Decodes a single BC1 block.
+		/// </summary>
+		/// <param name="a_pBlock">The 8 byte block.</param>
+		/// <param name="a_aPixels">Receives the 16 pixels, row by row.</param>
+		void DecodeBC1Block(const uint8_t* a_pBlock, uint32_t a_aPixels[16]);
+
+		/// <summary>
+		/// Decodes a single BC3 block.
+		/// </summary>
+		/// <param name="a_pBlock">The 16 byte block.</param>
+		/// <param name="a_aPixels">Receives the 16 pixels, row by row.</param>
+		void DecodeBC3Block(const uint8_t* a_pBlock, uint32_t a_aPixels[16]);
+
+		/// <summary>
+		/// Decodes a single BC4 block. Green and blue are zero and alpha is opaque, like the gpu samples it.
+		/// </summary>
+		/// <param name="a_pBlock">The 8 byte block.</param>
+		/// <param name="a_aPixels">Receives the 16 pixels, row by row.</param>
+		void DecodeBC4Block(const uint8_t* a_pBlock, uint32_t a_aPixels[16]);
+
+		/// <summary>
+		/// Decodes a single BC5 block. Blue is zero and alpha is opaque, like the gpu samples it.
+		/// </summary>
+		/// <param name="a_pBlock">The 16 byte block.</param>
+		/// <param name="a_aPixels">Receives the 16 pixels, row by row.</param>
+		void DecodeBC5Block(const uint8_t* a_pBlock, uint32_t a_aPixels[16]);
+
+		/// <summary>
+		/// Decodes a single BC7 block. Only the modes without partitions (4, 5 and 6) are supported, which includes every
+		/// block the cooker writes. Other modes decode as transparent black, like the reserved mode does on the gpu.
+		/// </summary>
+		/// <param name="a_pBlock">The 16 byte block.</param>
+		/// <param name="a_aPixels">Receives the 16 pixels, row by row.</param>
+		void DecodeBC7Block(const uint8_t* a_pBlock, uint32_t a_aPixels[16]);
+	}
+}
\ No newline at end of file
@@ -1,5 +1,7 @@
 #include "CommandList.h"
 
+#include <cstring>
+
 #include "core/Tool.h" 
 #include "graphics/dx12/DX12System2D.h"
 #include "logger/Logger.h"
@@ -31,10 +33,21 @@ namespace gallus
 				return true;
 			}
 
+			//---------------------------------------------------------------------
+			void CommandList::SetUploadRing(UploadRing* a_pUploadRing)
+			{
+				m_pUploadRing = a_pUploadRing;
+			}
+
+			//---------------------------------------------------------------------
+			UploadAllocation CommandList::AllocateUpload(size_t a_iSize, size_t a_iAlignment)
+			{
+				return m_pUploadRing->Allocate(a_iSize, a_iAlignment, this);
+			}
+
 			//---------------------------------------------------------------------
 			void CommandList::UpdateBufferResource(
 				ID3D12Resource** a_pDestinationResource,
-				ID3D12Resource** a_pIntermediateResource,
 				size_t a_iNumElements, size_t a_iElementSize, const void* a_pBufferData,
 				D3D12_RESOURCE_FLAGS a_Flags)
 			{
@@ -57,32 +70,18 @@ namespace gallus
 					return;
 				}
 
-				// Create an committed resource for the upload.
+				// Stage the data in the upload ring, it gets reused once the gpu executed the copy.
 				if (a_pBufferData)
 				{
-					const CD3DX12_HEAP_PROPERTIES uploadHeaptype = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD);
-					const CD3DX12_RESOURCE_DESC buff = CD3DX12_RESOURCE_DESC::Buffer(bufferSize);
-					Microsoft::WRL::ComPtr<ID3D12Device2>& device = core::TOOL->GetDX12().GetDevice();
-					if (FAILED(device->CreateCommittedResource(
-						&uploadHeaptype,
-						D3D12_HEAP_FLAG_NONE,
-						&buff,
-						D3D12_RESOURCE_STATE_GENERIC_READ,
-						nullptr,
-						IID_PPV_ARGS(a_pIntermediateResource))))
+					const UploadAllocation staging = AllocateUpload(bufferSize, 16);
+					if (!staging.m_pData)
 					{
-						LOG(LOGSEVERITY_ERROR, LOG_CATEGORY_DX12, "Failed creating committed resource.");
+						LOG(LOGSEVERITY_ERROR, LOG_CATEGORY_DX12, "Failed allocating staging memory.");
 						return;
 					}
 
-					D3D12_SUBRESOURCE_DATA subresourceData = {};
-					subresourceData.pData = a_pBufferData;
-					subresourceData.RowPitch = bufferSize;
-					subresourceData.SlicePitch = subresourceData.RowPitch;
-
-					UpdateSubresources(m_pCommandList.Get(),
-						*a_pDestinationResource, *a_pIntermediateResource,
-						0, 0, 1, &subresourceData);
+					memcpy(staging.m_pData, a_pBufferData, bufferSize);
+					m_pCommandList->CopyBufferRegion(*a_pDestinationResource, 0, staging.m_pResource, staging.m_iOffset, bufferSize);
 				}
 			}
 
@@ -2,6 +2,8 @@
 
 #include "DX12PCH.h"
 
+#include "graphics/dx12/UploadRing.h"
+
 namespace gallus
 {
 	namespace graphics
@@ -35,15 +37,28 @@ namespace gallus
 				bool CreateCommandList(Microsoft::WRL::ComPtr<ID3D12CommandAllocator>& a_pAllocator, D3D12_COMMAND_LIST_TYPE a_CommandListType);
 
 				/// <summary>
-				/// Updates the buffer resource.
+				/// Sets the upload ring upload memory is allocated from.
+				/// </summary>
+				/// <param name="a_pUploadRing">The upload ring of the command queue the command list gets executed on.</param>
+				void SetUploadRing(UploadRing* a_pUploadRing);
+
+				/// <summary>
+				/// Allocates upload memory that stays valid until the gpu finished executing the command list.
+				/// </summary>
+				/// <param name="a_iSize">Size of the memory in bytes.</param>
+				/// <param name="a_iAlignment">Alignment of the memory, has to be a power of two.</param>
+				/// <returns>The memory, with m_pData set to nullptr if no memory could be allocated.</returns>
+				UploadAllocation AllocateUpload(size_t a_iSize, size_t a_iAlignment);
+
+				/// <summary>
+				/// Creates a buffer in a default heap and records the upload of its data, staged through the upload ring.
 				/// </summary>
-				/// <param name="a_pDestinationResource">The resource that needs to be updated.</param>
-				/// <param name="a_pIntermediateResource">The resource that needs to be updated in between.</param>
+				/// <param name="a_pDestinationResource">Receives the buffer.</param>
 				/// <param name="a_NumElements">The number of elements to update the resource with.</param>
 				/// <param name="a_ElementSize">The element size to update the resource with.</param>
 				/// <param name="a_BufferData">Pointer to the data that will be put in the resource.</param>
 				/// <param name="a_Flags">Flags that will be put in the resource.</param>
-				void UpdateBufferResource(ID3D12Resource** a_pDestinationResource, ID3D12Resource** a_pIntermediateResource, size_t a_NumElements, size_t a_ElementSize, const void* a_BufferData, D3D12_RESOURCE_FLAGS a_Flags = D3D12_RESOURCE_FLAG_NONE);
+				void UpdateBufferResource(ID3D12Resource** a_pDestinationResource, size_t a_NumElements, size_t a_ElementSize, const void* a_BufferData, D3D12_RESOURCE_FLAGS a_Flags = D3D12_RESOURCE_FLAG_NONE);
 
 				/// <summary>
 				/// Updates the buffer resource.
@@ -54,6 +69,7 @@ namespace gallus
 				void TransitionResource(Microsoft::WRL::ComPtr<ID3D12Resource> a_pResource, D3D12_RESOURCE_STATES a_BeforeState, D3D12_RESOURCE_STATES a_AfterState);
 			private:
 				Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList2> m_pCommandList;
+				UploadRing* m_pUploadRing = nullptr;
 			};
 		}
 	}
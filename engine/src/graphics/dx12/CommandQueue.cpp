@@ -44,6 +44,8 @@ namespace gallus
 					LOG(LOGSEVERITY_ERROR, LOG_CATEGORY_DX12, "Failed creating fence event.");
 					return;
 				}
+
+				m_UploadRing.Initialize(g_iUploadRingSize);
 			}
 
 			//---------------------------------------------------------------------
@@ -53,6 +55,8 @@ namespace gallus
 				Microsoft::WRL::ComPtr<ID3D12CommandAllocator> commandAllocator;
 				std::shared_ptr<CommandList> commandList = std::make_shared<CommandList>();
 
+				m_UploadRing.ReleaseCompleted(m_pFence->GetCompletedValue());
+
 				if (!m_CommandAllocatorQueue.empty() && IsFenceComplete(m_CommandAllocatorQueue.front().m_iFenceValue))
 				{
 					commandAllocator = m_CommandAllocatorQueue.front().m_pCommandAllocator;
@@ -84,6 +88,7 @@ namespace gallus
 				{
 					commandList->CreateCommandList(commandAllocator, m_CommandListType);
 				}
+				commandList->SetUploadRing(&m_UploadRing);
 
 				// Associate the command allocator with the command list so that it can be
 				// retrieved when the command list is executed.
@@ -116,6 +121,9 @@ namespace gallus
 				m_pCommandQueue->ExecuteCommandLists(1, ppCommandLists);
 				uint64_t fenceValue = Signal();
 
+				// Only the upload memory of this command list gets its fence, lists recorded at the same time keep theirs.
+				m_UploadRing.Finish(a_pCommandList.get(), fenceValue);
+
 				m_CommandAllocatorQueue.emplace(CommandAllocatorEntry{ fenceValue, commandAllocator });
 				m_CommandListQueue.push(a_pCommandList);
 
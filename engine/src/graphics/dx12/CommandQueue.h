@@ -6,6 +6,8 @@
 #include <queue>    // For std::queue
 #include <memory>
 
+#include "graphics/dx12/UploadRing.h"
+
 namespace gallus
 {
 	namespace graphics
@@ -14,6 +16,8 @@ namespace gallus
 		{
 			class CommandList;
 
+			inline const size_t g_iUploadRingSize = 16 * 1024 * 1024; /// Size of the upload ring of a command queue in bytes.
+
 			//---------------------------------------------------------------------
 			// CommandQueue
 			//---------------------------------------------------------------------
@@ -36,7 +40,8 @@ namespace gallus
 				CommandQueue(D3D12_COMMAND_LIST_TYPE a_CommandListType);
 
 				/// <summary>
-				/// Retrieves an available command list from the command queue.
+				/// Retrieves an available command list from the command queue. Upload memory allocated through the command list
+				/// stays valid until the gpu finished executing it.
 				/// </summary>
 				/// <returns>A shared pointer to the command list.</returns>
 				std::shared_ptr<CommandList> GetCommandList();
@@ -104,6 +109,8 @@ namespace gallus
 
 				CommandAllocatorQueue                       m_CommandAllocatorQueue; /// Queue of in-flight command allocators.
 				CommandListQueue                            m_CommandListQueue; /// Queue of available command lists.
+
+				UploadRing                                  m_UploadRing; /// Upload memory of the command lists, released by the fence like the command allocators.
 			};
 		}
 	}
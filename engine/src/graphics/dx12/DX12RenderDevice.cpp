@@ -0,0 +1,94 @@
+#include "graphics/dx12/DX12RenderDevice.h"
+
+#include <cstring>
+
+#include "core/Tool.h"
+#include "graphics/SpriteBatcher.h"
+#include "graphics/dx12/CommandList.h"
+#include "graphics/dx12/Mesh.h"
+#include "graphics/dx12/Shader.h"
+#include "graphics/dx12/Texture.h"
+
+namespace gallus
+{
+	namespace graphics
+	{
+		namespace dx12
+		{
+			//---------------------------------------------------------------------
+			// DX12RenderDevice
+			//---------------------------------------------------------------------
+			void DX12RenderDevice::Begin(std::shared_ptr<CommandList> a_pCommandList, D3D12_CPU_DESCRIPTOR_HANDLE a_RTVHandle)
+			{
+				m_pCommandList = a_pCommandList;
+				m_RTVHandle = a_RTVHandle;
+			}
+
+			//---------------------------------------------------------------------
+			void DX12RenderDevice::End()
+			{
+				m_pCommandList.reset();
+				m_InstanceBufferView = {};
+			}
+
+			//---------------------------------------------------------------------
+			void DX12RenderDevice::Clear(const glm::vec4& a_vColor)
+			{
+				const FLOAT clearColor[] = { a_vColor.r, a_vColor.g, a_vColor.b, a_vColor.a };
+				m_pCommandList->GetCommandList()->ClearRenderTargetView(m_RTVHandle, clearColor, 0, nullptr);
+			}
+
+			//---------------------------------------------------------------------
+			void DX12RenderDevice::SetViewProjection(const glm::mat4& a_ViewProjection)
+			{
+				m_ViewProjection = a_ViewProjection;
+			}
+
+			//---------------------------------------------------------------------
+			bool DX12RenderDevice::SetInstances(const std::vector<SpriteInstance>& a_aInstances)
+			{
+				const size_t size = a_aInstances.size() * sizeof(SpriteInstance);
+				const UploadAllocation allocation = m_pCommandList->AllocateUpload(size, 16);
+				if (!allocation.m_pData)
+				{
+					return false;
+				}
+
+				memcpy(allocation.m_pData, a_aInstances.data(), size);
+
+				m_InstanceBufferView.BufferLocation = allocation.m_GPUAddress;
+				m_InstanceBufferView.SizeInBytes = static_cast<UINT>(size);
+				m_InstanceBufferView.StrideInBytes = sizeof(SpriteInstance);
+				return true;
+			}
+
+			//---------------------------------------------------------------------
+			void DX12RenderDevice::BindShader(Shader* a_pShader)
+			{
+				a_pShader->Bind(m_pCommandList);
+			}
+
+			//---------------------------------------------------------------------
+			void DX12RenderDevice::BindTexture(Texture* a_pTexture)
+			{
+				// Textures that are still loading show the default texture until their upload completed.
+				if (!a_pTexture->IsValid())
+				{
+					core::ResourceAtlas& atlas = core::TOOL->GetResourceAtlas();
+					a_pTexture = atlas.GetTexture(atlas.GetDefaultTexture());
+				}
+
+				if (a_pTexture && a_pTexture->IsValid())
+				{
+					a_pTexture->Bind(m_pCommandList);
+				}
+			}
+
+			//---------------------------------------------------------------------
+			void DX12RenderDevice::DrawInstanced(Mesh* a_pMesh, uint32_t a_iFirstInstance, uint32_t a_iInstanceCount)
+			{
+				a_pMesh->RenderInstanced(m_pCommandList, m_InstanceBufferView, a_iFirstInstance, a_iInstanceCount, m_ViewProjection);
+			}
+		}
+	}
+}
\ No newline at end of file
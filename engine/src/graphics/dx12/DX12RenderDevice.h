@@ -0,0 +1,85 @@
+#pragma once
+
+#include "graphics/dx12/DX12PCH.h"
+
+#include <memory>
+
+#include "graphics/RenderDevice.h"
+
+namespace gallus
+{
+	namespace graphics
+	{
+		namespace dx12
+		{
+			class CommandList;
+
+			//---------------------------------------------------------------------
+			// DX12RenderDevice
+			//---------------------------------------------------------------------
+			/// <summary>
+			/// Render device that records the draw commands into a dx12 command list. It expects the root signature,
+			/// viewport and descriptor heaps to be set on the command list already.
+			/// </summary>
+			class DX12RenderDevice : public RenderDevice
+			{
+			public:
+				/// <summary>
+				/// Starts recording into a command list.
+				/// </summary>
+				/// <param name="a_pCommandList">The command list the commands get recorded into.</param>
+				/// <param name="a_RTVHandle">The render target the commands draw to.</param>
+				void Begin(std::shared_ptr<CommandList> a_pCommandList, D3D12_CPU_DESCRIPTOR_HANDLE a_RTVHandle);
+
+				/// <summary>
+				/// Stops recording, releasing the command list.
+				/// </summary>
+				void End();
+
+				/// <summary>
+				/// Clears the render target.
+				/// </summary>
+				/// <param name="a_vColor">The clear color.</param>
+				void Clear(const glm::vec4& a_vColor) override;
+
+				/// <summary>
+				/// Sets the matrix that maps world positions to clip space, for the draws that follow.
+				/// </summary>
+				/// <param name="a_ViewProjection">The view projection matrix, for column vectors.</param>
+				void SetViewProjection(const glm::mat4& a_ViewProjection) override;
+
+				/// <summary>
+				/// Copies the instance data into upload memory of the command list.
+				/// </summary>
+				/// <param name="a_aInstances">The instances.</param>
+				/// <returns>True if the instances were uploaded, otherwise false.</returns>
+				bool SetInstances(const std::vector<SpriteInstance>& a_aInstances) override;
+
+				/// <summary>
+				/// Sets the pipeline state of a shader.
+				/// </summary>
+				/// <param name="a_pShader">The shader.</param>
+				void BindShader(Shader* a_pShader) override;
+
+				/// <summary>
+				/// Binds the srv of a texture, if the texture is valid.
+				/// </summary>
+				/// <param name="a_pTexture">The texture.</param>
+				void BindTexture(Texture* a_pTexture) override;
+
+				/// <summary>
+				/// Records an instanced draw of a mesh.
+				/// </summary>
+				/// <param name="a_pMesh">The mesh.</param>
+				/// <param name="a_iFirstInstance">Index of the first instance.</param>
+				/// <param name="a_iInstanceCount">The number of instances.</param>
+				void DrawInstanced(Mesh* a_pMesh, uint32_t a_iFirstInstance, uint32_t a_iInstanceCount) override;
+			private:
+				std::shared_ptr<CommandList> m_pCommandList;
+				D3D12_VERTEX_BUFFER_VIEW m_InstanceBufferView = {};
+				D3D12_CPU_DESCRIPTOR_HANDLE m_RTVHandle = {};
+				glm::mat4 m_ViewProjection = glm::mat4(1.0f);
+			};
+		}
+	}
+}
\ No newline at end of file
@@ -9,7 +9,6 @@
 #include "Shader.h"
 #include "Texture.h"
 #include "Mesh.h"
-#include "gameplay/systems/MeshSystem.h"
 
 namespace gallus
 {
@@ -191,17 +190,21 @@ namespace gallus
 					return false;
 				}
 
-				std::shared_ptr<Texture> texture = core::TOOL->GetResourceAtlas().LoadTexture("tex_missing.png", cCommandList); // Default texture.
-				texture->SetResourceCategory(core::EngineResourceCategory::Missing);
-				texture->SetIsDestroyable(false);
+				core::ResourceAtlas& resourceAtlas = core::TOOL->GetResourceAtlas();
 
-				std::shared_ptr<Shader> shader = core::TOOL->GetResourceAtlas().LoadShader("vertexShader.hlsl", "pixelShader.hlsl"); // Default shader.
-				shader->SetResourceCategory(core::EngineResourceCategory::Missing);
-				shader->SetIsDestroyable(false);
+				core::TextureHandle texture = resourceAtlas.LoadTexture("tex_missing.png", cCommandList); // Default texture.
+				resourceAtlas.GetTexture(texture)->SetResourceCategory(core::EngineResourceCategory::Missing);
+				resourceAtlas.GetTexture(texture)->SetIsDestroyable(false);
 
-				std::shared_ptr<Mesh> mesh = core::TOOL->GetResourceAtlas().LoadMesh("generic_mesh", cCommandList); // Default mesh.
-				mesh->SetResourceCategory(core::EngineResourceCategory::Missing);
-				mesh->SetIsDestroyable(false);
+				core::ShaderHandle shader = resourceAtlas.LoadShader("vertexShader.hlsl", "pixelShader.hlsl"); // Default shader.
+				resourceAtlas.GetShader(shader)->SetResourceCategory(core::EngineResourceCategory::Missing);
+				resourceAtlas.GetShader(shader)->SetIsDestroyable(false);
+
+				core::MeshHandle mesh = resourceAtlas.LoadMesh("generic_mesh", cCommandList); // Default mesh.
+				resourceAtlas.GetMesh(mesh)->SetResourceCategory(core::EngineResourceCategory::Missing);
+				resourceAtlas.GetMesh(mesh)->SetIsDestroyable(false);
+
+				resourceAtlas.SetDefaultResources(texture, shader, mesh);
 
 				uint64_t fenceValue = cCommandQueue->ExecuteCommandList(cCommandList);
 				cCommandQueue->WaitForFenceValue(fenceValue);
@@ -443,7 +446,7 @@ namespace gallus
 				rtvHeapDesc.NumDescriptors = static_cast<UINT>(numBuffers);
 				rtvHeapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_RTV;
 				rtvHeapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
-				m_RTV = HeapAllocation(rtvHeapDesc);
+				m_RTV.Initialize(rtvHeapDesc);
 			}
 
 			//---------------------------------------------------------------------
@@ -453,7 +456,7 @@ namespace gallus
 				srvHeapDesc.NumDescriptors = 100;  // Adjust based on how many textures you need
 				srvHeapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
 				srvHeapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE; // Important for binding!
-				m_SRV = HeapAllocation(srvHeapDesc);
+				m_SRV.Initialize(srvHeapDesc);
 			}
 
 			//---------------------------------------------------------------------
@@ -812,10 +815,25 @@ namespace gallus
 				a_pCommandList->GetCommandList()->SetDescriptorHeaps(_countof(descriptorHeaps), descriptorHeaps);
 
 				// TODO: RENDER LOOP.
-				for (auto& pair : core::TOOL->GetECS().GetSystem<gameplay::MeshSystem>().GetComponents())
+				// The game thread publishes a packet with the draw data of every frame. If there is no new one,
+				// the previous one is drawn again, so the ecs is never touched from this thread.
+				core::TripleBuffer<RenderPacket>& packets = core::TOOL->GetRenderPackets();
+				if (packets.Consume())
 				{
-					pair.second.Render(a_pCommandList, pair.first, m_Camera);
+					m_SpriteBatcher.Build(packets.GetReadBuffer());
 				}
+				m_aPacketFrames[GetCurrentBackBufferIndex()] = packets.GetReadBuffer().m_iFrame;
+
+				// A row-major matrix for row vectors has the same memory layout as glm's column-major matrix for column vectors,
+				// so the camera matrix is stored as is.
+				glm::mat4 viewProjection;
+				DirectX::XMStoreFloat4x4(reinterpret_cast<DirectX::XMFLOAT4X4*>(&viewProjection), m_Camera.GetViewMatrix() * m_Camera.GetProjectionMatrix());
+
+				// Sprites that share a shader, texture and mesh are drawn with a single instanced draw call.
+				m_RenderDevice.Begin(a_pCommandList, a_RTVHandle);
+				m_RenderDevice.SetViewProjection(viewProjection);
+				m_RenderDevice.DrawBatches(m_SpriteBatcher);
+				m_RenderDevice.End();
 
 				m_eOnRender(a_pCommandList);
 			}
@@ -842,6 +860,9 @@ namespace gallus
 					m_iCurrentBackBufferIndex = m_pSwapChain->GetCurrentBackBufferIndex();
 
 					a_pCommandQueue->WaitForFenceValue(m_aFenceValues[m_iCurrentBackBufferIndex]);
+
+					// The resources unloaded before the packet drawn into this back buffer are no longer used by the gpu.
+					core::TOOL->GetResourceAtlas().SetCompletedFrame(m_aPacketFrames[m_iCurrentBackBufferIndex]);
 				}
 			}
 
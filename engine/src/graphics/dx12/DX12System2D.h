@@ -16,6 +16,8 @@
 
 #include "core/Event.h"
 #include "Camera.h"
+#include "DX12RenderDevice.h"
+#include "graphics/SpriteBatcher.h"
 
 #include "gameplay/systems/components/MeshComponent.h"
 
@@ -45,7 +47,7 @@ namespace gallus
 			// Root parameters for the game.
 			enum RootParameters
 			{
-				CBV = 0,                // ConstantBuffer<ModelViewProjection> ModelViewProjectionCB : register(b0);
+				CBV = 0,                // ConstantBuffer<ViewProjection> Camera : register(b0);
 				TEX_SRV = 1,            // Texture2D texture0 : register(t0);
 				NumRootParameters = 2
 			};
@@ -281,6 +283,7 @@ namespace gallus
 				win32::Window* m_pWindow = nullptr;
 
 				uint64_t m_aFenceValues[g_iBufferCount] = {};
+				uint64_t m_aPacketFrames[g_iBufferCount] = {}; /// Frame of the render packet drawn into each back buffer.
 
 				HeapAllocation
 					m_SRV,
@@ -308,6 +311,9 @@ namespace gallus
 				gameplay::MeshComponent m_MeshComponent;
 
 				Camera m_Camera;
+
+				SpriteBatcher m_SpriteBatcher;
+				DX12RenderDevice m_RenderDevice;
 			};
 		}
 	}
@@ -8,6 +8,16 @@ namespace gallus
 	{
 		namespace dx12
 		{
+			//---------------------------------------------------------------------
+			DirectX::XMMATRIX ToXMMATRIX(const math::Affine2D& a_Matrix)
+			{
+				return DirectX::XMMATRIX(
+					a_Matrix.a, a_Matrix.b, 0.0f, 0.0f,
+					a_Matrix.c, a_Matrix.d, 0.0f, 0.0f,
+					0.0f, 0.0f, 1.0f, 0.0f,
+					a_Matrix.tx, a_Matrix.ty, 0.0f, 1.0f);
+			}
+
 			//---------------------------------------------------------------------
 			// DX12Transform
 			//---------------------------------------------------------------------
@@ -56,23 +66,7 @@ namespace gallus
 			//---------------------------------------------------------------------
 			const DirectX::XMMATRIX DX12Transform::GetWorldMatrix() const
 			{
-				const DirectX::XMFLOAT2 origin = { 0.5f, 0.5f };
-				const DirectX::XMMATRIX originMatrix = DirectX::XMMatrixTranslation(origin.x, origin.y, 0.0f);
-				const DirectX::XMMATRIX negativeOriginMatrix = DirectX::XMMatrixTranslation(-origin.x, -origin.y, 0.0f);
-
-				const DirectX::XMMATRIX scaleMatrix = DirectX::XMMatrixScaling(m_vScale.x, m_vScale.y, 1.0f);
-				const float radians = DirectX::XMConvertToRadians(m_fRotationDegrees);
-				const DirectX::XMMATRIX rotationMatrix = DirectX::XMMatrixRotationZ(radians);
-				const DirectX::XMMATRIX translationMatrix = DirectX::XMMatrixTranslation(m_vPosition.x, m_vPosition.y, 0.0f);
-
-				return negativeOriginMatrix * rotationMatrix * scaleMatrix * translationMatrix * originMatrix;
-
-				//const DirectX::XMMATRIX scaleMatrix = DirectX::XMMatrixScaling(m_vScale.x, m_vScale.y, 1.0f);
-				//const float radians = DirectX::XMConvertToRadians(m_fRotationDegrees);
-				//const DirectX::XMMATRIX rotationMatrix = DirectX::XMMatrixRotationZ(radians);
-				//const DirectX::XMMATRIX translationMatrix = DirectX::XMMatrixTranslation(m_vPosition.x, m_vPosition.y, 0.0f);
-
-				//return scaleMatrix * rotationMatrix * translationMatrix;
+				return ToXMMATRIX(math::Affine2D::FromTransform({ m_vPosition.x, m_vPosition.y }, m_fRotationDegrees, { m_vScale.x, m_vScale.y }, { 0.5f, 0.5f }));
 			}
 
 			//---------------------------------------------------------------------
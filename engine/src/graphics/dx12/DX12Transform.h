@@ -2,12 +2,21 @@
 
 #include <DirectXMath.h>
 
+#include "math/Affine2D.h"
+
 namespace gallus
 {
 	namespace graphics
 	{
 		namespace dx12
 		{
+			/// <summary>
+			/// Expands a 2D affine matrix to the 4x4 matrix the shaders expect.
+			/// </summary>
+			/// <param name="a_Matrix">The affine matrix.</param>
+			/// <returns>A XMMATRIX containing the same transform.</returns>
+			DirectX::XMMATRIX ToXMMATRIX(const math::Affine2D& a_Matrix);
+
 			//---------------------------------------------------------------------
 			// DX12Transform
 			//---------------------------------------------------------------------
@@ -13,45 +13,51 @@ namespace gallus
 			//---------------------------------------------------------------------
 			// HeapAllocation
 			//---------------------------------------------------------------------
-			HeapAllocation::HeapAllocation(const D3D12_DESCRIPTOR_HEAP_DESC& a_Desc) : m_Type(a_Desc.Type)
+			bool HeapAllocation::Initialize(const D3D12_DESCRIPTOR_HEAP_DESC& a_Desc)
 			{
+				m_Type = a_Desc.Type;
+
 				Microsoft::WRL::ComPtr<ID3D12Device2>& device = core::TOOL->GetDX12().GetDevice();
 				HRESULT hr = device->CreateDescriptorHeap(&a_Desc, IID_PPV_ARGS(&m_pHeap));
 				if (FAILED(hr))
 				{
 					LOG(LOGSEVERITY_ERROR, LOG_CATEGORY_DX12, "Failed to create descriptor heap.");
-					return;
+					return false;
 				}
 
-				m_aAllocated = std::vector<bool>(a_Desc.NumDescriptors);
+				m_Allocated.Reset(a_Desc.NumDescriptors);
 				m_iDescriptorSize = device->GetDescriptorHandleIncrementSize(m_Type);
+				return true;
 			}
 
 			//---------------------------------------------------------------------
 			size_t HeapAllocation::Allocate()
 			{
-				for (size_t i = 0; i < m_aAllocated.size(); ++i)
+				return AllocateRange(1);
+			}
+
+			//---------------------------------------------------------------------
+			size_t HeapAllocation::AllocateRange(size_t a_iCount)
+			{
+				std::lock_guard<std::mutex> lock(m_AllocationMutex);
+
+				const size_t index = m_Allocated.AllocateRange(a_iCount);
+				if (index == INVALID_INDEX)
 				{
-					if (!m_aAllocated[i])
-					{
-						m_aAllocated[i] = true;
-						return i;
-					}
+					LOGF(LOGSEVERITY_ERROR, LOG_CATEGORY_DX12, "No %zu consecutive descriptor heap slots available, %zu of %zu are free.", a_iCount, m_Allocated.GetFreeCount(), m_Allocated.GetCount());
 				}
-
-				LOG(LOGSEVERITY_ERROR, LOG_CATEGORY_DX12, "No available descriptor heap slots!");
-				throw std::runtime_error("Descriptor heap out of memory.");
+				return index;
 			}
 
 			//---------------------------------------------------------------------
-			void HeapAllocation::Deallocate(size_t a_iIndex)
+			void HeapAllocation::Deallocate(size_t a_iIndex, size_t a_iCount)
 			{
-				if (a_iIndex >= m_aAllocated.size())
+				std::lock_guard<std::mutex> lock(m_AllocationMutex);
+
+				if (!m_Allocated.Free(a_iIndex, a_iCount))
 				{
-					LOG(LOGSEVERITY_WARNING, LOG_CATEGORY_DX12, "Deallocation index out of bounds.");
-					return;
+					LOG(LOGSEVERITY_WARNING, LOG_CATEGORY_DX12, "Deallocating descriptor heap slots that are out of bounds or not allocated.");
 				}
-				m_aAllocated[a_iIndex] = false;
 			}
 
 			//---------------------------------------------------------------------
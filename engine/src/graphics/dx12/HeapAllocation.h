@@ -2,9 +2,10 @@
 
 #include "DX12PCH.h"
 
-#include <vector>
 #include <mutex>
 
+#include "core/BitsetAllocator.h"
+
 namespace gallus
 {
 	namespace graphics
@@ -16,32 +17,39 @@ namespace gallus
 			//---------------------------------------------------------------------
 			/// <summary>
 			/// Manages allocation of descriptor handles from a DirectX 12 descriptor heap.
-			/// Provides thread-safe allocation and deallocation, as well as access to handle offsets.
+			/// Descriptors are tracked in a bitset and can be allocated and deallocated from any thread.
 			/// </summary>
 			class HeapAllocation
 			{
 			public:
-				/// <summary>
-				/// Default constructor. Does not create a descriptor heap.
-				/// </summary>
-				HeapAllocation() = default;
+				static constexpr size_t INVALID_INDEX = core::BitsetAllocator::INVALID_INDEX;
 
 				/// <summary>
-				/// Constructs a new descriptor heap and initializes allocation tracking.
+				/// Creates the descriptor heap and initializes allocation tracking.
 				/// </summary>
-				/// <param name="a_Desc">The descriptor heap description to create.</param>
-				HeapAllocation(const D3D12_DESCRIPTOR_HEAP_DESC& a_Desc);
+				/// <param name="a_Desc">The descriptor heap description.</param>
+				/// <returns>True if the heap was created, otherwise false.</returns>
+				bool Initialize(const D3D12_DESCRIPTOR_HEAP_DESC& a_Desc);
 
 				/// <summary>
 				/// Allocates a free descriptor slot from the heap.
 				/// </summary>
+				/// <returns>The index of the descriptor, or INVALID_INDEX if the heap is full.</returns>
 				size_t Allocate();
 
 				/// <summary>
-				/// Frees a previously allocated descriptor slot.
+				/// Allocates consecutive descriptor slots, for descriptor tables.
+				/// </summary>
+				/// <param name="a_iCount">The number of descriptors.</param>
+				/// <returns>The index of the first descriptor, or INVALID_INDEX if there is no free range that is large enough.</returns>
+				size_t AllocateRange(size_t a_iCount);
+
+				/// <summary>
+				/// Frees previously allocated descriptor slots.
 				/// </summary>
-				/// <param name="a_iIndex">The index of the descriptor to free.</param>
-				void Deallocate(size_t a_iIndex);
+				/// <param name="a_iIndex">The index of the first descriptor to free.</param>
+				/// <param name="a_iCount">The number of descriptors to free.</param>
+				void Deallocate(size_t a_iIndex, size_t a_iCount = 1);
 
 				/// <summary>
 				/// Gets the starting CPU descriptor handle for the heap.
@@ -79,7 +87,8 @@ namespace gallus
 				D3D12_DESCRIPTOR_HEAP_TYPE m_Type;
 				Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> m_pHeap;
 
-				std::vector<bool> m_aAllocated;
+				std::mutex m_AllocationMutex;
+				core::BitsetAllocator m_Allocated;
 			};
 		}
 	}
@@ -21,19 +21,22 @@ namespace gallus
 			Mesh::Mesh() : EngineResource()
 			{}
 
-			void Mesh::Render(std::shared_ptr<CommandList> a_pCommandList, const DX12Transform& a_Transform, const DirectX::XMMATRIX& a_CameraView, const DirectX::XMMATRIX& a_CameraProjection)
+			void Mesh::RenderInstanced(std::shared_ptr<CommandList> a_pCommandList, const D3D12_VERTEX_BUFFER_VIEW& a_InstanceBufferView, uint32_t a_iFirstInstance, uint32_t a_iInstanceCount, const glm::mat4& a_ViewProjection)
 			{
+				// The world matrices are part of the instance data, so only the view projection matrix is passed as root constants.
+				a_pCommandList->GetCommandList()->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+				a_pCommandList->GetCommandList()->SetGraphicsRoot32BitConstants(0, sizeof(glm::mat4) / 4, &a_ViewProjection, 0);
+
 				for (MeshPartData* meshData : m_aMeshData)
 				{
-					a_pCommandList->GetCommandList()->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-					a_pCommandList->GetCommandList()->IASetVertexBuffers(0, 1, &meshData->m_VertexBuffer.GetVertexBufferView());
+					const D3D12_VERTEX_BUFFER_VIEW vertexBufferViews[] = {
+						meshData->m_VertexBuffer.GetVertexBufferView(),
+						a_InstanceBufferView
+					};
+					a_pCommandList->GetCommandList()->IASetVertexBuffers(0, _countof(vertexBufferViews), vertexBufferViews);
 					a_pCommandList->GetCommandList()->IASetIndexBuffer(&meshData->m_IndexBuffer.GetIndexBufferView());
 
-					// Update the MVP matrix
-					const DirectX::XMMATRIX mvpMatrix = a_Transform.GetWorldMatrix() * a_CameraView * a_CameraProjection;
-					a_pCommandList->GetCommandList()->SetGraphicsRoot32BitConstants(0, sizeof(DirectX::XMMATRIX) / 4, &mvpMatrix, 0);
-
-					a_pCommandList->GetCommandList()->DrawIndexedInstanced(static_cast<UINT>(meshData->m_aIndices.size()), 1, 0, 0, 0);
+					a_pCommandList->GetCommandList()->DrawIndexedInstanced(static_cast<UINT>(meshData->m_aIndices.size()), a_iInstanceCount, 0, 0, a_iFirstInstance);
 				}
 			}
 
@@ -58,7 +61,7 @@ namespace gallus
 
 					// Upload vertex buffer data.
 				a_pCommandList->UpdateBufferResource(
-					&meshData->m_VertexBuffer.GetResource(), &meshData->m_pIntermediateVertexBuffer,
+					&meshData->m_VertexBuffer.GetResource(),
 					meshData->m_aVertices.size(), sizeof(VertexPosUV), meshData->m_aVertices.data());
 
 				// Create the vertex buffer view.
@@ -66,7 +69,7 @@ namespace gallus
 
 				// Upload index buffer data.
 				a_pCommandList->UpdateBufferResource(
-					&meshData->m_IndexBuffer.GetResource(), &meshData->m_pIntermediateIndexBuffer,
+					&meshData->m_IndexBuffer.GetResource(),
 					meshData->m_aIndices.size(), sizeof(uint16_t), meshData->m_aIndices.data());
 
 				// Create index buffer view.
@@ -8,6 +8,8 @@
 #include <cstdint>
 #include <memory>
 
+#include <glm/mat4x4.hpp>
+
 #include "utils/file_abstractions.h"
 #include "graphics/dx12/DX12Transform.h"
 #include "graphics/dx12/IndexBuffer.h"
@@ -32,9 +34,6 @@ namespace gallus
 
 				VertexBuffer m_VertexBuffer;
 				IndexBuffer m_IndexBuffer;
-
-				Microsoft::WRL::ComPtr<ID3D12Resource> m_pIntermediateVertexBuffer;
-				Microsoft::WRL::ComPtr<ID3D12Resource> m_pIntermediateIndexBuffer;
 			};
 
 			class CommandList;
@@ -43,7 +42,15 @@ namespace gallus
 			{
 			public:
 				Mesh();
-				void Render(std::shared_ptr<CommandList> a_pCommandList, const DX12Transform& a_Transform, const DirectX::XMMATRIX& a_CameraView, const DirectX::XMMATRIX& a_CameraProjection);
+				/// <summary>
+				/// Renders a range of instances of the mesh with one draw call per mesh part.
+				/// </summary>
+				/// <param name="a_pCommandList">The command list used for rendering.</param>
+				/// <param name="a_InstanceBufferView">View of the buffer that contains the per-instance data.</param>
+				/// <param name="a_iFirstInstance">Index of the first instance in the instance buffer.</param>
+				/// <param name="a_iInstanceCount">The number of instances.</param>
+				/// <param name="a_ViewProjection">The view projection matrix of the camera, for column vectors.</param>
+				void RenderInstanced(std::shared_ptr<CommandList> a_pCommandList, const D3D12_VERTEX_BUFFER_VIEW& a_InstanceBufferView, uint32_t a_iFirstInstance, uint32_t a_iInstanceCount, const glm::mat4& a_ViewProjection);
 				bool IsValid() const override;
 
 				bool LoadByName(const std::string& a_sName, const std::shared_ptr<CommandList> a_pCommandList);
@@ -14,17 +14,26 @@ namespace gallus
 			void Shader::Bind(std::shared_ptr<CommandList> a_CommandList)
 			{
 				a_CommandList->GetCommandList()->SetPipelineState(m_pPipelineState.Get());
-				a_CommandList->GetCommandList()->SetGraphicsRootSignature(core::TOOL->GetDX12().GetRootSignature().Get()); // Set the existing root signature
 			}
 
 			//---------------------------------------------------------------------
 			Microsoft::WRL::ComPtr<ID3DBlob> Shader::CompileShader(const fs::path& a_FilePath, const std::string& a_EntryPoint, const std::string& a_Target)
 			{
+				// The source is read through the atlas so shaders can come from the mounted archive.
+				core::Data source;
+				if (!core::TOOL->GetResourceAtlas().ReadFile(a_FilePath, source))
+				{
+					LOGF(LOGSEVERITY_ERROR, LOG_CATEGORY_DX12, "Failed reading shader: \"%s\".", a_FilePath.generic_string().c_str());
+					return nullptr;
+				}
+
 				Microsoft::WRL::ComPtr<ID3DBlob> shaderBlob;
 				Microsoft::WRL::ComPtr<ID3DBlob> errorBlob;
-				const std::wstring wFilePath = a_FilePath.generic_wstring();
-				HRESULT hr = D3DCompileFromFile(
-					wFilePath.c_str(),
+				const std::string sFilePath = a_FilePath.generic_string();
+				HRESULT hr = D3DCompile(
+					source.data(),
+					source.size(),
+					sFilePath.c_str(),
 					nullptr,
 					D3D_COMPILE_STANDARD_FILE_INCLUDE,
 					a_EntryPoint.c_str(),
@@ -88,10 +97,15 @@ namespace gallus
 					return false;
 				}
 
-				// Create the vertex input layout
+				// Create the vertex input layout. Slot 0 holds the mesh vertices, slot 1 the sprite instances (see SpriteInstance).
 				const D3D12_INPUT_ELEMENT_DESC inputLayout[] = {
 					{ "POSITION", 0, DXGI_FORMAT_R32G32_FLOAT, 0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
 					{ "TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
+					{ "WORLD", 0, DXGI_FORMAT_R32G32_FLOAT, 1, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_INSTANCE_DATA, 1 },
+					{ "WORLD", 1, DXGI_FORMAT_R32G32_FLOAT, 1, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_INSTANCE_DATA, 1 },
+					{ "WORLD", 2, DXGI_FORMAT_R32G32_FLOAT, 1, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_INSTANCE_DATA, 1 },
+					{ "UVRECT", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_INSTANCE_DATA, 1 },
+					{ "COLOR", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_INSTANCE_DATA, 1 },
 				};
 
 				CD3DX12_RASTERIZER_DESC rasterDesc(D3D12_DEFAULT);
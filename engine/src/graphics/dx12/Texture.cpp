@@ -1,12 +1,13 @@
 ﻿#include "graphics/dx12/Texture.h"
 
-#define STB_IMAGE_IMPLEMENTATION
-#include <stb_image.h>
+#include <algorithm>
+#include <vector>
 
 #include "core/Tool.h"
 #include "logger/Logger.h"
 #include "graphics/dx12/CommandList.h"
 #include "core/Data.h"
+#include "graphics/TextureData.h"
 
 namespace gallus
 {
@@ -77,7 +78,13 @@ namespace gallus
 					D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
 				a_pCommandList->GetCommandList()->ResourceBarrier(1, &barrier);
 
-				m_iSRVIndex = static_cast<int32_t>(core::TOOL->GetDX12().GetSRV().Allocate());
+				const size_t srvIndex = core::TOOL->GetDX12().GetSRV().Allocate();
+				if (srvIndex == HeapAllocation::INVALID_INDEX)
+				{
+					return false;
+				}
+
+				m_iSRVIndex = static_cast<int32_t>(srvIndex);
 				core::TOOL->GetDX12().GetDevice()->CreateShaderResourceView(m_pResource.Get(), &m_SrvDesc, core::TOOL->GetDX12().GetSRV().GetCPUHandle(m_iSRVIndex));
 
 				return true;
@@ -86,8 +93,6 @@ namespace gallus
 			//---------------------------------------------------------------------
 			void Texture::Bind(std::shared_ptr<CommandList> a_pCommandList)
 			{
-				a_pCommandList->GetCommandList()->SetDescriptorHeaps(1, core::TOOL->GetDX12().GetSRV().GetHeap().GetAddressOf());
-
 				CD3DX12_GPU_DESCRIPTOR_HANDLE gpuHandle = core::TOOL->GetDX12().GetSRV().GetGPUHandle(m_iSRVIndex);
 
 				a_pCommandList->GetCommandList()->SetGraphicsRootDescriptorTable(1, gpuHandle);
@@ -129,12 +134,30 @@ namespace gallus
 				return success;
 			}
 
-			// TODO: This is for loading from the tex file (library of all textures that would get compiled). For now it is unused since we just use the editor.
+			// Loads from the archive the resource atlas mounted, which is how builds without the editor ship their textures.
 			//---------------------------------------------------------------------
 			bool Texture::LoadByName(const std::string& a_sName, std::shared_ptr<CommandList> a_pCommandList, const D3D12_HEAP_PROPERTIES& a_Heap, const D3D12_RESOURCE_STATES a_ResourceState)
 			{
 				m_ResourceType = core::ResourceType::ResourceType_Texture;
-				return false;
+
+				const core::ResourceAtlas& atlas = core::TOOL->GetResourceAtlas();
+				const fs::path path = fs::path(atlas.GetResourceFolder() + "/textures/" + a_sName).lexically_normal();
+
+				core::Data file;
+				if (!atlas.ReadFile(path, file))
+				{
+					LOGF(LOGSEVERITY_ERROR, LOG_CATEGORY_DX12, "Failed to load texture: \"%s\".", path.generic_string().c_str());
+					return false;
+				}
+
+				TextureData texture;
+				if (!ReadTextureFile(file, texture))
+				{
+					LOGF(LOGSEVERITY_ERROR, LOG_CATEGORY_DX12, "Failed to decode texture: \"%s\".", path.generic_string().c_str());
+					return false;
+				}
+
+				return LoadFromData(path, texture, a_pCommandList);
 			}
 
 			//---------------------------------------------------------------------
@@ -145,52 +168,69 @@ namespace gallus
 					return false;
 				}
 
-				int width, height, channels;
-				stbi_uc* imageData = stbi_load(a_Path.generic_string().c_str(), &width, &height, &channels, STBI_rgb_alpha);
-				if (!imageData)
+				core::Data file;
+				TextureData texture;
+				if (!core::TOOL->GetResourceAtlas().ReadFile(a_Path, file) || !ReadTextureFile(file, texture))
 				{
 					LOGF(LOGSEVERITY_ERROR, LOG_CATEGORY_DX12, "Failed to load texture: \"%s\".", a_Path.generic_string().c_str());
 					return false;
 				}
 
-				size_t memorySize = static_cast<size_t>(width) * height * 4;
-				core::Data data = core::Data(imageData, memorySize);
+				return LoadFromData(a_Path, texture, a_CommandList);
+			}
 
-				stbi_image_free(imageData);
+			//---------------------------------------------------------------------
+			bool Texture::LoadFromData(const fs::path& a_Path, const TextureData& a_Texture, std::shared_ptr<CommandList> a_CommandList)
+			{
+				if (m_pResource && !m_bIsDestroyable)
+				{
+					return false;
+				}
 
 				m_sName = a_Path.filename().generic_string();
 				m_Path = a_Path;
 
+				// The texture formats share their values with DXGI, so cooked textures describe their resource as they are.
+				const DXGI_FORMAT format = static_cast<DXGI_FORMAT>(a_Texture.m_Format);
+
 				D3D12_RESOURCE_DESC textureDesc = {};
 				textureDesc.Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE2D;
-				textureDesc.Width = width;
-				textureDesc.Height = height;
+				textureDesc.Width = a_Texture.m_iWidth;
+				textureDesc.Height = a_Texture.m_iHeight;
 				textureDesc.DepthOrArraySize = 1;
-				textureDesc.MipLevels = 1;
-				textureDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+				textureDesc.MipLevels = static_cast<UINT16>(a_Texture.m_iMipLevels);
+				textureDesc.Format = format;
 				textureDesc.SampleDesc.Count = 1;
 				textureDesc.Flags = D3D12_RESOURCE_FLAG_NONE;
 				textureDesc.Layout = D3D12_TEXTURE_LAYOUT_UNKNOWN;
 
 				CreateResource(textureDesc, m_sName);
 
-				const UINT64 uploadBufferSize = GetRequiredIntermediateSize(m_pResource.Get(), 0, 1);
-				const CD3DX12_HEAP_PROPERTIES uploadHeapProperties(D3D12_HEAP_TYPE_UPLOAD);
-				const CD3DX12_RESOURCE_DESC bufferResource = CD3DX12_RESOURCE_DESC::Buffer(uploadBufferSize);
-				D3D12_SUBRESOURCE_DATA textureData = {};
-				textureData.pData = data.data();
-				textureData.RowPitch = width * channels;
-				textureData.SlicePitch = textureData.RowPitch * height;
+				// The pixels are staged in the upload ring of the command list, which reuses the memory once the copy was executed.
+				const UINT64 uploadBufferSize = GetRequiredIntermediateSize(m_pResource.Get(), 0, a_Texture.m_iMipLevels);
+				const UploadAllocation staging = a_CommandList->AllocateUpload(uploadBufferSize, D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT);
+				if (!staging.m_pData)
+				{
+					LOGF(LOGSEVERITY_ERROR, LOG_CATEGORY_DX12, "Failed allocating staging memory for texture: \"%s\".", a_Path.generic_string().c_str());
+					return false;
+				}
 
-				UploadTexture(uploadHeapProperties, bufferResource);
-				UpdateSubresources(a_CommandList->GetCommandList().Get(), m_pResource.Get(), m_pResourceUploadHeap.Get(), 0, 0, 1, &textureData);
+				std::vector<D3D12_SUBRESOURCE_DATA> mips(a_Texture.m_iMipLevels);
+				for (uint32_t i = 0; i < a_Texture.m_iMipLevels; i++)
+				{
+					mips[i].pData = a_Texture.m_Data.dataAs<uint8_t>() + GetTextureMipOffset(a_Texture, i);
+					mips[i].RowPitch = static_cast<LONG_PTR>(GetTextureRowPitch(a_Texture.m_Format, std::max(a_Texture.m_iWidth >> i, 1u)));
+					mips[i].SlicePitch = mips[i].RowPitch * GetTextureRowCount(a_Texture.m_Format, std::max(a_Texture.m_iHeight >> i, 1u));
+				}
+
+				UpdateSubresources(a_CommandList->GetCommandList().Get(), m_pResource.Get(), staging.m_pResource, staging.m_iOffset, 0, a_Texture.m_iMipLevels, mips.data());
 
 				D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
 				srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
-				srvDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+				srvDesc.Format = format;
 				srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
 				srvDesc.Texture2D.MostDetailedMip = 0;
-				srvDesc.Texture2D.MipLevels = 1;
+				srvDesc.Texture2D.MipLevels = a_Texture.m_iMipLevels;
 				srvDesc.Texture2D.ResourceMinLODClamp = 0.0f;
 				SetSRVDesc(srvDesc);
 
@@ -200,31 +240,6 @@ namespace gallus
 				return true;
 			}
 
-			//---------------------------------------------------------------------
-			bool Texture::UploadTexture(const D3D12_HEAP_PROPERTIES& a_UploadHeapProperties, const D3D12_RESOURCE_DESC& a_BufferDescription)
-			{
-				UINT64 uploadBufferSize = GetRequiredIntermediateSize(m_pResource.Get(), 0, 1);
-				if (FAILED(core::TOOL->GetDX12().GetDevice()->CreateCommittedResource(
-					&a_UploadHeapProperties,
-					D3D12_HEAP_FLAG_NONE,
-					&a_BufferDescription,
-					D3D12_RESOURCE_STATE_GENERIC_READ,
-					nullptr,
-					IID_PPV_ARGS(&m_pResourceUploadHeap))))
-				{
-					LOG(LOGSEVERITY_ERROR, LOG_CATEGORY_DX12, "Failed to create upload heap.");
-					return false;
-				}
-
-				return true;
-			}
-
-			//---------------------------------------------------------------------
-			Microsoft::WRL::ComPtr<ID3D12Resource>& Texture::GetUploadResource()
-			{
-				return m_pResourceUploadHeap;
-			}
-
 			//---------------------------------------------------------------------
 			void Texture::SetSRVDesc(const D3D12_SHADER_RESOURCE_VIEW_DESC& a_SrvDesc)
 			{
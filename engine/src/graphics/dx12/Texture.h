@@ -15,6 +15,8 @@ namespace gallus
 {
 	namespace graphics
 	{
+		struct TextureData;
+
 		namespace dx12
 		{
 			class CommandList;
@@ -66,7 +68,7 @@ namespace gallus
 				bool CreateSRV(std::shared_ptr<CommandList> a_pCommandList);
 
 				/// <summary>
-				/// Binds the texture to the pipeline (causing it to be rendered).
+				/// Binds the texture to the pipeline (causing it to be rendered). Expects the srv heap to be set on the command list.
 				/// </summary>
 				/// <param name="a_pCommandList">The command list that will be used.</param>
 				void Bind(std::shared_ptr<CommandList> a_pCommandList);
@@ -118,14 +120,13 @@ namespace gallus
 				bool LoadByPath(const fs::path& a_Path, std::shared_ptr<CommandList> a_pCommandList);
 
 				/// <summary>
-				/// Uploads a texture to the heap.
+				/// Creates the texture from decoded or cooked texture data and records the upload of every mip.
 				/// </summary>
-				/// <param name="a_UploadHeapProperties">Properties for the heap.</param>
-				/// <param name="a_BufferDescription">Properties for the resource.</param>
-				/// <returns></returns>
-				bool UploadTexture(const D3D12_HEAP_PROPERTIES& a_UploadHeapProperties, const D3D12_RESOURCE_DESC& a_BufferDescription);
-
-				Microsoft::WRL::ComPtr<ID3D12Resource>& GetUploadResource();
+				/// <param name="a_Path">The path the texture was read from.</param>
+				/// <param name="a_Texture">The texture data, only read while recording.</param>
+				/// <param name="a_pCommandList">The command list used for updating resources.</param>
+				/// <returns>True if the upload was recorded, otherwise false.</returns>
+				bool LoadFromData(const fs::path& a_Path, const TextureData& a_Texture, std::shared_ptr<CommandList> a_pCommandList);
 
 				void SetSRVDesc(const D3D12_SHADER_RESOURCE_VIEW_DESC& a_SrvDesc);
 
@@ -135,7 +136,6 @@ namespace gallus
 			private:
 				friend ResourceAtlas;
 
-				Microsoft::WRL::ComPtr<ID3D12Resource> m_pResourceUploadHeap = nullptr;
 				int32_t m_iSRVIndex = -1;
 				D3D12_SHADER_RESOURCE_VIEW_DESC m_SrvDesc;
 			};
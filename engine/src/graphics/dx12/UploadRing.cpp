@@ -0,0 +1,133 @@
+#include "graphics/dx12/UploadRing.h"
+
+#include "core/Tool.h"
+#include "graphics/dx12/DX12System2D.h"
+#include "logger/Logger.h"
+
+namespace gallus
+{
+	namespace graphics
+	{
+		namespace dx12
+		{
+			//---------------------------------------------------------------------
+			// UploadRing
+			//---------------------------------------------------------------------
+			UploadRing::~UploadRing()
+			{
+				if (m_pResource && m_pMappedData)
+				{
+					m_pResource->Unmap(0, nullptr);
+				}
+			}
+
+			//---------------------------------------------------------------------
+			bool UploadRing::Initialize(size_t a_iCapacity)
+			{
+				if (!CreateBuffer(a_iCapacity, m_pResource, &m_pMappedData))
+				{
+					LOG(LOGSEVERITY_ERROR, LOG_CATEGORY_DX12, "Failed creating upload ring.");
+					return false;
+				}
+
+				m_pResource->SetName(L"UploadRing");
+				m_Allocator.Reset(a_iCapacity);
+				return true;
+			}
+
+			//---------------------------------------------------------------------
+			UploadAllocation UploadRing::Allocate(size_t a_iSize, size_t a_iAlignment, const void* a_pCommandList)
+			{
+				UploadAllocation allocation;
+
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				const size_t offset = m_Allocator.Allocate(a_iSize, a_iAlignment, reinterpret_cast<uintptr_t>(a_pCommandList));
+				if (offset != core::RingAllocator::INVALID_OFFSET)
+				{
+					allocation.m_pData = m_pMappedData + offset;
+					allocation.m_GPUAddress = m_pResource->GetGPUVirtualAddress() + offset;
+					allocation.m_pResource = m_pResource.Get();
+					allocation.m_iOffset = offset;
+					return allocation;
+				}
+
+				// Placed resources start at a 64KB boundary, which covers every alignment the uploads ask for.
+				Microsoft::WRL::ComPtr<ID3D12Resource> resource;
+				if (!CreateBuffer(a_iSize, resource, &allocation.m_pData))
+				{
+					LOGF(LOGSEVERITY_ERROR, LOG_CATEGORY_DX12, "Failed allocating %zu bytes of upload memory.", a_iSize);
+					return {};
+				}
+
+				allocation.m_GPUAddress = resource->GetGPUVirtualAddress();
+				allocation.m_pResource = resource.Get();
+				m_aUnfinishedBuffers.push_back({ a_pCommandList, 0, resource });
+				return allocation;
+			}
+
+			//---------------------------------------------------------------------
+			void UploadRing::Finish(const void* a_pCommandList, uint64_t a_iFenceValue)
+			{
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				m_Allocator.Finish(reinterpret_cast<uintptr_t>(a_pCommandList), a_iFenceValue);
+
+				for (size_t i = 0; i < m_aUnfinishedBuffers.size();)
+				{
+					if (m_aUnfinishedBuffers[i].m_pCommandList == a_pCommandList)
+					{
+						m_aUnfinishedBuffers[i].m_iFenceValue = a_iFenceValue;
+						m_aDedicatedBuffers.push_back(m_aUnfinishedBuffers[i]);
+						m_aUnfinishedBuffers.erase(m_aUnfinishedBuffers.begin() + i);
+					}
+					else
+					{
+						i++;
+					}
+				}
+			}
+
+			//---------------------------------------------------------------------
+			void UploadRing::ReleaseCompleted(uint64_t a_iCompletedFenceValue)
+			{
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				m_Allocator.ReleaseCompleted(a_iCompletedFenceValue);
+
+				while (!m_aDedicatedBuffers.empty() && m_aDedicatedBuffers.front().m_iFenceValue <= a_iCompletedFenceValue)
+				{
+					m_aDedicatedBuffers.pop_front();
+				}
+			}
+
+			//---------------------------------------------------------------------
+			bool UploadRing::CreateBuffer(size_t a_iSize, Microsoft::WRL::ComPtr<ID3D12Resource>& a_pResource, uint8_t** a_pData)
+			{
+				const CD3DX12_HEAP_PROPERTIES uploadHeapType = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD);
+				const CD3DX12_RESOURCE_DESC buffer = CD3DX12_RESOURCE_DESC::Buffer(a_iSize);
+
+				Microsoft::WRL::ComPtr<ID3D12Device2>& device = core::TOOL->GetDX12().GetDevice();
+				if (FAILED(device->CreateCommittedResource(
+					&uploadHeapType,
+					D3D12_HEAP_FLAG_NONE,
+					&buffer,
+					D3D12_RESOURCE_STATE_GENERIC_READ,
+					nullptr,
+					IID_PPV_ARGS(&a_pResource))))
+				{
+					LOG(LOGSEVERITY_ERROR, LOG_CATEGORY_DX12, "Failed creating committed resource.");
+					return false;
+				}
+
+				// The cpu never reads from upload memory. Upload heap buffers can stay mapped while the gpu uses them.
+				const CD3DX12_RANGE readRange(0, 0);
+				if (FAILED(a_pResource->Map(0, &readRange, reinterpret_cast<void**>(a_pData))))
+				{
+					LOG(LOGSEVERITY_ERROR, LOG_CATEGORY_DX12, "Failed mapping upload buffer.");
+					a_pResource.Reset();
+					return false;
+				}
+
+				return true;
+			}
+		}
+	}
+}
\ No newline at end of file
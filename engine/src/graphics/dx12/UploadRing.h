@@ -0,0 +1,103 @@
+#pragma once
+
+#include "DX12PCH.h"
+
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+#include "core/RingAllocator.h"
+
+namespace gallus
+{
+	namespace graphics
+	{
+		namespace dx12
+		{
+			//---------------------------------------------------------------------
+			// UploadAllocation
+			//---------------------------------------------------------------------
+			/// <summary>
+			/// Range of upload heap memory that stays valid until the gpu finished the command list it was allocated for.
+			/// </summary>
+			struct UploadAllocation
+			{
+				uint8_t* m_pData = nullptr; /// Cpu address of the range, write only.
+				D3D12_GPU_VIRTUAL_ADDRESS m_GPUAddress = 0; /// Gpu address of the range.
+				ID3D12Resource* m_pResource = nullptr; /// The buffer the range is part of.
+				uint64_t m_iOffset = 0; /// Offset of the range in the buffer.
+			};
+
+			//---------------------------------------------------------------------
+			// UploadRing
+			//---------------------------------------------------------------------
+			/// <summary>
+			/// Persistently mapped upload heap buffer that is handed out as a ring. Allocating is a pointer bump, the memory gets
+			/// reused once the fence of the command list it was allocated for is reached. Requests that do not fit get a buffer
+			/// of their own, which is released the same way. The ring is locked, so command lists of the same queue can be
+			/// recorded on different threads; every command list is recorded by one thread at a time.
+			/// </summary>
+			class UploadRing
+			{
+			public:
+				~UploadRing();
+
+				/// <summary>
+				/// Creates and maps the buffer of the ring.
+				/// </summary>
+				/// <param name="a_iCapacity">Size of the ring in bytes.</param>
+				/// <returns>True if the buffer was created, otherwise false.</returns>
+				bool Initialize(size_t a_iCapacity);
+
+				/// <summary>
+				/// Allocates a range of upload memory.
+				/// </summary>
+				/// <param name="a_iSize">Size of the range in bytes.</param>
+				/// <param name="a_iAlignment">Alignment of the range, has to be a power of two.</param>
+				/// <param name="a_pCommandList">The command list the range is used by.</param>
+				/// <returns>The range, with m_pData set to nullptr if no memory could be allocated.</returns>
+				UploadAllocation Allocate(size_t a_iSize, size_t a_iAlignment, const void* a_pCommandList);
+
+				/// <summary>
+				/// Tags everything a command list allocated with the fence value it was executed with.
+				/// </summary>
+				/// <param name="a_pCommandList">The command list.</param>
+				/// <param name="a_iFenceValue">The fence value.</param>
+				void Finish(const void* a_pCommandList, uint64_t a_iFenceValue);
+
+				/// <summary>
+				/// Frees the memory of all command lists whose fence value was reached.
+				/// </summary>
+				/// <param name="a_iCompletedFenceValue">The fence value the gpu has completed.</param>
+				void ReleaseCompleted(uint64_t a_iCompletedFenceValue);
+			private:
+				/// <summary>
+				/// Creates a mapped buffer in an upload heap.
+				/// </summary>
+				/// <param name="a_iSize">Size of the buffer in bytes.</param>
+				/// <param name="a_pResource">Receives the buffer.</param>
+				/// <param name="a_pData">Receives the cpu address of the buffer.</param>
+				/// <returns>True if the buffer was created, otherwise false.</returns>
+				bool CreateBuffer(size_t a_iSize, Microsoft::WRL::ComPtr<ID3D12Resource>& a_pResource, uint8_t** a_pData);
+
+				/// <summary>
+				/// Buffer that was created for a request that did not fit in the ring.
+				/// </summary>
+				struct DedicatedBuffer
+				{
+					const void* m_pCommandList = nullptr;
+					uint64_t m_iFenceValue = 0;
+					Microsoft::WRL::ComPtr<ID3D12Resource> m_pResource;
+				};
+
+				std::mutex m_Mutex;
+				core::RingAllocator m_Allocator;
+				Microsoft::WRL::ComPtr<ID3D12Resource> m_pResource = nullptr;
+				uint8_t* m_pMappedData = nullptr;
+				std::vector<DedicatedBuffer> m_aUnfinishedBuffers; /// Dedicated buffers of command lists that have not been executed yet.
+				std::deque<DedicatedBuffer> m_aDedicatedBuffers; /// Dedicated buffers of executed command lists, oldest first.
+			};
+		}
+	}
+}
\ No newline at end of file
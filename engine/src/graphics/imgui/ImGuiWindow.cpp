@@ -98,6 +98,11 @@ namespace gallus
 			{
 				dx12::DX12System2D& dx12window = core::TOOL->GetDX12();
 				m_SrvIndex = dx12window.GetSRV().Allocate();
+				if (m_SrvIndex == dx12::HeapAllocation::INVALID_INDEX)
+				{
+					LOG(LOGSEVERITY_ERROR, LOG_CATEGORY_EDITOR, "Failed allocating font descriptor for ImGui.");
+					return false;
+				}
 
 				if (!ImGui_ImplDX12_Init(dx12window.GetDevice().Get(), dx12::g_iBufferCount,
 					DXGI_FORMAT_R8G8B8A8_UNORM, dx12window.GetSRV().GetHeap().Get(),
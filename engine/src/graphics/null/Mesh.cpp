@@ -0,0 +1,54 @@
+#include "graphics/null/Mesh.h"
+
+namespace gallus
+{
+	namespace graphics
+	{
+		namespace null
+		{
+			//---------------------------------------------------------------------
+			// Mesh
+			//---------------------------------------------------------------------
+			bool Mesh::IsValid() const
+			{
+				return m_bLoaded;
+			}
+
+			//---------------------------------------------------------------------
+			bool Mesh::LoadByName(const std::string& a_sName, const std::shared_ptr<CommandList> /*a_pCommandList*/)
+			{
+				m_sName = a_sName;
+				m_ResourceType = core::ResourceType::ResourceType_Mesh;
+
+				// Same quad as the dx12 mesh.
+				m_aVertices = {
+					{ glm::vec2(0.0f, 0.0f), glm::vec2(1.0f, 0.0f) },
+					{ glm::vec2(1.0f, 0.0f), glm::vec2(0.0f, 0.0f) },
+					{ glm::vec2(0.0f, 1.0f), glm::vec2(1.0f, 1.0f) },
+					{ glm::vec2(1.0f, 1.0f), glm::vec2(0.0f, 1.0f) }
+				};
+
+				m_aIndices = {
+					0, 1, 2,
+					2, 1, 3
+				};
+
+				m_bLoaded = true;
+
+				return true;
+			}
+
+			//---------------------------------------------------------------------
+			const std::vector<VertexPosUV>& Mesh::GetVertices() const
+			{
+				return m_aVertices;
+			}
+
+			//---------------------------------------------------------------------
+			const std::vector<uint16_t>& Mesh::GetIndices() const
+			{
+				return m_aIndices;
+			}
+		}
+	}
+}
\ No newline at end of file
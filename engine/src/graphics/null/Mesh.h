@@ -0,0 +1,68 @@
+#pragma once
+
+#include "core/EngineResource.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <glm/vec2.hpp>
+
+namespace gallus
+{
+	namespace graphics
+	{
+		namespace null
+		{
+			class CommandList;
+
+			struct VertexPosUV
+			{
+				glm::vec2 Position;
+				glm::vec2 UV;
+			};
+
+			//---------------------------------------------------------------------
+			// Mesh
+			//---------------------------------------------------------------------
+			/// <summary>
+			/// Mesh of the null graphics backend. Keeps the same vertices and indices as the dx12 mesh in memory, so cpu renderers can draw it.
+			/// There are no vertex or index buffers.
+			/// </summary>
+			class Mesh : public core::EngineResource
+			{
+			public:
+				/// <summary>
+				/// Returns whether the resource is a valid resource.
+				/// </summary>
+				/// <returns>True if the resource was valid, false otherwise.</returns>
+				bool IsValid() const override;
+
+				/// <summary>
+				/// Loads a mesh by name.
+				/// </summary>
+				/// <param name="a_sName">Name of the mesh.</param>
+				/// <param name="a_pCommandList">Unused, there is nothing to upload.</param>
+				/// <returns>True if the mesh was loaded, otherwise false.</returns>
+				bool LoadByName(const std::string& a_sName, const std::shared_ptr<CommandList> a_pCommandList);
+
+				/// <summary>
+				/// Retrieves the vertices of the mesh.
+				/// </summary>
+				/// <returns>The vertices.</returns>
+				const std::vector<VertexPosUV>& GetVertices() const;
+
+				/// <summary>
+				/// Retrieves the indices of the mesh, three per triangle.
+				/// </summary>
+				/// <returns>The indices.</returns>
+				const std::vector<uint16_t>& GetIndices() const;
+			private:
+				std::vector<VertexPosUV> m_aVertices;
+				std::vector<uint16_t> m_aIndices;
+				bool m_bLoaded = false;
+			};
+		}
+	}
+}
\ No newline at end of file
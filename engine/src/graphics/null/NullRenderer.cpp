@@ -0,0 +1,115 @@
+#include "graphics/null/NullRenderer.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "core/Tool.h"
+#include "logger/Logger.h"
+
+#include "graphics/null/Texture.h"
+#include "graphics/null/Shader.h"
+#include "graphics/null/Mesh.h"
+
+namespace gallus
+{
+	namespace graphics
+	{
+		namespace null
+		{
+			//---------------------------------------------------------------------
+			// NullRenderer
+			//---------------------------------------------------------------------
+			bool NullRenderer::Initialize(const glm::ivec2& a_vSize)
+			{
+				m_vSize = a_vSize;
+				m_iFrameCount = 0;
+
+				// Same defaults as the dx12 system, so components that fall back on them behave the same.
+				core::ResourceAtlas& resourceAtlas = core::TOOL->GetResourceAtlas();
+
+				core::TextureHandle texture = resourceAtlas.LoadTexture("tex_missing.png", nullptr); // Default texture.
+				resourceAtlas.GetTexture(texture)->SetResourceCategory(core::EngineResourceCategory::Missing);
+				resourceAtlas.GetTexture(texture)->SetIsDestroyable(false);
+
+				core::ShaderHandle shader = resourceAtlas.LoadShader("vertexShader.hlsl", "pixelShader.hlsl"); // Default shader.
+				resourceAtlas.GetShader(shader)->SetResourceCategory(core::EngineResourceCategory::Missing);
+				resourceAtlas.GetShader(shader)->SetIsDestroyable(false);
+
+				core::MeshHandle mesh = resourceAtlas.LoadMesh("generic_mesh", nullptr); // Default mesh.
+				resourceAtlas.GetMesh(mesh)->SetResourceCategory(core::EngineResourceCategory::Missing);
+				resourceAtlas.GetMesh(mesh)->SetIsDestroyable(false);
+
+				resourceAtlas.SetDefaultResources(texture, shader, mesh);
+
+				LOG(LOGSEVERITY_SUCCESS, LOG_CATEGORY_ENGINE, "Initialized null renderer.");
+
+				return System::Initialize();
+			}
+
+			//---------------------------------------------------------------------
+			bool NullRenderer::Destroy()
+			{
+				m_pRenderDevice = nullptr;
+				return System::Destroy();
+			}
+
+			//---------------------------------------------------------------------
+			void NullRenderer::Render()
+			{
+				// Renders the latest packet the game thread published, or the previous one again if there is no new one.
+				core::TripleBuffer<RenderPacket>& packets = core::TOOL->GetRenderPackets();
+				if (packets.Consume())
+				{
+					m_SpriteBatcher.Build(packets.GetReadBuffer());
+				}
+
+				if (m_pRenderDevice)
+				{
+					// Same projection as the dx12 camera: pixels with the origin in the top left corner.
+					m_pRenderDevice->SetViewProjection(glm::ortho(0.0f, static_cast<float>(m_vSize.x), static_cast<float>(m_vSize.y), 0.0f, -1.0f, 1.0f));
+					m_pRenderDevice->Clear({ 0.0f, 0.0f, 0.0f, 1.0f });
+					m_pRenderDevice->DrawBatches(m_SpriteBatcher);
+				}
+
+				// Drawing is done by the time this returns, so nothing points at the resources unloaded before this packet.
+				core::TOOL->GetResourceAtlas().SetCompletedFrame(packets.GetReadBuffer().m_iFrame);
+				m_iFrameCount++;
+			}
+
+			//---------------------------------------------------------------------
+			void NullRenderer::SetRenderDevice(RenderDevice* a_pRenderDevice)
+			{
+				m_pRenderDevice = a_pRenderDevice;
+			}
+
+			//---------------------------------------------------------------------
+			uint64_t NullRenderer::GetFrameCount() const
+			{
+				return m_iFrameCount;
+			}
+
+			//---------------------------------------------------------------------
+			uint32_t NullRenderer::GetDrawCount() const
+			{
+				return m_SpriteBatcher.GetStats().m_iDrawCount;
+			}
+
+			//---------------------------------------------------------------------
+			uint32_t NullRenderer::GetBatchCount() const
+			{
+				return m_SpriteBatcher.GetStats().m_iBatchCount;
+			}
+
+			//---------------------------------------------------------------------
+			const RenderStats& NullRenderer::GetStats() const
+			{
+				return m_SpriteBatcher.GetStats();
+			}
+
+			//---------------------------------------------------------------------
+			const glm::ivec2& NullRenderer::GetSize() const
+			{
+				return m_vSize;
+			}
+		}
+	}
+}
\ No newline at end of file
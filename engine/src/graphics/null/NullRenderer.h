@@ -0,0 +1,88 @@
+#pragma once
+
+#include "core/System.h"
+#include "graphics/RenderDevice.h"
+#include "graphics/SpriteBatcher.h"
+
+#include <glm/vec2.hpp>
+#include <cstdint>
+
+namespace gallus
+{
+	namespace graphics
+	{
+		namespace null
+		{
+			//---------------------------------------------------------------------
+			// NullRenderer
+			//---------------------------------------------------------------------
+			/// <summary>
+			/// Stand-in for the dx12 system in headless builds. Loads the default resources and consumes the same
+			/// render packets a frame would draw, but never touches a gpu. Frames are rendered on the calling thread.
+			/// If a render device is set, the batches of every frame are drawn with it, for example by the software rasterizer.
+			/// </summary>
+			class NullRenderer : public core::System
+			{
+			public:
+				/// <summary>
+				/// Initializes the system, loading the default resources.
+				/// </summary>
+				/// <param name="a_vSize">Size of the (virtual) back buffer.</param>
+				/// <returns>True if the initialization was successful, otherwise false.</returns>
+				bool Initialize(const glm::ivec2& a_vSize);
+
+				/// <summary>
+				/// Destroys the system.
+				/// </summary>
+				/// <returns>True if the destruction was successful, otherwise false.</returns>
+				bool Destroy() override;
+
+				/// <summary>
+				/// Renders a frame: consumes the latest render packet and batches the meshes that would be drawn.
+				/// </summary>
+				void Render();
+
+				/// <summary>
+				/// Sets the device the frames get drawn with.
+				/// </summary>
+				/// <param name="a_pRenderDevice">The render device, or nullptr to only batch the frames. Has to outlive the renderer.</param>
+				void SetRenderDevice(RenderDevice* a_pRenderDevice);
+
+				/// <summary>
+				/// Retrieves the number of frames that have been rendered.
+				/// </summary>
+				/// <returns>The number of rendered frames.</returns>
+				uint64_t GetFrameCount() const;
+
+				/// <summary>
+				/// Retrieves the number of meshes the last frame would have drawn.
+				/// </summary>
+				/// <returns>The number of draws in the last frame.</returns>
+				uint32_t GetDrawCount() const;
+
+				/// <summary>
+				/// Retrieves the number of instanced draw calls the last frame would have issued.
+				/// </summary>
+				/// <returns>The number of batches in the last frame.</returns>
+				uint32_t GetBatchCount() const;
+
+				/// <summary>
+				/// Retrieves the counters of the last frame, including the state changes the render queue avoided.
+				/// </summary>
+				/// <returns>The counters of the last frame.</returns>
+				const RenderStats& GetStats() const;
+
+				/// <summary>
+				/// Retrieves the size of the (virtual) back buffer.
+				/// </summary>
+				/// <returns>A 2D vector representing the width and height of the back buffer.</returns>
+				const glm::ivec2& GetSize() const;
+			private:
+				glm::ivec2 m_vSize = { 1920, 1080 };
+				uint64_t m_iFrameCount = 0;
+				SpriteBatcher m_SpriteBatcher;
+				RenderDevice* m_pRenderDevice = nullptr;
+			};
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,92 @@
+#include "graphics/null/NullWindow.h"
+
+#include <csignal>
+
+#include "logger/Logger.h"
+
+namespace gallus
+{
+	namespace graphics
+	{
+		namespace null
+		{
+			// Set from the signal handler, so it has to be a lock-free atomic.
+			std::atomic<bool> s_bQuitRequested = false;
+
+			//---------------------------------------------------------------------
+			void OnSignal(int /*a_iSignal*/)
+			{
+				s_bQuitRequested.store(true);
+			}
+
+			//---------------------------------------------------------------------
+			// NullWindow
+			//---------------------------------------------------------------------
+			bool NullWindow::Initialize()
+			{
+				s_bQuitRequested.store(false);
+
+				std::signal(SIGINT, OnSignal);
+				std::signal(SIGTERM, OnSignal);
+
+				LOG(LOGSEVERITY_SUCCESS, LOG_CATEGORY_WINDOW, "Initialized null window.");
+
+				return System::Initialize();
+			}
+
+			//---------------------------------------------------------------------
+			bool NullWindow::Destroy()
+			{
+				std::signal(SIGINT, SIG_DFL);
+				std::signal(SIGTERM, SIG_DFL);
+
+				return System::Destroy();
+			}
+
+			//---------------------------------------------------------------------
+			void NullWindow::ProcessEvents()
+			{
+				if (s_bQuitRequested.exchange(false))
+				{
+					m_OnQuit();
+				}
+			}
+
+			//---------------------------------------------------------------------
+			void NullWindow::Quit()
+			{
+				s_bQuitRequested.store(true);
+			}
+
+			//---------------------------------------------------------------------
+			void NullWindow::SetTitle(const std::string& a_sTitle)
+			{
+				m_sTitle = a_sTitle;
+			}
+
+			//---------------------------------------------------------------------
+			const std::string& NullWindow::GetTitle() const
+			{
+				return m_sTitle;
+			}
+
+			//---------------------------------------------------------------------
+			glm::ivec2 NullWindow::GetRealSize() const
+			{
+				return m_vSize;
+			}
+
+			//---------------------------------------------------------------------
+			void NullWindow::SetSize(const glm::ivec2& a_vSize)
+			{
+				m_vSize = a_vSize;
+			}
+
+			//---------------------------------------------------------------------
+			SimpleEvent<>& NullWindow::OnQuit()
+			{
+				return m_OnQuit;
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "core/System.h"
+
+#include <glm/vec2.hpp>
+#include <string>
+
+#include "core/Event.h"
+
+namespace gallus
+{
+	namespace graphics
+	{
+		namespace null
+		{
+			//---------------------------------------------------------------------
+			// NullWindow
+			//---------------------------------------------------------------------
+			/// <summary>
+			/// Stand-in for the window in headless builds. Nothing is shown on screen, but it has a size and
+			/// forwards quit requests (including interrupt and terminate signals) through the same on quit event.
+			/// </summary>
+			class NullWindow : public core::System
+			{
+			public:
+				/// <summary>
+				/// Initializes the system, installing the signal handlers.
+				/// </summary>
+				/// <returns>True if the initialization was successful, otherwise false.</returns>
+				bool Initialize() override;
+
+				/// <summary>
+				/// Destroys the system, restoring the default signal handlers.
+				/// </summary>
+				/// <returns>True if the destruction was successful, otherwise false.</returns>
+				bool Destroy() override;
+
+				/// <summary>
+				/// Invokes the on quit event if a quit has been requested since the last call.
+				/// </summary>
+				void ProcessEvents();
+
+				/// <summary>
+				/// Requests the program to quit. The on quit event is invoked by the next ProcessEvents call.
+				/// </summary>
+				void Quit();
+
+				/// <summary>
+				/// Sets the window title.
+				/// </summary>
+				/// <param name="a_sTitle">The new title for the window.</param>
+				void SetTitle(const std::string& a_sTitle);
+
+				/// <summary>
+				/// Retrieves the window title.
+				/// </summary>
+				/// <returns>The title of the window.</returns>
+				const std::string& GetTitle() const;
+
+				/// <summary>
+				/// Retrieves the real (physical) size of the window.
+				/// </summary>
+				/// <returns>A 2D vector representing the width and height of the window.</returns>
+				glm::ivec2 GetRealSize() const;
+
+				/// <summary>
+				/// Sets the size of the window.
+				/// </summary>
+				/// <param name="a_vSize">The size of the window</param>
+				void SetSize(const glm::ivec2& a_vSize);
+
+				/// <summary>
+				/// Retrieves the on quit event.
+				/// </summary>
+				/// <returns>Reference to the on quit event.</returns>
+				SimpleEvent<>& OnQuit();
+			private:
+				SimpleEvent<> m_OnQuit;
+
+				std::string m_sTitle;
+				glm::ivec2 m_vSize = { 1920, 1080 };
+			};
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,54 @@
+#include "graphics/null/Shader.h"
+
+#include "core/Tool.h"
+#include "logger/Logger.h"
+
+namespace gallus
+{
+	namespace graphics
+	{
+		namespace null
+		{
+			//---------------------------------------------------------------------
+			// Shader
+			//---------------------------------------------------------------------
+			bool Shader::IsValid() const
+			{
+				return m_bLoaded;
+			}
+
+			//---------------------------------------------------------------------
+			const std::string& Shader::GetPixelPath() const
+			{
+				return m_sPixelName;
+			}
+
+			//---------------------------------------------------------------------
+			const std::string& Shader::GetVertexPath() const
+			{
+				return m_sName;
+			}
+
+			//---------------------------------------------------------------------
+			bool Shader::LoadByPath(const fs::path& a_VertexShaderPath, const fs::path& a_PixelShaderPath)
+			{
+				m_Path = a_VertexShaderPath;
+				m_sName = a_VertexShaderPath.filename().generic_string();
+				m_sPixelName = a_PixelShaderPath.filename().generic_string();
+				m_ResourceType = core::ResourceType::ResourceType_Shader;
+
+				const core::ResourceAtlas& atlas = core::TOOL->GetResourceAtlas();
+				core::Data vertexShader, pixelShader;
+				if (!atlas.ReadFile(a_VertexShaderPath, vertexShader) || !atlas.ReadFile(a_PixelShaderPath, pixelShader))
+				{
+					LOGF(LOGSEVERITY_ERROR, LOG_CATEGORY_ENGINE, "Failed loading shader: \"%s\".", a_VertexShaderPath.generic_string().c_str());
+					return false;
+				}
+
+				m_bLoaded = true;
+
+				return true;
+			}
+		}
+	}
+}
\ No newline at end of file
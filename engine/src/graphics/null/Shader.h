@@ -0,0 +1,46 @@
+#pragma once
+
+#include "core/EngineResource.h"
+
+#include <string>
+
+#include "utils/file_abstractions.h"
+
+namespace gallus
+{
+	namespace graphics
+	{
+		namespace null
+		{
+			//---------------------------------------------------------------------
+			// Shader
+			//---------------------------------------------------------------------
+			/// <summary>
+			/// Shader of the null graphics backend. Keeps the names of the shader files so they can be serialized, nothing gets compiled.
+			/// </summary>
+			class Shader : public core::EngineResource
+			{
+			public:
+				/// <summary>
+				/// Returns whether the resource is a valid resource.
+				/// </summary>
+				/// <returns>True if the resource was valid, false otherwise.</returns>
+				bool IsValid() const override;
+
+				const std::string& GetPixelPath() const;
+				const std::string& GetVertexPath() const;
+
+				/// <summary>
+				/// Loads a shader from its vertex and pixel shader files.
+				/// </summary>
+				/// <param name="a_VertexShaderPath">Path to the vertex shader.</param>
+				/// <param name="a_PixelShaderPath">Path to the pixel shader.</param>
+				/// <returns>True if both files exist, otherwise false.</returns>
+				bool LoadByPath(const fs::path& a_VertexShaderPath, const fs::path& a_PixelShaderPath);
+			private:
+				std::string m_sPixelName;
+				bool m_bLoaded = false;
+			};
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,73 @@
+#include "graphics/null/Texture.h"
+
+#include "core/Tool.h"
+#include "logger/Logger.h"
+
+namespace gallus
+{
+	namespace graphics
+	{
+		namespace null
+		{
+			//---------------------------------------------------------------------
+			// Texture
+			//---------------------------------------------------------------------
+			bool Texture::LoadByPath(const fs::path& a_Path, std::shared_ptr<CommandList> /*a_pCommandList*/)
+			{
+				m_ResourceType = core::ResourceType::ResourceType_Texture;
+
+				if (!fs::exists(a_Path))
+				{
+					LOGF(LOGSEVERITY_ERROR, LOG_CATEGORY_ENGINE, "Failed to load texture: \"%s\".", a_Path.generic_string().c_str());
+					return false;
+				}
+
+				m_sName = a_Path.filename().generic_string();
+				m_Path = a_Path;
+				m_bLoaded = true;
+
+				return true;
+			}
+
+			//---------------------------------------------------------------------
+			bool Texture::LoadByName(const std::string& a_sName, std::shared_ptr<CommandList> /*a_pCommandList*/)
+			{
+				m_ResourceType = core::ResourceType::ResourceType_Texture;
+
+				const core::ResourceAtlas& atlas = core::TOOL->GetResourceAtlas();
+				const fs::path path = fs::path(atlas.GetResourceFolder() + "/textures/" + a_sName).lexically_normal();
+
+				// Archive entries are views, so this only checks that the texture exists.
+				core::Data file;
+				if (!atlas.ReadFile(path, file))
+				{
+					LOGF(LOGSEVERITY_ERROR, LOG_CATEGORY_ENGINE, "Failed to load texture: \"%s\".", path.generic_string().c_str());
+					return false;
+				}
+
+				m_sName = path.filename().generic_string();
+				m_Path = path;
+				m_bLoaded = true;
+
+				return true;
+			}
+
+			//---------------------------------------------------------------------
+			bool Texture::LoadFromData(const fs::path& a_Path, const TextureData&, std::shared_ptr<CommandList>)
+			{
+				m_ResourceType = core::ResourceType::ResourceType_Texture;
+				m_sName = a_Path.filename().generic_string();
+				m_Path = a_Path;
+				m_bLoaded = true;
+
+				return true;
+			}
+
+			//---------------------------------------------------------------------
+			bool Texture::IsValid() const
+			{
+				return m_bLoaded;
+			}
+		}
+	}
+}
\ No newline at end of file
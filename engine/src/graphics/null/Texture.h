@@ -0,0 +1,65 @@
+#pragma once
+
+#include "core/EngineResource.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "utils/file_abstractions.h"
+
+namespace gallus
+{
+	namespace graphics
+	{
+		struct TextureData;
+
+		namespace null
+		{
+			class CommandList;
+
+			//---------------------------------------------------------------------
+			// Texture
+			//---------------------------------------------------------------------
+			/// <summary>
+			/// Texture of the null graphics backend. Only remembers the file it was loaded from, the pixels are never read.
+			/// </summary>
+			class Texture : public core::EngineResource
+			{
+			public:
+				/// <summary>
+				/// Loads a texture from a file.
+				/// </summary>
+				/// <param name="a_Path">Path to the image file.</param>
+				/// <param name="a_pCommandList">Unused, there is nothing to upload.</param>
+				/// <returns>True if the file exists, otherwise false.</returns>
+				bool LoadByPath(const fs::path& a_Path, std::shared_ptr<CommandList> a_pCommandList);
+
+				/// <summary>
+				/// Loads a texture from the archive the resource atlas mounted, or the textures folder if the archive does not have it.
+				/// </summary>
+				/// <param name="a_sName">Name of the texture, relative to the textures folder.</param>
+				/// <param name="a_pCommandList">Unused, there is nothing to upload.</param>
+				/// <returns>True if the texture exists, otherwise false.</returns>
+				bool LoadByName(const std::string& a_sName, std::shared_ptr<CommandList> a_pCommandList);
+
+				/// <summary>
+				/// Creates the texture from decoded or cooked texture data.
+				/// </summary>
+				/// <param name="a_Path">The path the texture was read from.</param>
+				/// <param name="a_Texture">Unused, there is nothing to upload.</param>
+				/// <param name="a_pCommandList">Unused, there is nothing to upload.</param>
+				/// <returns>Always true.</returns>
+				bool LoadFromData(const fs::path& a_Path, const TextureData& a_Texture, std::shared_ptr<CommandList> a_pCommandList);
+
+				/// <summary>
+				/// Returns whether the resource is a valid resource.
+				/// </summary>
+				/// <returns>True if the resource was valid, false otherwise.</returns>
+				bool IsValid() const override;
+			private:
+				bool m_bLoaded = false;
+			};
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,90 @@
+#include "graphics/software/FrameBuffer.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "core/DataStream.h"
+
+namespace gallus
+{
+	namespace graphics
+	{
+		namespace software
+		{
+			//---------------------------------------------------------------------
+			// FrameBuffer
+			//---------------------------------------------------------------------
+			void FrameBuffer::Resize(const glm::ivec2& a_vSize)
+			{
+				m_vSize = glm::max(a_vSize, glm::ivec2(0, 0));
+				m_aPixels.resize(static_cast<size_t>(m_vSize.x) * m_vSize.y);
+			}
+
+			//---------------------------------------------------------------------
+			void FrameBuffer::Clear(uint32_t a_iColor)
+			{
+				std::fill(m_aPixels.begin(), m_aPixels.end(), a_iColor);
+			}
+
+			//---------------------------------------------------------------------
+			const glm::ivec2& FrameBuffer::GetSize() const
+			{
+				return m_vSize;
+			}
+
+			//---------------------------------------------------------------------
+			uint32_t* FrameBuffer::GetRow(int32_t a_iY)
+			{
+				return m_aPixels.data() + static_cast<size_t>(a_iY) * m_vSize.x;
+			}
+
+			//---------------------------------------------------------------------
+			const std::vector<uint32_t>& FrameBuffer::GetPixels() const
+			{
+				return m_aPixels;
+			}
+
+			//---------------------------------------------------------------------
+			bool FrameBuffer::SaveTGA(const fs::path& a_Path) const
+			{
+				// Uncompressed true color, 32 bits per pixel with 8 alpha bits, rows stored from the top.
+				const uint8_t header[18] = {
+					0, 0, 2,
+					0, 0, 0, 0, 0,
+					0, 0, 0, 0,
+					static_cast<uint8_t>(m_vSize.x & 0xFF), static_cast<uint8_t>(m_vSize.x >> 8),
+					static_cast<uint8_t>(m_vSize.y & 0xFF), static_cast<uint8_t>(m_vSize.y >> 8),
+					32, 0x28
+				};
+
+				core::DataStream data(sizeof(header) + m_aPixels.size() * sizeof(uint32_t));
+				data.Write(header, sizeof(header));
+
+				// Tga stores the channels as BGRA.
+				std::vector<uint32_t> row(m_vSize.x);
+				for (int32_t y = 0; y < m_vSize.y; y++)
+				{
+					const uint32_t* pixels = m_aPixels.data() + static_cast<size_t>(y) * m_vSize.x;
+					for (int32_t x = 0; x < m_vSize.x; x++)
+					{
+						const uint32_t pixel = pixels[x];
+						row[x] = (pixel & 0xFF00FF00) | ((pixel & 0xFF) << 16) | ((pixel >> 16) & 0xFF);
+					}
+					data.Write(row.data(), row.size() * sizeof(uint32_t));
+				}
+
+				return file::SaveFile(a_Path, data);
+			}
+
+			//---------------------------------------------------------------------
+			uint32_t FrameBuffer::PackColor(const glm::vec4& a_vColor)
+			{
+				const glm::vec4 color = glm::clamp(a_vColor, 0.0f, 1.0f) * 255.0f;
+				return static_cast<uint32_t>(std::lrint(color.r)) |
+					(static_cast<uint32_t>(std::lrint(color.g)) << 8) |
+					(static_cast<uint32_t>(std::lrint(color.b)) << 16) |
+					(static_cast<uint32_t>(std::lrint(color.a)) << 24);
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/vec2.hpp>
+#include <glm/common.hpp>
+#include <glm/vec4.hpp>
+
+#include "utils/file_abstractions.h"
+
+namespace gallus
+{
+	namespace graphics
+	{
+		namespace software
+		{
+			//---------------------------------------------------------------------
+			// FrameBuffer
+			//---------------------------------------------------------------------
+			/// <summary>
+			/// In-memory RGBA8 render target. Pixels are packed 32-bit values with red in the lowest byte, stored row by row from the top.
+			/// </summary>
+			class FrameBuffer
+			{
+			public:
+				/// <summary>
+				/// Resizes the frame buffer. The contents are undefined afterwards.
+				/// </summary>
+				/// <param name="a_vSize">Width and height in pixels.</param>
+				void Resize(const glm::ivec2& a_vSize);
+
+				/// <summary>
+				/// Fills all pixels with a color.
+				/// </summary>
+				/// <param name="a_iColor">The packed color.</param>
+				void Clear(uint32_t a_iColor);
+
+				/// <summary>
+				/// Retrieves the size of the frame buffer.
+				/// </summary>
+				/// <returns>Width and height in pixels.</returns>
+				const glm::ivec2& GetSize() const;
+
+				/// <summary>
+				/// Retrieves the first pixel of a row.
+				/// </summary>
+				/// <param name="a_iY">The row, from the top.</param>
+				/// <returns>Pointer to the pixels of the row.</returns>
+				uint32_t* GetRow(int32_t a_iY);
+
+				/// <summary>
+				/// Retrieves all pixels.
+				/// </summary>
+				/// <returns>The pixels.</returns>
+				const std::vector<uint32_t>& GetPixels() const;
+
+				/// <summary>
+				/// Saves the frame buffer as an uncompressed 32-bit tga file.
+				/// </summary>
+				/// <param name="a_Path">Path of the file.</param>
+				/// <returns>True if the file was written, otherwise false.</returns>
+				bool SaveTGA(const fs::path& a_Path) const;
+
+				/// <summary>
+				/// Packs a color with channels in [0, 1].
+				/// </summary>
+				/// <param name="a_vColor">The color.</param>
+				/// <returns>The packed color.</returns>
+				static uint32_t PackColor(const glm::vec4& a_vColor);
+			private:
+				std::vector<uint32_t> m_aPixels;
+				glm::ivec2 m_vSize = { 0, 0 };
+			};
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,385 @@
+#include "graphics/software/SoftwareRenderDevice.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <utility>
+
+#include <glm/common.hpp>
+
+#include "graphics/SpriteBatcher.h"
+#include "graphics/null/Mesh.h"
+#include "graphics/null/Texture.h"
+
+// The span fill is picked at compile time, like the batched math. MSVC does not define __SSE2__, but SSE2 is always available on x64.
+#if !defined(GALLUS_SOFTWARE_SCALAR) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define GALLUS_SOFTWARE_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace gallus
+{
+	namespace graphics
+	{
+		namespace software
+		{
+			namespace
+			{
+				// Vertices are snapped to 1/256th of a pixel like on gpus, so corners that sprites share end up at exactly the same position.
+				constexpr float SUBPIXEL_STEPS = 256.0f;
+
+				//---------------------------------------------------------------------
+				// Edge
+				//---------------------------------------------------------------------
+				// Edge function of a triangle edge from A to B, positive on the inside of a triangle with positive area.
+				struct Edge
+				{
+					float m_fX = 0.0f; /// X of the corner the edge is evaluated from.
+					float m_fY = 0.0f; /// Y of the corner the edge is evaluated from.
+					float m_fDX = 0.0f; /// X of the other corner minus m_fX.
+					float m_fDY = 0.0f; /// Y of the other corner minus m_fY.
+					float m_fSign = 1.0f; /// -1 if the edge is evaluated from B.
+					bool m_bOwnsTies = false; /// Whether pixels exactly on the edge belong to this triangle.
+
+					Edge(const glm::vec2& a_vFrom, const glm::vec2& a_vTo)
+					{
+						// The two triangles that share an edge walk it in opposite directions. Both evaluate it from the same corner,
+						// so they get exactly opposite values and a pixel can never be covered by both or by neither.
+						const bool reversed = a_vTo.x < a_vFrom.x || (a_vTo.x == a_vFrom.x && a_vTo.y < a_vFrom.y);
+						const glm::vec2& origin = reversed ? a_vTo : a_vFrom;
+						const glm::vec2& other = reversed ? a_vFrom : a_vTo;
+						m_fX = origin.x;
+						m_fY = origin.y;
+						m_fDX = other.x - origin.x;
+						m_fDY = other.y - origin.y;
+						m_fSign = reversed ? -1.0f : 1.0f;
+
+						// Pixels exactly on the edge go to one of the two triangles.
+						const float dx = a_vTo.x - a_vFrom.x;
+						const float dy = a_vTo.y - a_vFrom.y;
+						m_bOwnsTies = dy > 0.0f || (dy == 0.0f && dx < 0.0f);
+					}
+
+					float RowTerm(float a_fY) const
+					{
+						return m_fDX * (a_fY - m_fY);
+					}
+
+					float Evaluate(float a_fRowTerm, float a_fX) const
+					{
+						return m_fSign * (a_fRowTerm - m_fDY * (a_fX - m_fX));
+					}
+
+					bool IsInside(float a_fValue) const
+					{
+						return a_fValue > 0.0f || (a_fValue == 0.0f && m_bOwnsTies);
+					}
+				};
+
+				/// <summary>
+				/// Multiplies a texel with a color, the way the sprite pixel shader does.
+				/// </summary>
+				/// <param name="a_iTexel">The packed texel.</param>
+				/// <param name="a_vColor">The color.</param>
+				/// <returns>The packed result.</returns>
+				uint32_t Shade(uint32_t a_iTexel, const glm::vec4& a_vColor)
+				{
+					uint32_t result = 0;
+					for (uint32_t channel = 0; channel < 4; channel++)
+					{
+						const float value = static_cast<float>(static_cast<int32_t>((a_iTexel >> (channel * 8)) & 0xFF)) * a_vColor[channel];
+						result |= static_cast<uint32_t>(std::lrint(std::min(std::max(value, 0.0f), 255.0f))) << (channel * 8);
+					}
+					return result;
+				}
+
+#ifdef GALLUS_SOFTWARE_SSE2
+				/// <summary>
+				/// Multiplies four texels with a color, giving the same results as Shade.
+				/// </summary>
+				/// <param name="a_Texels">The packed texels.</param>
+				/// <param name="a_aColor">The color channels, each in all lanes.</param>
+				/// <returns>The packed results.</returns>
+				__m128i Shade4(__m128i a_Texels, const __m128 a_aColor[4])
+				{
+					const __m128i mask = _mm_set1_epi32(0xFF);
+					const __m128 zero = _mm_setzero_ps();
+					const __m128 max = _mm_set1_ps(255.0f);
+					const auto shadeChannel = [&](__m128i a_Channel, __m128 a_Color)
+						{
+							return _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_cvtepi32_ps(a_Channel), a_Color), zero), max));
+						};
+
+					const __m128i r = shadeChannel(_mm_and_si128(a_Texels, mask), a_aColor[0]);
+					const __m128i g = shadeChannel(_mm_and_si128(_mm_srli_epi32(a_Texels, 8), mask), a_aColor[1]);
+					const __m128i b = shadeChannel(_mm_and_si128(_mm_srli_epi32(a_Texels, 16), mask), a_aColor[2]);
+					const __m128i a = shadeChannel(_mm_srli_epi32(a_Texels, 24), a_aColor[3]);
+
+					return _mm_or_si128(_mm_or_si128(r, _mm_slli_epi32(g, 8)), _mm_or_si128(_mm_slli_epi32(b, 16), _mm_slli_epi32(a, 24)));
+				}
+
+				/// <summary>
+				/// Tests four edge function values against an edge, following its tie rule.
+				/// </summary>
+				/// <param name="a_Values">The edge function values.</param>
+				/// <param name="a_Edge">The edge.</param>
+				/// <returns>All bits set in the lanes that are inside.</returns>
+				__m128 IsInside4(__m128 a_Values, const Edge& a_Edge)
+				{
+					return a_Edge.m_bOwnsTies ? _mm_cmpge_ps(a_Values, _mm_setzero_ps()) : _mm_cmpgt_ps(a_Values, _mm_setzero_ps());
+				}
+#endif // GALLUS_SOFTWARE_SSE2
+			}
+
+			//---------------------------------------------------------------------
+			// SoftwareRenderDevice
+			//---------------------------------------------------------------------
+			void SoftwareRenderDevice::Resize(const glm::ivec2& a_vSize)
+			{
+				m_FrameBuffer.Resize(a_vSize);
+			}
+
+			//---------------------------------------------------------------------
+			void SoftwareRenderDevice::Clear(const glm::vec4& a_vColor)
+			{
+				m_FrameBuffer.Clear(FrameBuffer::PackColor(a_vColor));
+			}
+
+			//---------------------------------------------------------------------
+			void SoftwareRenderDevice::SetViewProjection(const glm::mat4& a_ViewProjection)
+			{
+				m_ViewProjection = a_ViewProjection;
+			}
+
+			//---------------------------------------------------------------------
+			bool SoftwareRenderDevice::SetInstances(const std::vector<SpriteInstance>& a_aInstances)
+			{
+				m_pInstances = &a_aInstances;
+				return true;
+			}
+
+			//---------------------------------------------------------------------
+			void SoftwareRenderDevice::BindShader(backend::Shader* /*a_pShader*/)
+			{}
+
+			//---------------------------------------------------------------------
+			void SoftwareRenderDevice::BindTexture(backend::Texture* a_pTexture)
+			{
+				m_pTexture = nullptr;
+				if (!a_pTexture || !a_pTexture->IsValid())
+				{
+					return;
+				}
+
+				const std::string key = a_pTexture->GetPath().generic_string();
+				auto it = m_aTextures.find(key);
+				if (it == m_aTextures.end())
+				{
+					// Textures that fail to decode stay in the map empty, so they are only tried once.
+					it = m_aTextures.emplace(key, SoftwareTexture()).first;
+					it->second.LoadByPath(a_pTexture->GetPath());
+				}
+
+				if (it->second.IsValid())
+				{
+					m_pTexture = &it->second;
+				}
+			}
+
+			//---------------------------------------------------------------------
+			void SoftwareRenderDevice::DrawInstanced(backend::Mesh* a_pMesh, uint32_t a_iFirstInstance, uint32_t a_iInstanceCount)
+			{
+				if (!m_pInstances || !a_pMesh)
+				{
+					return;
+				}
+
+				const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+				const std::vector<null::VertexPosUV>& vertices = a_pMesh->GetVertices();
+				const std::vector<uint16_t>& indices = a_pMesh->GetIndices();
+				const glm::vec2 size = glm::vec2(m_FrameBuffer.GetSize());
+
+				m_aPositions.resize(vertices.size());
+				m_aUVs.resize(vertices.size());
+
+				const size_t end = std::min(static_cast<size_t>(a_iFirstInstance) + a_iInstanceCount, m_pInstances->size());
+				for (size_t i = a_iFirstInstance; i < end; i++)
+				{
+					const SpriteInstance& instance = (*m_pInstances)[i];
+
+					// Same transform as the sprite vertex shader, followed by the viewport transform.
+					for (size_t vertex = 0; vertex < vertices.size(); vertex++)
+					{
+						const math::Vector2 world = instance.m_WorldMatrix.TransformPoint({ vertices[vertex].Position.x, vertices[vertex].Position.y });
+						const glm::vec4 clip = m_ViewProjection * glm::vec4(world.x, world.y, 0.0f, 1.0f);
+						const glm::vec2 position = glm::vec2((clip.x / clip.w + 1.0f) * 0.5f * size.x, (1.0f - clip.y / clip.w) * 0.5f * size.y);
+						m_aPositions[vertex] = glm::round(position * SUBPIXEL_STEPS) / SUBPIXEL_STEPS;
+						m_aUVs[vertex] = glm::vec2(instance.m_vUVRect.x, instance.m_vUVRect.y) + vertices[vertex].UV * glm::vec2(instance.m_vUVRect.z, instance.m_vUVRect.w);
+					}
+
+					for (size_t index = 0; index + 2 < indices.size(); index += 3)
+					{
+						const glm::vec2 positions[3] = { m_aPositions[indices[index]], m_aPositions[indices[index + 1]], m_aPositions[indices[index + 2]] };
+						const glm::vec2 uvs[3] = { m_aUVs[indices[index]], m_aUVs[indices[index + 1]], m_aUVs[indices[index + 2]] };
+						RasterizeTriangle(positions, uvs, instance.m_vColor);
+					}
+				}
+
+				m_Stats.m_fRasterTime += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+			}
+
+			//---------------------------------------------------------------------
+			void SoftwareRenderDevice::RasterizeTriangle(const glm::vec2 a_aPositions[3], const glm::vec2 a_aUVs[3], const glm::vec4& a_vColor)
+			{
+				glm::vec2 p0 = a_aPositions[0], p1 = a_aPositions[1], p2 = a_aPositions[2];
+				glm::vec2 uv0 = a_aUVs[0], uv1 = a_aUVs[1], uv2 = a_aUVs[2];
+
+				float area = (p1.x - p0.x) * (p2.y - p0.y) - (p1.y - p0.y) * (p2.x - p0.x);
+				if (!std::isfinite(area) || area == 0.0f)
+				{
+					return;
+				}
+
+				// Culling is off in the sprite pipeline, so triangles of both windings get turned into positive ones.
+				if (area < 0.0f)
+				{
+					std::swap(p1, p2);
+					std::swap(uv1, uv2);
+					area = -area;
+				}
+
+				const glm::ivec2& size = m_FrameBuffer.GetSize();
+				const int32_t minX = std::max(0, static_cast<int32_t>(std::floor(std::min({ p0.x, p1.x, p2.x }))));
+				const int32_t minY = std::max(0, static_cast<int32_t>(std::floor(std::min({ p0.y, p1.y, p2.y }))));
+				const int32_t maxX = std::min(size.x - 1, static_cast<int32_t>(std::ceil(std::max({ p0.x, p1.x, p2.x }))));
+				const int32_t maxY = std::min(size.y - 1, static_cast<int32_t>(std::ceil(std::max({ p0.y, p1.y, p2.y }))));
+				if (minX > maxX || minY > maxY)
+				{
+					return;
+				}
+
+				m_Stats.m_iTriangleCount++;
+
+				// Edge k is opposite of corner k, so its value divided by the area is the barycentric weight of corner k.
+				const Edge edges[3] = { Edge(p1, p2), Edge(p2, p0), Edge(p0, p1) };
+				const float inverseArea = 1.0f / area;
+				const glm::vec2 uvDelta1 = uv1 - uv0;
+				const glm::vec2 uvDelta2 = uv2 - uv0;
+
+#ifdef GALLUS_SOFTWARE_SSE2
+				const __m128 colorLanes[4] = { _mm_set1_ps(a_vColor.r), _mm_set1_ps(a_vColor.g), _mm_set1_ps(a_vColor.b), _mm_set1_ps(a_vColor.a) };
+				const __m128i laneOffsets = _mm_setr_epi32(0, 1, 2, 3);
+				const __m128 half = _mm_set1_ps(0.5f);
+				const __m128 edgeX[3] = { _mm_set1_ps(edges[0].m_fX), _mm_set1_ps(edges[1].m_fX), _mm_set1_ps(edges[2].m_fX) };
+				const __m128 edgeDY[3] = { _mm_set1_ps(edges[0].m_fDY), _mm_set1_ps(edges[1].m_fDY), _mm_set1_ps(edges[2].m_fDY) };
+				const __m128 edgeSign[3] = { _mm_set1_ps(edges[0].m_fSign), _mm_set1_ps(edges[1].m_fSign), _mm_set1_ps(edges[2].m_fSign) };
+				const __m128 inverseAreaLanes = _mm_set1_ps(inverseArea);
+				const __m128 u0 = _mm_set1_ps(uv0.x), v0 = _mm_set1_ps(uv0.y);
+				const __m128 du1 = _mm_set1_ps(uvDelta1.x), dv1 = _mm_set1_ps(uvDelta1.y);
+				const __m128 du2 = _mm_set1_ps(uvDelta2.x), dv2 = _mm_set1_ps(uvDelta2.y);
+#endif // GALLUS_SOFTWARE_SSE2
+
+				for (int32_t y = minY; y <= maxY; y++)
+				{
+					uint32_t* row = m_FrameBuffer.GetRow(y);
+					const float pixelY = static_cast<float>(y) + 0.5f;
+					const float rowTerms[3] = { edges[0].RowTerm(pixelY), edges[1].RowTerm(pixelY), edges[2].RowTerm(pixelY) };
+
+					int32_t x = minX;
+#ifdef GALLUS_SOFTWARE_SSE2
+					if (m_bSimdEnabled)
+					{
+						const __m128 rowTermLanes[3] = { _mm_set1_ps(rowTerms[0]), _mm_set1_ps(rowTerms[1]), _mm_set1_ps(rowTerms[2]) };
+						for (; x + 3 <= maxX; x += 4)
+						{
+							const __m128 pixelX = _mm_add_ps(_mm_cvtepi32_ps(_mm_add_epi32(_mm_set1_epi32(x), laneOffsets)), half);
+							const __m128 w0 = _mm_mul_ps(edgeSign[0], _mm_sub_ps(rowTermLanes[0], _mm_mul_ps(edgeDY[0], _mm_sub_ps(pixelX, edgeX[0]))));
+							const __m128 w1 = _mm_mul_ps(edgeSign[1], _mm_sub_ps(rowTermLanes[1], _mm_mul_ps(edgeDY[1], _mm_sub_ps(pixelX, edgeX[1]))));
+							const __m128 w2 = _mm_mul_ps(edgeSign[2], _mm_sub_ps(rowTermLanes[2], _mm_mul_ps(edgeDY[2], _mm_sub_ps(pixelX, edgeX[2]))));
+
+							const __m128 inside = _mm_and_ps(_mm_and_ps(IsInside4(w0, edges[0]), IsInside4(w1, edges[1])), IsInside4(w2, edges[2]));
+							const int coverage = _mm_movemask_ps(inside);
+							if (coverage == 0)
+							{
+								continue;
+							}
+
+							const __m128 weight1 = _mm_mul_ps(w1, inverseAreaLanes);
+							const __m128 weight2 = _mm_mul_ps(w2, inverseAreaLanes);
+							alignas(16) float u[4];
+							alignas(16) float v[4];
+							_mm_store_ps(u, _mm_add_ps(_mm_add_ps(u0, _mm_mul_ps(du1, weight1)), _mm_mul_ps(du2, weight2)));
+							_mm_store_ps(v, _mm_add_ps(_mm_add_ps(v0, _mm_mul_ps(dv1, weight1)), _mm_mul_ps(dv2, weight2)));
+
+							// Texels are fetched one by one, sse2 has no gather.
+							alignas(16) uint32_t texels[4] = {};
+							for (int lane = 0; lane < 4; lane++)
+							{
+								if (coverage & (1 << lane))
+								{
+									texels[lane] = m_pTexture ? m_pTexture->Sample(u[lane], v[lane]) : 0xFFFFFFFF;
+									m_Stats.m_iPixelCount++;
+								}
+							}
+
+							const __m128i shaded = Shade4(_mm_load_si128(reinterpret_cast<const __m128i*>(texels)), colorLanes);
+							const __m128i mask = _mm_castps_si128(inside);
+							const __m128i previous = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + x));
+							_mm_storeu_si128(reinterpret_cast<__m128i*>(row + x), _mm_or_si128(_mm_and_si128(mask, shaded), _mm_andnot_si128(mask, previous)));
+						}
+					}
+#endif // GALLUS_SOFTWARE_SSE2
+
+					for (; x <= maxX; x++)
+					{
+						const float pixelX = static_cast<float>(x) + 0.5f;
+						const float w0 = edges[0].Evaluate(rowTerms[0], pixelX);
+						const float w1 = edges[1].Evaluate(rowTerms[1], pixelX);
+						const float w2 = edges[2].Evaluate(rowTerms[2], pixelX);
+						if (!edges[0].IsInside(w0) || !edges[1].IsInside(w1) || !edges[2].IsInside(w2))
+						{
+							continue;
+						}
+
+						const float weight1 = w1 * inverseArea;
+						const float weight2 = w2 * inverseArea;
+						const float u = uv0.x + uvDelta1.x * weight1 + uvDelta2.x * weight2;
+						const float v = uv0.y + uvDelta1.y * weight1 + uvDelta2.y * weight2;
+
+						row[x] = Shade(m_pTexture ? m_pTexture->Sample(u, v) : 0xFFFFFFFF, a_vColor);
+						m_Stats.m_iPixelCount++;
+					}
+				}
+			}
+
+			//---------------------------------------------------------------------
+			void SoftwareRenderDevice::SetSimdEnabled(bool a_bEnabled)
+			{
+				m_bSimdEnabled = a_bEnabled;
+			}
+
+			//---------------------------------------------------------------------
+			const char* SoftwareRenderDevice::GetFillInstructionSet() const
+			{
+#ifdef GALLUS_SOFTWARE_SSE2
+				return m_bSimdEnabled ? "SSE2" : "Scalar";
+#else
+				return "Scalar";
+#endif // GALLUS_SOFTWARE_SSE2
+			}
+
+			//---------------------------------------------------------------------
+			const FrameBuffer& SoftwareRenderDevice::GetFrameBuffer() const
+			{
+				return m_FrameBuffer;
+			}
+
+			//---------------------------------------------------------------------
+			const SoftwareRenderStats& SoftwareRenderDevice::GetStats() const
+			{
+				return m_Stats;
+			}
+		}
+	}
+}
\ No newline at end of file
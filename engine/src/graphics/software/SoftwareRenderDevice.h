@@ -0,0 +1,133 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/vec2.hpp>
+
+#include "graphics/RenderDevice.h"
+#include "graphics/software/FrameBuffer.h"
+#include "graphics/software/SoftwareTexture.h"
+
+namespace gallus
+{
+	namespace graphics
+	{
+		namespace software
+		{
+			//---------------------------------------------------------------------
+			// SoftwareRenderStats
+			//---------------------------------------------------------------------
+			/// <summary>
+			/// Counters of the software render device, accumulated since it was created.
+			/// </summary>
+			struct SoftwareRenderStats
+			{
+				uint64_t m_iTriangleCount = 0; /// Number of triangles that were rasterized.
+				uint64_t m_iPixelCount = 0; /// Number of pixels that were written.
+				double m_fRasterTime = 0.0; /// Seconds spent rasterizing.
+			};
+
+			//---------------------------------------------------------------------
+			// SoftwareRenderDevice
+			//---------------------------------------------------------------------
+			/// <summary>
+			/// Render device that rasterizes the meshes on the cpu into an in-memory RGBA8 frame buffer. It emulates the sprite shader:
+			/// textures are point sampled with wrapping and multiplied with the instance color, without blending, like the dx12 pipeline.
+			/// Spans are filled four pixels at a time with SSE2 where available, which gives the same pixels as the scalar fill.
+			/// </summary>
+			class SoftwareRenderDevice : public RenderDevice
+			{
+			public:
+				/// <summary>
+				/// Resizes the frame buffer.
+				/// </summary>
+				/// <param name="a_vSize">Width and height in pixels.</param>
+				void Resize(const glm::ivec2& a_vSize);
+
+				/// <summary>
+				/// Clears the frame buffer.
+				/// </summary>
+				/// <param name="a_vColor">The clear color.</param>
+				void Clear(const glm::vec4& a_vColor) override;
+
+				/// <summary>
+				/// Sets the matrix that maps world positions to clip space, for the draws that follow.
+				/// </summary>
+				/// <param name="a_ViewProjection">The view projection matrix, for column vectors.</param>
+				void SetViewProjection(const glm::mat4& a_ViewProjection) override;
+
+				/// <summary>
+				/// Sets the instance data the draws that follow index into.
+				/// </summary>
+				/// <param name="a_aInstances">The instances. Has to stay alive until the last draw that uses it.</param>
+				/// <returns>Always true.</returns>
+				bool SetInstances(const std::vector<SpriteInstance>& a_aInstances) override;
+
+				/// <summary>
+				/// Does nothing, every draw runs the emulated sprite shader.
+				/// </summary>
+				/// <param name="a_pShader">The shader.</param>
+				void BindShader(backend::Shader* a_pShader) override;
+
+				/// <summary>
+				/// Binds a texture, decoding its file the first time it gets bound. Textures that cannot be decoded sample as white.
+				/// </summary>
+				/// <param name="a_pTexture">The texture.</param>
+				void BindTexture(backend::Texture* a_pTexture) override;
+
+				/// <summary>
+				/// Rasterizes the triangles of a mesh for a range of the instances.
+				/// </summary>
+				/// <param name="a_pMesh">The mesh.</param>
+				/// <param name="a_iFirstInstance">Index of the first instance.</param>
+				/// <param name="a_iInstanceCount">The number of instances.</param>
+				void DrawInstanced(backend::Mesh* a_pMesh, uint32_t a_iFirstInstance, uint32_t a_iInstanceCount) override;
+
+				/// <summary>
+				/// Enables or disables the SIMD span fill. Has no effect if the build has no SIMD fill.
+				/// </summary>
+				/// <param name="a_bEnabled">Whether the SIMD fill should be used.</param>
+				void SetSimdEnabled(bool a_bEnabled);
+
+				/// <summary>
+				/// Retrieves the instruction set spans are filled with.
+				/// </summary>
+				/// <returns>Name of the instruction set.</returns>
+				const char* GetFillInstructionSet() const;
+
+				/// <summary>
+				/// Retrieves the frame buffer.
+				/// </summary>
+				/// <returns>The frame buffer.</returns>
+				const FrameBuffer& GetFrameBuffer() const;
+
+				/// <summary>
+				/// Retrieves the counters of the device.
+				/// </summary>
+				/// <returns>The counters.</returns>
+				const SoftwareRenderStats& GetStats() const;
+			private:
+				/// <summary>
+				/// Rasterizes a single triangle in screen space, with either winding order.
+				/// </summary>
+				/// <param name="a_aPositions">Screen positions of the corners, in pixels.</param>
+				/// <param name="a_aUVs">Texture coordinates of the corners.</param>
+				/// <param name="a_vColor">The color the texture gets multiplied with.</param>
+				void RasterizeTriangle(const glm::vec2 a_aPositions[3], const glm::vec2 a_aUVs[3], const glm::vec4& a_vColor);
+
+				FrameBuffer m_FrameBuffer;
+				glm::mat4 m_ViewProjection = glm::mat4(1.0f);
+				const std::vector<SpriteInstance>* m_pInstances = nullptr;
+				const SoftwareTexture* m_pTexture = nullptr; /// Bound texture, nullptr samples as white.
+				std::unordered_map<std::string, SoftwareTexture> m_aTextures; /// Decoded textures by path.
+				std::vector<glm::vec2> m_aPositions; /// Screen positions of the vertices of the instance that is being drawn.
+				std::vector<glm::vec2> m_aUVs; /// Texture coordinates of the vertices of the instance that is being drawn.
+				SoftwareRenderStats m_Stats;
+				bool m_bSimdEnabled = true;
+			};
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,78 @@
+#include "graphics/software/SoftwareTexture.h"
+
+#include <cmath>
+
+#include "core/Tool.h"
+#include "graphics/TextureData.h"
+#include "logger/Logger.h"
+
+namespace gallus
+{
+	namespace graphics
+	{
+		namespace software
+		{
+			namespace
+			{
+				constexpr float MAX_TEXEL_COORDINATE = 2147483648.0f; /// 2^31, the first float that does not fit in an int32_t.
+			}
+
+			//---------------------------------------------------------------------
+			// SoftwareTexture
+			//---------------------------------------------------------------------
+			bool SoftwareTexture::LoadByPath(const fs::path& a_Path)
+			{
+				// Read through the atlas, so textures inside a mounted archive decode straight from the mapping. Only the largest mip
+				// of a cooked texture is sampled, block compressed ones are decoded here once.
+				core::Data file;
+				if (!core::TOOL->GetResourceAtlas().ReadFile(a_Path, file) || !Load(file))
+				{
+					LOGF(LOGSEVERITY_ERROR, LOG_CATEGORY_ENGINE, "Failed to decode texture: \"%s\".", a_Path.generic_string().c_str());
+					return false;
+				}
+
+				return true;
+			}
+
+			//---------------------------------------------------------------------
+			bool SoftwareTexture::Load(const core::Data& a_File)
+			{
+				TextureData texture;
+				if (!ReadTextureFile(a_File, texture) || !DecodeTextureMip(texture, 0, m_aPixels))
+				{
+					return false;
+				}
+
+				m_iWidth = static_cast<int32_t>(texture.m_iWidth);
+				m_iHeight = static_cast<int32_t>(texture.m_iHeight);
+
+				return true;
+			}
+
+			//---------------------------------------------------------------------
+			uint32_t SoftwareTexture::Sample(float a_fU, float a_fV) const
+			{
+				if (m_aPixels.empty())
+				{
+					return 0xFFFFFFFF;
+				}
+
+				// Converting a value outside of the int range is undefined, NaN fails the range check as well.
+				const float texelX = std::floor(a_fU * m_iWidth);
+				const float texelY = std::floor(a_fV * m_iHeight);
+				int32_t x = std::abs(texelX) < MAX_TEXEL_COORDINATE ? static_cast<int32_t>(texelX) % m_iWidth : 0;
+				int32_t y = std::abs(texelY) < MAX_TEXEL_COORDINATE ? static_cast<int32_t>(texelY) % m_iHeight : 0;
+				x += (x < 0) ? m_iWidth : 0;
+				y += (y < 0) ? m_iHeight : 0;
+
+				return m_aPixels[static_cast<size_t>(y) * m_iWidth + x];
+			}
+
+			//---------------------------------------------------------------------
+			bool SoftwareTexture::IsValid() const
+			{
+				return !m_aPixels.empty();
+			}
+		}
+	}
+}
\ No newline at end of file
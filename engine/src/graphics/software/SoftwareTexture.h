@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "core/Data.h"
+#include "utils/file_abstractions.h"
+
+namespace gallus
+{
+	namespace graphics
+	{
+		namespace software
+		{
+			//---------------------------------------------------------------------
+			// SoftwareTexture
+			//---------------------------------------------------------------------
+			/// <summary>
+			/// Decoded RGBA8 image the software render device samples from. Pixels are stored as packed 32-bit values
+			/// with red in the lowest byte, the same as the frame buffer.
+			/// </summary>
+			class SoftwareTexture
+			{
+			public:
+				/// <summary>
+				/// Loads and decodes an image file or a cooked texture.
+				/// </summary>
+				/// <param name="a_Path">Path to the image file.</param>
+				/// <returns>True if the image was decoded, otherwise false.</returns>
+				bool LoadByPath(const fs::path& a_Path);
+
+				/// <summary>
+				/// Decodes an image file or a cooked texture that is already in memory.
+				/// </summary>
+				/// <param name="a_File">Contents of the file.</param>
+				/// <returns>True if the image was decoded, otherwise false.</returns>
+				bool Load(const core::Data& a_File);
+
+				/// <summary>
+				/// Samples the nearest texel, wrapping coordinates outside of [0, 1). Matches the point sampler of the sprite shader.
+				/// </summary>
+				/// <param name="a_fU">Horizontal texture coordinate.</param>
+				/// <param name="a_fV">Vertical texture coordinate.</param>
+				/// <returns>The packed texel, or opaque white if the texture is empty. Coordinates that are not finite or too large to
+				/// wrap sample the first texel.</returns>
+				uint32_t Sample(float a_fU, float a_fV) const;
+
+				/// <summary>
+				/// Returns whether the texture has pixels.
+				/// </summary>
+				/// <returns>True if the texture was loaded, otherwise false.</returns>
+				bool IsValid() const;
+			private:
+				std::vector<uint32_t> m_aPixels;
+				int32_t m_iWidth = 0;
+				int32_t m_iHeight = 0;
+			};
+		}
+	}
+}
\ No newline at end of file
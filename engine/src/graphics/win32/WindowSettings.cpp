@@ -1,6 +1,7 @@
 #include "WindowSettings.h"
 
 // # Rapidjson
+#include "utils/rapidjson_config.h"
 #include <rapidjson/document.h>
 #include <rapidjson/stringbuffer.h>
 #include <rapidjson/prettywriter.h>
@@ -4,8 +4,9 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <time.h>
-#include <format>
+#ifdef _WIN32
 #include <windows.h>
+#endif // _WIN32
 #include <iostream>
 
 #define CATEGORY_LOGGER "LOGGER"
@@ -70,8 +71,8 @@ namespace gallus
 		//---------------------------------------------------------------------
 		bool Logger::InitThreadWorker()
 		{
-			// Terminal/Console initialization for debug builds.
-#ifdef _DEBUG
+			// Terminal/Console initialization for debug builds. Other platforms log to the terminal the program was started from.
+#if defined(_DEBUG) && defined(_WIN32)
 			AllocConsole();
 			freopen_s(&s_pConsole, "CONOUT$", "w", stdout);
 
@@ -89,17 +90,25 @@ namespace gallus
 			// Optionally adjust console window size
 			const HWND consoleWindow = GetConsoleWindow();
 			MoveWindow(consoleWindow, 100, 100, 800, 600, TRUE);
-#endif // _DEBUG
+#endif // _DEBUG && _WIN32
 
 			time_t time_t = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
 			struct tm buf;
 
+#ifdef _WIN32
 			localtime_s(&buf, &time_t);
+#else
+			localtime_r(&time_t, &buf);
+#endif // _WIN32
 
 			std::string logFilename(50, '\0');
 			std::strftime(&logFilename[0], logFilename.size(), "./log-%Y-%m-%d %H-%M-%S.log", &buf);  // Changed colon to dash
 
+#ifdef _WIN32
 			fopen_s(&s_pLogFile, logFilename.c_str(), "wb");
+#else
+			s_pLogFile = fopen(logFilename.c_str(), "wb");
+#endif // _WIN32
 			if (!s_pLogFile)
 			{
 				LOG(LOGSEVERITY_SUCCESS, CATEGORY_LOGGER, "Failed initializing logger: Could not create log file.");
@@ -116,13 +125,16 @@ namespace gallus
 		//---------------------------------------------------------------------
 		void Logger::Finalize()
 		{
-#ifdef _DEBUG
+			// Messages that were queued after the thread was told to stop still need to be written.
+			Loop();
+
+#if defined(_DEBUG) && defined(_WIN32)
 			if (s_pConsole)
 			{
 				fclose(s_pConsole);
 				s_pConsole = nullptr;
 			}
-#endif // _DEBUG
+#endif // _DEBUG && _WIN32
 			if (s_pLogFile)
 			{
 				fclose(s_pLogFile);
@@ -189,7 +201,7 @@ namespace gallus
 					fileName + "\" on line " + std::to_string(lm.GetLine()) + "\n\n";
 
 				// Print the message to the console.
-				printf(message.c_str());
+				printf("%s", message.c_str());
 				fflush(stdout);
 
 				// Format the message.
@@ -200,7 +212,7 @@ namespace gallus
 
 				if (s_pLogFile)
 				{
-					fprintf(s_pLogFile, message.c_str());
+					fprintf(s_pLogFile, "%s", message.c_str());
 				}
 
 				m_eOnMessageLogged(lm);
@@ -226,9 +238,15 @@ namespace gallus
 			va_list va_format_list;
 			va_start(va_format_list, a_iLine);
 
-			const size_t buffersize = vsnprintf(NULL, 0, a_sMessage, va_format_list) + 1;
+			// The list gets consumed by measuring the message, so the measuring is done on a copy.
+			va_list va_size_list;
+			va_copy(va_size_list, va_format_list);
+			const size_t buffersize = vsnprintf(NULL, 0, a_sMessage, va_size_list) + 1;
+			va_end(va_size_list);
+
 			char* formatted_message = (char*) malloc(buffersize);
 			vsnprintf(formatted_message, buffersize, a_sMessage, va_format_list);
+			va_end(va_format_list);
 
 			PrintMessage(a_Severity, a_sCategory, formatted_message, a_sFile, a_iLine);
 
@@ -240,9 +258,12 @@ namespace gallus
 		{
 			const std::string fileName = a_sFile;
 
-			std::scoped_lock lock(m_MessagesMutex);
-			m_Messages.push(LoggerMessage(a_sMessage, a_sCategory, fileName, a_iLine, a_Severity, std::chrono::system_clock::now()));
+			{
+				std::scoped_lock lock(m_MessagesMutex);
+				m_Messages.push(LoggerMessage(a_sMessage, a_sCategory, fileName, a_iLine, a_Severity, std::chrono::system_clock::now()));
+			}
 
+			// Woken up outside of the message lock, the logger thread takes both locks in the opposite order.
 			WakeUp();
 		}
 
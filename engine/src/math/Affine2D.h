@@ -0,0 +1,275 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+namespace gallus
+{
+	namespace math
+	{
+		constexpr float PI = 3.14159265358979323846f;
+
+		/// <summary>
+		/// Converts degrees to radians.
+		/// </summary>
+		/// <param name="a_fDegrees">The angle in degrees.</param>
+		/// <returns>The angle in radians.</returns>
+		constexpr float ToRadians(float a_fDegrees)
+		{
+			return a_fDegrees * (PI / 180.0f);
+		}
+
+		//---------------------------------------------------------------------
+		// Vector2
+		//---------------------------------------------------------------------
+		struct Vector2
+		{
+			float x = 0.0f;
+			float y = 0.0f;
+		};
+
+		//---------------------------------------------------------------------
+		// AABB2D
+		//---------------------------------------------------------------------
+		/// <summary>
+		/// Axis aligned bounding box.
+		/// </summary>
+		struct AABB2D
+		{
+			Vector2 m_vMin;
+			Vector2 m_vMax;
+		};
+
+		//---------------------------------------------------------------------
+		// Affine2D
+		//---------------------------------------------------------------------
+		/// <summary>
+		/// 2D affine transform stored as a 3x2 matrix. Points are row vectors, like in DirectXMath:
+		/// x' = x * a + y * c + tx and y' = x * b + y * d + ty.
+		/// Multiplying A * B gives the transform that applies A first and B second.
+		/// </summary>
+		struct Affine2D
+		{
+			float a = 1.0f;
+			float b = 0.0f;
+			float c = 0.0f;
+			float d = 1.0f;
+			float tx = 0.0f;
+			float ty = 0.0f;
+
+			/// <summary>
+			/// Creates a translation.
+			/// </summary>
+			/// <param name="a_vTranslation">The translation.</param>
+			/// <returns>The translation matrix.</returns>
+			static Affine2D Translation(const Vector2& a_vTranslation)
+			{
+				return { 1.0f, 0.0f, 0.0f, 1.0f, a_vTranslation.x, a_vTranslation.y };
+			}
+
+			/// <summary>
+			/// Creates a scale.
+			/// </summary>
+			/// <param name="a_vScale">The scale.</param>
+			/// <returns>The scale matrix.</returns>
+			static Affine2D Scaling(const Vector2& a_vScale)
+			{
+				return { a_vScale.x, 0.0f, 0.0f, a_vScale.y, 0.0f, 0.0f };
+			}
+
+			/// <summary>
+			/// Creates a rotation, counter clockwise in a y-up coordinate system.
+			/// </summary>
+			/// <param name="a_fRadians">The angle in radians.</param>
+			/// <returns>The rotation matrix.</returns>
+			static Affine2D Rotation(float a_fRadians)
+			{
+				const float cosine = std::cos(a_fRadians);
+				const float sine = std::sin(a_fRadians);
+				return { cosine, sine, -sine, cosine, 0.0f, 0.0f };
+			}
+
+			/// <summary>
+			/// Creates the matrix of a position, rotation and scale, where rotation and scale are applied around an origin.
+			/// Equal to Translation(-origin) * Rotation * Scaling * Translation(position) * Translation(origin).
+			/// </summary>
+			/// <param name="a_vPosition">The position.</param>
+			/// <param name="a_fRotationDegrees">The rotation in degrees.</param>
+			/// <param name="a_vScale">The scale.</param>
+			/// <param name="a_vOrigin">The origin that rotation and scale are applied around.</param>
+			/// <returns>The transform matrix.</returns>
+			static Affine2D FromTransform(const Vector2& a_vPosition, float a_fRotationDegrees, const Vector2& a_vScale, const Vector2& a_vOrigin = {})
+			{
+				const float radians = ToRadians(a_fRotationDegrees);
+				const float cosine = std::cos(radians);
+				const float sine = std::sin(radians);
+
+				Affine2D matrix;
+				matrix.a = cosine * a_vScale.x;
+				matrix.b = sine * a_vScale.y;
+				matrix.c = -sine * a_vScale.x;
+				matrix.d = cosine * a_vScale.y;
+				matrix.tx = a_vPosition.x + a_vOrigin.x - (a_vOrigin.x * matrix.a + a_vOrigin.y * matrix.c);
+				matrix.ty = a_vPosition.y + a_vOrigin.y - (a_vOrigin.x * matrix.b + a_vOrigin.y * matrix.d);
+				return matrix;
+			}
+
+			/// <summary>
+			/// Transforms a point.
+			/// </summary>
+			/// <param name="a_vPoint">The point.</param>
+			/// <returns>The transformed point.</returns>
+			Vector2 TransformPoint(const Vector2& a_vPoint) const
+			{
+				return { a_vPoint.x * a + a_vPoint.y * c + tx, a_vPoint.x * b + a_vPoint.y * d + ty };
+			}
+
+			/// <summary>
+			/// Transforms a direction, ignoring the translation.
+			/// </summary>
+			/// <param name="a_vVector">The direction.</param>
+			/// <returns>The transformed direction.</returns>
+			Vector2 TransformVector(const Vector2& a_vVector) const
+			{
+				return { a_vVector.x * a + a_vVector.y * c, a_vVector.x * b + a_vVector.y * d };
+			}
+
+			/// <summary>
+			/// Transforms a bounding box, returning the bounding box of the transformed corners.
+			/// </summary>
+			/// <param name="a_Box">The bounding box.</param>
+			/// <returns>The transformed bounding box.</returns>
+			AABB2D TransformAABB(const AABB2D& a_Box) const
+			{
+				const Vector2 center = TransformPoint({ (a_Box.m_vMin.x + a_Box.m_vMax.x) * 0.5f, (a_Box.m_vMin.y + a_Box.m_vMax.y) * 0.5f });
+				const float extentX = (a_Box.m_vMax.x - a_Box.m_vMin.x) * 0.5f;
+				const float extentY = (a_Box.m_vMax.y - a_Box.m_vMin.y) * 0.5f;
+				const float newExtentX = std::abs(a) * extentX + std::abs(c) * extentY;
+				const float newExtentY = std::abs(b) * extentX + std::abs(d) * extentY;
+				return { { center.x - newExtentX, center.y - newExtentY }, { center.x + newExtentX, center.y + newExtentY } };
+			}
+
+			/// <summary>
+			/// Retrieves the determinant of the linear part.
+			/// </summary>
+			/// <returns>The determinant.</returns>
+			float Determinant() const
+			{
+				return a * d - b * c;
+			}
+
+			/// <summary>
+			/// Retrieves the inverse transform.
+			/// </summary>
+			/// <param name="a_Inverse">Receives the inverse.</param>
+			/// <returns>True if the transform could be inverted, otherwise false.</returns>
+			bool Inverse(Affine2D& a_Inverse) const
+			{
+				const float determinant = Determinant();
+				if (determinant == 0.0f)
+				{
+					return false;
+				}
+
+				const float invDeterminant = 1.0f / determinant;
+				a_Inverse.a = d * invDeterminant;
+				a_Inverse.b = -b * invDeterminant;
+				a_Inverse.c = -c * invDeterminant;
+				a_Inverse.d = a * invDeterminant;
+				a_Inverse.tx = -(tx * a_Inverse.a + ty * a_Inverse.c);
+				a_Inverse.ty = -(tx * a_Inverse.b + ty * a_Inverse.d);
+				return true;
+			}
+
+			Affine2D operator*(const Affine2D& a_Other) const
+			{
+				return {
+					a * a_Other.a + b * a_Other.c,
+					a * a_Other.b + b * a_Other.d,
+					c * a_Other.a + d * a_Other.c,
+					c * a_Other.b + d * a_Other.d,
+					tx * a_Other.a + ty * a_Other.c + a_Other.tx,
+					tx * a_Other.b + ty * a_Other.d + a_Other.ty
+				};
+			}
+		};
+
+		//---------------------------------------------------------------------
+		// Transform2D
+		//---------------------------------------------------------------------
+		/// <summary>
+		/// Position, rotation and scale of an object.
+		/// </summary>
+		class Transform2D
+		{
+		public:
+			/// <summary>
+			/// Sets the position of the transform.
+			/// </summary>
+			/// <param name="a_vPosition">The position.</param>
+			void SetPosition(const Vector2& a_vPosition)
+			{
+				m_vPosition = a_vPosition;
+			}
+
+			/// <summary>
+			/// Sets the rotation of the transform.
+			/// </summary>
+			/// <param name="a_fRotationDegrees">The rotation in degrees.</param>
+			void SetRotation(float a_fRotationDegrees)
+			{
+				m_fRotationDegrees = a_fRotationDegrees;
+			}
+
+			/// <summary>
+			/// Sets the scale of the transform.
+			/// </summary>
+			/// <param name="a_vScale">The scale.</param>
+			void SetScale(const Vector2& a_vScale)
+			{
+				m_vScale = a_vScale;
+			}
+
+			/// <summary>
+			/// Retrieves the position of the transform.
+			/// </summary>
+			/// <returns>The position.</returns>
+			const Vector2& GetPosition() const
+			{
+				return m_vPosition;
+			}
+
+			/// <summary>
+			/// Retrieves the rotation of the transform.
+			/// </summary>
+			/// <returns>The rotation in degrees.</returns>
+			float GetRotation() const
+			{
+				return m_fRotationDegrees;
+			}
+
+			/// <summary>
+			/// Retrieves the scale of the transform.
+			/// </summary>
+			/// <returns>The scale.</returns>
+			const Vector2& GetScale() const
+			{
+				return m_vScale;
+			}
+
+			/// <summary>
+			/// Retrieves the matrix of the transform. Rotation and scale are applied around the center of a unit quad,
+			/// the same way DX12Transform does.
+			/// </summary>
+			/// <returns>The transform matrix.</returns>
+			Affine2D GetMatrix() const
+			{
+				return Affine2D::FromTransform(m_vPosition, m_fRotationDegrees, m_vScale, { 0.5f, 0.5f });
+			}
+		private:
+			Vector2 m_vPosition = { 0.0f, 0.0f };
+			float m_fRotationDegrees = 0.0f;
+			Vector2 m_vScale = { 1.0f, 1.0f };
+		};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,231 @@
+#include "math/Affine2DBatch.h"
+
+#include <algorithm>
+
+// The instruction set is picked at compile time. MSVC does not define __SSE2__, but SSE2 is always available on x64.
+#if !defined(GALLUS_MATH_SCALAR) && defined(__AVX2__)
+#define GALLUS_MATH_AVX2
+#include <immintrin.h>
+#elif !defined(GALLUS_MATH_SCALAR) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define GALLUS_MATH_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace gallus
+{
+	namespace math
+	{
+		namespace
+		{
+			//---------------------------------------------------------------------
+			// Lanes
+			//---------------------------------------------------------------------
+			// Thin wrapper around the widest register type available, so every kernel is written once.
+#if defined(GALLUS_MATH_AVX2)
+			struct Lanes
+			{
+				static constexpr size_t WIDTH = 8;
+				__m256 m_Value;
+
+				static Lanes Load(const float* a_pData) { return { _mm256_loadu_ps(a_pData) }; }
+				static Lanes Set(float a_fValue) { return { _mm256_set1_ps(a_fValue) }; }
+				void Store(float* a_pData) const { _mm256_storeu_ps(a_pData, m_Value); }
+				friend Lanes operator+(Lanes a_Left, Lanes a_Right) { return { _mm256_add_ps(a_Left.m_Value, a_Right.m_Value) }; }
+				friend Lanes operator-(Lanes a_Left, Lanes a_Right) { return { _mm256_sub_ps(a_Left.m_Value, a_Right.m_Value) }; }
+				friend Lanes operator*(Lanes a_Left, Lanes a_Right) { return { _mm256_mul_ps(a_Left.m_Value, a_Right.m_Value) }; }
+			};
+#elif defined(GALLUS_MATH_SSE2)
+			struct Lanes
+			{
+				static constexpr size_t WIDTH = 4;
+				__m128 m_Value;
+
+				static Lanes Load(const float* a_pData) { return { _mm_loadu_ps(a_pData) }; }
+				static Lanes Set(float a_fValue) { return { _mm_set1_ps(a_fValue) }; }
+				void Store(float* a_pData) const { _mm_storeu_ps(a_pData, m_Value); }
+				friend Lanes operator+(Lanes a_Left, Lanes a_Right) { return { _mm_add_ps(a_Left.m_Value, a_Right.m_Value) }; }
+				friend Lanes operator-(Lanes a_Left, Lanes a_Right) { return { _mm_sub_ps(a_Left.m_Value, a_Right.m_Value) }; }
+				friend Lanes operator*(Lanes a_Left, Lanes a_Right) { return { _mm_mul_ps(a_Left.m_Value, a_Right.m_Value) }; }
+			};
+#else
+			struct Lanes
+			{
+				static constexpr size_t WIDTH = 1;
+				float m_Value;
+
+				static Lanes Load(const float* a_pData) { return { *a_pData }; }
+				static Lanes Set(float a_fValue) { return { a_fValue }; }
+				void Store(float* a_pData) const { *a_pData = m_Value; }
+				friend Lanes operator+(Lanes a_Left, Lanes a_Right) { return { a_Left.m_Value + a_Right.m_Value }; }
+				friend Lanes operator-(Lanes a_Left, Lanes a_Right) { return { a_Left.m_Value - a_Right.m_Value }; }
+				friend Lanes operator*(Lanes a_Left, Lanes a_Right) { return { a_Left.m_Value * a_Right.m_Value }; }
+			};
+#endif
+
+			/// <summary>
+			/// Scalar version of Lanes, used for the elements left over after the last full register.
+			/// </summary>
+			struct ScalarLane
+			{
+				float m_Value;
+
+				static ScalarLane Load(const float* a_pData) { return { *a_pData }; }
+				static ScalarLane Set(float a_fValue) { return { a_fValue }; }
+				void Store(float* a_pData) const { *a_pData = m_Value; }
+				friend ScalarLane operator+(ScalarLane a_Left, ScalarLane a_Right) { return { a_Left.m_Value + a_Right.m_Value }; }
+				friend ScalarLane operator-(ScalarLane a_Left, ScalarLane a_Right) { return { a_Left.m_Value - a_Right.m_Value }; }
+				friend ScalarLane operator*(ScalarLane a_Left, ScalarLane a_Right) { return { a_Left.m_Value * a_Right.m_Value }; }
+			};
+
+			/// <summary>
+			/// Runs a kernel over [0, a_iCount), a full register at a time and scalar for the remainder.
+			/// </summary>
+			/// <param name="a_iCount">The number of elements.</param>
+			/// <param name="a_Kernel">Generic lambda that gets called with a lane type tag and the first element index.</param>
+			template <class Kernel>
+			void RunKernel(size_t a_iCount, Kernel&& a_Kernel)
+			{
+				size_t i = 0;
+				for (; i + Lanes::WIDTH <= a_iCount; i += Lanes::WIDTH)
+				{
+					a_Kernel(Lanes(), i);
+				}
+				for (; i < a_iCount; i++)
+				{
+					a_Kernel(ScalarLane(), i);
+				}
+			}
+		}
+
+		//---------------------------------------------------------------------
+		const char* GetBatchInstructionSet()
+		{
+#if defined(GALLUS_MATH_AVX2)
+			return "AVX2";
+#elif defined(GALLUS_MATH_SSE2)
+			return "SSE2";
+#else
+			return "Scalar";
+#endif
+		}
+
+		//---------------------------------------------------------------------
+		void TransformPoints(const Affine2D& a_Matrix, const Points2DSoA& a_Points, Points2DSoA& a_Result)
+		{
+			const size_t count = a_Points.Size();
+			a_Result.Resize(count);
+
+			const float* inX = a_Points.m_aX.data();
+			const float* inY = a_Points.m_aY.data();
+			float* outX = a_Result.m_aX.data();
+			float* outY = a_Result.m_aY.data();
+
+			RunKernel(count, [&](auto a_Lane, size_t a_iIndex)
+				{
+					using L = decltype(a_Lane);
+					const L x = L::Load(inX + a_iIndex);
+					const L y = L::Load(inY + a_iIndex);
+					(x * L::Set(a_Matrix.a) + y * L::Set(a_Matrix.c) + L::Set(a_Matrix.tx)).Store(outX + a_iIndex);
+					(x * L::Set(a_Matrix.b) + y * L::Set(a_Matrix.d) + L::Set(a_Matrix.ty)).Store(outY + a_iIndex);
+				});
+		}
+
+		//---------------------------------------------------------------------
+		void TransformPoints(const Affine2DSoA& a_Matrices, const Points2DSoA& a_Points, Points2DSoA& a_Result)
+		{
+			const size_t count = std::min(a_Matrices.Size(), a_Points.Size());
+			a_Result.Resize(count);
+
+			const float* inX = a_Points.m_aX.data();
+			const float* inY = a_Points.m_aY.data();
+			float* outX = a_Result.m_aX.data();
+			float* outY = a_Result.m_aY.data();
+
+			RunKernel(count, [&](auto a_Lane, size_t a_iIndex)
+				{
+					using L = decltype(a_Lane);
+					const L x = L::Load(inX + a_iIndex);
+					const L y = L::Load(inY + a_iIndex);
+					const L a = L::Load(a_Matrices.m_aA.data() + a_iIndex);
+					const L b = L::Load(a_Matrices.m_aB.data() + a_iIndex);
+					const L c = L::Load(a_Matrices.m_aC.data() + a_iIndex);
+					const L d = L::Load(a_Matrices.m_aD.data() + a_iIndex);
+					const L tx = L::Load(a_Matrices.m_aTx.data() + a_iIndex);
+					const L ty = L::Load(a_Matrices.m_aTy.data() + a_iIndex);
+					(x * a + y * c + tx).Store(outX + a_iIndex);
+					(x * b + y * d + ty).Store(outY + a_iIndex);
+				});
+		}
+
+		//---------------------------------------------------------------------
+		void ComposeAffines(const Affine2DSoA& a_First, const Affine2DSoA& a_Second, Affine2DSoA& a_Result)
+		{
+			const size_t count = std::min(a_First.Size(), a_Second.Size());
+			a_Result.Resize(count);
+
+			RunKernel(count, [&](auto a_Lane, size_t a_iIndex)
+				{
+					using L = decltype(a_Lane);
+					const L a1 = L::Load(a_First.m_aA.data() + a_iIndex);
+					const L b1 = L::Load(a_First.m_aB.data() + a_iIndex);
+					const L c1 = L::Load(a_First.m_aC.data() + a_iIndex);
+					const L d1 = L::Load(a_First.m_aD.data() + a_iIndex);
+					const L tx1 = L::Load(a_First.m_aTx.data() + a_iIndex);
+					const L ty1 = L::Load(a_First.m_aTy.data() + a_iIndex);
+					const L a2 = L::Load(a_Second.m_aA.data() + a_iIndex);
+					const L b2 = L::Load(a_Second.m_aB.data() + a_iIndex);
+					const L c2 = L::Load(a_Second.m_aC.data() + a_iIndex);
+					const L d2 = L::Load(a_Second.m_aD.data() + a_iIndex);
+					const L tx2 = L::Load(a_Second.m_aTx.data() + a_iIndex);
+					const L ty2 = L::Load(a_Second.m_aTy.data() + a_iIndex);
+
+					// All inputs are loaded before storing, so the result can alias one of the inputs.
+					(a1 * a2 + b1 * c2).Store(a_Result.m_aA.data() + a_iIndex);
+					(a1 * b2 + b1 * d2).Store(a_Result.m_aB.data() + a_iIndex);
+					(c1 * a2 + d1 * c2).Store(a_Result.m_aC.data() + a_iIndex);
+					(c1 * b2 + d1 * d2).Store(a_Result.m_aD.data() + a_iIndex);
+					(tx1 * a2 + ty1 * c2 + tx2).Store(a_Result.m_aTx.data() + a_iIndex);
+					(tx1 * b2 + ty1 * d2 + ty2).Store(a_Result.m_aTy.data() + a_iIndex);
+				});
+		}
+
+		//---------------------------------------------------------------------
+		void TransformAABBs(const Affine2D& a_Matrix, const AABB2DSoA& a_Boxes, AABB2DSoA& a_Result)
+		{
+			const size_t count = a_Boxes.Size();
+			a_Result.Resize(count);
+
+			// The transformed box is centered on the transformed center, its extents are the extents
+			// multiplied by the absolute values of the linear part.
+			const float absA = std::abs(a_Matrix.a);
+			const float absB = std::abs(a_Matrix.b);
+			const float absC = std::abs(a_Matrix.c);
+			const float absD = std::abs(a_Matrix.d);
+
+			RunKernel(count, [&](auto a_Lane, size_t a_iIndex)
+				{
+					using L = decltype(a_Lane);
+					const L half = L::Set(0.5f);
+					const L minX = L::Load(a_Boxes.m_aMinX.data() + a_iIndex);
+					const L minY = L::Load(a_Boxes.m_aMinY.data() + a_iIndex);
+					const L maxX = L::Load(a_Boxes.m_aMaxX.data() + a_iIndex);
+					const L maxY = L::Load(a_Boxes.m_aMaxY.data() + a_iIndex);
+
+					const L centerX = (minX + maxX) * half;
+					const L centerY = (minY + maxY) * half;
+					const L extentX = (maxX - minX) * half;
+					const L extentY = (maxY - minY) * half;
+
+					const L newCenterX = centerX * L::Set(a_Matrix.a) + centerY * L::Set(a_Matrix.c) + L::Set(a_Matrix.tx);
+					const L newCenterY = centerX * L::Set(a_Matrix.b) + centerY * L::Set(a_Matrix.d) + L::Set(a_Matrix.ty);
+					const L newExtentX = extentX * L::Set(absA) + extentY * L::Set(absC);
+					const L newExtentY = extentX * L::Set(absB) + extentY * L::Set(absD);
+
+					(newCenterX - newExtentX).Store(a_Result.m_aMinX.data() + a_iIndex);
+					(newCenterY - newExtentY).Store(a_Result.m_aMinY.data() + a_iIndex);
+					(newCenterX + newExtentX).Store(a_Result.m_aMaxX.data() + a_iIndex);
+					(newCenterY + newExtentY).Store(a_Result.m_aMaxY.data() + a_iIndex);
+				});
+		}
+	}
+}
\ No newline at end of file
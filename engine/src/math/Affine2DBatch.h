@@ -0,0 +1,173 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "math/Affine2D.h"
+
+namespace gallus
+{
+	namespace math
+	{
+		//---------------------------------------------------------------------
+		// Points2DSoA
+		//---------------------------------------------------------------------
+		/// <summary>
+		/// Points stored as separate x and y arrays, so batches can be processed several points at a time.
+		/// </summary>
+		struct Points2DSoA
+		{
+			std::vector<float> m_aX;
+			std::vector<float> m_aY;
+
+			void Resize(size_t a_iSize)
+			{
+				m_aX.resize(a_iSize);
+				m_aY.resize(a_iSize);
+			}
+
+			size_t Size() const
+			{
+				return m_aX.size();
+			}
+
+			void Set(size_t a_iIndex, const Vector2& a_vPoint)
+			{
+				m_aX[a_iIndex] = a_vPoint.x;
+				m_aY[a_iIndex] = a_vPoint.y;
+			}
+
+			Vector2 Get(size_t a_iIndex) const
+			{
+				return { m_aX[a_iIndex], m_aY[a_iIndex] };
+			}
+		};
+
+		//---------------------------------------------------------------------
+		// Affine2DSoA
+		//---------------------------------------------------------------------
+		/// <summary>
+		/// Affine transforms stored as one array per matrix element.
+		/// </summary>
+		struct Affine2DSoA
+		{
+			std::vector<float> m_aA;
+			std::vector<float> m_aB;
+			std::vector<float> m_aC;
+			std::vector<float> m_aD;
+			std::vector<float> m_aTx;
+			std::vector<float> m_aTy;
+
+			void Resize(size_t a_iSize)
+			{
+				m_aA.resize(a_iSize);
+				m_aB.resize(a_iSize);
+				m_aC.resize(a_iSize);
+				m_aD.resize(a_iSize);
+				m_aTx.resize(a_iSize);
+				m_aTy.resize(a_iSize);
+			}
+
+			size_t Size() const
+			{
+				return m_aA.size();
+			}
+
+			void Set(size_t a_iIndex, const Affine2D& a_Matrix)
+			{
+				m_aA[a_iIndex] = a_Matrix.a;
+				m_aB[a_iIndex] = a_Matrix.b;
+				m_aC[a_iIndex] = a_Matrix.c;
+				m_aD[a_iIndex] = a_Matrix.d;
+				m_aTx[a_iIndex] = a_Matrix.tx;
+				m_aTy[a_iIndex] = a_Matrix.ty;
+			}
+
+			Affine2D Get(size_t a_iIndex) const
+			{
+				return { m_aA[a_iIndex], m_aB[a_iIndex], m_aC[a_iIndex], m_aD[a_iIndex], m_aTx[a_iIndex], m_aTy[a_iIndex] };
+			}
+		};
+
+		//---------------------------------------------------------------------
+		// AABB2DSoA
+		//---------------------------------------------------------------------
+		/// <summary>
+		/// Bounding boxes stored as one array per coordinate.
+		/// </summary>
+		struct AABB2DSoA
+		{
+			std::vector<float> m_aMinX;
+			std::vector<float> m_aMinY;
+			std::vector<float> m_aMaxX;
+			std::vector<float> m_aMaxY;
+
+			void Resize(size_t a_iSize)
+			{
+				m_aMinX.resize(a_iSize);
+				m_aMinY.resize(a_iSize);
+				m_aMaxX.resize(a_iSize);
+				m_aMaxY.resize(a_iSize);
+			}
+
+			size_t Size() const
+			{
+				return m_aMinX.size();
+			}
+
+			void Set(size_t a_iIndex, const AABB2D& a_Box)
+			{
+				m_aMinX[a_iIndex] = a_Box.m_vMin.x;
+				m_aMinY[a_iIndex] = a_Box.m_vMin.y;
+				m_aMaxX[a_iIndex] = a_Box.m_vMax.x;
+				m_aMaxY[a_iIndex] = a_Box.m_vMax.y;
+			}
+
+			AABB2D Get(size_t a_iIndex) const
+			{
+				return { { m_aMinX[a_iIndex], m_aMinY[a_iIndex] }, { m_aMaxX[a_iIndex], m_aMaxY[a_iIndex] } };
+			}
+		};
+
+		/// <summary>
+		/// Retrieves the name of the instruction set the batch functions were compiled for.
+		/// </summary>
+		/// <returns>"AVX2", "SSE2" or "Scalar".</returns>
+		const char* GetBatchInstructionSet();
+
+		/// <summary>
+		/// Transforms points by a single matrix. The output is resized to the size of the input and may be the input itself.
+		/// </summary>
+		/// <param name="a_Matrix">The matrix.</param>
+		/// <param name="a_Points">The points.</param>
+		/// <param name="a_Result">Receives the transformed points.</param>
+		void TransformPoints(const Affine2D& a_Matrix, const Points2DSoA& a_Points, Points2DSoA& a_Result);
+
+		/// <summary>
+		/// Transforms every point by the matrix at the same index. Processes as many points as there are in the smaller input.
+		/// The output may be the input itself.
+		/// </summary>
+		/// <param name="a_Matrices">The matrices.</param>
+		/// <param name="a_Points">The points.</param>
+		/// <param name="a_Result">Receives the transformed points.</param>
+		void TransformPoints(const Affine2DSoA& a_Matrices, const Points2DSoA& a_Points, Points2DSoA& a_Result);
+
+		/// <summary>
+		/// Multiplies the matrices at the same index, a_Result[i] = a_First[i] * a_Second[i], so the result applies
+		/// a_First[i] first. Processes as many matrices as there are in the smaller input. The output may be one of the inputs.
+		/// </summary>
+		/// <param name="a_First">The matrices that get applied first.</param>
+		/// <param name="a_Second">The matrices that get applied second.</param>
+		/// <param name="a_Result">Receives the combined matrices.</param>
+		void ComposeAffines(const Affine2DSoA& a_First, const Affine2DSoA& a_Second, Affine2DSoA& a_Result);
+
+		/// <summary>
+		/// Transforms bounding boxes by a single matrix, giving the bounding boxes of the transformed corners.
+		/// The output is resized to the size of the input and may be the input itself.
+		/// </summary>
+		/// <param name="a_Matrix">The matrix.</param>
+		/// <param name="a_Boxes">The bounding boxes.</param>
+		/// <param name="a_Result">Receives the transformed bounding boxes.</param>
+		void TransformAABBs(const Affine2D& a_Matrix, const AABB2DSoA& a_Boxes, AABB2DSoA& a_Result);
+	}
+}
\ No newline at end of file
@@ -1,8 +1,11 @@
 #include "utils/file_abstractions.h"
 
 #include <vector>
+#include <cstdlib>
+#ifdef _WIN32
 #include <windows.h>
 #include <ShlObj_core.h>
+#endif // _WIN32
 
 #include "core/DataStream.h"
 
@@ -10,6 +13,7 @@ namespace gallus
 {
 	namespace file
 	{
+#ifdef _WIN32
 		//---------------------------------------------------------------------
 		bool genericFileOpen(fs::path& a_sPath, const IID a_Rclsid, FILEOPENDIALOGOPTIONS a_Options, const std::vector<COMDLG_FILTERSPEC>& a_aFilters = {})
 		{
@@ -78,6 +82,49 @@ namespace gallus
 
 			return path;
 		}
+#else
+		//---------------------------------------------------------------------
+		bool PickContainer(fs::path& /*a_sPath*/)
+		{
+			// There are no native dialogs outside of win32.
+			return false;
+		}
+
+		//---------------------------------------------------------------------
+		bool PickFile(fs::path& /*a_sPath*/, const std::vector<COMDLG_FILTERSPEC>& /*a_aFilters*/)
+		{
+			return false;
+		}
+
+		//---------------------------------------------------------------------
+		bool SaveFile(fs::path& /*a_sPath*/, const std::vector<COMDLG_FILTERSPEC>& /*a_aFilters*/)
+		{
+			return false;
+		}
+
+		//---------------------------------------------------------------------
+		const fs::path GetAppDataPath()
+		{
+			// Follows the XDG base directory specification.
+			fs::path path;
+			if (const char* dataHome = std::getenv("XDG_DATA_HOME"); dataHome && *dataHome)
+			{
+				path = dataHome;
+			}
+			else if (const char* home = std::getenv("HOME"); home && *home)
+			{
+				path = fs::path(home) / ".local/share";
+			}
+			else
+			{
+				path = fs::temp_directory_path();
+			}
+
+			fs::create_directories(path);
+
+			return path;
+		}
+#endif // _WIN32
 
 		//---------------------------------------------------------------------
 		bool CreateDirectory(const fs::path& a_Path)
@@ -86,10 +133,14 @@ namespace gallus
 		}
 
 		//---------------------------------------------------------------------
-		bool OpenInExplorer(const fs::path& a_Path)
+		bool OpenInExplorer([[maybe_unused]] const fs::path& a_Path)
 		{
+#ifdef _WIN32
 			ShellExecuteA(NULL, "open", fs::absolute(a_Path).string().c_str(), NULL, NULL, SW_SHOWDEFAULT);
 			return true;
+#else
+			return false;
+#endif // _WIN32
 		}
 
 		//---------------------------------------------------------------------
@@ -101,7 +152,11 @@ namespace gallus
 			}
 
 			FILE* file = nullptr;
+#ifdef _WIN32
 			fopen_s(&file, a_Path.generic_string().c_str(), "rb");
+#else
+			file = fopen(a_Path.generic_string().c_str(), "rb");
+#endif // _WIN32
 			if (!file)
 			{
 				return false;
@@ -123,7 +178,11 @@ namespace gallus
 		bool SaveFile(const fs::path& a_Path, const core::DataStream& a_Data)
 		{
 			FILE* file = nullptr;
+#ifdef _WIN32
 			fopen_s(&file, a_Path.generic_string().c_str(), "wb");
+#else
+			file = fopen(a_Path.generic_string().c_str(), "wb");
+#endif // _WIN32
 			if (!file)
 			{
 				return false;
@@ -2,9 +2,21 @@
 
 #include <string>
 #include <vector>
-#include <shtypes.h>
 #include <filesystem>
 
+#ifdef _WIN32
+#include <shtypes.h>
+#else
+/// <summary>
+/// File type filter for the file dialogs, matching the win32 declaration.
+/// </summary>
+struct COMDLG_FILTERSPEC
+{
+	const wchar_t* pszName;
+	const wchar_t* pszSpec;
+};
+#endif // _WIN32
+
 #if defined(CreateDirectory)
 #undef CreateDirectory
 #undef CreateDirectoryA
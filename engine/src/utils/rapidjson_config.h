@@ -0,0 +1,7 @@
+#pragma once
+
+// Rapidjson asserts with __debugbreak unless RAPIDJSON_ASSERT is defined, which only MSVC has.
+// Include this before any rapidjson header.
+#if !defined(RAPIDJSON_ASSERT) && !defined(_MSC_VER)
+#define RAPIDJSON_ASSERT(x) ((x) ? (void)0 : __builtin_trap())
+#endif
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include "logger/Logger.h"
 
 #include "gameplay/systems/MeshSystem.h"
+#include "gameplay/systems/TransformSystem.h"
 #include "core/Tool.h"
 
 namespace game
@@ -49,7 +50,7 @@ namespace game
 	{
 		while (m_bRunning.load())
 		{
-			gallus::core::TOOL->GetECS().Update(0.0f);
+			gallus::core::TOOL->Update();
 		}
 	}
 
@@ -80,6 +81,11 @@ namespace game
 		meshComp->SetShader(gallus::core::TOOL->GetResourceAtlas().GetDefaultShader());
 		meshComp->SetTexture(gallus::core::TOOL->GetResourceAtlas().GetDefaultTexture());
 
+		// Meshes are only drawn with a transform. The mesh is a unit quad, so this is where and how large the sprite shows up.
+		gallus::math::Transform2D& transform = gallus::core::TOOL->GetECS().GetSystem<gallus::gameplay::TransformSystem>().GetComponent(entityId).Transform();
+		transform.SetPosition({ 300.0f, 300.0f });
+		transform.SetScale({ 128.0f, 128.0f });
+
 		return true;
 	}
 }
\ No newline at end of file
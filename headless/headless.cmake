@@ -0,0 +1,56 @@
+project(headless)
+
+# Gather the engine files, without the win32 window, dx12 and imgui code. The null graphics backend takes their place.
+file(GLOB_RECURSE ENGINE_HEADERS ${CMAKE_SOURCE_DIR}/engine/src/*.h)
+file(GLOB_RECURSE ENGINE_SOURCES ${CMAKE_SOURCE_DIR}/engine/src/*.cpp)
+list(FILTER ENGINE_HEADERS EXCLUDE REGEX "/graphics/(dx12|win32|imgui)/")
+list(FILTER ENGINE_SOURCES EXCLUDE REGEX "/graphics/(dx12|win32|imgui)/")
+
+# Gather the shared game files.
+file(GLOB_RECURSE GAME_SHARED_HEADERS ${CMAKE_SOURCE_DIR}/game_shared/src/*.h)
+file(GLOB_RECURSE GAME_SHARED_SOURCES ${CMAKE_SOURCE_DIR}/game_shared/src/*.cpp)
+
+# Gather all headless files.
+file(GLOB_RECURSE HEADERS ${CMAKE_SOURCE_DIR}/headless/src/*.h)
+file(GLOB_RECURSE SOURCES ${CMAKE_SOURCE_DIR}/headless/src/*.cpp)
+
+# Define executable.
+add_executable(${PROJECT_NAME} ${HEADERS} ${SOURCES} ${ENGINE_HEADERS} ${ENGINE_SOURCES} ${GAME_SHARED_HEADERS} ${GAME_SHARED_SOURCES})
+
+# Define preprocessor definitions for different configurations
+target_compile_definitions(${PROJECT_NAME} PRIVATE
+    "$<$<CONFIG:${DEBUG}>:${PREDEFINITIONS_HEADLESS_DEBUG}>"
+    "$<$<CONFIG:${RELEASE}>:${PREDEFINITIONS_HEADLESS_RELEASE}>"
+)
+
+# Include directories
+target_include_directories(${PROJECT_NAME} PUBLIC
+    ${CMAKE_SOURCE_DIR}/engine/src
+    ${CMAKE_SOURCE_DIR}/game_shared/src
+    ${CMAKE_SOURCE_DIR}/headless/src
+    ${CMAKE_SOURCE_DIR}/external
+)
+
+# Set C++ standard
+set_target_properties(${PROJECT_NAME} PROPERTIES
+    CXX_STANDARD 20
+)
+
+find_package(Threads REQUIRED)
+target_link_libraries(${PROJECT_NAME} PRIVATE Threads::Threads)
+
+if(MSVC)
+    target_compile_options(${PROJECT_NAME} PRIVATE
+        "$<$<CONFIG:${DEBUG}>:/Od>"   # Disable optimizations for Debug
+        "$<$<CONFIG:${RELEASE}>:/O2>"  # Enable optimizations for Release
+        "$<$<CONFIG:${DEBUG}>:/MTd>"
+        "$<$<CONFIG:${RELEASE}>:/MT>"
+    )
+    target_link_libraries(${PROJECT_NAME} PRIVATE Shlwapi.lib)
+else()
+    # For GCC/Clang, set optimization level to 0 for debugging
+    target_compile_options(${PROJECT_NAME} PRIVATE
+        "$<$<CONFIG:${DEBUG}>:-O0>"  # Disable optimizations for Debug
+        "$<$<CONFIG:${RELEASE}>:-O2>"  # Optimize for Release
+    )
+endif()
\ No newline at end of file
@@ -0,0 +1,154 @@
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+
+#include "utils/file_abstractions.h"
+#include "core/Tool.h"
+#include "core/DataStream.h"
+#include "logger/Logger.h"
+#include "gameplay/Game.h"
+#include "graphics/software/SoftwareRenderDevice.h"
+
+int main(int argc, char* argv[])
+{
+	// Options:
+	//   --frames <count>     Quit after a number of frames (default: run until interrupted).
+	//   --scene <path>       Scene file to load after the game has been initialized.
+	//   --resources <path>   Folder the resource atlas loads textures and shaders from.
+	//   --pak <path>         Archive the resource atlas reads from before the resource folder, with entries relative to it.
+	//   --rate <fps>         Frames per second the loop gets paced to, 0 runs frames back to back (default: 60).
+	//   --renderer <name>    "null" only batches the frames, "software" rasterizes them on the cpu (default: null).
+	//   --simd <0|1>         Whether the software renderer fills spans with SIMD instructions (default: 1).
+	//   --capture <path>     Saves the last frame of the software renderer as a tga file.
+	uint64_t frameLimit = 0;
+	float frameRate = 60.0f;
+	fs::path scenePath;
+	std::string resourceFolder;
+	fs::path archivePath;
+	bool softwareRenderer = false;
+	bool simd = true;
+	fs::path capturePath;
+	for (int i = 1; i + 1 < argc; i += 2)
+	{
+		if (strcmp(argv[i], "--frames") == 0)
+		{
+			frameLimit = std::strtoull(argv[i + 1], nullptr, 10);
+		}
+		else if (strcmp(argv[i], "--scene") == 0)
+		{
+			scenePath = argv[i + 1];
+		}
+		else if (strcmp(argv[i], "--resources") == 0)
+		{
+			resourceFolder = argv[i + 1];
+		}
+		else if (strcmp(argv[i], "--pak") == 0)
+		{
+			archivePath = argv[i + 1];
+		}
+		else if (strcmp(argv[i], "--rate") == 0)
+		{
+			frameRate = std::strtof(argv[i + 1], nullptr);
+		}
+		else if (strcmp(argv[i], "--renderer") == 0)
+		{
+			softwareRenderer = strcmp(argv[i + 1], "software") == 0;
+		}
+		else if (strcmp(argv[i], "--simd") == 0)
+		{
+			simd = std::strtol(argv[i + 1], nullptr, 10) != 0;
+		}
+		else if (strcmp(argv[i], "--capture") == 0)
+		{
+			capturePath = argv[i + 1];
+			softwareRenderer = true;
+		}
+	}
+
+	// Initialize systems.
+	std::string name = "Professor Layton and the Shitty Game Engine";
+	std::string saveDirPath = gallus::file::GetAppDataPath().generic_string() + "/professor-layton";
+	gallus::core::TOOL = new gallus::core::Tool();
+	gallus::core::TOOL->SetSaveDirectory(saveDirPath);
+	gallus::core::TOOL->SetFrameLimit(frameLimit);
+	gallus::core::TOOL->GetGameLoop().SetTargetFrameRate(frameRate);
+	gallus::core::TOOL->GetResourceAtlas().SetResourceFolder(resourceFolder);
+	if (!archivePath.empty())
+	{
+		gallus::core::TOOL->GetResourceAtlas().MountArchive(archivePath);
+	}
+
+	gallus::core::TOOL->Initialize(name);
+
+	gallus::graphics::software::SoftwareRenderDevice softwareDevice;
+	if (softwareRenderer)
+	{
+		softwareDevice.Resize(gallus::core::TOOL->GetRenderer().GetSize());
+		softwareDevice.SetSimdEnabled(simd);
+		gallus::core::TOOL->GetRenderer().SetRenderDevice(&softwareDevice);
+	}
+
+	game::GAME.Initialize();
+
+	if (!scenePath.empty())
+	{
+		gallus::core::DataStream data;
+		if (!gallus::file::LoadFile(scenePath, data))
+		{
+			LOGF(gallus::LOGSEVERITY_ERROR, LOG_CATEGORY_GAME, "Failed loading scene file: \"%s\".", scenePath.generic_string().c_str());
+		}
+		else
+		{
+			game::GAME.GetScene().SetData(data);
+			game::GAME.GetScene().LoadData();
+
+			// Captures and frame counts should not depend on how fast the textures decode.
+			gallus::core::TOOL->GetResourceAtlas().WaitForAsyncLoads();
+		}
+	}
+
+	// Loop.
+	game::GAME.Loop();
+
+	const gallus::core::FrameTimer& frameTimer = gallus::core::TOOL->GetFrameTimer();
+	const gallus::core::GameLoop& gameLoop = gallus::core::TOOL->GetGameLoop();
+	LOGF(gallus::LOGSEVERITY_INFO, LOG_CATEGORY_GAME, "Ran %llu frames and %llu simulation steps in %.3f seconds (average %.3f ms, min %.3f ms, max %.3f ms, %.3f seconds dropped, %u draws in %u batches in the last frame).",
+		static_cast<unsigned long long>(frameTimer.GetFrameCount()),
+		static_cast<unsigned long long>(gameLoop.GetStepCount()),
+		frameTimer.GetTotalTime(),
+		frameTimer.GetAverageFrameTime() * 1000.0f,
+		frameTimer.GetMinFrameTime() * 1000.0f,
+		frameTimer.GetMaxFrameTime() * 1000.0f,
+		gameLoop.GetDroppedTime(),
+		gallus::core::TOOL->GetRenderer().GetDrawCount(),
+		gallus::core::TOOL->GetRenderer().GetBatchCount());
+
+	const gallus::graphics::RenderStats& renderStats = gallus::core::TOOL->GetRenderer().GetStats();
+	LOGF(gallus::LOGSEVERITY_INFO, LOG_CATEGORY_GAME, "Last frame bound %u shaders (%u skipped) and %u textures (%u skipped).",
+		renderStats.m_iShaderBinds,
+		renderStats.m_iShaderBindsSkipped,
+		renderStats.m_iTextureBinds,
+		renderStats.m_iTextureBindsSkipped);
+
+	if (softwareRenderer)
+	{
+		const gallus::graphics::software::SoftwareRenderStats& softwareStats = softwareDevice.GetStats();
+		LOGF(gallus::LOGSEVERITY_INFO, LOG_CATEGORY_GAME, "Software renderer (%s) rasterized %llu triangles and %llu pixels in %.3f ms (%.1f megapixels per second).",
+			softwareDevice.GetFillInstructionSet(),
+			static_cast<unsigned long long>(softwareStats.m_iTriangleCount),
+			static_cast<unsigned long long>(softwareStats.m_iPixelCount),
+			softwareStats.m_fRasterTime * 1000.0,
+			softwareStats.m_fRasterTime > 0.0 ? softwareStats.m_iPixelCount / softwareStats.m_fRasterTime / 1000000.0 : 0.0);
+
+		if (!capturePath.empty() && !softwareDevice.GetFrameBuffer().SaveTGA(capturePath))
+		{
+			LOGF(gallus::LOGSEVERITY_ERROR, LOG_CATEGORY_GAME, "Failed saving capture: \"%s\".", capturePath.generic_string().c_str());
+		}
+	}
+
+	// Destroy the tool after loop ends.
+	gallus::core::TOOL->Destroy();
+
+	return 0;
+}
\ No newline at end of file
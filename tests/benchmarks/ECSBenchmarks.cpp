@@ -0,0 +1,170 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#include "TestRunner.h"
+#include "core/JobSystem.h"
+#include "gameplay/EntityComponentSystem.h"
+#include "gameplay/ECSBaseSystem.h"
+
+namespace gallus
+{
+	namespace tests
+	{
+		namespace
+		{
+			class MotionComponent : public gameplay::Component
+			{
+			public:
+				void Serialize(rapidjson::Value&, rapidjson::Document::AllocatorType&) const override
+				{}
+
+				void Deserialize(const rapidjson::Value&, rapidjson::Document::AllocatorType&) override
+				{}
+
+				float m_aPosition[2] = { 0.0f, 0.0f };
+				float m_aVelocity[2] = { 1.0f, 2.0f };
+			};
+
+			class MotionSystem : public gameplay::ECSBaseSystem<MotionComponent>
+			{
+			public:
+				std::string GetPropertyName() const override
+				{
+					return "motion";
+				}
+
+				std::string GetSystemName() const override
+				{
+					return "Motion";
+				}
+
+				void Update(float) override
+				{}
+			};
+
+			constexpr uint32_t REPETITIONS = 10;
+
+			/// <summary>
+			/// Runs a function a few times and returns the fastest run.
+			/// </summary>
+			/// <param name="a_Function">The function.</param>
+			/// <returns>The fastest run in milliseconds.</returns>
+			template <class Function>
+			double measureBest(Function&& a_Function)
+			{
+				double best = 0.0;
+				for (uint32_t i = 0; i < REPETITIONS; i++)
+				{
+					const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+					a_Function();
+					const double time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+					best = i == 0 ? time : std::min(best, time);
+				}
+				return best;
+			}
+
+			/// <summary>
+			/// Integrates and sums the components serially and with ParallelForEach and ParallelReduce, and logs the times.
+			/// </summary>
+			/// <param name="a_iCount">The number of components.</param>
+			/// <returns>True if the parallel results match the serial ones.</returns>
+			bool benchmarkComponents(uint32_t a_iCount)
+			{
+				core::JobSystem jobSystem;
+				jobSystem.Initialize();
+
+				gameplay::EntityComponentSystem ecs;
+				ecs.SetJobSystem(&jobSystem);
+				ecs.Initialize();
+
+				MotionSystem& system = ecs.CreateSystem<MotionSystem>();
+				for (const gameplay::EntityID& id : ecs.CreateEntities(a_iCount, "Motion"))
+				{
+					system.GetComponent(id);
+				}
+				MotionSystem::ComponentVector& components = system.GetComponents();
+
+				const double serialForEach = measureBest([&components]()
+					{
+						for (MotionComponent& component : components)
+						{
+							component.m_aPosition[0] += component.m_aVelocity[0];
+							component.m_aPosition[1] += component.m_aVelocity[1];
+						}
+					});
+
+				const double parallelForEach = measureBest([&system, &jobSystem]()
+					{
+						system.ParallelForEach(jobSystem, [](const gameplay::EntityID&, MotionComponent& a_Component)
+							{
+								a_Component.m_aPosition[0] += a_Component.m_aVelocity[0];
+								a_Component.m_aPosition[1] += a_Component.m_aVelocity[1];
+							});
+					});
+
+				// Every component was moved the same number of times, so all of them are at the same position.
+				const bool moved = std::all_of(components.begin(), components.end(), [](const MotionComponent& a_Component)
+					{
+						return a_Component.m_aPosition[0] == 2.0f * REPETITIONS && a_Component.m_aPosition[1] == 4.0f * REPETITIONS;
+					});
+
+				// Sums of whole numbers below 2^53 are exact in doubles, so the order of the chunks does not matter.
+				double serialSum = 0.0;
+				const double serialReduce = measureBest([&components, &serialSum]()
+					{
+						serialSum = 0.0;
+						for (const MotionComponent& component : components)
+						{
+							serialSum += component.m_aPosition[0];
+						}
+					});
+
+				double parallelSum = 0.0;
+				const double parallelReduce = measureBest([&system, &jobSystem, &parallelSum]()
+					{
+						parallelSum = system.ParallelReduce(jobSystem, 0.0,
+							[](double& a_fSum, const gameplay::EntityID&, const MotionComponent& a_Component)
+							{
+								a_fSum += a_Component.m_aPosition[0];
+							},
+							[](double& a_fResult, double a_fSum)
+							{
+								a_fResult += a_fSum;
+							});
+					});
+
+				LOGF(LOGSEVERITY_INFO, LOG_CATEGORY_TEST, "%u components, %u workers: for each %.3f ms serial, %.3f ms parallel (%.2fx), reduce %.3f ms serial, %.3f ms parallel (%.2fx).",
+					a_iCount, jobSystem.GetWorkerCount(),
+					serialForEach, parallelForEach, serialForEach / parallelForEach,
+					serialReduce, parallelReduce, serialReduce / parallelReduce);
+
+				ecs.Destroy();
+				jobSystem.Destroy();
+
+				return moved && parallelSum == serialSum;
+			}
+		}
+
+		//---------------------------------------------------------------------
+		TEST_CASE(ParallelForEach10K)
+		{
+			CHECK(benchmarkComponents(10000));
+			return true;
+		}
+
+		//---------------------------------------------------------------------
+		TEST_CASE(ParallelForEach100K)
+		{
+			CHECK(benchmarkComponents(100000));
+			return true;
+		}
+
+		//---------------------------------------------------------------------
+		TEST_CASE(ParallelForEach1M)
+		{
+			CHECK(benchmarkComponents(1000000));
+			return true;
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,166 @@
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "TestRunner.h"
+#include "math/Affine2DBatch.h"
+
+namespace gallus
+{
+	namespace tests
+	{
+		namespace
+		{
+			// Every count up to two full AVX2 registers and a remainder, so each lane width gets a scalar tail.
+			constexpr size_t MAX_COUNT = 19;
+
+			/// <summary>
+			/// Small deterministic generator, so failures reproduce.
+			/// </summary>
+			struct Random
+			{
+				uint32_t m_iState = 1;
+
+				float Next(float a_fMin, float a_fMax)
+				{
+					m_iState = m_iState * 1664525u + 1013904223u;
+					return a_fMin + (a_fMax - a_fMin) * static_cast<float>(m_iState >> 8) / static_cast<float>(1u << 24);
+				}
+
+				math::Affine2D NextAffine()
+				{
+					return math::Affine2D::FromTransform({ Next(-100.0f, 100.0f), Next(-100.0f, 100.0f) }, Next(-180.0f, 180.0f),
+						{ Next(-3.0f, 3.0f), Next(-3.0f, 3.0f) }, { Next(-5.0f, 5.0f), Next(-5.0f, 5.0f) });
+				}
+			};
+
+			/// <summary>
+			/// Compares the batch result with the scalar one. The kernels evaluate the same expressions, only a compiler that
+			/// contracts them into fused multiply adds can make the last bit differ.
+			/// </summary>
+			bool nearlyEqual(float a_fBatch, float a_fScalar)
+			{
+				return std::abs(a_fBatch - a_fScalar) <= 1e-5f * std::max(1.0f, std::abs(a_fScalar));
+			}
+
+			bool nearlyEqual(const math::Affine2D& a_Batch, const math::Affine2D& a_Scalar)
+			{
+				return nearlyEqual(a_Batch.a, a_Scalar.a) && nearlyEqual(a_Batch.b, a_Scalar.b) && nearlyEqual(a_Batch.c, a_Scalar.c) &&
+					nearlyEqual(a_Batch.d, a_Scalar.d) && nearlyEqual(a_Batch.tx, a_Scalar.tx) && nearlyEqual(a_Batch.ty, a_Scalar.ty);
+			}
+		}
+
+		//---------------------------------------------------------------------
+		TEST_CASE(TransformPointsMatchesScalar)
+		{
+			TESTF("Batch math runs with %s.", math::GetBatchInstructionSet());
+
+			Random random;
+			for (size_t count = 0; count <= MAX_COUNT; count++)
+			{
+				const math::Affine2D matrix = random.NextAffine();
+				math::Affine2DSoA matrices;
+				math::Points2DSoA points;
+				matrices.Resize(count);
+				points.Resize(count);
+				for (size_t i = 0; i < count; i++)
+				{
+					matrices.Set(i, random.NextAffine());
+					points.Set(i, { random.Next(-50.0f, 50.0f), random.Next(-50.0f, 50.0f) });
+				}
+
+				math::Points2DSoA single;
+				math::TransformPoints(matrix, points, single);
+				math::Points2DSoA perPoint;
+				math::TransformPoints(matrices, points, perPoint);
+				CHECK(single.Size() == count && perPoint.Size() == count);
+
+				for (size_t i = 0; i < count; i++)
+				{
+					const math::Vector2 expectedSingle = matrix.TransformPoint(points.Get(i));
+					const math::Vector2 expectedPerPoint = matrices.Get(i).TransformPoint(points.Get(i));
+					CHECK(nearlyEqual(single.Get(i).x, expectedSingle.x) && nearlyEqual(single.Get(i).y, expectedSingle.y));
+					CHECK(nearlyEqual(perPoint.Get(i).x, expectedPerPoint.x) && nearlyEqual(perPoint.Get(i).y, expectedPerPoint.y));
+				}
+
+				// Transforming in place gives the same points.
+				math::TransformPoints(matrix, points, points);
+				for (size_t i = 0; i < count; i++)
+				{
+					CHECK(points.Get(i).x == single.Get(i).x && points.Get(i).y == single.Get(i).y);
+				}
+			}
+			return true;
+		}
+
+		//---------------------------------------------------------------------
+		TEST_CASE(ComposeAffinesMatchesScalar)
+		{
+			Random random;
+			for (size_t count = 0; count <= MAX_COUNT; count++)
+			{
+				math::Affine2DSoA first;
+				math::Affine2DSoA second;
+				first.Resize(count);
+				second.Resize(count + 3);
+				for (size_t i = 0; i < count; i++)
+				{
+					first.Set(i, random.NextAffine());
+				}
+				for (size_t i = 0; i < count + 3; i++)
+				{
+					second.Set(i, random.NextAffine());
+				}
+
+				// Only as many matrices as the smaller input has are composed.
+				math::Affine2DSoA result;
+				math::ComposeAffines(first, second, result);
+				CHECK(result.Size() == count);
+				for (size_t i = 0; i < count; i++)
+				{
+					CHECK(nearlyEqual(result.Get(i), first.Get(i) * second.Get(i)));
+				}
+
+				// The result may be the first input.
+				math::ComposeAffines(first, second, first);
+				for (size_t i = 0; i < count; i++)
+				{
+					const math::Affine2D composed = first.Get(i);
+					const math::Affine2D expected = result.Get(i);
+					CHECK(composed.a == expected.a && composed.b == expected.b && composed.c == expected.c &&
+						composed.d == expected.d && composed.tx == expected.tx && composed.ty == expected.ty);
+				}
+			}
+			return true;
+		}
+
+		//---------------------------------------------------------------------
+		TEST_CASE(TransformAABBsMatchesScalar)
+		{
+			Random random;
+			for (size_t count = 0; count <= MAX_COUNT; count++)
+			{
+				const math::Affine2D matrix = random.NextAffine();
+				math::AABB2DSoA boxes;
+				boxes.Resize(count);
+				for (size_t i = 0; i < count; i++)
+				{
+					const math::Vector2 min = { random.Next(-50.0f, 50.0f), random.Next(-50.0f, 50.0f) };
+					boxes.Set(i, { min, { min.x + random.Next(0.0f, 20.0f), min.y + random.Next(0.0f, 20.0f) } });
+				}
+
+				math::AABB2DSoA result;
+				math::TransformAABBs(matrix, boxes, result);
+				CHECK(result.Size() == count);
+				for (size_t i = 0; i < count; i++)
+				{
+					const math::AABB2D expected = matrix.TransformAABB(boxes.Get(i));
+					const math::AABB2D box = result.Get(i);
+					CHECK(nearlyEqual(box.m_vMin.x, expected.m_vMin.x) && nearlyEqual(box.m_vMin.y, expected.m_vMin.y));
+					CHECK(nearlyEqual(box.m_vMax.x, expected.m_vMax.x) && nearlyEqual(box.m_vMax.y, expected.m_vMax.y));
+				}
+			}
+			return true;
+		}
+	}
+}
\ No newline at end of file
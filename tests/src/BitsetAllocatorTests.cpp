@@ -0,0 +1,205 @@
+#include <vector>
+
+#include "TestRunner.h"
+#include "core/BitsetAllocator.h"
+
+namespace gallus
+{
+	namespace tests
+	{
+		namespace
+		{
+			using core::BitsetAllocator;
+
+			// A single index, the edges of the first word and enough words that the summary needs a second word.
+			constexpr size_t COUNTS[] = { 1, 63, 64, 65, 4097 };
+
+			/// <summary>
+			/// The allocator as a plain vector of bools, lowest free index first.
+			/// </summary>
+			struct Model
+			{
+				std::vector<bool> m_aAllocated;
+
+				size_t AllocateRange(size_t a_iCount)
+				{
+					size_t length = 0;
+					for (size_t i = 0; i < m_aAllocated.size() && a_iCount != 0; i++)
+					{
+						length = m_aAllocated[i] ? 0 : length + 1;
+						if (length == a_iCount)
+						{
+							const size_t start = i + 1 - a_iCount;
+							for (size_t j = start; j <= i; j++)
+							{
+								m_aAllocated[j] = true;
+							}
+							return start;
+						}
+					}
+					return BitsetAllocator::INVALID_INDEX;
+				}
+
+				bool Free(size_t a_iIndex, size_t a_iCount)
+				{
+					if (a_iCount == 0 || a_iIndex >= m_aAllocated.size() || a_iCount > m_aAllocated.size() - a_iIndex)
+					{
+						return false;
+					}
+					for (size_t i = a_iIndex; i < a_iIndex + a_iCount; i++)
+					{
+						if (!m_aAllocated[i])
+						{
+							return false;
+						}
+					}
+					for (size_t i = a_iIndex; i < a_iIndex + a_iCount; i++)
+					{
+						m_aAllocated[i] = false;
+					}
+					return true;
+				}
+
+				size_t GetFreeCount() const
+				{
+					size_t count = 0;
+					for (bool allocated : m_aAllocated)
+					{
+						count += allocated ? 0 : 1;
+					}
+					return count;
+				}
+			};
+
+			/// <summary>
+			/// Checks every index and the free count against the model.
+			/// </summary>
+			bool matchesModel(const BitsetAllocator& a_Allocator, const Model& a_Model)
+			{
+				if (a_Allocator.GetCount() != a_Model.m_aAllocated.size() || a_Allocator.GetFreeCount() != a_Model.GetFreeCount())
+				{
+					return false;
+				}
+				for (size_t i = 0; i < a_Model.m_aAllocated.size(); i++)
+				{
+					if (a_Allocator.IsAllocated(i) != a_Model.m_aAllocated[i])
+					{
+						return false;
+					}
+				}
+				return !a_Allocator.IsAllocated(a_Model.m_aAllocated.size());
+			}
+		}
+
+		//---------------------------------------------------------------------
+		TEST_CASE(AllocatesLowestFreeIndexUntilFull)
+		{
+			for (size_t count : COUNTS)
+			{
+				BitsetAllocator allocator;
+				allocator.Reset(count);
+				CHECK(allocator.GetCount() == count && allocator.GetFreeCount() == count);
+
+				for (size_t i = 0; i < count; i++)
+				{
+					CHECK(allocator.Allocate() == i);
+				}
+				CHECK(allocator.Allocate() == BitsetAllocator::INVALID_INDEX);
+				CHECK(allocator.AllocateRange(1) == BitsetAllocator::INVALID_INDEX);
+				CHECK(allocator.GetFreeCount() == 0);
+
+				// A freed index is the next one handed out, even if it is in the last word.
+				CHECK(allocator.Free(count - 1));
+				CHECK(allocator.Allocate() == count - 1);
+				CHECK(allocator.Free(0));
+				CHECK(allocator.Allocate() == 0);
+
+				// Resetting frees everything.
+				allocator.Reset(count);
+				CHECK(allocator.GetFreeCount() == count && !allocator.IsAllocated(0));
+				CHECK(allocator.AllocateRange(count) == 0);
+				CHECK(allocator.AllocateRange(count + 1) == BitsetAllocator::INVALID_INDEX);
+			}
+			return true;
+		}
+
+		//---------------------------------------------------------------------
+		TEST_CASE(RejectsInvalidFrees)
+		{
+			for (size_t count : COUNTS)
+			{
+				BitsetAllocator allocator;
+				allocator.Reset(count);
+				CHECK(!allocator.Free(0));
+				CHECK(allocator.AllocateRange(0) == BitsetAllocator::INVALID_INDEX);
+
+				CHECK(allocator.AllocateRange(count) == 0);
+				CHECK(!allocator.Free(0, 0));
+				CHECK(!allocator.Free(count));
+				CHECK(!allocator.Free(0, count + 1));
+				CHECK(!allocator.Free(count - 1, 2));
+				CHECK(!allocator.Free(BitsetAllocator::INVALID_INDEX, 2));
+
+				// A range that is only partly allocated is left alone.
+				CHECK(allocator.Free(count - 1));
+				if (count > 1)
+				{
+					CHECK(!allocator.Free(count - 2, 2));
+					CHECK(allocator.IsAllocated(count - 2));
+				}
+				CHECK(!allocator.Free(count - 1));
+				CHECK(allocator.GetFreeCount() == 1);
+			}
+			return true;
+		}
+
+		//---------------------------------------------------------------------
+		TEST_CASE(MatchesVectorOfBools)
+		{
+			uint32_t seed = 7;
+			const auto next = [&seed](uint32_t a_iRange)
+				{
+					seed = seed * 1664525u + 1013904223u;
+					return (seed >> 8) % a_iRange;
+				};
+
+			for (size_t count : COUNTS)
+			{
+				BitsetAllocator allocator;
+				allocator.Reset(count);
+				Model model;
+				model.m_aAllocated.assign(count, false);
+
+				// Ranges up to a little more than a word, so runs of free words are taken whole and cross word edges.
+				const uint32_t maxRange = static_cast<uint32_t>(count < 70 ? count + 2 : 70);
+				for (uint32_t step = 0; step < 2000; step++)
+				{
+					const uint32_t operation = next(4);
+					if (operation == 0)
+					{
+						CHECK(allocator.Allocate() == model.AllocateRange(1));
+					}
+					else if (operation == 1)
+					{
+						const size_t rangeCount = next(maxRange) + 1;
+						CHECK(allocator.AllocateRange(rangeCount) == model.AllocateRange(rangeCount));
+					}
+					else
+					{
+						// Frees may start anywhere, also past the end, and cover free indices.
+						const size_t index = next(static_cast<uint32_t>(count + 2));
+						const size_t rangeCount = operation == 2 ? 1 : next(maxRange) + 1;
+						CHECK(allocator.Free(index, rangeCount) == model.Free(index, rangeCount));
+					}
+
+					if (!matchesModel(allocator, model))
+					{
+						TESTF("Allocator of %zu indices differs from the model after %u operations.", count, step + 1);
+						return false;
+					}
+				}
+			}
+			return true;
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,632 @@
+﻿#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include "TestRunner.h"
+#include "core/JobSystem.h"
+#include "cooking/BlockCompression.h"
+#include "cooking/MipGenerator.h"
+#include "cooking/TextureCooker.h"
+#include "graphics/TextureData.h"
+
+namespace gallus
+{
+	namespace tests
+	{
+		namespace
+		{
+			constexpr uint32_t IMAGE_SIZE = 64;
+
+			/// <summary>
+			/// The lowest PSNR in dB a format may reach at a quality, on the gradient and on the noise.
+			/// </summary>
+			struct QualityFloor
+			{
+				graphics::TextureFormat m_Format;
+				cooking::CompressionQuality m_Quality;
+				double m_fGradient = 0.0;
+				double m_fNoise = 0.0;
+			};
+
+			const QualityFloor g_aQualityFloors[] = {
+				{ graphics::TextureFormat::BC1, cooking::CompressionQuality::Fast, 37.0, 11.0 },
+				{ graphics::TextureFormat::BC1, cooking::CompressionQuality::Normal, 37.0, 12.5 },
+				{ graphics::TextureFormat::BC1, cooking::CompressionQuality::High, 37.0, 12.5 },
+				{ graphics::TextureFormat::BC3, cooking::CompressionQuality::Fast, 38.5, 12.0 },
+				{ graphics::TextureFormat::BC3, cooking::CompressionQuality::Normal, 38.5, 13.5 },
+				{ graphics::TextureFormat::BC3, cooking::CompressionQuality::High, 38.5, 13.5 },
+				{ graphics::TextureFormat::BC4, cooking::CompressionQuality::Fast, 52.0, 27.5 },
+				{ graphics::TextureFormat::BC4, cooking::CompressionQuality::Normal, 52.0, 28.0 },
+				{ graphics::TextureFormat::BC4, cooking::CompressionQuality::High, 52.0, 28.0 },
+				{ graphics::TextureFormat::BC5, cooking::CompressionQuality::Fast, 52.0, 27.5 },
+				{ graphics::TextureFormat::BC5, cooking::CompressionQuality::Normal, 52.0, 28.0 },
+				{ graphics::TextureFormat::BC5, cooking::CompressionQuality::High, 52.0, 28.5 },
+				{ graphics::TextureFormat::BC7, cooking::CompressionQuality::Fast, 39.0, 12.0 },
+				{ graphics::TextureFormat::BC7, cooking::CompressionQuality::Normal, 39.0, 12.0 },
+				{ graphics::TextureFormat::BC7, cooking::CompressionQuality::High, 45.0, 15.0 },
+			};
+
+			//---------------------------------------------------------------------
+			std::vector<uint32_t> createGradient()
+			{
+				std::vector<uint32_t> pixels(IMAGE_SIZE * IMAGE_SIZE);
+				for (uint32_t y = 0; y < IMAGE_SIZE; y++)
+				{
+					for (uint32_t x = 0; x < IMAGE_SIZE; x++)
+					{
+						const uint32_t r = x * 4;
+						const uint32_t g = y * 4;
+						const uint32_t b = (x + y) * 2;
+						const uint32_t a = 255 - x * 2;
+						pixels[y * IMAGE_SIZE + x] = r | (g << 8) | (b << 16) | (a << 24);
+					}
+				}
+				return pixels;
+			}
+
+			//---------------------------------------------------------------------
+			std::vector<uint32_t> createNoise()
+			{
+				std::vector<uint32_t> pixels(IMAGE_SIZE * IMAGE_SIZE);
+				uint32_t state = 12345;
+				for (uint32_t& pixel : pixels)
+				{
+					state = state * 1664525u + 1013904223u;
+					pixel = state;
+				}
+				return pixels;
+			}
+
+			//---------------------------------------------------------------------
+			uint32_t getComparedChannels(graphics::TextureFormat a_Format)
+			{
+				switch (a_Format)
+				{
+					case graphics::TextureFormat::BC1:
+					{
+						return 0x00FFFFFF;
+					}
+					case graphics::TextureFormat::BC4:
+					{
+						return 0x000000FF;
+					}
+					case graphics::TextureFormat::BC5:
+					{
+						return 0x0000FFFF;
+					}
+					default:
+					{
+						return 0xFFFFFFFF;
+					}
+				}
+			}
+
+			//---------------------------------------------------------------------
+			const char* getQualityName(cooking::CompressionQuality a_Quality)
+			{
+				switch (a_Quality)
+				{
+					case cooking::CompressionQuality::Fast:
+					{
+						return "fast";
+					}
+					case cooking::CompressionQuality::Normal:
+					{
+						return "normal";
+					}
+					case cooking::CompressionQuality::High:
+					default:
+					{
+						return "high";
+					}
+				}
+			}
+
+			/// <summary>
+			/// Encodes an image block by block and decodes it again through the texture data, the way the engine reads cooked textures.
+			/// </summary>
+			/// <param name="a_aPixels">The pixels of the image.</param>
+			/// <param name="a_Format">The format to encode to.</param>
+			/// <param name="a_Quality">The quality to encode with.</param>
+			/// <param name="a_fSeconds">Receives how long encoding took.</param>
+			/// <returns>The PSNR in dB over the channels the format stores, or 0 if decoding failed.</returns>
+			double encodeAndMeasure(const std::vector<uint32_t>& a_aPixels, graphics::TextureFormat a_Format, cooking::CompressionQuality a_Quality, double& a_fSeconds)
+			{
+				const size_t blockSize = graphics::GetTextureBlockSize(a_Format);
+				const uint32_t blocksWide = IMAGE_SIZE / 4;
+				std::vector<uint8_t> encoded(blocksWide * blocksWide * blockSize);
+
+				const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+				uint32_t block[16];
+				for (uint32_t blockY = 0; blockY < blocksWide; blockY++)
+				{
+					for (uint32_t blockX = 0; blockX < blocksWide; blockX++)
+					{
+						for (uint32_t i = 0; i < 16; i++)
+						{
+							block[i] = a_aPixels[(blockY * 4 + i / 4) * IMAGE_SIZE + blockX * 4 + i % 4];
+						}
+						cooking::EncodeBlock(a_Format, block, encoded.data() + (blockY * blocksWide + blockX) * blockSize, a_Quality);
+					}
+				}
+				a_fSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+				graphics::TextureData texture;
+				texture.m_iWidth = IMAGE_SIZE;
+				texture.m_iHeight = IMAGE_SIZE;
+				texture.m_iMipLevels = 1;
+				texture.m_Format = a_Format;
+				texture.m_Data = core::Data(encoded.data(), encoded.size());
+
+				std::vector<uint32_t> decoded;
+				if (!graphics::DecodeTextureMip(texture, 0, decoded) || decoded.size() != a_aPixels.size())
+				{
+					return 0.0;
+				}
+
+				const uint32_t channels = getComparedChannels(a_Format);
+				double squaredError = 0.0;
+				uint64_t samples = 0;
+				for (size_t i = 0; i < decoded.size(); i++)
+				{
+					for (uint32_t shift = 0; shift < 32; shift += 8)
+					{
+						if ((channels >> shift) & 0xFF)
+						{
+							const double difference = static_cast<double>((a_aPixels[i] >> shift) & 0xFF) - static_cast<double>((decoded[i] >> shift) & 0xFF);
+							squaredError += difference * difference;
+							samples++;
+						}
+					}
+				}
+
+				if (squaredError == 0.0)
+				{
+					return std::numeric_limits<double>::infinity();
+				}
+				return 10.0 * std::log10(255.0 * 255.0 / (squaredError / static_cast<double>(samples)));
+			}
+
+			/// <summary>
+			/// The fields of a BC7 mode 6 block, unpacked.
+			/// </summary>
+			struct Mode6Block
+			{
+				uint32_t m_aEndpoints[2][4] = {}; /// 7 bit RGBA of both endpoints.
+				uint32_t m_aPBits[2] = {};
+				uint32_t m_aIndices[16] = {};
+			};
+
+			//---------------------------------------------------------------------
+			uint32_t readBits(const uint8_t* a_pBlock, uint32_t& a_iOffset, uint32_t a_iCount)
+			{
+				uint32_t value = 0;
+				for (uint32_t i = 0; i < a_iCount; i++, a_iOffset++)
+				{
+					value |= ((a_pBlock[a_iOffset / 8] >> (a_iOffset % 8)) & 1u) << i;
+				}
+				return value;
+			}
+
+			//---------------------------------------------------------------------
+			void writeBits(uint8_t* a_pBlock, uint32_t& a_iOffset, uint32_t a_iCount, uint32_t a_iValue)
+			{
+				for (uint32_t i = 0; i < a_iCount; i++, a_iOffset++)
+				{
+					a_pBlock[a_iOffset / 8] |= static_cast<uint8_t>(((a_iValue >> i) & 1u) << (a_iOffset % 8));
+				}
+			}
+
+			//---------------------------------------------------------------------
+			bool unpackMode6(const uint8_t* a_pBlock, Mode6Block& a_Block)
+			{
+				uint32_t offset = 0;
+				if (readBits(a_pBlock, offset, 7) != 1u << 6)
+				{
+					return false;
+				}
+
+				for (uint32_t channel = 0; channel < 4; channel++)
+				{
+					a_Block.m_aEndpoints[0][channel] = readBits(a_pBlock, offset, 7);
+					a_Block.m_aEndpoints[1][channel] = readBits(a_pBlock, offset, 7);
+				}
+				a_Block.m_aPBits[0] = readBits(a_pBlock, offset, 1);
+				a_Block.m_aPBits[1] = readBits(a_pBlock, offset, 1);
+
+				// The anchor index drops its top bit, which is always zero.
+				for (uint32_t i = 0; i < 16; i++)
+				{
+					a_Block.m_aIndices[i] = readBits(a_pBlock, offset, i == 0 ? 3 : 4);
+				}
+				return true;
+			}
+
+			//---------------------------------------------------------------------
+			void packMode6(const Mode6Block& a_Block, uint8_t a_aBlock[16])
+			{
+				memset(a_aBlock, 0, 16);
+				uint32_t offset = 0;
+				writeBits(a_aBlock, offset, 7, 1u << 6);
+				for (uint32_t channel = 0; channel < 4; channel++)
+				{
+					writeBits(a_aBlock, offset, 7, a_Block.m_aEndpoints[0][channel]);
+					writeBits(a_aBlock, offset, 7, a_Block.m_aEndpoints[1][channel]);
+				}
+				writeBits(a_aBlock, offset, 1, a_Block.m_aPBits[0]);
+				writeBits(a_aBlock, offset, 1, a_Block.m_aPBits[1]);
+				for (uint32_t i = 0; i < 16; i++)
+				{
+					writeBits(a_aBlock, offset, i == 0 ? 3 : 4, a_Block.m_aIndices[i]);
+				}
+			}
+
+			//---------------------------------------------------------------------
+			uint32_t getMode6Pixel(const Mode6Block& a_Block, uint32_t a_iPixel)
+			{
+				static const uint32_t weights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+				const uint32_t weight = weights[a_Block.m_aIndices[a_iPixel]];
+
+				uint32_t pixel = 0;
+				for (uint32_t channel = 0; channel < 4; channel++)
+				{
+					const uint32_t value0 = a_Block.m_aEndpoints[0][channel] * 2 + a_Block.m_aPBits[0];
+					const uint32_t value1 = a_Block.m_aEndpoints[1][channel] * 2 + a_Block.m_aPBits[1];
+					pixel |= (((64 - weight) * value0 + weight * value1 + 32) >> 6) << (channel * 8);
+				}
+				return pixel;
+			}
+
+			/// <summary>
+			/// Generates mips on a job system of its own.
+			/// </summary>
+			/// <param name="a_aPixels">The pixels of the first mip.</param>
+			/// <param name="a_iWidth">The width of the first mip.</param>
+			/// <param name="a_iHeight">The height of the first mip.</param>
+			/// <param name="a_Filter">The filter to shrink with.</param>
+			/// <param name="a_bSRGB">Whether the color is stored as sRGB.</param>
+			/// <param name="a_bPremultiplyAlpha">Whether the mips are stored premultiplied.</param>
+			/// <returns>Every mip down to 1x1.</returns>
+			std::vector<cooking::MipImage> generateMips(const std::vector<uint32_t>& a_aPixels, uint32_t a_iWidth, uint32_t a_iHeight, cooking::MipFilter a_Filter, bool a_bSRGB, bool a_bPremultiplyAlpha)
+			{
+				cooking::MipSettings settings;
+				settings.m_Filter = a_Filter;
+				settings.m_bSRGB = a_bSRGB;
+				settings.m_bPremultiplyAlpha = a_bPremultiplyAlpha;
+
+				core::JobSystem jobSystem;
+				jobSystem.Initialize(2);
+
+				std::vector<cooking::MipImage> mips;
+				cooking::GenerateMips(a_aPixels, a_iWidth, a_iHeight, cooking::GetMipCount(a_iWidth, a_iHeight), settings, jobSystem, mips);
+
+				jobSystem.Destroy();
+				return mips;
+			}
+
+			//---------------------------------------------------------------------
+			uint32_t getRed(const cooking::MipImage& a_Mip, uint32_t a_iX, uint32_t a_iY)
+			{
+				return a_Mip.m_aPixels[a_iY * a_Mip.m_iWidth + a_iX] & 0xFF;
+			}
+		}
+
+		//---------------------------------------------------------------------
+		TEST_CASE(MeetsQualityFloorsOnGradientAndNoise)
+		{
+			const std::vector<uint32_t> gradient = createGradient();
+			const std::vector<uint32_t> noise = createNoise();
+			const double megapixels = static_cast<double>(IMAGE_SIZE * IMAGE_SIZE) / 1000000.0;
+
+			TESTF("Block compression runs with %s.", cooking::GetBlockCompressionInstructionSet());
+			const QualityFloor* lower = nullptr;
+			double lowerGradientPSNR = 0.0;
+			double lowerNoisePSNR = 0.0;
+			for (const QualityFloor& floor : g_aQualityFloors)
+			{
+				double gradientTime = 0.0;
+				double noiseTime = 0.0;
+				const double gradientPSNR = encodeAndMeasure(gradient, floor.m_Format, floor.m_Quality, gradientTime);
+				const double noisePSNR = encodeAndMeasure(noise, floor.m_Format, floor.m_Quality, noiseTime);
+
+				TESTF("%s %s: gradient %.2f dB, noise %.2f dB, %.2f MP/s.", cooking::GetTextureFormatName(floor.m_Format), getQualityName(floor.m_Quality),
+					gradientPSNR, noisePSNR, 2.0 * megapixels / std::max(gradientTime + noiseTime, 1e-9));
+				CHECK(gradientPSNR >= floor.m_fGradient);
+				CHECK(noisePSNR >= floor.m_fNoise);
+
+				// The floors of a format go from Fast to High, a higher quality never does worse.
+				if (lower && lower->m_Format == floor.m_Format)
+				{
+					CHECK(gradientPSNR >= lowerGradientPSNR);
+					CHECK(noisePSNR >= lowerNoisePSNR);
+				}
+				lower = &floor;
+				lowerGradientPSNR = gradientPSNR;
+				lowerNoisePSNR = noisePSNR;
+			}
+			return true;
+		}
+
+		//---------------------------------------------------------------------
+		TEST_CASE(DecodesHandPackedBC7Mode6)
+		{
+			// Red runs up the whole palette, green down, blue stays flat and alpha is opaque.
+			Mode6Block source;
+			const uint32_t endpoints[2][4] = { { 0, 127, 64, 127 }, { 127, 0, 64, 127 } };
+			memcpy(source.m_aEndpoints, endpoints, sizeof(endpoints));
+			source.m_aPBits[0] = 0;
+			source.m_aPBits[1] = 1;
+			for (uint32_t i = 0; i < 16; i++)
+			{
+				source.m_aIndices[i] = i;
+			}
+
+			uint8_t block[16];
+			packMode6(source, block);
+			CHECK(block[0] == 0x40);
+
+			uint32_t pixels[16];
+			graphics::DecodeBC7Block(block, pixels);
+			for (uint32_t i = 0; i < 16; i++)
+			{
+				CHECK(pixels[i] == getMode6Pixel(source, i));
+			}
+			CHECK((pixels[0] & 0xFF) == 0);
+			CHECK((pixels[15] & 0xFF) == 255);
+			CHECK(((pixels[0] >> 8) & 0xFF) == 254);
+			CHECK(((pixels[15] >> 8) & 0xFF) == 1);
+			return true;
+		}
+
+		//---------------------------------------------------------------------
+		TEST_CASE(RoundTripsBC7Mode6Packing)
+		{
+			const std::vector<uint32_t> noise = createNoise();
+			const std::vector<uint32_t> gradient = createGradient();
+			const cooking::CompressionQuality qualities[] = { cooking::CompressionQuality::Fast, cooking::CompressionQuality::Normal, cooking::CompressionQuality::High };
+
+			// High may pick modes 4 and 5, the other qualities always write mode 6.
+			for (cooking::CompressionQuality quality : { cooking::CompressionQuality::Fast, cooking::CompressionQuality::Normal })
+			{
+				for (uint32_t blockIndex = 0; blockIndex < 16; blockIndex++)
+				{
+					const std::vector<uint32_t>& image = blockIndex % 2 ? noise : gradient;
+					uint32_t pixels[16];
+					for (uint32_t i = 0; i < 16; i++)
+					{
+						pixels[i] = image[(blockIndex * 4 + i / 4) * IMAGE_SIZE + blockIndex * 4 + i % 4];
+					}
+
+					uint8_t encoded[16];
+					cooking::EncodeBC7Block(pixels, encoded, quality);
+
+					// Every field is read back the way the format lays them out and packed again into the same bits.
+					Mode6Block unpacked;
+					CHECK(unpackMode6(encoded, unpacked));
+
+					uint8_t repacked[16];
+					packMode6(unpacked, repacked);
+					CHECK(memcmp(encoded, repacked, sizeof(encoded)) == 0);
+
+					uint32_t decoded[16];
+					graphics::DecodeBC7Block(encoded, decoded);
+					for (uint32_t i = 0; i < 16; i++)
+					{
+						CHECK(decoded[i] == getMode6Pixel(unpacked, i));
+					}
+				}
+			}
+
+			// Two colors an endpoint can hold exactly come back without loss.
+			uint32_t twoColors[16];
+			for (uint32_t i = 0; i < 16; i++)
+			{
+				twoColors[i] = i % 3 ? 0xFF3365CB : 0x0064C8F0;
+			}
+			for (cooking::CompressionQuality quality : qualities)
+			{
+				uint8_t encoded[16];
+				cooking::EncodeBC7Block(twoColors, encoded, quality);
+
+				uint32_t decoded[16];
+				graphics::DecodeBC7Block(encoded, decoded);
+				CHECK(memcmp(decoded, twoColors, sizeof(decoded)) == 0);
+			}
+			return true;
+		}
+
+		//---------------------------------------------------------------------
+		TEST_CASE(HighBC7KeepsTheBestMode)
+		{
+			const auto getError = [](const uint32_t a_aPixels[16], cooking::CompressionQuality a_Quality, uint32_t& a_iMode)
+				{
+					uint8_t encoded[16];
+					cooking::EncodeBC7Block(a_aPixels, encoded, a_Quality);
+					a_iMode = static_cast<uint32_t>(std::countr_zero(encoded[0]));
+
+					uint32_t decoded[16];
+					graphics::DecodeBC7Block(encoded, decoded);
+					uint64_t error = 0;
+					for (uint32_t i = 0; i < 16; i++)
+					{
+						for (uint32_t channel = 0; channel < 4; channel++)
+						{
+							const int32_t difference = static_cast<int32_t>((a_aPixels[i] >> (channel * 8)) & 0xFF) - static_cast<int32_t>((decoded[i] >> (channel * 8)) & 0xFF);
+							error += static_cast<uint64_t>(difference * difference);
+						}
+					}
+					return error;
+				};
+
+			// Every block of the noise does at least as well as with Normal, and some of them are better off with modes 4 or 5.
+			const std::vector<uint32_t> noise = createNoise();
+			uint32_t separateAlphaBlocks = 0;
+			for (uint32_t blockY = 0; blockY < IMAGE_SIZE / 4; blockY++)
+			{
+				for (uint32_t blockX = 0; blockX < IMAGE_SIZE / 4; blockX++)
+				{
+					uint32_t pixels[16];
+					for (uint32_t i = 0; i < 16; i++)
+					{
+						pixels[i] = noise[(blockY * 4 + i / 4) * IMAGE_SIZE + blockX * 4 + i % 4];
+					}
+
+					uint32_t normalMode = 0;
+					uint32_t highMode = 0;
+					CHECK(getError(pixels, cooking::CompressionQuality::High, highMode) <= getError(pixels, cooking::CompressionQuality::Normal, normalMode));
+					CHECK(normalMode == 6 && highMode >= 4 && highMode <= 6);
+					separateAlphaBlocks += highMode == 6 ? 0 : 1;
+				}
+			}
+			CHECK(separateAlphaBlocks > 0);
+
+			// A color ramp under a checkerboard alpha: the alpha steps do not follow the color, so one set of indices can not
+			// hold both.
+			uint32_t ramp[16];
+			for (uint32_t i = 0; i < 16; i++)
+			{
+				const uint32_t alpha = ((i / 4 + i % 4) % 2) ? 255 : 0;
+				ramp[i] = (i * 16) | ((255 - i * 16) << 8) | (128 << 16) | (alpha << 24);
+			}
+			uint32_t normalMode = 0;
+			uint32_t highMode = 0;
+			const uint64_t normalError = getError(ramp, cooking::CompressionQuality::Normal, normalMode);
+			const uint64_t highError = getError(ramp, cooking::CompressionQuality::High, highMode);
+			TESTF("Ramp under a checkerboard: mode 6 error %llu, mode %u error %llu.", static_cast<unsigned long long>(normalError), highMode,
+				static_cast<unsigned long long>(highError));
+			CHECK(highMode == 4 || highMode == 5);
+			CHECK(highError * 10 < normalError);
+			return true;
+		}
+
+		//---------------------------------------------------------------------
+		TEST_CASE(RejectsCookedTexturesWithTooManyMips)
+		{
+			// The mip count of a file is checked before the sides get shifted by it.
+			graphics::CookedTextureHeader header;
+			header.m_iWidth = UINT32_MAX;
+			header.m_iHeight = 1;
+			std::vector<uint8_t> file(sizeof(header) + 64);
+
+			for (uint16_t mipLevels : { uint16_t(33), uint16_t(64), uint16_t(UINT16_MAX) })
+			{
+				header.m_iMipLevels = mipLevels;
+				memcpy(file.data(), &header, sizeof(header));
+				graphics::TextureData texture;
+				CHECK(!graphics::ReadTextureFile(core::Data(file.data(), file.size()), texture));
+			}
+
+			// Past the last mip every side is 1, shifting does not wrap back to the full size.
+			graphics::TextureData texture;
+			texture.m_iWidth = UINT32_MAX;
+			texture.m_iHeight = 8;
+			CHECK(graphics::GetTextureMipSize(texture, 31) == 4);
+			CHECK(graphics::GetTextureMipSize(texture, 32) == 4);
+			CHECK(graphics::GetTextureMipSize(texture, 40) == 4);
+
+			// A 1x1 texture with a single mip still reads.
+			header.m_iWidth = 1;
+			header.m_iMipLevels = 1;
+			header.m_iDataSize = 4;
+			file.resize(sizeof(header) + 4);
+			memcpy(file.data(), &header, sizeof(header));
+			CHECK(graphics::ReadTextureFile(core::Data(file.data(), file.size()), texture) && texture.m_iWidth == 1);
+			return true;
+		}
+
+		//---------------------------------------------------------------------
+		TEST_CASE(BoxMipsAverageInLinearSpace)
+		{
+			// Black and white columns average to half the light, which sRGB stores as 188.
+			std::vector<uint32_t> stripes(8 * 8);
+			for (uint32_t i = 0; i < stripes.size(); i++)
+			{
+				stripes[i] = i % 2 ? 0xFFFFFFFF : 0xFF000000;
+			}
+			std::vector<cooking::MipImage> mips = generateMips(stripes, 8, 8, cooking::MipFilter::Box, true, true);
+			CHECK(mips.size() == 4);
+			for (const cooking::MipImage& mip : mips)
+			{
+				CHECK(mip.m_aPixels.size() == static_cast<size_t>(mip.m_iWidth) * mip.m_iHeight);
+			}
+			for (size_t mip = 1; mip < mips.size(); mip++)
+			{
+				for (uint32_t pixel : mips[mip].m_aPixels)
+				{
+					CHECK(pixel == 0xFFBCBCBC);
+				}
+			}
+
+			// Stored linearly, a ramp shrinks to the middle of each pair of pixels.
+			std::vector<uint32_t> ramp(32 * 4);
+			for (uint32_t i = 0; i < ramp.size(); i++)
+			{
+				ramp[i] = 0xFF000000 | ((i % 32) * 8);
+			}
+			mips = generateMips(ramp, 32, 4, cooking::MipFilter::Box, false, false);
+			CHECK(mips[1].m_iWidth == 16 && mips[1].m_iHeight == 2);
+			for (uint32_t x = 0; x < 16; x++)
+			{
+				CHECK(getRed(mips[1], x, 0) == 16 * x + 4);
+				CHECK(getRed(mips[1], x, 1) == 16 * x + 4);
+			}
+
+			// Transparent red must not bleed into the opaque green next to it.
+			const std::vector<uint32_t> edge = { 0x000000FF, 0xFF00FF00, 0x000000FF, 0xFF00FF00 };
+			mips = generateMips(edge, 2, 2, cooking::MipFilter::Box, false, false);
+			CHECK(mips[1].m_aPixels[0] == 0x8000FF00);
+
+			// Premultiplied mips store the color already scaled by alpha.
+			mips = generateMips(edge, 2, 2, cooking::MipFilter::Box, false, true);
+			CHECK(mips[0].m_aPixels[0] == 0x00000000);
+			CHECK(mips[1].m_aPixels[0] == 0x80008000);
+			return true;
+		}
+
+		//---------------------------------------------------------------------
+		TEST_CASE(KaiserMipsMatchReference)
+		{
+			// The normalized kernel keeps flat color flat, all the way down to 1x1.
+			const std::vector<uint32_t> flat(16 * 16, 0xC0306090);
+			std::vector<cooking::MipImage> mips = generateMips(flat, 16, 16, cooking::MipFilter::Kaiser, true, false);
+			CHECK(mips.size() == 5);
+			for (const cooking::MipImage& mip : mips)
+			{
+				for (uint32_t pixel : mip.m_aPixels)
+				{
+					CHECK(pixel == 0xC0306090);
+				}
+			}
+
+			// The kernel is symmetric, so away from the edges a linear ramp comes out exactly like the box filter makes it.
+			std::vector<uint32_t> ramp(32 * 4);
+			for (uint32_t i = 0; i < ramp.size(); i++)
+			{
+				ramp[i] = 0xFF000000 | ((i % 32) * 8);
+			}
+			mips = generateMips(ramp, 32, 4, cooking::MipFilter::Kaiser, false, false);
+			for (uint32_t x = 2; x < 14; x++)
+			{
+				CHECK(getRed(mips[1], x, 0) == 16 * x + 4);
+			}
+
+			// Next to a step the negative lobes ring below and above the two levels, where the box filter stays flat.
+			std::vector<uint32_t> step(32 * 4);
+			for (uint32_t i = 0; i < step.size(); i++)
+			{
+				step[i] = 0xFF000000 | (i % 32 < 16 ? 64 : 192);
+			}
+			mips = generateMips(step, 32, 4, cooking::MipFilter::Kaiser, false, false);
+			const uint32_t reference[16] = { 64, 64, 64, 64, 64, 64, 62, 72, 184, 194, 192, 192, 192, 192, 192, 192 };
+			for (uint32_t x = 0; x < 16; x++)
+			{
+				CHECK(getRed(mips[1], x, 0) == reference[x]);
+			}
+			return true;
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,48 @@
+#include <vector>
+
+#include "TestRunner.h"
+#include "core/Compression.h"
+
+namespace gallus
+{
+	namespace tests
+	{
+		//---------------------------------------------------------------------
+		TEST_CASE(RoundTripsRepeatingAndRandomData)
+		{
+			std::vector<uint8_t> source(100000);
+			uint32_t state = 12345;
+			for (size_t i = 0; i < source.size(); i++)
+			{
+				// The first half repeats a short pattern, the second half does not compress.
+				state = state * 1664525u + 1013904223u;
+				source[i] = i < source.size() / 2 ? static_cast<uint8_t>(i % 7) : static_cast<uint8_t>(state >> 24);
+			}
+
+			std::vector<uint8_t> compressed;
+			core::CompressLZ(source.data(), source.size(), compressed);
+
+			std::vector<uint8_t> decompressed(source.size());
+			CHECK(core::DecompressLZ(compressed.data(), compressed.size(), decompressed.data(), decompressed.size()));
+			CHECK(decompressed == source);
+
+			// A destination of the wrong size is rejected rather than partly filled.
+			decompressed.resize(source.size() - 1);
+			CHECK(!core::DecompressLZ(compressed.data(), compressed.size(), decompressed.data(), decompressed.size()));
+			return true;
+		}
+
+		//---------------------------------------------------------------------
+		TEST_CASE(MaxDecompressedSizeHoldsForZeros)
+		{
+			// Zeros compress into long matches, the best ratio the format has.
+			const std::vector<uint8_t> source(1 << 20, 0);
+			std::vector<uint8_t> compressed;
+			core::CompressLZ(source.data(), source.size(), compressed);
+
+			CHECK(source.size() <= core::GetMaxDecompressedSizeLZ(compressed.size()));
+			CHECK(core::GetMaxDecompressedSizeLZ(SIZE_MAX) == SIZE_MAX);
+			return true;
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,456 @@
+#include <atomic>
+
+#include "TestRunner.h"
+#include "core/JobSystem.h"
+#include "core/Memory.h"
+#include "gameplay/EntityComponentSystem.h"
+#include "gameplay/ECSBaseSystem.h"
+
+namespace gallus
+{
+	namespace tests
+	{
+		namespace
+		{
+			class LookupComponent : public gameplay::Component
+			{
+			public:
+				void Serialize(rapidjson::Value&, rapidjson::Document::AllocatorType&) const override
+				{}
+
+				void Deserialize(const rapidjson::Value&, rapidjson::Document::AllocatorType&) override
+				{}
+			};
+
+			/// <summary>
+			/// System that looks up its entities through the ECS from a job worker, while the ECS is updating.
+			/// </summary>
+			class LookupSystem : public gameplay::ECSBaseSystem<LookupComponent>
+			{
+			public:
+				std::string GetPropertyName() const override
+				{
+					return "lookup";
+				}
+
+				std::string GetSystemName() const override
+				{
+					return "Lookup";
+				}
+
+				void Update(float) override
+				{
+					if (!m_pJobSystem)
+					{
+						return;
+					}
+
+					// The job only runs on a worker, since nothing here helps out while waiting for it.
+					std::atomic<bool> done = false;
+					m_pJobSystem->Schedule([this, &done]()
+						{
+							for (const gameplay::EntityID& id : GetComponentEntities())
+							{
+								if (m_pECS->IsEntityValid(id) && m_pECS->GetEntity(id))
+								{
+									m_iFoundCount++;
+								}
+							}
+							done.store(true);
+						});
+
+					while (!done.load())
+					{
+						std::this_thread::yield();
+					}
+				}
+
+				core::JobSystem* m_pJobSystem = nullptr;
+				std::atomic<uint32_t> m_iFoundCount = 0;
+			};
+
+			class QueryComponent : public gameplay::Component
+			{
+			public:
+				void Serialize(rapidjson::Value&, rapidjson::Document::AllocatorType&) const override
+				{}
+
+				void Deserialize(const rapidjson::Value&, rapidjson::Document::AllocatorType&) override
+				{}
+			};
+
+			/// <summary>
+			/// System that deletes one of its entities between two queries of the same update.
+			/// </summary>
+			class QuerySystem : public gameplay::ECSBaseSystem<QueryComponent>
+			{
+			public:
+				std::string GetPropertyName() const override
+				{
+					return "query";
+				}
+
+				std::string GetSystemName() const override
+				{
+					return "Query";
+				}
+
+				void Update(float) override
+				{
+					const gameplay::QueryResult<QueryComponent>& before = m_pECS->Query<QueryComponent>();
+					m_iSizeBefore = before.size();
+					if (!before.empty())
+					{
+						m_pECS->DeleteEntity(std::get<0>(before.front()));
+					}
+
+					const gameplay::QueryResult<QueryComponent>& after = m_pECS->Query<QueryComponent>();
+					m_bFrozen = &after == &before && after.size() == m_iSizeBefore;
+				}
+
+				size_t m_iSizeBefore = 0;
+				bool m_bFrozen = false;
+			};
+
+			class TrackedComponent : public gameplay::Component
+			{
+			public:
+				void Serialize(rapidjson::Value&, rapidjson::Document::AllocatorType&) const override
+				{}
+
+				void Deserialize(const rapidjson::Value&, rapidjson::Document::AllocatorType&) override
+				{}
+
+				uint32_t m_iValue = 0;
+			};
+
+			/// <summary>
+			/// System that records the components that were added or changed since its previous update.
+			/// </summary>
+			class TrackingSystem : public gameplay::ECSBaseSystem<TrackedComponent>
+			{
+			public:
+				std::string GetPropertyName() const override
+				{
+					return "tracking";
+				}
+
+				std::string GetSystemName() const override
+				{
+					return "Tracking";
+				}
+
+				void Update(float) override
+				{
+					m_aAdded.clear();
+					m_aChanged.clear();
+					m_aQueryChanged.clear();
+					ForEach<gameplay::Added<TrackedComponent>>(GetLastRunTick(), [this](const gameplay::EntityID& a_ID, const TrackedComponent&)
+						{
+							m_aAdded.push_back(a_ID);
+						});
+					ForEach<gameplay::Changed<TrackedComponent>>(GetLastRunTick(), [this](const gameplay::EntityID& a_ID, const TrackedComponent&)
+						{
+							m_aChanged.push_back(a_ID);
+						});
+					m_pECS->ForEach<gameplay::Changed<TrackedComponent>, TrackedComponent>(GetLastRunTick(), [this](const gameplay::EntityID& a_ID, TrackedComponent*)
+						{
+							m_aQueryChanged.push_back(a_ID);
+						});
+				}
+
+				std::vector<gameplay::EntityID> m_aAdded;
+				std::vector<gameplay::EntityID> m_aChanged;
+				std::vector<gameplay::EntityID> m_aQueryChanged;
+			};
+		}
+
+		//---------------------------------------------------------------------
+		TEST_CASE(LookupEntitiesFromWorkerDuringUpdate)
+		{
+			core::JobSystem jobSystem;
+			jobSystem.Initialize(2);
+
+			gameplay::EntityComponentSystem ecs;
+			ecs.SetJobSystem(&jobSystem);
+			ecs.Initialize();
+
+			LookupSystem& system = ecs.CreateSystem<LookupSystem>();
+			system.m_pJobSystem = &jobSystem;
+			for (const gameplay::EntityID& id : ecs.CreateEntities(16, "Lookup"))
+			{
+				system.GetComponent(id);
+			}
+
+			// The game thread holds m_EntityMutex during the update, the worker must not wait for it.
+			ecs.Update(0.0f);
+			const uint32_t foundCount = system.m_iFoundCount.load();
+
+			ecs.Destroy();
+			jobSystem.Destroy();
+
+			CHECK(foundCount == 16);
+			return true;
+		}
+
+		//---------------------------------------------------------------------
+		TEST_CASE(QueriesStayFrozenDuringUpdate)
+		{
+			core::JobSystem jobSystem;
+			jobSystem.Initialize(2);
+
+			gameplay::EntityComponentSystem ecs;
+			ecs.SetJobSystem(&jobSystem);
+			ecs.Initialize();
+
+			// A second system makes the ECS update the systems on the workers.
+			ecs.CreateSystem<LookupSystem>();
+			QuerySystem& system = ecs.CreateSystem<QuerySystem>();
+			for (const gameplay::EntityID& id : ecs.CreateEntities(8, "Query"))
+			{
+				system.GetComponent(id);
+			}
+
+			// The entity deleted during the update stays in the results that other systems may still be iterating.
+			ecs.Update(0.0f);
+			const size_t firstSize = system.m_iSizeBefore;
+			const bool firstFrozen = system.m_bFrozen;
+			const size_t afterUpdate = ecs.Query<QueryComponent>().size();
+
+			ecs.Update(0.0f);
+			const size_t secondSize = system.m_iSizeBefore;
+			const bool secondFrozen = system.m_bFrozen;
+
+			ecs.Destroy();
+			jobSystem.Destroy();
+
+			CHECK(firstSize == 8 && firstFrozen);
+			CHECK(afterUpdate == 7);
+			CHECK(secondSize == 7 && secondFrozen);
+			return true;
+		}
+
+		//---------------------------------------------------------------------
+		TEST_CASE(QueriesPickUpAddedAndRemovedComponents)
+		{
+			gameplay::EntityComponentSystem ecs;
+			ecs.Initialize();
+
+			LookupSystem& lookupSystem = ecs.CreateSystem<LookupSystem>();
+			TrackingSystem& trackingSystem = ecs.CreateSystem<TrackingSystem>();
+			const gameplay::EntityID first = ecs.CreateEntity("First");
+			const gameplay::EntityID second = ecs.CreateEntity("Second");
+			lookupSystem.GetComponent(first);
+			lookupSystem.GetComponent(second);
+			trackingSystem.GetComponent(second);
+
+			// Both queries are cached before the entity that matches only one of them changes.
+			const size_t lookupMatches = ecs.Query<LookupComponent>().size();
+			const size_t bothMatches = ecs.Query<LookupComponent, TrackedComponent>().size();
+			CHECK(lookupMatches == 2 && bothMatches == 1);
+
+			trackingSystem.GetComponent(first);
+			const gameplay::QueryResult<LookupComponent, TrackedComponent>& afterAdd = ecs.Query<LookupComponent, TrackedComponent>();
+			CHECK(afterAdd.size() == 2);
+			CHECK(std::get<2>(afterAdd[0]) == trackingSystem.TryGetComponent(std::get<0>(afterAdd[0])));
+			CHECK(std::get<2>(afterAdd[1]) == trackingSystem.TryGetComponent(std::get<0>(afterAdd[1])));
+
+			// Removed components leave the results once the removal is applied, which also moves the remaining ones.
+			trackingSystem.DeleteComponent(second);
+			ecs.Update(0.0f);
+			const gameplay::QueryResult<LookupComponent, TrackedComponent>& afterRemove = ecs.Query<LookupComponent, TrackedComponent>();
+			CHECK(afterRemove.size() == 1 && std::get<0>(afterRemove[0]) == first);
+			CHECK(std::get<2>(afterRemove[0]) == trackingSystem.TryGetComponent(first));
+			CHECK(ecs.Query<LookupComponent>().size() == 2);
+
+			ecs.Destroy();
+			return true;
+		}
+
+		//---------------------------------------------------------------------
+		TEST_CASE(GetComponentAfterDeleteKeepsComponent)
+		{
+			gameplay::EntityComponentSystem ecs;
+			ecs.Initialize();
+
+			LookupSystem& system = ecs.CreateSystem<LookupSystem>();
+			const gameplay::EntityID id = ecs.CreateEntity("Deleted");
+			system.GetComponent(id);
+			system.DeleteComponent(id);
+			system.GetComponent(id);
+			ecs.Update(0.0f);
+
+			const bool hasComponent = system.HasComponent(id) && !system.GetComponent(id).IsDestroyed();
+			ecs.Destroy();
+
+			CHECK(hasComponent);
+			return true;
+		}
+
+		//---------------------------------------------------------------------
+		TEST_CASE(UniqueNamesStartOverAfterClear)
+		{
+			gameplay::EntityComponentSystem ecs;
+			ecs.Initialize();
+
+			for (uint32_t i = 0; i < 3; i++)
+			{
+				ecs.CreateEntity(ecs.GetUniqueName("Sprite"));
+			}
+
+			// A scene that gets loaded right after clearing gets the names of the scene it replaces.
+			ecs.Clear();
+			const std::string afterClear = ecs.GetUniqueName("Sprite");
+			ecs.Update(0.0f);
+			ecs.Destroy();
+
+			CHECK(afterClear == "Sprite");
+			return true;
+		}
+
+		//---------------------------------------------------------------------
+		TEST_CASE(UniqueNamesStartOverAfterLastEntity)
+		{
+			gameplay::EntityComponentSystem ecs;
+			ecs.Initialize();
+
+			std::vector<gameplay::EntityID> ids;
+			for (uint32_t i = 0; i < 3; i++)
+			{
+				ids.push_back(ecs.CreateEntity(ecs.GetUniqueName("Sprite")));
+			}
+			ecs.DeleteEntities(ids);
+			ecs.Update(0.0f);
+
+			ecs.CreateEntity(ecs.GetUniqueName("Sprite"));
+			const std::string secondName = ecs.GetUniqueName("Sprite");
+			ecs.Destroy();
+
+			CHECK(secondName == "Sprite (1)");
+			return true;
+		}
+
+		//---------------------------------------------------------------------
+		TEST_CASE(ParallelForEachChunksStartAtCacheLines)
+		{
+			// Sizes that do not divide a cache line still get chunks of whole lines.
+			struct Size24 { uint8_t m_aData[24]; };
+			struct Size40 { uint8_t m_aData[40]; };
+			struct Size100 { uint8_t m_aData[100]; };
+			CHECK(core::CacheLineGranularity<uint32_t>() == 16);
+			CHECK(core::CacheLineGranularity<Size24>() == 8);
+			CHECK(core::CacheLineGranularity<Size40>() == 8);
+			CHECK(core::CacheLineGranularity<Size100>() == 16);
+			CHECK(core::CacheLineGranularity<Size100>() * sizeof(Size100) % core::CACHE_LINE_SIZE == 0);
+
+			core::JobSystem jobSystem;
+			jobSystem.Initialize(2);
+
+			gameplay::EntityComponentSystem ecs;
+			ecs.Initialize();
+
+			LookupSystem& system = ecs.CreateSystem<LookupSystem>();
+			for (const gameplay::EntityID& id : ecs.CreateEntities(1000, "Chunk"))
+			{
+				system.GetComponent(id);
+			}
+
+			const uintptr_t first = reinterpret_cast<uintptr_t>(system.GetComponents().data());
+			const size_t chunkBytes = core::CacheLineGranularity<LookupComponent>() * sizeof(LookupComponent);
+			std::atomic<uint32_t> visited = 0;
+			std::atomic<uint32_t> misaligned = 0;
+			system.ParallelForEach(jobSystem, [&](const gameplay::EntityID&, LookupComponent& a_Component)
+				{
+					// The first component of every chunk starts a cache line.
+					const uintptr_t offset = reinterpret_cast<uintptr_t>(&a_Component) - first;
+					if (offset % chunkBytes == 0 && reinterpret_cast<uintptr_t>(&a_Component) % core::CACHE_LINE_SIZE != 0)
+					{
+						misaligned++;
+					}
+					visited++;
+				});
+
+			ecs.Destroy();
+			jobSystem.Destroy();
+
+			CHECK(first % core::CACHE_LINE_SIZE == 0);
+			CHECK(misaligned.load() == 0);
+			CHECK(visited.load() == 1000);
+			return true;
+		}
+
+		//---------------------------------------------------------------------
+		TEST_CASE(ChangeFiltersSeeEachChangeOnce)
+		{
+			gameplay::EntityComponentSystem ecs;
+			ecs.Initialize();
+
+			TrackingSystem& system = ecs.CreateSystem<TrackingSystem>();
+			const gameplay::EntityID first = ecs.CreateEntity("First");
+			const gameplay::EntityID second = ecs.CreateEntity("Second");
+			system.GetComponent(first);
+
+			ecs.Update(0.0f);
+			CHECK(system.m_aAdded.size() == 1 && system.m_aAdded[0] == first);
+			CHECK(system.m_aChanged.size() == 1 && system.m_aQueryChanged.size() == 1);
+
+			// Nothing happened since the previous update.
+			ecs.Update(0.0f);
+			CHECK(system.m_aAdded.empty() && system.m_aChanged.empty() && system.m_aQueryChanged.empty());
+
+			// A component added after the last run shows up once, as added and as changed.
+			system.GetComponent(second);
+			ecs.Update(0.0f);
+			CHECK(system.m_aAdded.size() == 1 && system.m_aAdded[0] == second);
+			CHECK(system.m_aChanged.size() == 1 && system.m_aChanged[0] == second);
+			ecs.Update(0.0f);
+			CHECK(system.m_aAdded.empty() && system.m_aChanged.empty());
+
+			// Reading does not count as a change, writing through the mutable accessor does.
+			system.TryGetComponent(first);
+			ecs.Update(0.0f);
+			CHECK(system.m_aChanged.empty());
+
+			system.GetComponent(first).m_iValue = 1;
+			ecs.Update(0.0f);
+			CHECK(system.m_aAdded.empty());
+			CHECK(system.m_aChanged.size() == 1 && system.m_aChanged[0] == first);
+			CHECK(system.m_aQueryChanged.size() == 1 && system.m_aQueryChanged[0] == first);
+
+			// Writes through TryGetComponent are only seen once they are marked.
+			system.TryGetComponent(second)->m_iValue = 2;
+			system.MarkChanged(second);
+			ecs.Update(0.0f);
+			CHECK(system.m_aChanged.size() == 1 && system.m_aChanged[0] == second);
+
+			ecs.Destroy();
+			return true;
+		}
+
+		//---------------------------------------------------------------------
+		TEST_CASE(ChangeFiltersHandleTickWraparound)
+		{
+			using gameplay::Added;
+			using gameplay::Changed;
+
+			CHECK(gameplay::IsNewerTick(5, 0xFFFFFFF0));
+			CHECK(!gameplay::IsNewerTick(0xFFFFFFF0, 5));
+			CHECK(gameplay::IsNewerTick(0, UINT32_MAX));
+			CHECK(!gameplay::IsNewerTick(7, 7));
+
+			// Components stamped on both sides of the wrap, filtered with a tick from before it.
+			gameplay::SparseSet<uint32_t> set;
+			set.Emplace(gameplay::EntityID(0, 0), 0xFFFFFFF8);
+			set.Emplace(gameplay::EntityID(1, 0), 3);
+			set.MarkChanged(0, 2);
+
+			const std::vector<gameplay::ComponentTicks>& ticks = set.GetTicks();
+			CHECK(Added<uint32_t>::Matches(ticks[0], 0xFFFFFFF0) && Added<uint32_t>::Matches(ticks[1], 0xFFFFFFF0));
+			CHECK(!Added<uint32_t>::Matches(ticks[0], 0xFFFFFFFC) && Added<uint32_t>::Matches(ticks[1], 0xFFFFFFFC));
+			CHECK(Changed<uint32_t>::Matches(ticks[0], 0xFFFFFFFC) && Changed<uint32_t>::Matches(ticks[1], 0xFFFFFFFC));
+			CHECK(!Changed<uint32_t>::Matches(ticks[0], 2) && Changed<uint32_t>::Matches(ticks[1], 2));
+			CHECK(!Changed<uint32_t>::Matches(ticks[0], 3) && !Changed<uint32_t>::Matches(ticks[1], 3));
+			return true;
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,183 @@
+#include "TestRunner.h"
+#include "core/RingAllocator.h"
+
+namespace gallus
+{
+	namespace tests
+	{
+		namespace
+		{
+			/// <summary>
+			/// Stands in for a gpu fence: executing hands out the next value, the gpu completes them in order whenever the test says so.
+			/// </summary>
+			struct FakeFence
+			{
+				uint64_t m_iLastSignalled = 0;
+				uint64_t m_iCompleted = 0;
+
+				uint64_t Execute(core::RingAllocator& a_Ring, uint64_t a_iOwner)
+				{
+					a_Ring.Finish(a_iOwner, ++m_iLastSignalled);
+					return m_iLastSignalled;
+				}
+
+				void Complete(core::RingAllocator& a_Ring, uint64_t a_iFenceValue)
+				{
+					m_iCompleted = a_iFenceValue;
+					a_Ring.ReleaseCompleted(m_iCompleted);
+				}
+			};
+
+			constexpr uint64_t OWNER_A = 1;
+			constexpr uint64_t OWNER_B = 2;
+		}
+
+		//---------------------------------------------------------------------
+		TEST_CASE(ReleasesInFenceOrder)
+		{
+			core::RingAllocator ring;
+			ring.Reset(1024);
+			FakeFence fence;
+
+			CHECK(ring.Allocate(256, 1, OWNER_A) == 0);
+			const uint64_t first = fence.Execute(ring, OWNER_A);
+			CHECK(ring.Allocate(256, 1, OWNER_A) == 256);
+			const uint64_t second = fence.Execute(ring, OWNER_A);
+			CHECK(ring.GetBlockCount() == 2);
+
+			// Nothing completed yet, nothing gets released.
+			fence.Complete(ring, 0);
+			CHECK(ring.GetUsedSize() == 512);
+
+			fence.Complete(ring, first);
+			CHECK(ring.GetUsedSize() == 256);
+			CHECK(ring.GetBlockCount() == 1);
+
+			fence.Complete(ring, second);
+			CHECK(ring.GetUsedSize() == 0);
+			CHECK(ring.GetBlockCount() == 0);
+
+			// An empty ring starts over from the beginning.
+			CHECK(ring.Allocate(64, 1, OWNER_A) == 0);
+			return true;
+		}
+
+		//---------------------------------------------------------------------
+		TEST_CASE(UnfinishedOwnerIsNotReleased)
+		{
+			core::RingAllocator ring;
+			ring.Reset(1024);
+			FakeFence fence;
+
+			// Two command lists record at the same time, only the second one gets executed.
+			CHECK(ring.Allocate(128, 1, OWNER_A) == 0);
+			CHECK(ring.Allocate(128, 1, OWNER_B) == 128);
+			CHECK(ring.Allocate(128, 1, OWNER_A) == 256);
+			CHECK(ring.GetBlockCount() == 3);
+
+			const uint64_t fenceB = fence.Execute(ring, OWNER_B);
+			fence.Complete(ring, fenceB);
+
+			// The allocations of A are still being recorded, so B's block in between them stays in use.
+			CHECK(ring.GetUsedSize() == 384);
+
+			const uint64_t fenceA = fence.Execute(ring, OWNER_A);
+			fence.Complete(ring, fenceA);
+			CHECK(ring.GetUsedSize() == 0);
+			CHECK(ring.GetBlockCount() == 0);
+			return true;
+		}
+
+		//---------------------------------------------------------------------
+		TEST_CASE(OwnersFinishOutOfOrder)
+		{
+			core::RingAllocator ring;
+			ring.Reset(1024);
+			FakeFence fence;
+
+			CHECK(ring.Allocate(128, 1, OWNER_A) == 0);
+			CHECK(ring.Allocate(128, 1, OWNER_B) == 128);
+
+			// B gets executed before A, which was allocated first.
+			const uint64_t fenceB = fence.Execute(ring, OWNER_B);
+			const uint64_t fenceA = fence.Execute(ring, OWNER_A);
+			CHECK(fenceA > fenceB);
+
+			// Only B is done, the tail stops at A.
+			fence.Complete(ring, fenceB);
+			CHECK(ring.GetUsedSize() == 256);
+
+			fence.Complete(ring, fenceA);
+			CHECK(ring.GetUsedSize() == 0);
+
+			// Allocating after a finish starts a new block, even for the same owner.
+			CHECK(ring.Allocate(64, 1, OWNER_A) == 0);
+			fence.Execute(ring, OWNER_A);
+			CHECK(ring.Allocate(64, 1, OWNER_A) == 64);
+			CHECK(ring.GetBlockCount() == 2);
+			return true;
+		}
+
+		//---------------------------------------------------------------------
+		TEST_CASE(AlignsAndWrapsAround)
+		{
+			core::RingAllocator ring;
+			ring.Reset(1024);
+			FakeFence fence;
+
+			CHECK(ring.Allocate(100, 1, OWNER_A) == 0);
+			CHECK(ring.Allocate(100, 256, OWNER_A) == 256);
+			CHECK(ring.GetUsedSize() == 356);
+			const uint64_t first = fence.Execute(ring, OWNER_A);
+
+			CHECK(ring.Allocate(512, 1, OWNER_B) == 356);
+			const uint64_t second = fence.Execute(ring, OWNER_B);
+			fence.Complete(ring, first);
+			CHECK(ring.GetUsedSize() == 512);
+
+			// 156 bytes are left at the end, which is not enough, so the range starts over at the beginning and skips them.
+			CHECK(ring.Allocate(200, 1, OWNER_A) == 0);
+			CHECK(ring.GetUsedSize() == 512 + 156 + 200);
+
+			// The space between the head and the tail is all that is left.
+			CHECK(ring.Allocate(200, 1, OWNER_A) == core::RingAllocator::INVALID_OFFSET);
+			CHECK(ring.Allocate(156, 1, OWNER_A) == 200);
+			const uint64_t third = fence.Execute(ring, OWNER_A);
+
+			// The skipped end of the ring belongs to the block that wrapped around, not to the one before it.
+			fence.Complete(ring, second);
+			CHECK(ring.GetUsedSize() == 156 + 200 + 156);
+			fence.Complete(ring, third);
+			CHECK(ring.GetUsedSize() == 0);
+			return true;
+		}
+
+		//---------------------------------------------------------------------
+		TEST_CASE(FullRingFailsUntilReleased)
+		{
+			core::RingAllocator ring;
+			ring.Reset(512);
+			FakeFence fence;
+
+			CHECK(ring.Allocate(0, 1, OWNER_A) == core::RingAllocator::INVALID_OFFSET);
+			CHECK(ring.Allocate(1024, 1, OWNER_A) == core::RingAllocator::INVALID_OFFSET);
+
+			CHECK(ring.Allocate(512, 1, OWNER_A) == 0);
+			CHECK(ring.Allocate(1, 1, OWNER_B) == core::RingAllocator::INVALID_OFFSET);
+
+			const uint64_t fenceA = fence.Execute(ring, OWNER_A);
+			CHECK(ring.Allocate(1, 1, OWNER_B) == core::RingAllocator::INVALID_OFFSET);
+
+			fence.Complete(ring, fenceA);
+			CHECK(ring.Allocate(1, 1, OWNER_B) == 0);
+
+			// Resetting drops the unfinished allocation as well.
+			ring.Reset(256);
+			CHECK(ring.GetCapacity() == 256);
+			CHECK(ring.GetUsedSize() == 0);
+			CHECK(ring.GetBlockCount() == 0);
+			CHECK(ring.Allocate(256, 1, OWNER_A) == 0);
+			return true;
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,178 @@
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "TestRunner.h"
+#include "core/SlotPool.h"
+
+namespace gallus
+{
+	namespace tests
+	{
+		namespace
+		{
+			using Pool = core::SlotPool<uint32_t>;
+			using Handle = Pool::Handle;
+		}
+
+		//---------------------------------------------------------------------
+		TEST_CASE(StaleHandlesStopResolving)
+		{
+			Pool pool;
+			CHECK(pool.Get(Handle()) == nullptr);
+			CHECK(pool.Get(Handle(0, 1)) == nullptr);
+
+			const Handle first = pool.Add(std::make_shared<uint32_t>(1));
+			CHECK(first.IsValid());
+			CHECK(first.GetIndex() == 0 && first.GetGeneration() == 1);
+			CHECK(pool.Get(first) && *pool.Get(first) == 1);
+
+			CHECK(pool.Remove(first));
+			CHECK(!pool.Remove(first));
+			CHECK(pool.Get(first) == nullptr);
+			CHECK(pool.GetShared(first) == nullptr);
+			CHECK(pool.GetSize() == 0);
+
+			// The slot is reused with a new generation, the old handle does not resolve to the new resource.
+			const Handle second = pool.Add(std::make_shared<uint32_t>(2));
+			CHECK(second.GetIndex() == first.GetIndex());
+			CHECK(second.GetGeneration() == 2);
+			CHECK(pool.Get(first) == nullptr);
+			CHECK(pool.Get(second) && *pool.Get(second) == 2);
+			CHECK(pool.GetShared(second).get() == pool.Get(second));
+
+			// A handle past the slots that were handed out does not read a page that does not exist.
+			CHECK(pool.Get(Handle(Pool::PAGE_SIZE * 4, 1)) == nullptr);
+			return true;
+		}
+
+		//---------------------------------------------------------------------
+		TEST_CASE(GenerationWrapsAroundToOne)
+		{
+			Pool pool;
+			Handle handle = pool.Add(std::make_shared<uint32_t>(0));
+			for (uint32_t generation = 1; generation < Handle::MAX_GENERATION; generation++)
+			{
+				CHECK(handle.GetGeneration() == generation);
+				CHECK(pool.Remove(handle));
+				handle = pool.Add(std::make_shared<uint32_t>(generation));
+			}
+			CHECK(handle.GetGeneration() == Handle::MAX_GENERATION);
+			CHECK(handle.GetIndex() == 0);
+
+			// Generation 0 is skipped, otherwise the handle of slot 0 would be the empty handle.
+			CHECK(pool.Remove(handle));
+			const Handle wrapped = pool.Add(std::make_shared<uint32_t>(0));
+			CHECK(wrapped.GetGeneration() == 1);
+			CHECK(wrapped.IsValid());
+			CHECK(pool.Get(wrapped) != nullptr);
+			CHECK(pool.Get(handle) == nullptr);
+			return true;
+		}
+
+		//---------------------------------------------------------------------
+		TEST_CASE(GrowsPastPageWithoutMovingSlots)
+		{
+			constexpr uint32_t COUNT = Pool::PAGE_SIZE * 3 + 10;
+
+			Pool pool;
+			std::vector<Handle> handles;
+			std::vector<uint32_t*> addresses;
+			for (uint32_t i = 0; i < COUNT; i++)
+			{
+				handles.push_back(pool.Add(std::make_shared<uint32_t>(i)));
+				addresses.push_back(pool.Get(handles.back()));
+				CHECK(handles.back().GetIndex() == i);
+			}
+			CHECK(pool.GetSize() == COUNT);
+
+			// Adding pages does not move the resources that were resolved before.
+			for (uint32_t i = 0; i < COUNT; i++)
+			{
+				CHECK(pool.Get(handles[i]) == addresses[i]);
+				CHECK(*addresses[i] == i);
+			}
+
+			// Removed slots are reused before a new one is created, the most recently removed first.
+			CHECK(pool.Remove(handles[Pool::PAGE_SIZE + 5]));
+			CHECK(pool.Remove(handles[3]));
+			CHECK(pool.Add(std::make_shared<uint32_t>(0)).GetIndex() == 3);
+			CHECK(pool.Add(std::make_shared<uint32_t>(0)).GetIndex() == Pool::PAGE_SIZE + 5);
+			CHECK(pool.Add(std::make_shared<uint32_t>(0)).GetIndex() == COUNT);
+
+			uint32_t visited = 0;
+			uint32_t previous = 0;
+			bool ordered = true;
+			pool.ForEach([&](Handle a_Handle, const uint32_t&)
+				{
+					ordered = ordered && (visited == 0 || a_Handle.GetIndex() > previous);
+					previous = a_Handle.GetIndex();
+					visited++;
+				});
+			CHECK(visited == COUNT + 1);
+			CHECK(ordered);
+			return true;
+		}
+
+		//---------------------------------------------------------------------
+		TEST_CASE(ResolvesWhileAnotherThreadAddsAndRemoves)
+		{
+			constexpr uint32_t SLOTS = Pool::PAGE_SIZE + 32;
+			constexpr uint32_t ROUNDS = 200;
+
+			// Every resource stores the value of its own handle, a handle that resolves to another resource shows up as a mismatch.
+			Pool pool;
+			std::vector<Handle> handles(SLOTS);
+			for (uint32_t i = 0; i < SLOTS; i++)
+			{
+				std::shared_ptr<uint32_t> resource = std::make_shared<uint32_t>(0);
+				handles[i] = pool.Add(resource);
+				*resource = handles[i].GetValue();
+			}
+			const std::vector<Handle> firstHandles = handles;
+
+			// Removed resources are kept alive, like the resource atlas keeps them until the gpu is done with them.
+			std::vector<std::shared_ptr<uint32_t>> removed;
+			std::atomic<bool> done = false;
+			std::atomic<uint32_t> mismatches = 0;
+
+			std::thread reader([&]()
+				{
+					while (!done.load())
+					{
+						for (const Handle& handle : firstHandles)
+						{
+							const uint32_t* resource = pool.Get(handle);
+							if (resource && *resource != handle.GetValue())
+							{
+								mismatches++;
+							}
+						}
+					}
+				});
+
+			for (uint32_t round = 0; round < ROUNDS; round++)
+			{
+				for (Handle& handle : handles)
+				{
+					removed.push_back(pool.GetShared(handle));
+					pool.Remove(handle);
+
+					std::shared_ptr<uint32_t> resource = std::make_shared<uint32_t>(0);
+					handle = pool.Add(resource);
+					*resource = handle.GetValue();
+				}
+			}
+			done = true;
+			reader.join();
+
+			CHECK(mismatches.load() == 0);
+			for (const Handle& handle : firstHandles)
+			{
+				CHECK(pool.Get(handle) == nullptr);
+			}
+			return true;
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,243 @@
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "TestRunner.h"
+#include "graphics/SpriteBatcher.h"
+#include "graphics/TextureData.h"
+#include "graphics/null/Mesh.h"
+#include "graphics/software/SoftwareRenderDevice.h"
+#include "graphics/software/SoftwareTexture.h"
+
+namespace gallus
+{
+	namespace tests
+	{
+		namespace
+		{
+			constexpr uint32_t BLACK = 0xFF000000;
+
+			/// <summary>
+			/// Software device with a frame buffer whose pixels are world units, like the null renderer sets it up.
+			/// </summary>
+			struct Scene
+			{
+				graphics::software::SoftwareRenderDevice m_Device;
+				graphics::null::Mesh m_Quad;
+				std::vector<graphics::SpriteInstance> m_aInstances;
+
+				Scene(int32_t a_iWidth, int32_t a_iHeight)
+				{
+					m_Quad.LoadByName("quad", nullptr);
+					m_Device.Resize({ a_iWidth, a_iHeight });
+					m_Device.SetViewProjection(glm::ortho(0.0f, static_cast<float>(a_iWidth), static_cast<float>(a_iHeight), 0.0f, -1.0f, 1.0f));
+				}
+
+				void AddSprite(const math::Affine2D& a_WorldMatrix, const glm::vec4& a_vColor)
+				{
+					m_aInstances.push_back({ a_WorldMatrix, glm::vec4(0.0f, 0.0f, 1.0f, 1.0f), a_vColor });
+				}
+
+				const std::vector<uint32_t>& Draw(bool a_bSimd)
+				{
+					m_Device.SetSimdEnabled(a_bSimd);
+					m_Device.Clear(glm::vec4(0.0f, 0.0f, 0.0f, 1.0f));
+					m_Device.SetInstances(m_aInstances);
+					m_Device.BindTexture(nullptr);
+					m_Device.DrawInstanced(&m_Quad, 0, static_cast<uint32_t>(m_aInstances.size()));
+					return m_Device.GetFrameBuffer().GetPixels();
+				}
+			};
+
+			/// <summary>
+			/// Builds a cooked RGBA8 texture file with a single mip.
+			/// </summary>
+			std::vector<uint8_t> makeCookedTexture(uint32_t a_iWidth, uint32_t a_iHeight, const std::vector<uint32_t>& a_aPixels)
+			{
+				graphics::CookedTextureHeader header;
+				header.m_iWidth = a_iWidth;
+				header.m_iHeight = a_iHeight;
+				header.m_iDataSize = a_aPixels.size() * sizeof(uint32_t);
+
+				std::vector<uint8_t> file(sizeof(header) + header.m_iDataSize);
+				memcpy(file.data(), &header, sizeof(header));
+				memcpy(file.data() + sizeof(header), a_aPixels.data(), header.m_iDataSize);
+				return file;
+			}
+		}
+
+		//---------------------------------------------------------------------
+		TEST_CASE(DrawsFixedScene)
+		{
+			Scene scene(16, 16);
+			scene.AddSprite(math::Affine2D::FromTransform({ 2.0f, 2.0f }, 0.0f, { 4.0f, 4.0f }), glm::vec4(1.0f, 0.0f, 0.0f, 1.0f));
+			scene.AddSprite(math::Affine2D::FromTransform({ 8.0f, 10.0f }, 0.0f, { 6.0f, 3.0f }), glm::vec4(0.0f, 1.0f, 0.0f, 1.0f));
+
+			// Drawn later, so it covers the corner of the red sprite. The color gets multiplied with the white texel.
+			scene.AddSprite(math::Affine2D::FromTransform({ 5.0f, 5.0f }, 0.0f, { 2.0f, 2.0f }), glm::vec4(0.0f, 0.0f, 1.0f, 0.2f));
+
+			const std::vector<uint32_t>& pixels = scene.Draw(true);
+			for (int32_t y = 0; y < 16; y++)
+			{
+				for (int32_t x = 0; x < 16; x++)
+				{
+					uint32_t expected = BLACK;
+					if (x >= 5 && x < 7 && y >= 5 && y < 7)
+					{
+						expected = 0x33FF0000;
+					}
+					else if (x >= 2 && x < 6 && y >= 2 && y < 6)
+					{
+						expected = 0xFF0000FF;
+					}
+					else if (x >= 8 && x < 14 && y >= 10 && y < 13)
+					{
+						expected = 0xFF00FF00;
+					}
+
+					if (pixels[y * 16 + x] != expected)
+					{
+						TESTF("Pixel (%i, %i) is %08X instead of %08X.", x, y, pixels[y * 16 + x], expected);
+						return false;
+					}
+				}
+			}
+
+			const graphics::software::SoftwareRenderStats& stats = scene.m_Device.GetStats();
+			CHECK(stats.m_iTriangleCount == 6);
+			CHECK(stats.m_iPixelCount == 16 + 18 + 4);
+			return true;
+		}
+
+		//---------------------------------------------------------------------
+		TEST_CASE(SimdFillMatchesScalarFill)
+		{
+			// Rotated sprites at fractional positions, with colors that round, cover partial spans of every length.
+			Scene scene(61, 47);
+			for (uint32_t i = 0; i < 24; i++)
+			{
+				const float t = static_cast<float>(i);
+				scene.AddSprite(math::Affine2D::FromTransform({ std::fmod(t * 7.37f, 50.0f), std::fmod(t * 5.11f, 40.0f) }, t * 17.0f, { 3.0f + t * 0.61f, 2.0f + std::fmod(t * 1.7f, 9.0f) }, { 1.5f, 1.0f }),
+					glm::vec4(std::fmod(t * 0.37f, 1.0f), std::fmod(t * 0.53f, 1.0f), std::fmod(t * 0.71f, 1.0f), 0.5f + std::fmod(t * 0.13f, 0.5f)));
+			}
+
+			// Also parts that are off screen or degenerate.
+			scene.AddSprite(math::Affine2D::FromTransform({ -5.0f, 40.0f }, 10.0f, { 12.0f, 30.0f }), glm::vec4(1.0f));
+			scene.AddSprite(math::Affine2D::FromTransform({ 10.0f, 10.0f }, 0.0f, { 0.0f, 5.0f }), glm::vec4(1.0f));
+
+			const std::vector<uint32_t> simd = scene.Draw(true);
+			const uint64_t simdPixels = scene.m_Device.GetStats().m_iPixelCount;
+			const char* instructionSet = scene.m_Device.GetFillInstructionSet();
+			const std::vector<uint32_t> scalar = scene.Draw(false);
+			const uint64_t scalarPixels = scene.m_Device.GetStats().m_iPixelCount - simdPixels;
+
+			TESTF("Compared the %s fill with the scalar fill.", instructionSet);
+			CHECK(simd == scalar);
+			CHECK(simdPixels == scalarPixels);
+			CHECK(simdPixels > 0);
+			return true;
+		}
+
+		//---------------------------------------------------------------------
+		TEST_CASE(AdjacentSpritesNeitherOverlapNorLeaveGaps)
+		{
+			constexpr int32_t SIZE = 48;
+			constexpr uint32_t CELLS = 12;
+
+			struct Grid
+			{
+				math::Vector2 m_vOrigin;
+				float m_fCellSize = 0.0f;
+				float m_fRotationDegrees = 0.0f;
+			};
+
+			// Cell edges on pixel centers test the tie rule, rotated grids test the shared diagonal edges.
+			const Grid grids[] = {
+				{ { 0.5f, 0.5f }, 1.5f, 0.0f },
+				{ { 3.25f, 2.75f }, 3.375f, 0.0f },
+				{ { 20.3125f, 1.0625f }, 2.125f, 30.0f },
+				{ { 24.0f, 0.5f }, 2.5f, 45.0f },
+				{ { 6.0f, 20.0f }, 2.75f, -17.0f },
+			};
+
+			for (const Grid& grid : grids)
+			{
+				const math::Affine2D placement = math::Affine2D::Rotation(math::ToRadians(grid.m_fRotationDegrees)) * math::Affine2D::Translation(grid.m_vOrigin);
+				math::Affine2D toGrid;
+				CHECK(placement.Inverse(toGrid));
+
+				Scene scene(SIZE, SIZE);
+				for (uint32_t y = 0; y < CELLS; y++)
+				{
+					for (uint32_t x = 0; x < CELLS; x++)
+					{
+						const math::Affine2D cell = math::Affine2D::Scaling({ grid.m_fCellSize, grid.m_fCellSize }) *
+							math::Affine2D::Translation({ static_cast<float>(x) * grid.m_fCellSize, static_cast<float>(y) * grid.m_fCellSize });
+						scene.AddSprite(cell * placement, glm::vec4(1.0f));
+					}
+				}
+				const std::vector<uint32_t>& pixels = scene.Draw(true);
+
+				// Every pixel is written at most once, so the writes add up to the covered pixels.
+				uint64_t covered = 0;
+				uint32_t gaps = 0;
+				uint32_t outside = 0;
+				const float extent = grid.m_fCellSize * CELLS;
+				constexpr float MARGIN = 0.01f;
+				for (int32_t y = 0; y < SIZE; y++)
+				{
+					for (int32_t x = 0; x < SIZE; x++)
+					{
+						const math::Vector2 local = toGrid.TransformPoint({ static_cast<float>(x) + 0.5f, static_cast<float>(y) + 0.5f });
+						const bool isCovered = pixels[y * SIZE + x] != BLACK;
+						const bool inside = local.x > MARGIN && local.y > MARGIN && local.x < extent - MARGIN && local.y < extent - MARGIN;
+						const bool nearGrid = local.x > -MARGIN && local.y > -MARGIN && local.x < extent + MARGIN && local.y < extent + MARGIN;
+						covered += isCovered ? 1 : 0;
+						gaps += (inside && !isCovered) ? 1 : 0;
+						outside += (isCovered && !nearGrid) ? 1 : 0;
+					}
+				}
+
+				const uint64_t written = scene.m_Device.GetStats().m_iPixelCount;
+				if (written != covered || gaps != 0 || outside != 0)
+				{
+					TESTF("Grid rotated %.0f degrees: %llu pixels written, %llu covered, %u gaps, %u outside.", grid.m_fRotationDegrees,
+						static_cast<unsigned long long>(written), static_cast<unsigned long long>(covered), gaps, outside);
+					return false;
+				}
+			}
+			return true;
+		}
+
+		//---------------------------------------------------------------------
+		TEST_CASE(SamplesOutOfRangeCoordinates)
+		{
+			const std::vector<uint32_t> texels = { 0xFF000001, 0xFF000002, 0xFF000003, 0xFF000004 };
+			const std::vector<uint8_t> file = makeCookedTexture(2, 2, texels);
+
+			graphics::software::SoftwareTexture texture;
+			CHECK(texture.Sample(0.5f, 0.5f) == 0xFFFFFFFF);
+			CHECK(texture.Load(core::Data(file.data(), file.size())));
+
+			// Nearest texel, wrapping in both directions.
+			CHECK(texture.Sample(0.25f, 0.25f) == texels[0]);
+			CHECK(texture.Sample(0.75f, 0.25f) == texels[1]);
+			CHECK(texture.Sample(0.25f, 0.75f) == texels[2]);
+			CHECK(texture.Sample(1.75f, -0.25f) == texels[3]);
+			CHECK(texture.Sample(-1.25f, 3.75f) == texels[3]);
+
+			// Coordinates that do not fit in an int fall back to the first texel instead of converting out of range.
+			const float infinity = std::numeric_limits<float>::infinity();
+			const float nan = std::numeric_limits<float>::quiet_NaN();
+			CHECK(texture.Sample(nan, 0.25f) == texels[0]);
+			CHECK(texture.Sample(0.75f, nan) == texels[1]);
+			CHECK(texture.Sample(infinity, -infinity) == texels[0]);
+			CHECK(texture.Sample(1e30f, 0.75f) == texels[2]);
+			CHECK(texture.Sample(0.75f, -1e30f) == texels[1]);
+			return true;
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,207 @@
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+#include "TestRunner.h"
+#include "graphics/RenderPacket.h"
+#include "graphics/RenderQueue.h"
+#include "graphics/SpriteBatcher.h"
+#include "graphics/null/Mesh.h"
+#include "graphics/null/Shader.h"
+#include "graphics/null/Texture.h"
+
+namespace gallus
+{
+	namespace tests
+	{
+		namespace
+		{
+			using graphics::RenderQueue;
+
+			/// <summary>
+			/// Resources the draws point at. The batcher only compares their addresses, so they do not need to be loaded.
+			/// </summary>
+			struct Resources
+			{
+				graphics::backend::Mesh m_Mesh;
+				graphics::backend::Shader m_aShaders[2];
+				graphics::backend::Texture m_aTextures[2];
+			};
+
+			/// <summary>
+			/// Creates a draw item, the color tells the draws apart after sorting.
+			/// </summary>
+			graphics::DrawItem makeItem(Resources& a_Resources, uint32_t a_iShader, uint32_t a_iTexture, float a_fTag, uint8_t a_iLayer = 0, float a_fDepth = 0.0f)
+			{
+				graphics::DrawItem item;
+				item.m_pMesh = &a_Resources.m_Mesh;
+				item.m_pShader = &a_Resources.m_aShaders[a_iShader];
+				item.m_pTexture = &a_Resources.m_aTextures[a_iTexture];
+				item.m_vColor = glm::vec4(a_fTag);
+				item.m_iLayer = a_iLayer;
+				item.m_fDepth = a_fDepth;
+				return item;
+			}
+		}
+
+		//---------------------------------------------------------------------
+		TEST_CASE(SplitsBatchesOnShaderAndTextureChanges)
+		{
+			Resources resources;
+			graphics::RenderPacket packet;
+			packet.m_aDrawItems = {
+				makeItem(resources, 0, 0, 0.0f),
+				makeItem(resources, 0, 0, 1.0f),
+				makeItem(resources, 0, 1, 2.0f),
+				makeItem(resources, 1, 1, 3.0f),
+				makeItem(resources, 0, 0, 4.0f),
+			};
+
+			// Draws without a mesh are left out.
+			packet.m_aDrawItems.push_back(makeItem(resources, 0, 0, 5.0f));
+			packet.m_aDrawItems.back().m_pMesh = nullptr;
+
+			graphics::SpriteBatcher batcher;
+			batcher.Build(packet);
+
+			// Draws with the same state end up in one batch, in the order they were submitted.
+			const std::vector<graphics::SpriteBatch>& batches = batcher.GetBatches();
+			CHECK(batches.size() == 3);
+			CHECK(batches[0].m_pShader == &resources.m_aShaders[0] && batches[0].m_pTexture == &resources.m_aTextures[0]);
+			CHECK(batches[0].m_iFirstInstance == 0 && batches[0].m_iInstanceCount == 3);
+			CHECK(batches[1].m_pShader == &resources.m_aShaders[0] && batches[1].m_pTexture == &resources.m_aTextures[1]);
+			CHECK(batches[1].m_iFirstInstance == 3 && batches[1].m_iInstanceCount == 1);
+			CHECK(batches[2].m_pShader == &resources.m_aShaders[1] && batches[2].m_pTexture == &resources.m_aTextures[1]);
+			CHECK(batches[2].m_iFirstInstance == 4 && batches[2].m_iInstanceCount == 1);
+
+			const float expectedTags[] = { 0.0f, 1.0f, 4.0f, 2.0f, 3.0f };
+			const std::vector<graphics::SpriteInstance>& instances = batcher.GetInstances();
+			CHECK(instances.size() == 5);
+			for (size_t i = 0; i < instances.size(); i++)
+			{
+				CHECK(instances[i].m_vColor.x == expectedTags[i]);
+			}
+
+			// Only the state that differs from the previous batch gets bound.
+			CHECK(batches[0].m_bBindShader && batches[0].m_bBindTexture);
+			CHECK(!batches[1].m_bBindShader && batches[1].m_bBindTexture);
+			CHECK(batches[2].m_bBindShader && !batches[2].m_bBindTexture);
+
+			const graphics::RenderStats& stats = batcher.GetStats();
+			CHECK(stats.m_iDrawCount == 5);
+			CHECK(stats.m_iBatchCount == 3);
+			CHECK(stats.m_iShaderBinds == 2 && stats.m_iShaderBindsSkipped == 1);
+			CHECK(stats.m_iTextureBinds == 2 && stats.m_iTextureBindsSkipped == 1);
+			return true;
+		}
+
+		//---------------------------------------------------------------------
+		TEST_CASE(CountsSkippedBindsAcrossLayers)
+		{
+			// Layers split batches even when the state is the same, the state is not bound again.
+			Resources resources;
+			graphics::RenderPacket packet;
+			packet.m_aDrawItems = {
+				makeItem(resources, 0, 0, 0.0f, 2),
+				makeItem(resources, 0, 0, 1.0f, 0),
+				makeItem(resources, 0, 0, 2.0f, 1),
+				makeItem(resources, 0, 1, 3.0f, 1),
+			};
+
+			graphics::SpriteBatcher batcher;
+			batcher.Build(packet);
+
+			const std::vector<graphics::SpriteBatch>& batches = batcher.GetBatches();
+			CHECK(batches.size() == 4);
+			CHECK(batcher.GetInstances()[0].m_vColor.x == 1.0f);
+			CHECK(batcher.GetInstances()[3].m_vColor.x == 0.0f);
+
+			// Sorted as layer 0, layer 1 with texture 0, layer 1 with texture 1, layer 2 with texture 0 again.
+			const graphics::RenderStats& stats = batcher.GetStats();
+			CHECK(stats.m_iBatchCount == 4);
+			CHECK(stats.m_iShaderBinds == 1 && stats.m_iShaderBindsSkipped == 3);
+			CHECK(stats.m_iTextureBinds == 3 && stats.m_iTextureBindsSkipped == 1);
+
+			// Building again starts the counters over.
+			packet.m_aDrawItems.resize(1);
+			batcher.Build(packet);
+			CHECK(batcher.GetStats().m_iBatchCount == 1);
+			CHECK(batcher.GetStats().m_iShaderBinds == 1 && batcher.GetStats().m_iShaderBindsSkipped == 0);
+			CHECK(batcher.GetStats().m_iTextureBinds == 1 && batcher.GetStats().m_iTextureBindsSkipped == 0);
+			return true;
+		}
+
+		//---------------------------------------------------------------------
+		TEST_CASE(SortKeysOrderLayerDepthShaderTextureMesh)
+		{
+			constexpr uint32_t MAX_SHADER = (1u << RenderQueue::SHADER_BITS) - 1;
+			constexpr uint32_t MAX_TEXTURE = (1u << RenderQueue::TEXTURE_BITS) - 1;
+			constexpr uint32_t MAX_MESH = (1u << RenderQueue::MESH_BITS) - 1;
+
+			// Every field outweighs all fields below it.
+			CHECK(RenderQueue::MakeKey(1, -1000.0f, 0, 0, 0) > RenderQueue::MakeKey(0, 1000.0f, MAX_SHADER, MAX_TEXTURE, MAX_MESH));
+			CHECK(RenderQueue::MakeKey(0, 1.0f, 0, 0, 0) > RenderQueue::MakeKey(0, 0.5f, MAX_SHADER, MAX_TEXTURE, MAX_MESH));
+			CHECK(RenderQueue::MakeKey(0, 0.0f, 1, 0, 0) > RenderQueue::MakeKey(0, 0.0f, 0, MAX_TEXTURE, MAX_MESH));
+			CHECK(RenderQueue::MakeKey(0, 0.0f, 0, 1, 0) > RenderQueue::MakeKey(0, 0.0f, 0, 0, MAX_MESH));
+			CHECK(RenderQueue::MakeKey(0, 0.0f, 0, 0, 1) > RenderQueue::MakeKey(0, 0.0f, 0, 0, 0));
+			CHECK(RenderQueue::MakeKey(255, 0.0f, 0, 0, 0) > RenderQueue::MakeKey(254, 0.0f, 0, 0, 0));
+
+			// Depths order like floats, negative ones included.
+			const float depths[] = { -1e30f, -250.0f, -1.0f, -0.25f, 0.0f, 0.25f, 1.0f, 250.0f, 1e30f };
+			for (size_t i = 1; i < std::size(depths); i++)
+			{
+				CHECK(RenderQueue::MakeKey(3, depths[i - 1], 0, 0, 0) < RenderQueue::MakeKey(3, depths[i], 0, 0, 0));
+			}
+
+			// Ids that do not fit wrap around instead of spilling into the fields above.
+			CHECK(RenderQueue::MakeKey(0, 0.0f, MAX_SHADER + 1, MAX_TEXTURE + 1, MAX_MESH + 1) == RenderQueue::MakeKey(0, 0.0f, 0, 0, 0));
+			return true;
+		}
+
+		//---------------------------------------------------------------------
+		TEST_CASE(SortsLikeStableSortOnKeys)
+		{
+			Resources resources;
+			std::vector<graphics::DrawItem> items;
+			uint32_t seed = 12345;
+			const auto next = [&seed]()
+				{
+					seed = seed * 1664525u + 1013904223u;
+					return seed >> 16;
+				};
+			for (uint32_t i = 0; i < 2000; i++)
+			{
+				const uint32_t value = next();
+				items.push_back(makeItem(resources, value & 1, (value >> 1) & 1, static_cast<float>(i), static_cast<uint8_t>((value >> 2) % 3), static_cast<float>(static_cast<int32_t>(value >> 4) % 7 - 3) * 0.5f));
+			}
+
+			RenderQueue queue;
+			for (uint32_t i = 0; i < static_cast<uint32_t>(items.size()); i++)
+			{
+				queue.Submit(items[i], i);
+			}
+			std::vector<RenderQueue::Entry> expected = queue.GetEntries();
+			std::stable_sort(expected.begin(), expected.end(), [](const RenderQueue::Entry& a_Left, const RenderQueue::Entry& a_Right)
+				{
+					return a_Left.m_iKey < a_Right.m_iKey;
+				});
+
+			queue.Sort();
+			const std::vector<RenderQueue::Entry>& entries = queue.GetEntries();
+			CHECK(entries.size() == expected.size());
+			for (size_t i = 0; i < entries.size(); i++)
+			{
+				CHECK(entries[i].m_iKey == expected[i].m_iKey && entries[i].m_iIndex == expected[i].m_iIndex);
+			}
+
+			// Layers and depths come out in drawing order.
+			for (size_t i = 1; i < entries.size(); i++)
+			{
+				const graphics::DrawItem& previous = items[entries[i - 1].m_iIndex];
+				const graphics::DrawItem& current = items[entries[i].m_iIndex];
+				CHECK(previous.m_iLayer < current.m_iLayer || (previous.m_iLayer == current.m_iLayer && previous.m_fDepth <= current.m_fDepth));
+			}
+			return true;
+		}
+	}
+}
\ No newline at end of file
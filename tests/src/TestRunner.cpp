@@ -0,0 +1,73 @@
+#include "TestRunner.h"
+
+#include <chrono>
+#include <vector>
+
+#include "utils/file_abstractions.h"
+
+namespace gallus
+{
+	namespace tests
+	{
+		namespace
+		{
+			struct RegisteredTest
+			{
+				std::string m_sGroup; /// Name of the file the test is in, without its extension.
+				std::string m_sName;
+				TestFunction m_Function = nullptr;
+			};
+
+			// Tests register themselves during static initialization, so the list cannot be a global.
+			std::vector<RegisteredTest>& getTests()
+			{
+				static std::vector<RegisteredTest> tests;
+				return tests;
+			}
+		}
+
+		//---------------------------------------------------------------------
+		bool RegisterTest(const char* a_sFile, const char* a_sName, TestFunction a_Function)
+		{
+			getTests().push_back({ fs::path(a_sFile).stem().string(), a_sName, a_Function });
+			return true;
+		}
+
+		//---------------------------------------------------------------------
+		uint32_t RunTests(const std::string& a_sGroup)
+		{
+			uint32_t ran = 0, failed = 0;
+			for (const RegisteredTest& test : getTests())
+			{
+				if (!a_sGroup.empty() && test.m_sGroup != a_sGroup)
+				{
+					continue;
+				}
+
+				const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+				const bool passed = test.m_Function();
+				const double time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+				ran++;
+				if (passed)
+				{
+					TESTF("Passed %s.%s (%.3f ms).", test.m_sGroup.c_str(), test.m_sName.c_str(), time);
+				}
+				else
+				{
+					failed++;
+					LOGF(LOGSEVERITY_ERROR, LOG_CATEGORY_TEST, "Failed %s.%s (%.3f ms).", test.m_sGroup.c_str(), test.m_sName.c_str(), time);
+				}
+			}
+
+			if (ran == 0)
+			{
+				LOGF(LOGSEVERITY_ERROR, LOG_CATEGORY_TEST, "Failed running tests: no tests in group \"%s\".", a_sGroup.c_str());
+				return 1;
+			}
+
+			TESTF("%u of %u tests passed.", ran - failed, ran);
+			return failed;
+		}
+	}
+}
\ No newline at end of file
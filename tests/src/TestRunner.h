@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "logger/Logger.h"
+
+namespace gallus
+{
+	namespace tests
+	{
+		/// <summary>
+		/// A test, returns true if it passed.
+		/// </summary>
+		using TestFunction = bool (*)();
+
+		/// <summary>
+		/// Registers a test. Tests are grouped by the file they are in, which is how ctest runs them.
+		/// </summary>
+		/// <param name="a_sFile">The file the test is in.</param>
+		/// <param name="a_sName">Name of the test.</param>
+		/// <param name="a_Function">The test.</param>
+		/// <returns>Always true, so it can initialize a static.</returns>
+		bool RegisterTest(const char* a_sFile, const char* a_sName, TestFunction a_Function);
+
+		/// <summary>
+		/// Runs the tests of a group.
+		/// </summary>
+		/// <param name="a_sGroup">Name of the file the tests are in without its extension, or empty to run all tests.</param>
+		/// <returns>The number of tests that failed, a group without tests counts as one.</returns>
+		uint32_t RunTests(const std::string& a_sGroup);
+	}
+}
+
+// Defines a test that gets registered before main runs.
+#define TEST_CASE(a_Name)\
+static bool a_Name();\
+static const bool a_Name##Registered = gallus::tests::RegisterTest(__FILE__, #a_Name, a_Name);\
+static bool a_Name()
+
+// Fails the test if the condition does not hold.
+#define CHECK(a_Condition)\
+do{\
+	if (!(a_Condition))\
+	{\
+		LOGF(LOGSEVERITY_ERROR, LOG_CATEGORY_TEST, "Check failed: %s.", #a_Condition);\
+		return false;\
+	}\
+} while (0)
\ No newline at end of file
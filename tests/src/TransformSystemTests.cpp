@@ -0,0 +1,136 @@
+#include <cmath>
+
+#include "TestRunner.h"
+#include "gameplay/EntityComponentSystem.h"
+#include "gameplay/systems/TransformSystem.h"
+
+namespace gallus
+{
+	namespace tests
+	{
+		namespace
+		{
+			bool nearlyEqual(const math::Vector2& a_vA, const math::Vector2& a_vB)
+			{
+				return std::abs(a_vA.x - a_vB.x) < 1e-4f && std::abs(a_vA.y - a_vB.y) < 1e-4f;
+			}
+
+			/// <summary>
+			/// Where the origin of a transform ends up in the world.
+			/// </summary>
+			math::Vector2 getWorldPosition(gameplay::TransformSystem& a_System, const gameplay::EntityID& a_ID)
+			{
+				return a_System.GetComponent(a_ID).GetWorldMatrix().TransformPoint({ 0.0f, 0.0f });
+			}
+		}
+
+		//---------------------------------------------------------------------
+		TEST_CASE(WorldMatricesFollowParents)
+		{
+			gameplay::EntityComponentSystem ecs;
+			ecs.Initialize();
+			gameplay::TransformSystem& transforms = ecs.CreateSystem<gameplay::TransformSystem>();
+
+			// The child gets its component first, so the storage has it before its parent and the hierarchy has to reorder them.
+			const gameplay::EntityID grandchild = ecs.CreateEntity("Grandchild");
+			const gameplay::EntityID child = ecs.CreateEntity("Child");
+			const gameplay::EntityID parent = ecs.CreateEntity("Parent");
+			transforms.GetComponent(grandchild).Transform().SetPosition({ 0.0f, 3.0f });
+			transforms.GetComponent(child).Transform().SetPosition({ 5.0f, 0.0f });
+			transforms.GetComponent(parent).Transform().SetPosition({ 10.0f, 0.0f });
+			CHECK(transforms.SetParent(grandchild, child));
+			CHECK(transforms.SetParent(child, parent));
+
+			ecs.Update(0.0f);
+			CHECK(nearlyEqual(getWorldPosition(transforms, parent), { 10.0f, 0.0f }));
+			CHECK(nearlyEqual(getWorldPosition(transforms, child), { 15.0f, 0.0f }));
+			CHECK(nearlyEqual(getWorldPosition(transforms, grandchild), { 15.0f, 3.0f }));
+
+			// Changing only the parent moves the whole subtree, the local matrices of the children stay as they are. Rotation
+			// turns around the center of the unit quad, which stays in place.
+			transforms.GetComponent(parent).Transform().SetRotation(90.0f);
+			ecs.Update(0.0f);
+			const math::Affine2D parentWorld = transforms.GetComponent(parent).GetWorldMatrix();
+			const math::Affine2D childWorld = transforms.GetComponent(child).GetLocalMatrix() * parentWorld;
+			const math::Affine2D grandchildWorld = transforms.GetComponent(grandchild).GetLocalMatrix() * childWorld;
+			CHECK(nearlyEqual(parentWorld.TransformPoint({ 0.5f, 0.5f }), { 10.5f, 0.5f }));
+			CHECK(nearlyEqual(getWorldPosition(transforms, child), childWorld.TransformPoint({ 0.0f, 0.0f })));
+			CHECK(nearlyEqual(getWorldPosition(transforms, grandchild), grandchildWorld.TransformPoint({ 0.0f, 0.0f })));
+			CHECK(nearlyEqual(transforms.GetComponent(child).GetLocalMatrix().TransformPoint({ 0.0f, 0.0f }), { 5.0f, 0.0f }));
+			CHECK(!nearlyEqual(getWorldPosition(transforms, child), { 15.0f, 0.0f }));
+
+			ecs.Destroy();
+			return true;
+		}
+
+		//---------------------------------------------------------------------
+		TEST_CASE(ReparentingKeepsLocalTransforms)
+		{
+			gameplay::EntityComponentSystem ecs;
+			ecs.Initialize();
+			gameplay::TransformSystem& transforms = ecs.CreateSystem<gameplay::TransformSystem>();
+
+			const gameplay::EntityID first = ecs.CreateEntity("First");
+			const gameplay::EntityID second = ecs.CreateEntity("Second");
+			const gameplay::EntityID child = ecs.CreateEntity("Child");
+			transforms.GetComponent(first).Transform().SetPosition({ 10.0f, 0.0f });
+			transforms.GetComponent(second).Transform().SetPosition({ 0.0f, 20.0f });
+			transforms.GetComponent(child).Transform().SetPosition({ 1.0f, 1.0f });
+			CHECK(transforms.SetParent(child, first));
+
+			ecs.Update(0.0f);
+			CHECK(nearlyEqual(getWorldPosition(transforms, child), { 11.0f, 1.0f }));
+
+			CHECK(transforms.SetParent(child, second));
+			ecs.Update(0.0f);
+			CHECK(transforms.GetComponent(child).GetParent() == second);
+			CHECK(nearlyEqual(getWorldPosition(transforms, child), { 1.0f, 21.0f }));
+
+			// Cycles and parents without a transform are refused and leave the hierarchy as it was.
+			CHECK(!transforms.SetParent(second, child));
+			CHECK(!transforms.SetParent(child, child));
+			CHECK(!transforms.SetParent(child, ecs.CreateEntity("NoTransform")));
+			ecs.Update(0.0f);
+			CHECK(transforms.GetComponent(child).GetParent() == second);
+			CHECK(!transforms.GetComponent(second).GetParent().IsValid());
+
+			// Detaching makes the local transform the world transform.
+			CHECK(transforms.SetParent(child, gameplay::EntityID()));
+			ecs.Update(0.0f);
+			CHECK(nearlyEqual(getWorldPosition(transforms, child), { 1.0f, 1.0f }));
+
+			ecs.Destroy();
+			return true;
+		}
+
+		//---------------------------------------------------------------------
+		TEST_CASE(DeletingParentDetachesChildren)
+		{
+			gameplay::EntityComponentSystem ecs;
+			ecs.Initialize();
+			gameplay::TransformSystem& transforms = ecs.CreateSystem<gameplay::TransformSystem>();
+
+			const gameplay::EntityID parent = ecs.CreateEntity("Parent");
+			const gameplay::EntityID child = ecs.CreateEntity("Child");
+			const gameplay::EntityID grandchild = ecs.CreateEntity("Grandchild");
+			transforms.GetComponent(parent).Transform().SetPosition({ 10.0f, 0.0f });
+			transforms.GetComponent(child).Transform().SetPosition({ 5.0f, 0.0f });
+			transforms.GetComponent(grandchild).Transform().SetPosition({ 0.0f, 3.0f });
+			CHECK(transforms.SetParent(child, parent));
+			CHECK(transforms.SetParent(grandchild, child));
+			ecs.Update(0.0f);
+
+			// Removing the parent moves other components in the storage, the children still find each other.
+			ecs.DeleteEntity(parent);
+			ecs.Update(0.0f);
+			CHECK(!transforms.HasComponent(parent));
+			CHECK(!transforms.GetComponent(child).GetParent().IsValid());
+			CHECK(transforms.GetComponent(grandchild).GetParent() == child);
+			CHECK(nearlyEqual(getWorldPosition(transforms, child), { 5.0f, 0.0f }));
+			CHECK(nearlyEqual(getWorldPosition(transforms, grandchild), { 5.0f, 3.0f }));
+
+			ecs.Destroy();
+			return true;
+		}
+	}
+}
\ No newline at end of file
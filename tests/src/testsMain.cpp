@@ -0,0 +1,20 @@
+#include <cstdlib>
+#include <string>
+
+#include "logger/Logger.h"
+#include "TestRunner.h"
+
+int main(int argc, char* argv[])
+{
+	// Usage: tests [group], or benchmarks [group]
+	// The group is the name of a *Tests.cpp or *Benchmarks.cpp file without its extension, for example "ECSTests".
+	// Without a group all of them run.
+	const std::string group = argc > 1 ? argv[1] : "";
+
+	gallus::logger::LOGGER.Initialize(true);
+
+	const uint32_t failed = gallus::tests::RunTests(group);
+
+	gallus::logger::LOGGER.Destroy();
+	return failed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
\ No newline at end of file
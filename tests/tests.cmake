@@ -0,0 +1,72 @@
+project(tests)
+
+# The tests build the engine like the headless project does, without the win32 window, dx12 and imgui code.
+file(GLOB_RECURSE ENGINE_HEADERS ${CMAKE_SOURCE_DIR}/engine/src/*.h)
+file(GLOB_RECURSE ENGINE_SOURCES ${CMAKE_SOURCE_DIR}/engine/src/*.cpp)
+list(FILTER ENGINE_HEADERS EXCLUDE REGEX "/graphics/(dx12|win32|imgui)/")
+list(FILTER ENGINE_SOURCES EXCLUDE REGEX "/graphics/(dx12|win32|imgui)/")
+
+# Gather all test files. Every *Tests.cpp file is a group of tests that ctest runs separately.
+file(GLOB_RECURSE HEADERS ${CMAKE_SOURCE_DIR}/tests/src/*.h)
+file(GLOB_RECURSE SOURCES ${CMAKE_SOURCE_DIR}/tests/src/*.cpp)
+file(GLOB_RECURSE TEST_GROUPS ${CMAKE_SOURCE_DIR}/tests/src/*Tests.cpp)
+
+# Define executable.
+add_executable(${PROJECT_NAME} ${HEADERS} ${SOURCES} ${ENGINE_HEADERS} ${ENGINE_SOURCES})
+set(TEST_TARGETS ${PROJECT_NAME})
+
+# The benchmarks are optional, they build the engine once more and take a while to run. They use the test runner,
+# every *Benchmarks.cpp file is a group: "benchmarks ECSBenchmarks" runs one, "benchmarks" runs all of them.
+option(GALLUS_BUILD_BENCHMARKS "Build the benchmarks project." OFF)
+if(GALLUS_BUILD_BENCHMARKS)
+    file(GLOB_RECURSE BENCHMARK_SOURCES ${CMAKE_SOURCE_DIR}/tests/benchmarks/*.cpp)
+    set(RUNNER_SOURCES ${CMAKE_SOURCE_DIR}/tests/src/TestRunner.cpp ${CMAKE_SOURCE_DIR}/tests/src/testsMain.cpp)
+    add_executable(benchmarks ${HEADERS} ${RUNNER_SOURCES} ${BENCHMARK_SOURCES} ${ENGINE_HEADERS} ${ENGINE_SOURCES})
+    list(APPEND TEST_TARGETS benchmarks)
+endif()
+
+foreach(TEST_TARGET ${TEST_TARGETS})
+    # Define preprocessor definitions for different configurations
+    target_compile_definitions(${TEST_TARGET} PRIVATE
+        "$<$<CONFIG:${DEBUG}>:${PREDEFINITIONS_HEADLESS_DEBUG}>"
+        "$<$<CONFIG:${RELEASE}>:${PREDEFINITIONS_HEADLESS_RELEASE}>"
+    )
+
+    # Include directories
+    target_include_directories(${TEST_TARGET} PUBLIC
+        ${CMAKE_SOURCE_DIR}/engine/src
+        ${CMAKE_SOURCE_DIR}/tests/src
+        ${CMAKE_SOURCE_DIR}/external
+    )
+
+    # Set C++ standard
+    set_target_properties(${TEST_TARGET} PROPERTIES
+        CXX_STANDARD 20
+    )
+
+    find_package(Threads REQUIRED)
+    target_link_libraries(${TEST_TARGET} PRIVATE Threads::Threads)
+
+    if(MSVC)
+        target_compile_options(${TEST_TARGET} PRIVATE
+            "$<$<CONFIG:${DEBUG}>:/Od>"   # Disable optimizations for Debug
+            "$<$<CONFIG:${RELEASE}>:/O2>"  # Enable optimizations for Release
+            "$<$<CONFIG:${DEBUG}>:/MTd>"
+            "$<$<CONFIG:${RELEASE}>:/MT>"
+        )
+        target_link_libraries(${TEST_TARGET} PRIVATE Shlwapi.lib)
+    else()
+        # For GCC/Clang, set optimization level to 0 for debugging
+        target_compile_options(${TEST_TARGET} PRIVATE
+            "$<$<CONFIG:${DEBUG}>:-O0>"  # Disable optimizations for Debug
+            "$<$<CONFIG:${RELEASE}>:-O2>"  # Optimize for Release
+        )
+    endif()
+endforeach()
+
+# Register every group with ctest. A test that hangs, for example on a deadlock, fails on the timeout.
+foreach(TEST_GROUP_FILE ${TEST_GROUPS})
+    get_filename_component(TEST_GROUP ${TEST_GROUP_FILE} NAME_WE)
+    add_test(NAME ${TEST_GROUP} COMMAND ${PROJECT_NAME} ${TEST_GROUP} WORKING_DIRECTORY ${CMAKE_CURRENT_BINARY_DIR})
+    set_tests_properties(${TEST_GROUP} PROPERTIES TIMEOUT 300)
+endforeach()
\ No newline at end of file